@@ -0,0 +1,359 @@
+/*
+ * XNZevdev.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_EVDEV_H
+#define XNZ_EVDEV_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "XNZplatform.h"
+
+/*
+ * Direct TCA lever input (Linux): a reader thread takes the two throttle axes
+ * straight from the quadrant's evdev node (/dev/input/event*), with kernel
+ * timestamps (monotonic clock, same origin as xnz_time_ns), and publishes the
+ * latest pair of lever values after every complete report (SYN_REPORT) into a
+ * single-slot mailbox; the axis flight loop takes the freshest sample instead
+ * of X-Plane's once-per-frame joystick_axis_values.
+ *
+ * The mailbox is a sequence lock (odd: being written): the reader thread never
+ * waits, the flight loop copies the slot and retries if it changed meanwhile.
+ *
+ * Device: the first Thrustmaster (vendor 0x044f) node named "...TCA..." with
+ * both axes, or the XNZ_EVDEV environment variable's path, which may also be
+ * a recording (see below) replayed in real time. Values are normalized to
+ * 0..1 over each axis' range (0: minimum).
+ *
+ * Recording layout (host byte order; tools/xnz_evdev.c -record):
+ *
+ *   xnz_evdev_header
+ *   xnz_evdev_event, oldest first, until end of file
+ */
+#define XNZ_EVDEV_ENV     "XNZ_EVDEV" // device or recording path, or "auto"
+#define XNZ_EVDEV_VENDOR  0x044f // Thrustmaster
+#define XNZ_EVDEV_MAGIC   0x455A4E58u // "XNZE"
+#define XNZ_EVDEV_VERSION 1
+#define XNZ_EVDEV_POLL    100 // reader thread's longest wait (ms), i.e. stop latency
+#define XNZ_EVDEV_NODES   64 // /dev/input/event0..63
+
+typedef struct
+{
+    uint32_t sequence; // sequence lock (odd: being written)
+    uint32_t count; // samples published so far
+    uint64_t time; // kernel timestamp of the latest report (ns)
+    float value[2]; // levers 1 and 2, 0..1
+}
+xnz_evdev_mailbox;
+
+typedef struct
+{
+    uint32_t count; // zero: nothing published yet
+    uint64_t time;
+    float value[2];
+}
+xnz_evdev_sample;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint16_t code[2]; // ABS_* for levers 1 and 2
+    int32_t minimum[2];
+    int32_t maximum[2];
+    char name[64];
+}
+xnz_evdev_header;
+
+typedef struct
+{
+    uint64_t time; // ns
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+}
+xnz_evdev_event;
+
+/*
+ * Writer side (one thread).
+ */
+static inline void xnz_evdev_publish(xnz_evdev_mailbox *m, uint64_t time, const float value[2])
+{
+    uint32_t sequence = m->sequence;
+    xnz_atomic_store_u32(&m->sequence, sequence + 1);
+    xnz_atomic_fence(); // odd sequence visible before any of the data
+    m->time = time;
+    m->value[0] = value[0];
+    m->value[1] = value[1];
+    m->count++;
+    xnz_atomic_store_u32(&m->sequence, sequence + 2);
+}
+
+/*
+ * Reader side: copy the latest sample to out; returns 0 on success, -1 if
+ * nothing was published yet (or the writer kept it busy).
+ */
+static inline int xnz_evdev_latest(const xnz_evdev_mailbox *m, xnz_evdev_sample *out)
+{
+    for (int attempt = 0; attempt < 64; attempt++)
+    {
+        uint32_t before = xnz_atomic_load_u32(&m->sequence);
+        if (before & 1)
+        {
+            continue; // being written
+        }
+        out->count = m->count;
+        out->time = m->time;
+        out->value[0] = m->value[0];
+        out->value[1] = m->value[1];
+        xnz_atomic_fence();
+        if (xnz_atomic_load_u32(&m->sequence) == before)
+        {
+            return out->count ? 0 : -1;
+        }
+    }
+    return -1;
+}
+
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+
+typedef struct
+{
+    xnz_evdev_mailbox mailbox XNZ_CACHELINE_ALIGNED; // written by the reader thread only
+    uint32_t running XNZ_CACHELINE_ALIGNED;
+    uint32_t failed; // device gone or read error: no more samples
+    int fd;
+    int replay; // recording: events paced by their timestamps
+    xnz_evdev_header axes;
+    float value[2]; // reader thread: values as of the last event
+    uint64_t events; // reader thread
+    uint64_t resyncs; // SYN_DROPPED (kernel buffer overrun)
+    xnz_thread thread;
+    char path[256];
+}
+xnz_evdev;
+
+static inline int xnz_evdev_axis_info(xnz_evdev *e, int i)
+{
+    struct input_absinfo abs;
+    if (ioctl(e->fd, EVIOCGABS(e->axes.code[i]), &abs) || abs.maximum <= abs.minimum)
+    {
+        return -1;
+    }
+    e->axes.minimum[i] = abs.minimum;
+    e->axes.maximum[i] = abs.maximum;
+    e->value[i] = (float)(abs.value - abs.minimum) / (float)(abs.maximum - abs.minimum);
+    return 0;
+}
+
+/*
+ * Open a device node (the levers must be ABS_X and ABS_Y) or a recording;
+ * path NULL or "auto": find the quadrant. Returns 0 on success.
+ */
+static inline int xnz_evdev_open(xnz_evdev *e, const char *path)
+{
+    struct stat st; struct input_id id; char name[64] = ""; int clock = CLOCK_MONOTONIC;
+    memset(e, 0, sizeof(*e));
+    e->fd = -1;
+    e->axes.code[0] = ABS_X;
+    e->axes.code[1] = ABS_Y;
+    if (path == NULL || !strcmp(path, "auto"))
+    {
+        for (int i = 0; i < XNZ_EVDEV_NODES && e->fd < 0; i++)
+        {
+            snprintf(e->path, sizeof(e->path), "/dev/input/event%d", i);
+            if ((e->fd = open(e->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC)) < 0)
+            {
+                continue;
+            }
+            if (ioctl(e->fd, EVIOCGID, &id) || id.vendor != XNZ_EVDEV_VENDOR ||
+                ioctl(e->fd, EVIOCGNAME(sizeof(name) - 1), name) < 0 || strstr(name, "TCA") == NULL ||
+                xnz_evdev_axis_info(e, 0) || xnz_evdev_axis_info(e, 1))
+            {
+                close(e->fd); e->fd = -1;
+            }
+        }
+        if (e->fd < 0)
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        snprintf(e->path, sizeof(e->path), "%s", path);
+        if ((e->fd = open(e->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC)) < 0 || fstat(e->fd, &st))
+        {
+            goto fail;
+        }
+        if ((e->replay = S_ISREG(st.st_mode)))
+        {
+            if (read(e->fd, &e->axes, sizeof(e->axes)) != (ssize_t)sizeof(e->axes) ||
+                e->axes.magic != XNZ_EVDEV_MAGIC || e->axes.version != XNZ_EVDEV_VERSION ||
+                e->axes.maximum[0] <= e->axes.minimum[0] || e->axes.maximum[1] <= e->axes.minimum[1])
+            {
+                goto fail;
+            }
+            e->axes.name[sizeof(e->axes.name) - 1] = '\0';
+            return 0;
+        }
+        if (ioctl(e->fd, EVIOCGNAME(sizeof(name) - 1), name) < 0 ||
+            xnz_evdev_axis_info(e, 0) || xnz_evdev_axis_info(e, 1))
+        {
+            goto fail;
+        }
+    }
+    ioctl(e->fd, EVIOCSCLOCKID, &clock); // else CLOCK_REALTIME: ages are wrong, values are not
+    e->axes.magic = XNZ_EVDEV_MAGIC;
+    e->axes.version = XNZ_EVDEV_VERSION;
+    snprintf(e->axes.name, sizeof(e->axes.name), "%s", name);
+    return 0;
+
+fail:
+    if (e->fd >= 0)
+    {
+        close(e->fd);
+    }
+    e->fd = -1;
+    return -1;
+}
+
+/*
+ * Reader thread: one event at a time (normalized into value[]), publishing
+ * the pair on each SYN_REPORT.
+ */
+static inline void xnz_evdev_event_apply(xnz_evdev *e, const xnz_evdev_event *ev)
+{
+    e->events++;
+    if (ev->type == EV_ABS)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            if (ev->code == e->axes.code[i])
+            {
+                e->value[i] = (float)(ev->value - e->axes.minimum[i]) / (float)(e->axes.maximum[i] - e->axes.minimum[i]);
+            }
+        }
+        return;
+    }
+    if (ev->type == EV_SYN && ev->code == SYN_DROPPED && e->replay == 0)
+    {
+        e->resyncs++; // events lost: read the current state back, complete at the next SYN_REPORT
+        xnz_evdev_axis_info(e, 0);
+        xnz_evdev_axis_info(e, 1);
+        return;
+    }
+    if (ev->type == EV_SYN && ev->code == SYN_REPORT)
+    {
+        xnz_evdev_publish(&e->mailbox, ev->time, e->value);
+    }
+}
+
+static inline XNZ_THREAD_RETURN XNZ_THREAD_CALL xnz_evdev_reader(void *arg)
+{
+    xnz_evdev *e = arg; struct input_event in[64]; struct pollfd p = { e->fd, POLLIN, 0, };
+    xnz_evdev_event ev; uint64_t origin = 0, start = xnz_time_ns(); ssize_t n;
+    if (e->replay == 0)
+    {
+        float current[2] = { e->value[0], e->value[1], };
+        xnz_evdev_publish(&e->mailbox, xnz_time_ns(), current); // levers at rest send nothing
+    }
+    while (xnz_atomic_load_u32(&e->running))
+    {
+        if (e->replay)
+        {
+            if (read(e->fd, &ev, sizeof(ev)) != (ssize_t)sizeof(ev))
+            {
+                break; // end of recording
+            }
+            if (origin == 0)
+            {
+                origin = ev.time;
+            }
+            uint64_t due = start + (ev.time - origin), now;
+            while ((now = xnz_time_ns()) < due && xnz_atomic_load_u32(&e->running))
+            {
+                uint64_t ms = (due - now) / 1000000;
+                xnz_sleep_ms(ms > XNZ_EVDEV_POLL ? XNZ_EVDEV_POLL : ms ? (unsigned int)ms : 1);
+            }
+            ev.time = due; // this session's clock
+            xnz_evdev_event_apply(e, &ev);
+            continue;
+        }
+        if (poll(&p, 1, XNZ_EVDEV_POLL) < 0 && errno != EINTR)
+        {
+            break;
+        }
+        if (p.revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            break; // unplugged
+        }
+        if ((p.revents & POLLIN) == 0)
+        {
+            continue;
+        }
+        if ((n = read(e->fd, in, sizeof(in))) < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        for (ssize_t i = 0; i < n / (ssize_t)sizeof(in[0]); i++)
+        {
+            ev.time = (uint64_t)in[i].input_event_sec * 1000000000ull + (uint64_t)in[i].input_event_usec * 1000ull;
+            ev.type = in[i].type;
+            ev.code = in[i].code;
+            ev.value = in[i].value;
+            xnz_evdev_event_apply(e, &ev);
+        }
+    }
+    xnz_atomic_store_u32(&e->failed, xnz_atomic_load_u32(&e->running)); // stopped by itself
+    return 0;
+}
+
+static inline int xnz_evdev_start(xnz_evdev *e)
+{
+    xnz_atomic_store_u32(&e->running, 1);
+    if (xnz_thread_create(&e->thread, &xnz_evdev_reader, e))
+    {
+        xnz_atomic_store_u32(&e->running, 0);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Stop the thread (within XNZ_EVDEV_POLL) and close the device.
+ */
+static inline void xnz_evdev_stop(xnz_evdev *e)
+{
+    xnz_atomic_store_u32(&e->running, 0);
+    xnz_thread_join(e->thread);
+    close(e->fd);
+    e->fd = -1;
+}
+#endif /* __linux__ */
+
+#endif /* XNZ_EVDEV_H */
@@ -0,0 +1,157 @@
+/*
+ * XNZffrec.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_FFREC_H
+#define XNZ_FFREC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * FlightFactor A320 recorder: a set of values from the aircraft's shared
+ * value interface (sharedvalue.h), resolved to ids once when recording
+ * starts, is snapshot every frame from a DataAddUpdate callback into a ring
+ * of columnar blocks (one array per value); a writer thread appends each full
+ * block to <preferences>/x-nullzones.ffrec while recording, which the
+ * xnz/ffrec/toggle command starts and stops. tools/xnz_ffrec.c decodes it.
+ *
+ * Values: <preferences>/x-nullzones.ffrec.txt, one name per line, '#' starts
+ * a comment, "prefix*" for every value whose name starts with prefix (e.g.
+ * Aircraft.Cockpit.Pedestal.*); the engine levers if there is no such file.
+ * Numeric values only (strings and objects are skipped).
+ *
+ * File layout (host byte order):
+ *
+ *   xnz_ffrec_header
+ *   xnz_ffrec_column[column_count]
+ *   blocks, oldest first, until end of file:
+ *     xnz_ffrec_block
+ *     uint64_t time[frames] (monotonic clock, ns)
+ *     double step[frames] (DataAddUpdate's time step)
+ *     for each column: frames * column.size bytes
+ *
+ * Every block but the last has XNZ_FFREC_FRAMES frames; frames dropped while
+ * the ring was full show as gaps between a block's first frame and the end
+ * of the previous block.
+ */
+#define XNZ_FFREC_MAGIC    0x465A4E58u // "XNZF"
+#define XNZ_FFREC_VERSION  1
+#define XNZ_FFREC_FRAMES   256 // per block
+#define XNZ_FFREC_COLUMNS  256
+#define XNZ_FFREC_NAME_MAX 96
+
+enum // same values as Value_Type_* (sharedvalue.h)
+{
+    XNZ_FFREC_SINT8   = 2,
+    XNZ_FFREC_UINT8   = 3,
+    XNZ_FFREC_SINT16  = 4,
+    XNZ_FFREC_UINT16  = 5,
+    XNZ_FFREC_SINT32  = 6,
+    XNZ_FFREC_UINT32  = 7,
+    XNZ_FFREC_FLOAT32 = 8,
+    XNZ_FFREC_FLOAT64 = 9,
+    XNZ_FFREC_TIME    = 11,
+};
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t column_count;
+    uint32_t block_frames; // XNZ_FFREC_FRAMES
+    uint64_t started; // monotonic clock (ns) when recording started
+}
+xnz_ffrec_header;
+
+typedef struct
+{
+    int32_t id; // value id (this session only)
+    uint32_t type; // XNZ_FFREC_*
+    uint32_t size; // bytes per frame
+    uint32_t units; // Value_Unit_* flags
+    char name[XNZ_FFREC_NAME_MAX];
+}
+xnz_ffrec_column;
+
+typedef struct
+{
+    uint32_t first; // frame number (since recording started) of the first frame
+    uint32_t frames;
+}
+xnz_ffrec_block;
+
+/*
+ * Bytes per frame for a value type, or zero if the type isn't recorded.
+ */
+static inline uint32_t xnz_ffrec_type_size(uint32_t type)
+{
+    switch (type)
+    {
+        case XNZ_FFREC_SINT8:
+        case XNZ_FFREC_UINT8:
+            return 1;
+        case XNZ_FFREC_SINT16:
+        case XNZ_FFREC_UINT16:
+            return 2;
+        case XNZ_FFREC_SINT32:
+        case XNZ_FFREC_UINT32:
+        case XNZ_FFREC_FLOAT32:
+            return 4;
+        case XNZ_FFREC_FLOAT64:
+        case XNZ_FFREC_TIME:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Size of a block's arrays (without its xnz_ffrec_block), given the sum of
+ * the column sizes.
+ */
+static inline size_t xnz_ffrec_block_size(size_t row_size, uint32_t frames)
+{
+    return (size_t)frames * (sizeof(uint64_t) + sizeof(double) + row_size);
+}
+
+/*
+ * Value of a column as a double (0 for unknown types); data: one frame.
+ */
+static inline double xnz_ffrec_value(uint32_t type, const void *data)
+{
+    union { int8_t i8; uint8_t u8; int16_t i16; uint16_t u16; int32_t i32; uint32_t u32; float f32; double f64; int64_t i64; } v;
+    switch (type)
+    {
+        case XNZ_FFREC_SINT8:   memcpy(&v, data, 1); return v.i8;
+        case XNZ_FFREC_UINT8:   memcpy(&v, data, 1); return v.u8;
+        case XNZ_FFREC_SINT16:  memcpy(&v, data, 2); return v.i16;
+        case XNZ_FFREC_UINT16:  memcpy(&v, data, 2); return v.u16;
+        case XNZ_FFREC_SINT32:  memcpy(&v, data, 4); return v.i32;
+        case XNZ_FFREC_UINT32:  memcpy(&v, data, 4); return v.u32;
+        case XNZ_FFREC_FLOAT32: memcpy(&v, data, 4); return v.f32;
+        case XNZ_FFREC_FLOAT64: memcpy(&v, data, 8); return v.f64;
+        case XNZ_FFREC_TIME:    memcpy(&v, data, 8); return (double)v.i64;
+        default:
+            return 0.0;
+    }
+}
+
+#endif /* XNZ_FFREC_H */
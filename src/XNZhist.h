@@ -0,0 +1,143 @@
+/*
+ * XNZhist.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_HIST_H
+#define XNZ_HIST_H
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Latency histogram: fixed log-linear buckets over durations in nanoseconds,
+ * 8 buckets per power of two (relative error below 12.5%), from 0 to ~4.3 s
+ * (longer durations land in the last bucket). Recording is a few integer
+ * operations, no allocation, no floating point; quantiles are computed when
+ * read and reported as the upper bound of their bucket (capped by the max).
+ */
+#define XNZ_HIST_SUB_BITS 3
+#define XNZ_HIST_SUB      (1 << XNZ_HIST_SUB_BITS)
+#define XNZ_HIST_BUCKETS  ((32 - XNZ_HIST_SUB_BITS + 1) * XNZ_HIST_SUB) // 240
+
+typedef struct
+{
+    uint64_t count;
+    uint64_t sum; // nanoseconds
+    uint32_t max; // nanoseconds
+    uint32_t bucket[XNZ_HIST_BUCKETS];
+}
+xnz_hist;
+
+static inline int xnz_hist_log2(uint32_t value) // value > 0
+{
+#if defined(_MSC_VER)
+    unsigned long index; _BitScanReverse(&index, value); return (int)index;
+#else
+    return 31 - __builtin_clz(value);
+#endif
+}
+
+static inline int xnz_hist_index(uint32_t value)
+{
+    if (value < XNZ_HIST_SUB)
+    {
+        return (int)value;
+    }
+    int e = xnz_hist_log2(value);
+    return (e - XNZ_HIST_SUB_BITS + 1) * XNZ_HIST_SUB + (int)((value >> (e - XNZ_HIST_SUB_BITS)) & (XNZ_HIST_SUB - 1));
+}
+
+/*
+ * Smallest value recorded in bucket index (the largest is the next bucket's
+ * lower bound minus one, or UINT32_MAX for the last bucket).
+ */
+static inline uint32_t xnz_hist_lower(int index)
+{
+    if (index < XNZ_HIST_SUB)
+    {
+        return (uint32_t)index;
+    }
+    int e = index / XNZ_HIST_SUB + XNZ_HIST_SUB_BITS - 1;
+    return (uint32_t)(XNZ_HIST_SUB + index % XNZ_HIST_SUB) << (e - XNZ_HIST_SUB_BITS);
+}
+
+static inline uint32_t xnz_hist_upper(int index)
+{
+    return index + 1 < XNZ_HIST_BUCKETS ? xnz_hist_lower(index + 1) - 1 : UINT32_MAX;
+}
+
+static inline void xnz_hist_record(xnz_hist *h, uint64_t ns)
+{
+    uint32_t value = ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+    h->bucket[xnz_hist_index(value)]++;
+    h->sum += value;
+    h->count++;
+    if (h->max < value)
+    {
+        h->max = value;
+    }
+}
+
+/*
+ * Value (nanoseconds) at or below which a fraction q (0..1) of the recorded
+ * durations lie; zero if nothing was recorded.
+ */
+static inline uint32_t xnz_hist_quantile(const xnz_hist *h, double q)
+{
+    if (h->count == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(q * (double)h->count + 0.5), seen = 0;
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    for (int i = 0; i < XNZ_HIST_BUCKETS; i++)
+    {
+        if ((seen += h->bucket[i]) >= rank)
+        {
+            uint32_t upper = xnz_hist_upper(i);
+            return upper < h->max ? upper : h->max;
+        }
+    }
+    return h->max;
+}
+
+/*
+ * Add the durations recorded in src to dst (e.g. per-thread histograms).
+ */
+static inline void xnz_hist_merge(xnz_hist *dst, const xnz_hist *src)
+{
+    for (int i = 0; i < XNZ_HIST_BUCKETS; i++)
+    {
+        dst->bucket[i] += src->bucket[i];
+    }
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (dst->max < src->max)
+    {
+        dst->max = src->max;
+    }
+}
+
+#endif /* XNZ_HIST_H */
@@ -0,0 +1,170 @@
+/*
+ * XNZingress.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_INGRESS_H
+#define XNZ_INGRESS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "XNZplatform.h"
+
+/*
+ * Command ingress: local processes (panels, automation, test harnesses) push
+ * {command, phase, argument} requests into a bounded multi-producer ring in
+ * named shared memory (see xnz_shm); a flight loop callback pops a few per
+ * frame and runs the corresponding xnz/ commands (begin, end or once).
+ *
+ * Commands are identified by their index in the names table, which the
+ * plugin fills in before publishing the magic number (xnz_ingress_find).
+ * A begin without a matching end is ended by the plugin when it stops.
+ *
+ * Each slot carries a sequence number (bounded MPMC queue, after D. Vyukov):
+ * producers claim a position with a compare-and-swap, then publish the slot;
+ * the consumer frees it for the producer one lap later. Neither side ever
+ * blocks; a producer finding the ring full gets an error. A producer that
+ * dies between claiming and publishing its slot stalls the queue until the
+ * segment is re-created (the plugin is re-enabled).
+ *
+ * Segment names: x-nullzones.ingress (Quadrant314.ingress in public builds).
+ */
+#define XNZ_INGRESS_NAME        "x-nullzones.ingress"
+#define XNZ_INGRESS_NAME_PUBLIC "Quadrant314.ingress"
+#define XNZ_INGRESS_MAGIC    0x495A4E58u // "XNZI"
+#define XNZ_INGRESS_VERSION  1
+#define XNZ_INGRESS_SLOTS    256 // power of two
+#define XNZ_INGRESS_COMMANDS 128
+#define XNZ_INGRESS_NAME_MAX 48
+
+enum
+{
+    XNZ_INGRESS_BEGIN = 0, // same values as XPLMCommandPhase
+    XNZ_INGRESS_END   = 2,
+    XNZ_INGRESS_ONCE  = 3,
+};
+
+typedef struct
+{
+    uint32_t sequence; // slot state (see above)
+    uint16_t command; // index in names
+    uint8_t phase; // XNZ_INGRESS_*
+    uint8_t reserved;
+    float argument; // reserved for commands with a parameter (none yet)
+    uint32_t client; // chosen by the producer (e.g. its process id), for the log
+}
+xnz_ingress_slot;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count; // XNZ_INGRESS_SLOTS
+    uint32_t command_count; // entries in names
+    uint32_t live; // zero once the consumer has stopped
+    uint32_t reserved[3];
+    char names[XNZ_INGRESS_COMMANDS][XNZ_INGRESS_NAME_MAX];
+    uint8_t padding[32];
+    uint32_t enqueue; // producers; own cache line
+    uint8_t padding_enqueue[60];
+    uint32_t dequeue; // consumer; own cache line
+    uint8_t padding_dequeue[60];
+    xnz_ingress_slot slot[XNZ_INGRESS_SLOTS];
+}
+xnz_ingress;
+
+/*
+ * Consumer side: make every slot free for the first lap.
+ */
+static inline void xnz_ingress_init(xnz_ingress *q)
+{
+    for (uint32_t i = 0; i < XNZ_INGRESS_SLOTS; i++)
+    {
+        xnz_atomic_store_u32(&q->slot[i].sequence, i);
+    }
+    xnz_atomic_store_u32(&q->enqueue, 0);
+    xnz_atomic_store_u32(&q->dequeue, 0);
+}
+
+/*
+ * Index of the named command, or -1 if there is no such command.
+ */
+static inline int xnz_ingress_find(const xnz_ingress *q, const char *name)
+{
+    for (uint32_t i = 0; i < q->command_count && i < XNZ_INGRESS_COMMANDS; i++)
+    {
+        if (!strncmp(q->names[i], name, XNZ_INGRESS_NAME_MAX))
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Producer side (any number of threads or processes): returns 0 on success,
+ * -1 if the ring is full.
+ */
+static inline int xnz_ingress_push(xnz_ingress *q, uint16_t command, uint8_t phase, float argument, uint32_t client)
+{
+    uint32_t position = xnz_atomic_load_u32(&q->enqueue);
+    while (1)
+    {
+        xnz_ingress_slot *s = &q->slot[position & (XNZ_INGRESS_SLOTS - 1)];
+        int32_t difference = (int32_t)(xnz_atomic_load_u32(&s->sequence) - position);
+        if (difference == 0)
+        {
+            if (xnz_atomic_cas_u32(&q->enqueue, &position, position + 1))
+            {
+                s->command = command;
+                s->phase = phase;
+                s->argument = argument;
+                s->client = client;
+                xnz_atomic_store_u32(&s->sequence, position + 1); // publish
+                return 0;
+            }
+            continue; // another producer got it: position was updated
+        }
+        if (difference < 0)
+        {
+            return -1; // slot not consumed yet: full
+        }
+        position = xnz_atomic_load_u32(&q->enqueue); // we're behind
+    }
+}
+
+/*
+ * Consumer side (one thread): returns 1 and copies the oldest request to out,
+ * or returns 0 if there is none (or the oldest isn't published yet).
+ */
+static inline int xnz_ingress_pop(xnz_ingress *q, xnz_ingress_slot *out)
+{
+    uint32_t position = q->dequeue;
+    xnz_ingress_slot *s = &q->slot[position & (XNZ_INGRESS_SLOTS - 1)];
+    if (xnz_atomic_load_u32(&s->sequence) != position + 1)
+    {
+        return 0;
+    }
+    memcpy(out, s, sizeof(*out));
+    xnz_atomic_store_u32(&s->sequence, position + XNZ_INGRESS_SLOTS); // free for the next lap
+    xnz_atomic_store_u32(&q->dequeue, position + 1);
+    return 1;
+}
+
+#endif /* XNZ_INGRESS_H */
@@ -0,0 +1,98 @@
+/*
+ * XNZjournal.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_JOURNAL_H
+#define XNZ_JOURNAL_H
+
+#include <stdint.h>
+
+/*
+ * Command journal: one fixed-size record per xnz command handler begin and
+ * end phase, kept in a ring in memory (no allocation, no I/O) and dumped on
+ * demand, by the xnz/debug/journal/dump command, to
+ * <preferences>/x-nullzones.journal. Continue phases (every frame while a
+ * command is held) aren't journaled, only counted in the end record.
+ * tools/xnz_journal.c decodes a dump into a timeline.
+ *
+ * File layout (host byte order):
+ *
+ *   xnz_journal_header
+ *   xnz_journal_record[record_count]  oldest first
+ *   command names[command_count]      uint32_t length + bytes, indexed by record.command
+ *   symbols[symbol_count]             uint64_t target + uint32_t length + bytes
+ *
+ * Symbols name the downstream commands and datarefs the plugin knows by name;
+ * targets without a symbol are printed as opaque handles.
+ */
+#define XNZ_JOURNAL_MAGIC   0x4A5A4E58u // "XNZJ"
+#define XNZ_JOURNAL_VERSION 2
+#define XNZ_JOURNAL_RECORDS 1024 // power of two
+
+enum
+{
+    XNZ_JOURNAL_FAMILY_NONE = 0,
+    XNZ_JOURNAL_FAMILY_AP   = 1,
+    XNZ_JOURNAL_FAMILY_AT   = 2,
+    XNZ_JOURNAL_FAMILY_BT   = 3,
+    XNZ_JOURNAL_FAMILY_ET   = 4,
+    XNZ_JOURNAL_FAMILY_PB   = 5,
+};
+
+enum
+{
+    XNZ_JOURNAL_CALL_NONE   = 0,
+    XNZ_JOURNAL_CALL_ONCE   = 1, // XPLMCommandOnce
+    XNZ_JOURNAL_CALL_BEGIN  = 2, // XPLMCommandBegin
+    XNZ_JOURNAL_CALL_END    = 3, // XPLMCommandEnd
+    XNZ_JOURNAL_CALL_SETI   = 4, // XPLMSetDatai
+    XNZ_JOURNAL_CALL_SETF   = 5, // XPLMSetDataf
+    XNZ_JOURNAL_CALL_SETVI  = 6, // XPLMSetDatavi
+    XNZ_JOURNAL_CALL_SETVF  = 7, // XPLMSetDatavf
+};
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size; // sizeof(xnz_journal_record)
+    uint32_t record_count;
+    uint32_t command_count;
+    uint32_t symbol_count;
+    uint64_t dumped; // monotonic clock (ns) at dump time, same origin as record.time
+}
+xnz_journal_header;
+
+typedef struct
+{
+    uint64_t time; // monotonic clock (ns) at handler entry
+    uint64_t target; // first downstream command or dataref (opaque handle, 0: none)
+    uint32_t sequence;
+    uint32_t duration; // handler duration (ns, saturated)
+    uint32_t holds; // end phase: continue phases since the begin phase (saturated)
+    uint16_t command; // index into the command names
+    int16_t  backend; // value of the family's backend selector (xnz_ap, xnz_at...)
+    uint8_t  phase; // XPLMCommandPhase
+    uint8_t  family; // XNZ_JOURNAL_FAMILY_*
+    uint8_t  call; // XNZ_JOURNAL_CALL_*: first downstream call
+    uint8_t  calls; // downstream calls (saturated)
+}
+xnz_journal_record;
+
+#endif /* XNZ_JOURNAL_H */
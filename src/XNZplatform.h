@@ -0,0 +1,411 @@
+/*
+ * XNZplatform.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_PLATFORM_H
+#define XNZ_PLATFORM_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if IBM
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#if APL
+#include <mach/mach_time.h>
+#endif
+
+/*
+ * Cache line size assumed for the layout of per-frame data (x86_64, arm64).
+ */
+#define XNZ_CACHELINE_SIZE 64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define XNZ_CACHELINE_ALIGNED __attribute__((aligned(XNZ_CACHELINE_SIZE)))
+#else
+#define XNZ_CACHELINE_ALIGNED
+#endif
+
+/*
+ * Zero-initialized, cache line-aligned allocation; free with xnz_aligned_free.
+ */
+static inline void* xnz_aligned_calloc(size_t size)
+{
+    void *ptr = NULL;
+    size = (size + XNZ_CACHELINE_SIZE - 1) & ~((size_t)XNZ_CACHELINE_SIZE - 1);
+#if IBM
+    if (NULL == (ptr = _aligned_malloc(size, XNZ_CACHELINE_SIZE)))
+    {
+        return NULL;
+    }
+#else
+    if (posix_memalign(&ptr, XNZ_CACHELINE_SIZE, size))
+    {
+        return NULL;
+    }
+#endif
+    return memset(ptr, 0, size);
+}
+
+static inline void xnz_aligned_free(void *ptr)
+{
+#if IBM
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/*
+ * Monotonic clock, in nanoseconds (arbitrary origin).
+ */
+static inline uint64_t xnz_time_ns(void)
+{
+#if APL
+    static mach_timebase_info_data_t tb;
+    if (tb.denom == 0)
+    {
+        mach_timebase_info(&tb);
+    }
+    return mach_absolute_time() * tb.numer / tb.denom;
+#elif IBM
+    static LARGE_INTEGER freq; LARGE_INTEGER now;
+    if (freq.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000000ull + (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000000ull / freq.QuadPart;
+#else
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+/*
+ * Atomics (used to hand data between the flight loop and worker threads).
+ * xnz_atomic_cas_u32: if *p == *e, set *p = v and return non-zero; else
+ * copy *p to *e and return zero.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define xnz_atomic_load_ptr(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define xnz_atomic_store_ptr(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define xnz_atomic_xchg_ptr(p, v)     __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#define xnz_atomic_load_u32(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define xnz_atomic_store_u32(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define xnz_atomic_add_u32(p, v)      __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+#define xnz_atomic_fence()            __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define xnz_atomic_cas_u32(p, e, v)   __atomic_compare_exchange_n((p), (e), (v), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+/*
+ * Loads must not be interlocked (a locked write): readers of shared memory
+ * may only have a read-only view. A plain volatile read is followed by a
+ * compiler barrier (x86 and x64 don't reorder loads with later accesses),
+ * or by a hardware barrier elsewhere.
+ */
+#if defined(_M_IX86) || defined(_M_X64)
+#define xnz_atomic_acquire_msc()      _ReadWriteBarrier()
+#else
+#define xnz_atomic_acquire_msc()      MemoryBarrier()
+#endif
+static __forceinline void* xnz_atomic_load_ptr_msc(void *const volatile *p)
+{
+    void *v = *p; xnz_atomic_acquire_msc(); return v;
+}
+static __forceinline uint32_t xnz_atomic_load_u32_msc(const volatile uint32_t *p)
+{
+    uint32_t v = *p; xnz_atomic_acquire_msc(); return v;
+}
+#define xnz_atomic_load_ptr(p)        xnz_atomic_load_ptr_msc((void *const volatile*)(p))
+#define xnz_atomic_store_ptr(p, v)    ((void)InterlockedExchangePointer((PVOID volatile*)(p), (v)))
+#define xnz_atomic_xchg_ptr(p, v)     InterlockedExchangePointer((PVOID volatile*)(p), (v))
+#define xnz_atomic_load_u32(p)        xnz_atomic_load_u32_msc((const volatile uint32_t*)(p))
+#define xnz_atomic_store_u32(p, v)    ((void)InterlockedExchange((LONG volatile*)(p), (LONG)(v)))
+#define xnz_atomic_add_u32(p, v)      ((uint32_t)InterlockedAdd((LONG volatile*)(p), (LONG)(v)))
+#define xnz_atomic_fence()            MemoryBarrier()
+#define xnz_atomic_cas_u32(p, e, v)   xnz_atomic_cas_u32_msc((LONG volatile*)(p), (uint32_t*)(e), (v))
+static inline int xnz_atomic_cas_u32_msc(LONG volatile *p, uint32_t *expected, uint32_t desired)
+{
+    uint32_t previous = (uint32_t)InterlockedCompareExchange(p, (LONG)desired, (LONG)*expected);
+    if (previous == *expected)
+    {
+        return 1;
+    }
+    *expected = previous;
+    return 0;
+}
+#else
+#error "unsupported compiler (atomics)"
+#endif
+
+/*
+ * Threads and mutexes; thread functions are declared as:
+ * static XNZ_THREAD_RETURN XNZ_THREAD_CALL fn(void *arg);
+ */
+#if IBM
+typedef HANDLE xnz_thread;
+typedef CRITICAL_SECTION xnz_mutex;
+#define XNZ_THREAD_RETURN DWORD
+#define XNZ_THREAD_CALL   WINAPI
+
+static inline int xnz_thread_create(xnz_thread *t, XNZ_THREAD_RETURN (XNZ_THREAD_CALL *fn)(void*), void *arg)
+{
+    return NULL == (*t = CreateThread(NULL, 0, fn, arg, 0, NULL));
+}
+
+static inline void xnz_thread_join(xnz_thread t)
+{
+    WaitForSingleObject(t, INFINITE); CloseHandle(t);
+}
+
+static inline void xnz_mutex_init   (xnz_mutex *m) { InitializeCriticalSection(m); }
+static inline void xnz_mutex_lock   (xnz_mutex *m) { EnterCriticalSection     (m); }
+static inline void xnz_mutex_unlock (xnz_mutex *m) { LeaveCriticalSection     (m); }
+static inline void xnz_mutex_destroy(xnz_mutex *m) { DeleteCriticalSection    (m); }
+
+static inline void xnz_sleep_ms(unsigned int ms)
+{
+    Sleep(ms);
+}
+#else
+typedef pthread_t xnz_thread;
+typedef pthread_mutex_t xnz_mutex;
+#define XNZ_THREAD_RETURN void*
+#define XNZ_THREAD_CALL
+
+static inline int xnz_thread_create(xnz_thread *t, XNZ_THREAD_RETURN (XNZ_THREAD_CALL *fn)(void*), void *arg)
+{
+    return pthread_create(t, NULL, fn, arg);
+}
+
+static inline void xnz_thread_join(xnz_thread t)
+{
+    pthread_join(t, NULL);
+}
+
+static inline void xnz_mutex_init   (xnz_mutex *m) { pthread_mutex_init   (m, NULL); }
+static inline void xnz_mutex_lock   (xnz_mutex *m) { pthread_mutex_lock   (m);       }
+static inline void xnz_mutex_unlock (xnz_mutex *m) { pthread_mutex_unlock (m);       }
+static inline void xnz_mutex_destroy(xnz_mutex *m) { pthread_mutex_destroy(m);       }
+
+static inline void xnz_sleep_ms(unsigned int ms)
+{
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L, };
+    while (nanosleep(&ts, &ts) != 0);
+}
+#endif
+
+/*
+ * Named shared memory (POSIX shm_open, or a Windows file mapping), for data
+ * exchanged with other local processes of the same user. The creator zeroes
+ * the segment and removes the name on destroy; mappings remain valid in the
+ * processes that still have them.
+ */
+typedef struct
+{
+    void *base;
+    size_t size;
+    char name[64];
+#if IBM
+    HANDLE mapping;
+#endif
+}
+xnz_shm;
+
+static inline int xnz_shm_create(xnz_shm *m, const char *name, size_t size)
+{
+    memset(m, 0, sizeof(*m));
+#if IBM
+    snprintf(m->name, sizeof(m->name), "Local\\%.*s", (int)sizeof(m->name) - 7, name);
+    if (NULL == (m->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, m->name)))
+    {
+        return -1;
+    }
+    if (NULL == (m->base = MapViewOfFile(m->mapping, FILE_MAP_ALL_ACCESS, 0, 0, size)))
+    {
+        CloseHandle(m->mapping); m->mapping = NULL; return -1;
+    }
+#else
+    int fd; void *base;
+    snprintf(m->name, sizeof(m->name), "/%.*s", (int)sizeof(m->name) - 2, name);
+    if ((fd = shm_open(m->name, O_CREAT | O_RDWR, 0600)) < 0)
+    {
+        return -1;
+    }
+    if (ftruncate(fd, size))
+    {
+        close(fd); shm_unlink(m->name); return -1;
+    }
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // the mapping outlives the descriptor
+    if (MAP_FAILED == base)
+    {
+        shm_unlink(m->name); return -1;
+    }
+    m->base = base;
+#endif
+    m->size = size;
+    memset(m->base, 0, size); // stale contents from a previous session
+    return 0;
+}
+
+/*
+ * Map an existing segment (of exactly size bytes, on POSIX systems).
+ */
+static inline int xnz_shm_open(xnz_shm *m, const char *name, size_t size, int writable)
+{
+    memset(m, 0, sizeof(*m));
+#if IBM
+    snprintf(m->name, sizeof(m->name), "Local\\%.*s", (int)sizeof(m->name) - 7, name);
+    if (NULL == (m->mapping = OpenFileMappingA(writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, FALSE, m->name)))
+    {
+        return -1;
+    }
+    if (NULL == (m->base = MapViewOfFile(m->mapping, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size)))
+    {
+        CloseHandle(m->mapping); m->mapping = NULL; return -1;
+    }
+#else
+    int fd; void *base; struct stat st;
+    snprintf(m->name, sizeof(m->name), "/%.*s", (int)sizeof(m->name) - 2, name);
+    if ((fd = shm_open(m->name, writable ? O_RDWR : O_RDONLY, 0)) < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) || (size_t)st.st_size != size)
+    {
+        close(fd); return -1;
+    }
+    base = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base)
+    {
+        return -1;
+    }
+    m->base = base;
+#endif
+    m->size = size;
+    return 0;
+}
+
+static inline void xnz_shm_close(xnz_shm *m)
+{
+    if (m->base)
+    {
+#if IBM
+        UnmapViewOfFile(m->base); CloseHandle(m->mapping);
+#else
+        munmap(m->base, m->size);
+#endif
+    }
+    memset(m, 0, sizeof(*m));
+}
+
+static inline void xnz_shm_destroy(xnz_shm *m)
+{
+    if (m->base)
+    {
+#if !IBM
+        shm_unlink(m->name); // Windows: gone with the last handle
+#endif
+    }
+    xnz_shm_close(m);
+}
+
+/*
+ * Read-only mapping of a whole file (offline tools); empty files can't be
+ * mapped and fail like missing ones.
+ */
+typedef struct
+{
+    const void *base;
+    size_t size;
+#if IBM
+    HANDLE file;
+    HANDLE mapping;
+#endif
+}
+xnz_file_map;
+
+static inline int xnz_file_map_open(xnz_file_map *m, const char *path)
+{
+    memset(m, 0, sizeof(*m));
+#if IBM
+    LARGE_INTEGER size;
+    if (INVALID_HANDLE_VALUE == (m->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL)))
+    {
+        return -1;
+    }
+    if (!GetFileSizeEx(m->file, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > SIZE_MAX ||
+        NULL == (m->mapping = CreateFileMappingA(m->file, NULL, PAGE_READONLY, 0, 0, NULL)))
+    {
+        CloseHandle(m->file); m->file = NULL; return -1;
+    }
+    if (NULL == (m->base = MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0)))
+    {
+        CloseHandle(m->mapping); CloseHandle(m->file); m->mapping = m->file = NULL; return -1;
+    }
+    m->size = (size_t)size.QuadPart;
+#else
+    int fd; void *base; struct stat st;
+    if ((fd = open(path, O_RDONLY)) < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) || st.st_size <= 0)
+    {
+        close(fd); return -1;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base)
+    {
+        return -1;
+    }
+    m->base = base;
+    m->size = (size_t)st.st_size;
+#endif
+    return 0;
+}
+
+static inline void xnz_file_map_close(xnz_file_map *m)
+{
+    if (m->base)
+    {
+#if IBM
+        UnmapViewOfFile(m->base); CloseHandle(m->mapping); CloseHandle(m->file);
+#else
+        munmap((void*)m->base, m->size);
+#endif
+    }
+    memset(m, 0, sizeof(*m));
+}
+
+#endif /* XNZ_PLATFORM_H */
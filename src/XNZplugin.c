@@ -18,15 +18,35 @@
  *     Timothy D. Walker
  */
 
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <ctype.h>
 #include <math.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+#include "XNZevdev.h"
+#include "XNZffrec.h"
+#include "XNZhist.h"
+#include "XNZingress.h"
+#include "XNZjournal.h"
+#include "XNZplatform.h"
+#include "XNZprofile.h"
+#include "XNZstutter.h"
+#include "XNZtelemetry.h"
+#include "XNZtrace.h"
 
-#include "Widgets/XPStandardWidgets.h"
-#include "Widgets/XPWidgets.h"
 #include "XPLM/XPLMDataAccess.h"
+#include "XPLM/XPLMDisplay.h"
+#include "XPLM/XPLMGraphics.h"
 #include "XPLM/XPLMMenus.h"
 #include "XPLM/XPLMPlanes.h"
 #include "XPLM/XPLMPlugin.h"
@@ -36,6 +56,8 @@
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wignored-attributes"
+#elif !defined(_WIN32) && !defined(__stdcall)
+#define __stdcall // GCC only knows it on 32-bit Windows
 #endif
 #include <stdbool.h>
 #include "sharedvalue.h"
@@ -43,6 +65,201 @@
 #pragma clang diagnostic pop
 #endif
 
+#ifdef XNZ_XPLM_CALLSTATS
+/*
+ * Instrumentation build (-DXNZ_XPLM_CALLSTATS, make callstats): every call
+ * to the XPLM dataref and command APIs below goes through a wrapper counting
+ * calls and elapsed time (inclusive: a command's time includes its handlers)
+ * by source line and by frame; see xnz_calls_dump() for the summary table.
+ */
+#define XNZ_CALLS_LINES 16384 // call sites by line (later lines share the last)
+#define XNZ_CALLS_TOP   40 // rows in the summary table
+
+enum
+{
+    XNZ_CALLS_FIND_DREF,
+    XNZ_CALLS_FIND_CMND,
+    XNZ_CALLS_GETI,
+    XNZ_CALLS_GETF,
+    XNZ_CALLS_GETVI,
+    XNZ_CALLS_GETVF,
+    XNZ_CALLS_GETB,
+    XNZ_CALLS_SETI,
+    XNZ_CALLS_SETF,
+    XNZ_CALLS_SETVI,
+    XNZ_CALLS_SETVF,
+    XNZ_CALLS_ONCE,
+    XNZ_CALLS_BEGIN,
+    XNZ_CALLS_END,
+    XNZ_CALLS_COUNT,
+};
+
+typedef struct
+{
+    uint64_t ns;
+    uint32_t calls;
+    uint32_t frames; // frames with at least one call
+    uint32_t frame_calls; // calls in frame number frame
+    uint32_t frame_max; // most calls in a single frame
+    uint32_t frame;
+    uint32_t function; // XNZ_CALLS_*
+}
+xnz_calls_site;
+
+typedef struct
+{
+    xnz_calls_site site[XNZ_CALLS_LINES];
+    uint64_t ns;
+    uint64_t calls;
+    uint64_t frame_ns; // all sites, current frame
+    uint64_t frame_ns_max;
+    uint32_t frame_calls;
+    uint32_t frame_calls_max;
+    uint32_t frame; // frames seen by calls_hdlr_fnc
+    XPLMFlightLoop_f f_l_cs;
+}
+xnz_calls;
+
+static xnz_calls xnz_calls_state;
+
+static void xnz_calls_record(int line, int function, uint64_t start)
+{
+    xnz_calls *c = &xnz_calls_state; uint64_t ns = xnz_time_ns() - start;
+    xnz_calls_site *s = &c->site[line < XNZ_CALLS_LINES ? line : XNZ_CALLS_LINES - 1];
+    if (s->calls == 0 || s->frame != c->frame)
+    {
+        s->function = function;
+        s->frame_calls = 0;
+        s->frame = c->frame;
+        s->frames++;
+    }
+    if (s->frame_max < ++s->frame_calls)
+    {
+        s->frame_max = s->frame_calls;
+    }
+    s->calls++;
+    s->ns += ns;
+    c->calls++;
+    c->ns += ns;
+    c->frame_calls++;
+    c->frame_ns += ns;
+}
+
+/*
+ * The wrappers call the XPLM through parenthesized names, which the macros
+ * defined after them (function-like) leave alone.
+ */
+static XPLMDataRef xnz_calls_XPLMFindDataRef(int line, const char *inDataRefName)
+{
+    uint64_t t = xnz_time_ns(); XPLMDataRef ret = (XPLMFindDataRef)(inDataRefName);
+    xnz_calls_record(line, XNZ_CALLS_FIND_DREF, t); return ret;
+}
+
+static XPLMCommandRef xnz_calls_XPLMFindCommand(int line, const char *inName)
+{
+    uint64_t t = xnz_time_ns(); XPLMCommandRef ret = (XPLMFindCommand)(inName);
+    xnz_calls_record(line, XNZ_CALLS_FIND_CMND, t); return ret;
+}
+
+static int xnz_calls_XPLMGetDatai(int line, XPLMDataRef inDataRef)
+{
+    uint64_t t = xnz_time_ns(); int ret = (XPLMGetDatai)(inDataRef);
+    xnz_calls_record(line, XNZ_CALLS_GETI, t); return ret;
+}
+
+static float xnz_calls_XPLMGetDataf(int line, XPLMDataRef inDataRef)
+{
+    uint64_t t = xnz_time_ns(); float ret = (XPLMGetDataf)(inDataRef);
+    xnz_calls_record(line, XNZ_CALLS_GETF, t); return ret;
+}
+
+static int xnz_calls_XPLMGetDatavi(int line, XPLMDataRef inDataRef, int *outValues, int inOffset, int inMax)
+{
+    uint64_t t = xnz_time_ns(); int ret = (XPLMGetDatavi)(inDataRef, outValues, inOffset, inMax);
+    xnz_calls_record(line, XNZ_CALLS_GETVI, t); return ret;
+}
+
+static int xnz_calls_XPLMGetDatavf(int line, XPLMDataRef inDataRef, float *outValues, int inOffset, int inMax)
+{
+    uint64_t t = xnz_time_ns(); int ret = (XPLMGetDatavf)(inDataRef, outValues, inOffset, inMax);
+    xnz_calls_record(line, XNZ_CALLS_GETVF, t); return ret;
+}
+
+static int xnz_calls_XPLMGetDatab(int line, XPLMDataRef inDataRef, void *outValue, int inOffset, int inMaxBytes)
+{
+    uint64_t t = xnz_time_ns(); int ret = (XPLMGetDatab)(inDataRef, outValue, inOffset, inMaxBytes);
+    xnz_calls_record(line, XNZ_CALLS_GETB, t); return ret;
+}
+
+static void xnz_calls_XPLMSetDatai(int line, XPLMDataRef inDataRef, int inValue)
+{
+    uint64_t t = xnz_time_ns(); (XPLMSetDatai)(inDataRef, inValue);
+    xnz_calls_record(line, XNZ_CALLS_SETI, t);
+}
+
+static void xnz_calls_XPLMSetDataf(int line, XPLMDataRef inDataRef, float inValue)
+{
+    uint64_t t = xnz_time_ns(); (XPLMSetDataf)(inDataRef, inValue);
+    xnz_calls_record(line, XNZ_CALLS_SETF, t);
+}
+
+static void xnz_calls_XPLMSetDatavi(int line, XPLMDataRef inDataRef, int *inValues, int inOffset, int inCount)
+{
+    uint64_t t = xnz_time_ns(); (XPLMSetDatavi)(inDataRef, inValues, inOffset, inCount);
+    xnz_calls_record(line, XNZ_CALLS_SETVI, t);
+}
+
+static void xnz_calls_XPLMSetDatavf(int line, XPLMDataRef inDataRef, float *inValues, int inOffset, int inCount)
+{
+    uint64_t t = xnz_time_ns(); (XPLMSetDatavf)(inDataRef, inValues, inOffset, inCount);
+    xnz_calls_record(line, XNZ_CALLS_SETVF, t);
+}
+
+static void xnz_calls_XPLMCommandOnce(int line, XPLMCommandRef inCommand)
+{
+    uint64_t t = xnz_time_ns(); (XPLMCommandOnce)(inCommand);
+    xnz_calls_record(line, XNZ_CALLS_ONCE, t);
+}
+
+static void xnz_calls_XPLMCommandBegin(int line, XPLMCommandRef inCommand)
+{
+    uint64_t t = xnz_time_ns(); (XPLMCommandBegin)(inCommand);
+    xnz_calls_record(line, XNZ_CALLS_BEGIN, t);
+}
+
+static void xnz_calls_XPLMCommandEnd(int line, XPLMCommandRef inCommand)
+{
+    uint64_t t = xnz_time_ns(); (XPLMCommandEnd)(inCommand);
+    xnz_calls_record(line, XNZ_CALLS_END, t);
+}
+
+#define XPLMFindDataRef(...)  xnz_calls_XPLMFindDataRef(__LINE__, __VA_ARGS__)
+#define XPLMFindCommand(...)  xnz_calls_XPLMFindCommand(__LINE__, __VA_ARGS__)
+#define XPLMGetDatai(...)     xnz_calls_XPLMGetDatai(__LINE__, __VA_ARGS__)
+#define XPLMGetDataf(...)     xnz_calls_XPLMGetDataf(__LINE__, __VA_ARGS__)
+#define XPLMGetDatavi(...)    xnz_calls_XPLMGetDatavi(__LINE__, __VA_ARGS__)
+#define XPLMGetDatavf(...)    xnz_calls_XPLMGetDatavf(__LINE__, __VA_ARGS__)
+#define XPLMGetDatab(...)     xnz_calls_XPLMGetDatab(__LINE__, __VA_ARGS__)
+#define XPLMSetDatai(...)     xnz_calls_XPLMSetDatai(__LINE__, __VA_ARGS__)
+#define XPLMSetDataf(...)     xnz_calls_XPLMSetDataf(__LINE__, __VA_ARGS__)
+#define XPLMSetDatavi(...)    xnz_calls_XPLMSetDatavi(__LINE__, __VA_ARGS__)
+#define XPLMSetDatavf(...)    xnz_calls_XPLMSetDatavf(__LINE__, __VA_ARGS__)
+#define XPLMCommandOnce(...)  xnz_calls_XPLMCommandOnce(__LINE__, __VA_ARGS__)
+#define XPLMCommandBegin(...) xnz_calls_XPLMCommandBegin(__LINE__, __VA_ARGS__)
+#define XPLMCommandEnd(...)   xnz_calls_XPLMCommandEnd(__LINE__, __VA_ARGS__)
+
+/* wrappers of the above (e.g. xnz_journal_*) forward their caller's line */
+#define XNZ_CALLS_SITE       __LINE__,
+#define XNZ_CALLS_SITE_PARAM int inLine,
+#define XNZ_CALLS_SITE_ARG   inLine,
+#define XNZ_CALLS_XPLM(f)    xnz_calls_##f
+#else
+#define XNZ_CALLS_SITE
+#define XNZ_CALLS_SITE_PARAM
+#define XNZ_CALLS_SITE_ARG
+#define XNZ_CALLS_XPLM(f)    f
+#endif
+
 #define T_ZERO                  (.000001f)
 #define T_SMALL                 (00.0025f)
 #define AIRSPEED_MIN_KTS        (50.0000f)
@@ -52,20 +269,13 @@
 #define GROUNDSP_KTS_MIN        (02.5000f)
 #define GROUNDSP_KTS_MID        (26.2500f)
 #define GROUNDSP_KTS_MAX        (50.0000f)
+#define BRAKE_DECEL_TAU         (0.2000f) // deceleration filter time constant (s)
+#define BRAKE_DECEL_GAIN        (0.4000f) // output change rate (1/s) per m/s² of deceleration error
+#define BRAKE_RAMP_UP           (0.8000f) // maximum output increase rate (1/s)
+#define BRAKE_RAMP_DN           (1.6000f) // maximum output decrease rate (1/s)
 #define MPS2KPH(MPS) (MPS * 3.6f / 1.000f)
 #define MPS2KTS(MPS) (MPS * 3.6f / 1.852f)
-#define ACF_ROLL_SET(_var, _gs, _base)                         \
-{                                                              \
-    if (_gs > GROUNDSP_KTS_MID)                                \
-    {                                                          \
-        _var  = ((_gs - GROUNDSP_KTS_MIN) / 950.0f) + _base;   \
-        _var -= ((_gs - GROUNDSP_KTS_MID) / 475.0f);           \
-    }                                                          \
-    else                                                       \
-    {                                                          \
-        _var  = ((_gs - GROUNDSP_KTS_MIN) / 950.0f) + _base;   \
-    }                                                          \
-}
+#define NULLZONE_MIN            (00.0400f)
 
 enum
 {
@@ -84,7 +294,119 @@ typedef struct
     float share[ZONE_MAX + 1];
 } thrust_zones;
 
+/*
+ * Per-backend command handlers, resolved once at aircraft detection (see
+ * xnz_cmd_ops_resolve); actions a backend doesn't support are xnz_op_noop.
+ */
+typedef struct xnz_cmd_context xnz_cmd_context;
+typedef int (*xnz_cmd_op)(xnz_cmd_context *commands, XPLMCommandPhase inPhase);
+
+typedef struct
+{
+    xnz_cmd_op a_p_onn;
+    xnz_cmd_op a_p_off;
+} xnz_ap_ops;
+
+typedef struct
+{
+    xnz_cmd_op at_toga;
+    xnz_cmd_op at_disc;
+    xnz_cmd_op a_12_lt;
+    xnz_cmd_op a_12_rt;
+    xnz_cmd_op a_34_lt;
+    xnz_cmd_op a_34_rt;
+} xnz_at_ops;
+
+typedef struct
+{
+    xnz_cmd_op x_12_lt;
+    xnz_cmd_op x_12_rt;
+    xnz_cmd_op x_34_lt;
+    xnz_cmd_op x_34_rt;
+    xnz_cmd_op m_12_cr;
+    xnz_cmd_op m_12_no;
+    xnz_cmd_op m_12_st;
+    xnz_cmd_op m_34_cr;
+    xnz_cmd_op m_34_no;
+    xnz_cmd_op m_34_st;
+    xnz_cmd_op e_1_onn;
+    xnz_cmd_op e_1_off;
+    xnz_cmd_op e_2_onn;
+    xnz_cmd_op e_2_off;
+    xnz_cmd_op e_3_onn;
+    xnz_cmd_op e_3_off;
+    xnz_cmd_op e_4_onn;
+    xnz_cmd_op e_4_off;
+} xnz_et_ops;
+
+typedef struct
+{
+    xnz_cmd_op rgb_hld;
+} xnz_bt_ops;
+
+typedef struct
+{
+    int (*get)(xnz_cmd_context *commands);
+    int (*set)(xnz_cmd_context *commands, int set);
+} xnz_pb_ops;
+
+/*
+ * Closed-loop regular braking: the brake output is ramped (rate-limited)
+ * so that the measured deceleration (low-pass filtered groundspeed change
+ * between frames) tracks a target deceleration for the speed range.
+ */
+typedef struct
+{
+    uint64_t t_last; // xnz_time_ns() of the last sample (zero: none)
+    float gs_last; // groundspeed at t_last (m/s)
+    float decel; // filtered deceleration (m/s²)
+    float output; // current brake output (ratio)
+} xnz_brake_ctl;
+
+/*
+ * Spoken callouts: queued by command handlers and the flight loop, spoken one
+ * at a time by callout_hdlr_fnc (never from a handler). Each callout is held
+ * for a short while first: a repeat is dropped, and an opposite callout (e.g.
+ * park brake set, then released) cancels the pending one.
+ */
+enum
+{
+    XNZ_CALLOUT_GEAR_UP,
+    XNZ_CALLOUT_GEAR_DN,
+    XNZ_CALLOUT_PKB_SET,
+    XNZ_CALLOUT_PKB_REL,
+    XNZ_CALLOUT_ICE,
+    XNZ_CALLOUT_COUNT,
+};
+#define XNZ_CALLOUT_QUEUE       8
+#define XNZ_CALLOUT_SETTLE_NS   400000000ull // hold time before speaking (cancellation window)
+#define XNZ_CALLOUT_SPACING_NS 1500000000ull // minimum time between two callouts
+#define XNZ_CALLOUT_REPEAT_NS  3000000000ull // drop the last callout spoken if repeated within this time
+
+typedef struct
+{
+    struct
+    {
+        int id;
+        uint64_t queued; // xnz_time_ns()
+    } queue[XNZ_CALLOUT_QUEUE];
+    int count;
+    int last_id; // last callout spoken (-1: none)
+    uint64_t last_spoken;
+    XPLMFlightLoop_f f_l_co; // NULL: not registered
+} xnz_callouts;
+
+#ifndef PUBLIC_RELEASE_BUILD
+#define XNZ_JOURNAL_COMMANDS 64 // max. number of xnz_init_cmds
 typedef struct
+{
+    xnz_journal_record record[XNZ_JOURNAL_RECORDS];
+    uint32_t holds[XNZ_JOURNAL_COMMANDS]; // continue phases, by command
+    uint32_t next; // sequence number of the next record
+} xnz_journal;
+#endif
+
+struct xnz_cmd_context
 {
     int xp_11_00_or_later;
     int xp_11_50_or_later;
@@ -464,8 +786,16 @@ typedef struct
         int         pbrak_onoff; // for manual braking: remember the pbrak state
         int         pbrakonoff2; // for xnz/brakes/regular/park
         XPLMDataRef mixture_all; // sim/cockpit2/engine/actuators/mixture_ratio_all
+        XPLMDataRef sim_paused; // sim/time/paused
+        XPLMDataRef sim_speedup; // sim/time/sim_speed_actual (optional)
     } xp;
 
+    xnz_brake_ctl brake; // xnz/brakes/regular/hold
+    xnz_callouts callouts;
+#ifndef PUBLIC_RELEASE_BUILD
+    xnz_journal journal; // written by chandler_journal (main thread only)
+#endif
+
     XPLMCommandRef cmd_ldg_upp; // xnz/landing/gear/up
     XPLMCommandRef cmd_ldg_dwn; // xnz/landing/gear/down
     XPLMCommandRef cmd_ldg_tog; // xnz/landing/gear/toggle
@@ -509,12 +839,40 @@ typedef struct
     XPLMCommandRef cmd_e_4_onh; // xnz/tca/engines/4/on/hold
     XPLMCommandRef cmd_e_4_onn; // xnz/tca/engines/4/on
     XPLMCommandRef cmd_e_4_off; // xnz/tca/engines/4/off
-} xnz_cmd_context;
+    XPLMCommandRef cmd_jrn_dmp; // xnz/debug/journal/dump
+
+    const xnz_profile *profile; // per-aircraft profile (NULL: built-in values)
+
+    struct
+    {
+        const xnz_ap_ops *ap;
+        const xnz_at_ops *at;
+        const xnz_bt_ops *bt;
+        const xnz_et_ops *et;
+        const xnz_pb_ops *pb;
+    } ops;
+};
+
+static void xnz_cmd_ops_resolve(xnz_cmd_context *commands);
+static void xnz_callout(xnz_cmd_context *commands, int id);
 
 static int chandler_ldg_upp(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_ldg_dwn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_ldg_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_rgb_pkb(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+/*
+ * Brake ratio for the given speed range (0: low, 1: medium, 2: high), from
+ * the aircraft's profile if it has one, else the built-in default.
+ */
+static inline float brake_ratio(const xnz_cmd_context *commands, int speed, float ratio)
+{
+    if (commands->profile && (commands->profile->flags & XNZ_PROFILE_BRAKES))
+    {
+        return commands->profile->brake[speed];
+    }
+    return ratio;
+}
+
 static int chandler_rgb_hld(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_pkb_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_pkb_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
@@ -554,1221 +912,3849 @@ static int chandler_e_3_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 static int chandler_e_4_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_e_4_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
 static int chandler_e_4_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+#ifndef PUBLIC_RELEASE_BUILD
+static int chandler_jrn_dmp(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+static int chandler_journal(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+static int chandler_ffr_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+#endif
 static int chandler_printax(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+static int chandler_trc_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+#if LIN
+static int chandler_dir_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon);
+#endif
 
+/*
+ * Signatures of all plugins loaded at the time of the last aircraft load,
+ * in an open-addressing hash table (FNV-1a, linear probing).
+ */
+#define XNZ_PLUGIN_INDEX_SLOTS 512 // power of two
+#define XNZ_PLUGIN_INDEX_LIMIT 256 // keep load factor at or below 1/2
+#define XNZ_PLUGIN_INDEX_BYTES (XNZ_PLUGIN_INDEX_LIMIT * 64)
 typedef struct
 {
-#ifndef PUBLIC_RELEASE_BUILD
-    XPLMFlightLoop_f f_l_cb;
-    XPLMDataRef f_air_speed;
-    XPLMDataRef f_grd_speed;
-    XPLMDataRef nullzone[3];
-    float prefs_nullzone[3];
-    float minimum_null_zone;
-    XPLMDataRef acf_roll_co;
-    XPLMDataRef ongroundany;
-    float nominal_roll_coef;
-    float last_throttle_all;
-    float show_throttle_all;
-    float icecheck_required;
-    char overly_txt_buf[11];
-    int throttle_did_change;
-    int ice_detect_positive;
-    int overly_position_set;
-    XPLMDataRef f_ice_rf[4];
-    XPWidgetID  widgetid[2];
-    XPLMCommandRef print_ax;
-#endif
-
-    xnz_cmd_context commands;
-
-    enum
-    {
-        XNZ_TT_ERRR =  -1,
-        XNZ_TT_XPLM =   1,
-        XNZ_TT_FF32 = 320,
-        XNZ_TT_TOLI = 321,
-        XNZ_TT_TBM9 = 900,
-    } xnz_tt;
-
-    union
+    struct
     {
-        struct
-        {
-            SharedValuesInterface s;
-            int id_f32_eng_lever_lt;
-            int id_f32_eng_lever_rt;
-            int api_has_initialized;
-        } ff32;
-
-        struct
-        {
-            XPLMDataRef f_thr_array;
-        } toli;
-
-        struct
-        {
-            XPLMDataRef engn_rng;
-        } tbm9;
-    } tt;
-
-    int i_got_axis_input[3];
-    int i_context_init_done;
-    int i_version_simulator;
-    int i_version_xplm_apis;
-    XPLMFlightLoop_f f_l_th;
-    XPLMDataRef i_stick_ass;
-    XPLMDataRef f_stick_val;
-    XPLMDataRef i_prop_mode;
-    XPLMDataRef i_ngine_num;
-    XPLMDataRef i_ngine_typ;
-    XPLMDataRef rev_info[3];
-    XPLMCommandRef betto[9];
-    XPLMCommandRef revto[9];
-    int acft_has_rev_thrust;
-    int acf_has_beta_thrust;
-    int arcrft_engine_count;
-    int i_propmode_value[8];
-    int idx_throttle_axis_1;
-    XPLMDataRef f_throttall;
-    XPLMDataRef f_thr_array;
-
-#define XNZ_THINN_NO (-1.0f)
-#define XNZ_THOUT_AT (-2.0f)
-#define XNZ_THOUT_SK (-3.0f)
-    float avrg_throttle_inn;
-    XPLMDataRef f_throt_inn;
-    float avrg_throttle_out;
-    XPLMDataRef f_throt_out;
-
-    XPLMMenuID id_th_on_off;
-    int id_menu_item_on_off;
-    int tca_support_enabled;
-    int msg_will_write_pref;
-    int skip_idle_overwrite;
-    thrust_zones zones_info;
+        uint32_t hash;
+        uint32_t name; // offset into pool, plus one (zero: empty slot)
+        XPLMPluginID id;
+        int enabled;
+    } slot[XNZ_PLUGIN_INDEX_SLOTS];
+    char pool[XNZ_PLUGIN_INDEX_BYTES];
+    size_t pool_used;
+    int count;
+    int count_enabled;
+    int complete; // zero: lookups fall back to XPLMFindPluginBySignature
 }
-xnz_context;
+xnz_plugin_index;
 
-static xnz_context *global_context = NULL;
+/*
+ * Backend selection for recently-loaded aircraft, persisted across sessions;
+ * keyed by .acf path, size and modification time, plus a fingerprint of the
+ * loaded plugins' signatures. Bump XNZ_ACF_CACHE_VERSION whenever profiles or
+ * backend type values change (stale entries would otherwise be trusted).
+ */
+#define XNZ_ACF_CACHE_MAGIC   0x444E5A58u // "XZND"
+#define XNZ_ACF_CACHE_VERSION 1
+#define XNZ_ACF_CACHE_ENTRIES 32
+typedef struct
+{
+    char     path[512];
+    int64_t  fsize;
+    int64_t  mtime;
+    uint64_t plugins; // xnz_plugin_index_fingerprint
+    char     profile[32]; // name of the matched profile (empty: none)
+    int32_t  xnz_ab, xnz_ap, xnz_at, xnz_bt, xnz_et, xnz_pb, xnz_sb, xnz_tt;
+    float    share[ZONE_MAX + 1];
+    uint32_t last_use;
+    uint32_t reserved;
+}
+xnz_acf_cache_entry;
 
-static int               xnz_log(const char *format, ...);
-static float      axes_hdlr_fnc(float, float, int, void*);
-static void       menu_hdlr_fnc(void*,             void*);
-static inline float throttle_mapping(float, thrust_zones);
+typedef struct
+{
+    struct
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entry_size;
+        uint32_t clock; // last_use of the most recently used entry
+    } header;
+    xnz_acf_cache_entry entry[XNZ_ACF_CACHE_ENTRIES];
+    xnz_acf_cache_entry key; // current aircraft (not persisted)
+    char filepath[1024]; // empty: not yet loaded
+    int key_valid;
+}
+xnz_acf_cache;
 
+/*
+ * Immutable parameter block (thrust zones, aircraft profile) read by the
+ * flight loop and command handlers via xnz_context.params; replacements are
+ * built by the profile watcher thread, handed over through params_pending
+ * and swapped in by the main thread (xnz_params_acquire). The superseded
+ * block goes to the retire slot, to be freed by the watcher.
+ */
 #ifndef PUBLIC_RELEASE_BUILD
-static float callback_hdlr(float, float, int, void*);
-#endif
+/*
+ * Speed-scheduled parameters: a (speed -> value) curve each, from the aircraft's
+ * profile or built-in, baked into a LUT with the parameter block; the flight
+ * loop evaluates them once per tick and writes a value only when it moved by
+ * at least its threshold since the last write (see xnz_sched_update).
+ */
+enum
+{
+    XNZ_SCHED_NZ_PR, // pitch/roll nullzone vs. indicated airspeed (kts)
+    XNZ_SCHED_NZ_YT, // yaw/tiller nullzone vs. groundspeed (kts)
+    XNZ_SCHED_ROLL, // ground roll friction increment vs. groundspeed (kts), X-Plane 10
+    XNZ_SCHED_COUNT,
+};
 
-#if IBM
-#include <windows.h>
-BOOL APIENTRY DllMain(HANDLE hModule,
-                      DWORD  ul_reason_for_call,
-                      LPVOID lpReserved)
+static const struct
 {
-    switch (ul_reason_for_call)
-    {
-        case DLL_PROCESS_ATTACH:
-        case DLL_THREAD_ATTACH:
-        case DLL_THREAD_DETACH:
-        case DLL_PROCESS_DETACH:
-            break;
-    }
-    return TRUE;
+    uint32_t flag; // XNZ_PROFILE_*: the profile overrides the built-in curve
+    float threshold;
+    xnz_curve curve; // built-in
 }
+xnz_sched_info[XNZ_SCHED_COUNT] =
+{
+    [XNZ_SCHED_NZ_PR] = { XNZ_PROFILE_NZ_PR, 0.0005f, { 2, { AIRSPEED_MIN_KTS, AIRSPEED_MAX_KTS, }, { 0.125f, NULLZONE_MIN, }, }, },
+    [XNZ_SCHED_NZ_YT] = { XNZ_PROFILE_NZ_YT, 0.0005f, { 2, { GROUNDSP_MIN_KTS, GROUNDSP_MAX_KTS, }, { 0.250f, NULLZONE_MIN, }, }, },
+    [XNZ_SCHED_ROLL]  = { XNZ_PROFILE_ROLL, 0.00005f, { 3, { GROUNDSP_KTS_MIN, GROUNDSP_KTS_MID, GROUNDSP_KTS_MAX, }, { 0.0f, 0.025f, 0.0f, }, }, },
+};
 #endif
 
-PLUGIN_API int XPluginStart(char *outName, char *outSig, char *outDesc)
+typedef struct
 {
+    thrust_zones zones;
+    xnz_profile_map map; // profile used in place (map.profile NULL: none)
 #ifndef PUBLIC_RELEASE_BUILD
-#define XNZ_XPLM_TITLE "X-Nullzones"
-#define XNZ_LOG_PREFIX "x-nullzones: "
-    strncpy(outName,                                    XNZ_XPLM_TITLE, 255);
-    strncpy(outSig,                                     "Rodeo314.XNZ", 255);
-    strncpy(outDesc, "Dynamic nullzones and other miscellaneous stuff", 255);
-#else
-#define XNZ_XPLM_TITLE "Quadrant314"
-#define XNZ_LOG_PREFIX "Quadrant314: "
-    strncpy(outName,                                    XNZ_XPLM_TITLE, 255);
-    strncpy(outSig,                                     "Rodeo314.TCA", 255);
-    strncpy(outDesc,   "\"Reverse on same axis\" thrust lever support", 255);
+    xnz_lut sched[XNZ_SCHED_COUNT];
 #endif
-
-    /* all good */
-    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginStart OK\n"); return 1;
 }
+xnz_params;
 
-static int xnz_log(const char *format, ...)
+typedef struct
 {
-    int ret;
-    va_list ap;
-    char string[1024];
-    va_start(ap, format);
-    ret = vsnprintf(string, sizeof(string), format, ap);
-    if (ret > 0) // output is NULL-terminated
+    xnz_mutex lock; // request, err; publication to params_pending
+    xnz_thread thread;
+    uint32_t running;
+    xnz_params *retired;
+    struct
     {
-        XPLMDebugString(XNZ_LOG_PREFIX);
-        XPLMDebugString(string);
-    }
-    va_end(ap);
-    return ret;
+        int active;
+        uint32_t generation; // bumped on each aircraft (un)load
+        char dir[1024];
+        char name[41];
+        thrust_zones zones; // baseline, without profile
+        int apply_shares;
+        int64_t size; // source file last seen (-1: absent)
+        int64_t mtime;
+    } request;
+    char err[1280];
 }
+xnz_params_watch;
 
-PLUGIN_API void XPluginStop(void)
+/*
+ * Duration of plugin enable and aircraft load (sub-)phases, in milliseconds
+ * (monotonic clock); published as xnz/timing/phases (float array, in this
+ * order) and summarized in Log.txt after each phase completes.
+ */
+enum
 {
-    return;
+    XNZ_PHASE_EN_TOTAL,
+    XNZ_PHASE_EN_CONTEXT,  // context allocation
+    XNZ_PHASE_EN_DATAREFS, // axis and reverser dataref/command resolution
+    XNZ_PHASE_EN_ACCESSOR, // xnz/throttle/ratio, xnz/init and xnz/timing datarefs
+    XNZ_PHASE_EN_MENU,
+    XNZ_PHASE_EN_PARAMS,   // thrust zones, profile watcher
+    XNZ_PHASE_IN_TOTAL,    // staged initialization (sum of the stages below)
+    XNZ_PHASE_IN_OVERLAY,  // nullzone datarefs, overlay widgets
+    XNZ_PHASE_IN_REFS,     // sim references for the TCA button handlers
+    XNZ_PHASE_IN_COMMANDS, // xnz/* command creation and registration
+    XNZ_PHASE_IN_ACCESSOR, // per-lever, per-engine and state datarefs
+    XNZ_PHASE_LV_TOTAL,
+    XNZ_PHASE_LV_ENGINES,  // engine count, type and reverser probing
+    XNZ_PHASE_LV_PLUGINS,  // plugin index
+    XNZ_PHASE_LV_CACHE,    // detection cache lookup
+    XNZ_PHASE_LV_PROBE,    // full detection chain (zero on cache hit)
+    XNZ_PHASE_LV_STORE,    // detection cache write (zero on cache hit)
+    XNZ_PHASE_LV_PROFILE,  // per-aircraft profile
+    XNZ_PHASE_LV_AXES,     // axis scan and capture
+    XNZ_PHASE_COUNT,
+};
+
+#define XNZ_TIMING_PROBES 32 // aircraft profiles timed individually
+
+typedef struct
+{
+    float ms[XNZ_PHASE_COUNT];
+    float probe_ms[XNZ_TIMING_PROBES]; // by index in xnz_acf_profiles[]
+    int probe_count; // profiles evaluated by the last detection
 }
+xnz_timing;
 
-static float XNZGetDataf(void *inRefcon) // XPLMGetDataf_f
+/*
+ * Staged initialization: everything not needed to capture the throttle axes
+ * is done from a flight loop callback, a few items at a time, within a time
+ * budget per frame; aircraft detection waits until it's complete.
+ */
+enum
 {
-    return ((float*)inRefcon)[0]; // https://developer.x-plane.com/sdk/XPLMRegisterDataAccessor/
+    XNZ_INIT_OVERLAY,
+    XNZ_INIT_REFS,
+    XNZ_INIT_COMMANDS,
+    XNZ_INIT_ACCESSOR,
+    XNZ_INIT_DONE,
+    XNZ_INIT_FAILED,
+};
+#define XNZ_INIT_BUDGET_NS (1000000ull) // per frame
+#define XNZ_INIT_ACCESSORS (9)
+
+typedef struct
+{
+    int stage; // XNZ_INIT_*
+    int index; // next item in current stage
+    int done;
+    int total;
+    int slices;
+    float progress; // 0..1
+    float slice_ms; // last slice
+    float slice_max_ms;
+    int detect_pending; // xnz_aircraft_detect once complete
+    XPLMFlightLoop_f f_l_in;
+    XPLMDataRef f_progress;
+    XPLMDataRef f_slice_ms;
 }
+xnz_init_state;
 
-#define HS_TBM9_IDLE (0.35f)
+#ifndef PUBLIC_RELEASE_BUILD
+/*
+ * Throttle/ICE/groundspeed overlay: text is re-formatted and re-measured only
+ * when the value changes at display resolution (kind, key); the box is laid
+ * out again whenever the screen size changes. Visibility is tracked here.
+ */
+enum
+{
+    XNZ_OVERLAY_NONE = 0,
+    XNZ_OVERLAY_ICE,
+    XNZ_OVERLAY_PERCENT, // key: percent
+    XNZ_OVERLAY_RATIO_4, // key: ratio * 10^4 (4 decimals)
+    XNZ_OVERLAY_RATIO_5, // key: ratio * 10^5 (5 decimals)
+    XNZ_OVERLAY_GRDSPD, // key: knots
+};
 
-static float TCA_SYNCBAND = 0.075000f; // note: maximum L/R difference was measured slightly over 6%, but we allow for noisier hardware than mine
-static float TCA_DEADBAND = 0.037500f; // half of the above
-static float TCA_FLEX_CTR = 0.706744f; // print_ax
-static float TCA_CLMB_CTR = 0.520279f; // print_ax
-//atic float TCA_IDLE_CTR = 0.323819f; // not held
-static float TCA_IDLE_CTR = 0.311589f; // averaged
-//atic float TCA_IDLE_CTR = 0.299359f; // yes held
+typedef struct
+{
+    XPLMWindowID window;
+    int visible;
+    int screen[2]; // width, height the box was laid out for (zero: not yet)
+    int box[4]; // left, top, right, bottom
+    int text_xy[2]; // text origin (centered in box)
+    int font_height;
+    int kind;
+    int key;
+    char text[16];
+} xnz_overlay;
+#endif
+
+/*
+ * Axis pipeline trace (see XNZtrace.h): single-producer, single-consumer ring;
+ * the flight loop owns head, the writer thread owns tail, and a full ring
+ * drops the record (the flight loop never waits). Allocated on start.
+ */
+#define XNZ_TRACE_RING  1024 // power of two (~50 seconds at 20 Hz)
+#define XNZ_TRACE_CHUNK (16 * 1024) // writer thread output buffer
+#define XNZ_TRACE_SLEEP 100 // writer thread poll interval (ms)
 
-static void update_thrust_zones(thrust_zones *info)
+typedef struct
 {
-    if (info)
-    {
-        /*
-         * Re-compute zones based on the center of each hardware detent.
-         */
-        info->max[ZONE_TGA] = (                      1.0f - TCA_DEADBAND);
-        info->min[ZONE_TGA] = (              TCA_FLEX_CTR + TCA_DEADBAND);
-        info->max[ZONE_FLX] = (              TCA_FLEX_CTR - TCA_DEADBAND);
-        info->min[ZONE_FLX] = (              TCA_CLMB_CTR + TCA_DEADBAND);
-        info->max[ZONE_CLB] = (              TCA_CLMB_CTR - TCA_DEADBAND);
-        info->min[ZONE_CLB] = (              TCA_IDLE_CTR + TCA_DEADBAND);
-        info->max[ZONE_REV] = (              TCA_IDLE_CTR - TCA_DEADBAND);
-        info->min[ZONE_REV] = (                      0.0f + TCA_DEADBAND);
-        info->len[ZONE_TGA] = (info->max[ZONE_TGA] - info->min[ZONE_TGA]);
-        info->len[ZONE_FLX] = (info->max[ZONE_FLX] - info->min[ZONE_FLX]);
-        info->len[ZONE_CLB] = (info->max[ZONE_CLB] - info->min[ZONE_CLB]);
-        info->len[ZONE_REV] = (info->max[ZONE_REV] - info->min[ZONE_REV]);
-    }
+    xnz_trace_record ring[XNZ_TRACE_RING];
+    uint32_t head XNZ_CACHELINE_ALIGNED; // flight loop
+    uint32_t sequence;
+    uint32_t dropped;
+    xnz_trace_record tick; // current tick's intermediate values, filled in by throttle_axes()
+    uint32_t tail XNZ_CACHELINE_ALIGNED; // writer thread
+    uint32_t running;
+    uint32_t written;
+    uint32_t failed; // write error (records are then discarded)
+    xnz_thread thread;
+    FILE *file;
+    uint8_t chunk[XNZ_TRACE_CHUNK];
+    char path[1024];
 }
+xnz_trace;
 
-static void default_throt_share(thrust_zones *info)
+#ifndef PUBLIC_RELEASE_BUILD
+/*
+ * FlightFactor A320 recorder (see XNZffrec.h): single-producer, single-consumer
+ * ring of blocks, the aircraft's update callback owns head, the writer thread
+ * owns tail; the callback fills the block at head one frame at a time and
+ * drops frames while the ring is full. Allocated on start.
+ */
+#define XNZ_FFREC_RING 8 // blocks, power of two (~34 seconds at 60 fps)
+
+typedef struct
 {
-    if (info)
-    {
-        info->share[ZONE_CLB] = 0.500f;
-        info->share[ZONE_FLX] = 0.875f - info->share[ZONE_CLB];
-        info->share[ZONE_TGA] = 1.000f - info->share[ZONE_FLX] - info->share[ZONE_CLB];
-    }
+    uint8_t *ring; // XNZ_FFREC_RING * block_size
+    size_t block_size;
+    size_t row_size; // bytes per frame, all columns
+    xnz_ffrec_block block[XNZ_FFREC_RING];
+    SharedValuesInterface *s;
+    XPLMPluginID pid;
+    uint32_t head XNZ_CACHELINE_ALIGNED; // update callback
+    uint32_t fill; // frames in the block at head
+    uint32_t sequence;
+    uint32_t dropped;
+    uint32_t tail XNZ_CACHELINE_ALIGNED; // writer thread
+    uint32_t running;
+    uint32_t written;
+    uint32_t failed; // write error (blocks are then discarded)
+    xnz_thread thread;
+    FILE *file;
+    uint32_t skipped; // values beyond XNZ_FFREC_COLUMNS
+    uint32_t column_count;
+    size_t offset[XNZ_FFREC_COLUMNS]; // of each column's array in a block
+    xnz_ffrec_column column[XNZ_FFREC_COLUMNS];
+    char path[1024];
 }
+xnz_ffrec;
+#endif
 
-PLUGIN_API int XPluginEnable(void)
+/*
+ * Latency histograms (see XNZhist.h) for the flight loop callbacks, the axis
+ * pipeline, command handlers (all of them, and each command and phase in a
+ * separate allocation) and aircraft (livery) loading; p50, p99 and max of
+ * each task are published as xnz/perf/ vector datarefs (microseconds).
+ */
+enum
 {
-    /* check for unsupported versions */
-    XPLMHostApplicationID outHostID;
-    int outXPlaneVersion, outXPLMVersion;
-    XPLMGetVersions(&outXPlaneVersion, &outXPLMVersion, &outHostID);
-    if (outXPLMVersion < 210) // currently pointless as we target XPLM210 at build time
-    {
-        xnz_log("[error]: XPluginEnable failed (outXPLMVersion: %d < 210)\n", outXPLMVersion);
-        return 0;
-    }
-    if (outXPlaneVersion > 11999)
-    {
-        xnz_log("[error]: XPluginEnable failed (outXPlaneVersion: %d > 11999)\n", outXPlaneVersion);
-        return 0;
-    }
+    XNZ_PERF_AXES,      // axes_hdlr_fnc (throttle_axes, publication, telemetry, trace)
+    XNZ_PERF_THROTTLE,  // throttle_axes
+    XNZ_PERF_NULLZONES, // callback_hdlr
+    XNZ_PERF_HANDLERS,  // chandler_journal (any command, any phase)
+    XNZ_PERF_LIVERY,    // XPLM_MSG_LIVERY_LOADED
+    XNZ_PERF_ICECHECK,  // callback_hdlr, every 10 seconds
+    XNZ_PERF_OVERLAY,   // overlay (re-)positioning
+    XNZ_PERF_CAPTURE,   // axis scan and capture (livery)
+    XNZ_PERF_INIT,      // init_hdlr_fnc (staged initialization)
+    XNZ_PERF_INGRESS,   // ingress_hdlr_fnc
+    XNZ_PERF_LOG,       // log_hdlr_fnc
+    XNZ_PERF_COUNT,
+};
 
-    /* Initialize context */
-    if (NULL == (global_context = malloc(sizeof(xnz_context))))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (malloc)\n"); goto fail;
-    }
+static const char *xnz_perf_names[XNZ_PERF_COUNT] =
+{
+    "axes", "throttle", "nullzones", "handlers", "livery",
+    "icecheck", "overlay", "capture", "init", "ingress", "log",
+};
+
+/*
+ * Stutter monitor: a flight loop callback measures the frame period (time
+ * between two of its calls), and hands it to the detector in XNZstutter.h;
+ * for each stutter, the time each of our tasks took during that period is
+ * kept (most recent XNZ_STUTTER_EVENTS) and the stutter is ours if our tasks
+ * account for at least half of the excess, external otherwise.
+ */
+#define XNZ_STUTTER_EVENTS  (64)
+
+typedef struct
+{
+    uint64_t time; // monotonic clock (ns), end of the frame
+    uint32_t frame;
+    uint32_t period_us;
+    uint32_t average_us;
+    uint32_t plugin_us; // our tasks, outermost only
+    uint32_t task_us[XNZ_PERF_COUNT]; // including nested tasks
+    uint32_t plugin; // attributed to us
+}
+xnz_stutter_event;
+
+typedef struct
+{
+    xnz_hist task[XNZ_PERF_COUNT];
 #ifndef PUBLIC_RELEASE_BUILD
-    if (NULL == (global_context->print_ax = XPLMCreateCommand("xnz/print/axes/average", "")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (print_ax)\n"); goto fail;
-    }
-    else
-    {
-        XPLMRegisterCommandHandler(global_context->print_ax, &chandler_printax, 0, global_context);
-    }
-    if (NULL == (global_context->nullzone[0] = XPLMFindDataRef("sim/joystick/joystick_pitch_nullzone")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (nullzone[0])\n"); goto fail;
-    }
-    if (NULL == (global_context->nullzone[1] = XPLMFindDataRef("sim/joystick/joystick_roll_nullzone")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (nullzone[1])\n"); goto fail;
-    }
-    if (NULL == (global_context->nullzone[2] = XPLMFindDataRef("sim/joystick/joystick_heading_nullzone")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (nullzone[2])\n"); goto fail;
-    }
-    if (NULL == (global_context->f_grd_speed = XPLMFindDataRef("sim/flightmodel/position/groundspeed")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_grd_speed)\n"); goto fail;
-    }
-    if (NULL == (global_context->f_air_speed = XPLMFindDataRef("sim/flightmodel/position/indicated_airspeed")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_air_speed)\n"); goto fail;
-    }
-    if (NULL == (global_context->acf_roll_co = XPLMFindDataRef("sim/aircraft/overflow/acf_roll_co")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (acf_roll_co)\n"); goto fail;
-    }
-    if (NULL == (global_context->ongroundany = XPLMFindDataRef("sim/flightmodel/failures/onground_any")))
+    xnz_hist (*handler)[3]; // by index in xnz_init_cmds, then command phase
+#endif
+    XPLMDataRef f_p50_us;
+    XPLMDataRef f_p99_us;
+    XPLMDataRef f_max_us;
+    int id_menu_item_dump;
+    int depth; // nested xnz_perf_enter calls
+
+    struct
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (ongroundany)\n"); goto fail;
-    }
-    if (NULL == (global_context->f_ice_rf[0] = XPLMFindDataRef("sim/flightmodel/failures/pitot_ice")) ||
-        NULL == (global_context->f_ice_rf[1] = XPLMFindDataRef("sim/flightmodel/failures/inlet_ice")) ||
-        NULL == (global_context->f_ice_rf[2] = XPLMFindDataRef("sim/flightmodel/failures/prop_ice")) ||
-        NULL == (global_context->f_ice_rf[3] = XPLMFindDataRef("sim/flightmodel/failures/frm_ice")))
+        XPLMFlightLoop_f f_l_st;
+        uint64_t started;
+        uint64_t last; // previous frame boundary (zero: none yet)
+        xnz_stutter_baseline baseline;
+        uint64_t plugin_ns; // our tasks since the last boundary (outermost only)
+        uint64_t plugin_ns_max;
+        uint64_t plugin_ns_sum;
+        uint64_t period_ns_sum;
+        uint64_t task_ns[XNZ_PERF_COUNT];
+        uint32_t frames;
+        uint32_t stutters;
+        uint32_t plugin;
+        xnz_stutter_event event[XNZ_STUTTER_EVENTS]; // ring, by stutters
+    } stutter;
+}
+xnz_perf;
+
+/*
+ * Nested-task accounting: the outermost xnz_perf_enter/xnz_perf_leave pair
+ * adds to the plugin's cost for the current frame; every pair (and every
+ * xnz_perf_record) adds to the task's histogram and time for the frame.
+ */
+static inline void xnz_perf_record(xnz_perf *perf, int task, uint64_t ns)
+{
+    xnz_hist_record(&perf->task[task], ns);
+    perf->stutter.task_ns[task] += ns;
+}
+
+static inline uint64_t xnz_perf_enter(xnz_perf *perf)
+{
+    perf->depth++;
+    return xnz_time_ns();
+}
+
+static inline void xnz_perf_leave(xnz_perf *perf, int task, uint64_t since)
+{
+    uint64_t ns = xnz_time_ns() - since;
+    xnz_perf_record(perf, task, ns);
+    if (--perf->depth == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_ice_rf)\n"); goto fail;
+        perf->stutter.plugin_ns += ns;
     }
-    if (!(global_context->widgetid[0] = XPCreateWidget(0, 0, 0, 0, 0, "", 1, NULL,
-                                                       xpWidgetClass_MainWindow)))
+}
+
+/*
+ * Per-lever/per-engine view of the axis pipeline, published as vector
+ * datarefs: written by throttle_axes(), copied as-is by the accessors.
+ */
+typedef struct
+{
+    float lever_inn[2];
+    float engine_out[8];
+    int   lever_zone[2];
+    enum
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (widgetid)\n"); goto fail;
-    }
-    if (!(global_context->widgetid[1] = XPCreateWidget(0, 0, 0, 0, 0, "", 0,
-                                                       global_context->widgetid[0],
-                                                       xpWidgetClass_Caption)))
+        XNZ_PIPE_OFF = 0, // TCA flight loop disabled via menu
+        XNZ_PIPE_NOIN = 1, // no axis input received yet
+        XNZ_PIPE_AUTO = 2, // autothrottle in control
+        XNZ_PIPE_SKIP = 3, // idle overwrite skipped (user override)
+        XNZ_PIPE_TOGG = 4, // beta/reverse toggle command issued
+        XNZ_PIPE_WRIT = 5, // throttle ratio(s) written
+        XNZ_PIPE_NSUP = 6, // aircraft not supported (yet)
+    } pipeline_st;
+}
+xnz_published;
+
+/*
+ * Rarely-accessed state: command references and handlers, menu, overlay and
+ * dataref handles, allocated separately from the per-frame (hot) context.
+ */
+typedef struct
+{
+#ifndef PUBLIC_RELEASE_BUILD
+    XPLMFlightLoop_f f_l_cb;
+    float prefs_nullzone[3];
+    XPLMDataRef f_ice_rf[4];
+    xnz_overlay overlay;
+    XPLMCommandRef print_ax;
+#endif
+
+    xnz_cmd_context commands;
+    xnz_plugin_index plugins;
+    xnz_acf_cache acf_cache;
+    xnz_params_watch watch;
+    thrust_zones zones_base; // built-in detents, detected shares (without profile)
+
+    int i_context_init_done;
+    int i_version_xplm_apis;
+    XPLMFlightLoop_f f_l_th;
+    XPLMDataRef i_stick_ass;
+    XPLMDataRef i_ngine_num;
+    XPLMDataRef i_ngine_typ;
+    XPLMDataRef rev_info[3];
+    XPLMCommandRef betto[9];
+    XPLMCommandRef revto[9];
+
+    XPLMDataRef f_throt_inn;
+    XPLMDataRef f_throt_out;
+    XPLMDataRef f_lever_inn;
+    XPLMDataRef i_lever_zon;
+    XPLMDataRef f_engin_out;
+    XPLMDataRef i_pipe_stat;
+    XPLMDataRef i_publi_gen;
+    XPLMDataRef i_log_level;
+    XPLMDataRef f_timing_ph;
+    xnz_timing timing;
+    xnz_init_state init;
+    XPLMCommandRef trace_tog;
+#if LIN
+    XPLMCommandRef direct_tog;
+#endif
+#ifndef PUBLIC_RELEASE_BUILD
+    XPLMCommandRef ffrec_tog;
+    xnz_ffrec *ffrec; // NULL: not recording
+#endif
+    xnz_shm telemetry_shm;
+    struct
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (widgetid)\n"); goto fail;
-    }
-    global_context->overly_position_set = 0; // X-Plane window's actual boundaries not yet available/reliable
-    XPSetWidgetProperty(global_context->widgetid[0], xpProperty_MainWindowType, xpMainWindowStyle_Translucent);
-    XPSetWidgetProperty(global_context->widgetid[1], xpProperty_CaptionLit, 1);
-    XPSetWidgetGeometry(global_context->widgetid[0], 0, 56 - 0, 64 - 0, 0);
-    XPSetWidgetGeometry(global_context->widgetid[1], 7, 56 - 7, 64 - 7, 7);
+        xnz_shm shm;
+        xnz_ingress *queue; // NULL: not available
+        XPLMFlightLoop_f f_l_ig;
+        XPLMCommandRef *refs[XNZ_INGRESS_COMMANDS]; // by index in queue->names
+        uint8_t held[XNZ_INGRESS_COMMANDS]; // begun, not ended yet
+        uint32_t count; // entries in refs (queue->command_count is client-writable)
+    } ingress;
+    xnz_perf perf;
 
-    /* flight loop callback */
-    XPLMRegisterFlightLoopCallback((global_context->f_l_cb = &callback_hdlr), 0, global_context);
-#endif // PUBLIC_RELEASE_BUILD
+    xnz_published previous; // last published values (see throttle_publish)
+    SharedValuesInterface ff32; // FlightFactor A320 (xnz_tt == XNZ_TT_FF32)
 
-    /* common datarefs */
-    if (NULL == (global_context->f_throttall = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio_all")))
+    XPLMMenuID id_th_on_off;
+    int id_menu_item_on_off;
+    int msg_will_write_pref;
+}
+xnz_cold_context;
+
+/*
+ * Everything the flight loops touch every frame, packed together and
+ * aligned to a cache line; anything else belongs in xnz_cold_context.
+ */
+typedef struct
+{
+    int tca_support_enabled;
+    int i_got_axis_input[3];
+    int idx_throttle_axis_1;
+    int arcrft_engine_count;
+    int acft_has_rev_thrust;
+    int acf_has_beta_thrust;
+    int skip_idle_overwrite;
+    int i_version_simulator;
+    int i_propmode_value[8];
+    XPLMDataRef f_stick_val;
+    XPLMDataRef i_prop_mode;
+    XPLMDataRef f_throttall;
+    XPLMDataRef f_thr_array;
+
+    /*
+     * Copies of the cold command context's backend types and autopilot
+     * datarefs, refreshed by xnz_context_sync() after (re-)detection.
+     */
+    int xnz_at;
+    int xnz_et;
+    XPLMDataRef auto_pil_on;
+    XPLMDataRef auto_thr_on;
+
+#define XNZ_THINN_NO (-1.0f)
+#define XNZ_THOUT_AT (-2.0f)
+#define XNZ_THOUT_SK (-3.0f)
+    float avrg_throttle_inn;
+    float avrg_throttle_out;
+    xnz_params *params; // never NULL (see xnz_params)
+    xnz_params *params_pending;
+    uint32_t params_errors;
+    uint32_t params_errors_seen;
+
+    xnz_published published;
+    int published_gen;
+
+    xnz_trace *trace; // NULL: not recording (see xnz_trace_push)
+    xnz_telemetry *telemetry; // NULL: not published
+#if LIN
+    struct
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_throt_all)\n"); goto fail;
-    }
+        xnz_evdev *reader; // NULL: X-Plane's joystick_axis_values only
+        uint32_t count; // mailbox count of the last sample used
+        uint32_t used; // samples used
+        uint64_t age_sum; // ns, from kernel timestamp to use
+        int invert[2]; // -1: not resolved yet
+    } direct;
+#endif
 
-    /* TCA thrust quadrant support */
-    if (NULL == (global_context->i_stick_ass = XPLMFindDataRef("sim/joystick/joystick_axis_assignments")))
+#ifndef PUBLIC_RELEASE_BUILD
+    XPLMDataRef f_air_speed;
+    XPLMDataRef f_grd_speed;
+    XPLMDataRef nullzone[3];
+    XPLMDataRef acf_roll_co;
+    XPLMDataRef ongroundany;
+    float nominal_roll_coef;
+    float sched_out[XNZ_SCHED_COUNT]; // last value written (-1: none since xnz_sched_invalidate)
+    float last_throttle_all;
+    float show_throttle_all;
+    float icecheck_required;
+    int throttle_did_change;
+    int ice_detect_positive;
+#endif
+
+    enum
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_stick_ass)\n"); goto fail;
-    }
-    if (NULL == (global_context->f_stick_val = XPLMFindDataRef("sim/joystick/joystick_axis_values")))
+        XNZ_TT_ERRR =  -1,
+        XNZ_TT_XPLM =   1,
+        XNZ_TT_FF32 = 320,
+        XNZ_TT_TOLI = 321,
+        XNZ_TT_TBM9 = 900,
+    } xnz_tt;
+
+    union
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_stick_val)\n"); goto fail;
-    }
-    if (NULL == (global_context->f_thr_array = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio")))
+        struct
+        {
+            XPLMDataRef f_thr_array;
+        } toli;
+
+        struct
+        {
+            XPLMDataRef engn_rng;
+        } tbm9;
+
+        struct
+        {
+            XPLMPluginID pid;
+            int id_f32_eng_lever_lt;
+            int id_f32_eng_lever_rt;
+            int api_has_initialized; // cold->ff32 filled in
+        } ff32;
+    } tt;
+
+    xnz_cold_context *cold;
+}
+XNZ_CACHELINE_ALIGNED xnz_context;
+
+static xnz_context *global_context = NULL;
+
+/*
+ * Logging: messages are appended to a bounded buffer (no I/O) and written to
+ * Log.txt the next frame, all at once, by log_hdlr_fnc; while that callback
+ * isn't registered (plugin enable/disable), they are written immediately.
+ * Each call site may log up to XNZ_LOG_BURST messages per XNZ_LOG_WINDOW_NS.
+ * Levels below XNZ_LOG_LEVEL_MIN are compiled out; the runtime minimum level
+ * is the xnz/log/level dataref. Main thread only.
+ */
+enum
+{
+    XNZ_LOG_DEBUG = 0,
+    XNZ_LOG_INFO  = 1,
+    XNZ_LOG_ERROR = 2,
+};
+#ifndef XNZ_LOG_LEVEL_MIN
+#ifdef PUBLIC_RELEASE_BUILD
+#define XNZ_LOG_LEVEL_MIN XNZ_LOG_INFO
+#else
+#define XNZ_LOG_LEVEL_MIN XNZ_LOG_DEBUG
+#endif
+#endif
+#define XNZ_LOG_BUFFER    (16 * 1024)
+#define XNZ_LOG_RESERVE   (128) // for the "messages dropped" line
+#define XNZ_LOG_BURST     (5)
+#define XNZ_LOG_WINDOW_NS (10000000000ull)
+
+typedef struct
+{
+    uint64_t window; // start of the current rate-limiting window
+    uint32_t count; // messages logged in the current window
+    uint32_t suppressed;
+}
+xnz_log_site;
+
+typedef struct
+{
+    char buffer[XNZ_LOG_BUFFER];
+    size_t used;
+    uint32_t dropped; // buffer full
+    int level; // runtime minimum level (xnz/log/level)
+    int scheduled;
+    XPLMFlightLoop_f f_l_lg; // NULL: not registered (write immediately)
+}
+xnz_logger;
+
+static xnz_logger xnz_logger_state = { .level = XNZ_LOG_LEVEL_MIN, };
+
+#define xnz_log(lvl, ...)                                                          \
+do                                                                                 \
+{                                                                                  \
+    if ((lvl) >= XNZ_LOG_LEVEL_MIN && (lvl) >= xnz_logger_state.level)             \
+    {                                                                              \
+        static xnz_log_site xnz_log_site_;                                         \
+        xnz_log_write(&xnz_log_site_, (lvl), __VA_ARGS__);                         \
+    }                                                                              \
+}                                                                                  \
+while (0)
+
+static void       xnz_log_write(xnz_log_site*, int, const char*, ...);
+static void       xnz_log_flush(void);
+static float        log_hdlr_fnc(float, float, int, void*);
+static float      axes_hdlr_fnc(float, float, int, void*);
+static float      init_hdlr_fnc(float, float, int, void*);
+static float   callout_hdlr_fnc(float, float, int, void*);
+static void       menu_hdlr_fnc(void*,             void*);
+static void      xnz_trace_stop(xnz_context*);
+static void xnz_aircraft_detect(xnz_context*);
+#if LIN
+static void   xnz_direct_start(xnz_context*, const char*);
+static void    xnz_direct_stop(xnz_context*);
+static void  xnz_direct_levers(xnz_context*, float[2]);
+#endif
+#ifndef PUBLIC_RELEASE_BUILD
+static void      xnz_ffrec_stop(xnz_context*);
+#endif
+static void  xnz_telemetry_start(xnz_context*);
+static void   xnz_telemetry_stop(xnz_context*);
+static void    xnz_ingress_start(xnz_context*);
+static void     xnz_ingress_stop(xnz_context*);
+static void        xnz_perf_dump(xnz_context*);
+static void   xnz_stutter_report(xnz_context*);
+static float    stutter_hdlr_fnc(float, float, int, void*);
+#ifdef XNZ_XPLM_CALLSTATS
+static float      calls_hdlr_fnc(float, float, int, void*);
+#endif
+static inline float throttle_mapping(float, thrust_zones);
+
+#ifndef PUBLIC_RELEASE_BUILD
+static float callback_hdlr(float, float, int, void*);
+#endif
+
+#if IBM
+#include <windows.h>
+BOOL APIENTRY DllMain(HANDLE hModule,
+                      DWORD  ul_reason_for_call,
+                      LPVOID lpReserved)
+{
+    switch (ul_reason_for_call)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_thr_array)\n"); goto fail;
+        case DLL_PROCESS_ATTACH:
+        case DLL_THREAD_ATTACH:
+        case DLL_THREAD_DETACH:
+        case DLL_PROCESS_DETACH:
+            break;
     }
-    if (NULL == (global_context->i_prop_mode = XPLMFindDataRef("sim/cockpit2/engine/actuators/prop_mode")))
+    return TRUE;
+}
+#endif
+
+PLUGIN_API int XPluginStart(char *outName, char *outSig, char *outDesc)
+{
+#ifndef PUBLIC_RELEASE_BUILD
+#define XNZ_XPLM_TITLE "X-Nullzones"
+#define XNZ_LOG_PREFIX "x-nullzones: "
+#define XNZ_XPLM_CACHE "x-nullzones.cache"
+#define XNZ_XPLM_TRACE "x-nullzones.trace"
+#define XNZ_XPLM_FFREC "x-nullzones.ffrec"
+#define XNZ_XPLM_TELEM XNZ_TELEMETRY_NAME
+#define XNZ_XPLM_INGRS XNZ_INGRESS_NAME
+#define XNZ_XPLM_FOLDER "x-nullzones"
+    strncpy(outName,                                    XNZ_XPLM_TITLE, 255);
+    strncpy(outSig,                                     "Rodeo314.XNZ", 255);
+    strncpy(outDesc, "Dynamic nullzones and other miscellaneous stuff", 255);
+#else
+#define XNZ_XPLM_TITLE "Quadrant314"
+#define XNZ_LOG_PREFIX "Quadrant314: "
+#define XNZ_XPLM_CACHE "Quadrant314.cache"
+#define XNZ_XPLM_TRACE "Quadrant314.trace"
+#define XNZ_XPLM_TELEM XNZ_TELEMETRY_NAME_PUBLIC
+#define XNZ_XPLM_INGRS XNZ_INGRESS_NAME_PUBLIC
+#define XNZ_XPLM_FOLDER "Quadrant314"
+    strncpy(outName,                                    XNZ_XPLM_TITLE, 255);
+    strncpy(outSig,                                     "Rodeo314.TCA", 255);
+    strncpy(outDesc,   "\"Reverse on same axis\" thrust lever support", 255);
+#endif
+
+    /* POSIX paths on macOS (detection cache, .acf modification time) */
+    XPLMEnableFeature("XPLM_USE_NATIVE_PATHS", 1);
+
+    /* all good */
+    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginStart OK\n"); return 1;
+}
+
+static void xnz_log_append(const char *string, size_t length)
+{
+    xnz_logger *l = &xnz_logger_state;
+    if (l->f_l_lg == NULL)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_prop_mode)\n"); goto fail;
+        XPLMDebugString(string);
+        return;
     }
-    if (NULL == (global_context->i_ngine_num = XPLMFindDataRef("sim/aircraft/engine/acf_num_engines")))
+    if (l->used + length >= sizeof(l->buffer) - XNZ_LOG_RESERVE)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_ngine_num)\n"); goto fail;
+        l->dropped++;
+        return;
     }
-    if (NULL == (global_context->i_ngine_typ = XPLMFindDataRef("sim/aircraft/prop/acf_en_type")))
+    memcpy(l->buffer + l->used, string, length + 1);
+    l->used += length;
+    if (l->scheduled == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_ngine_typ)\n"); goto fail;
+        XPLMSetFlightLoopCallbackInterval(l->f_l_lg, -1.0f, 1, NULL);
+        l->scheduled = 1;
     }
-    if (NULL == (global_context->rev_info[0] = XPLMFindDataRef("sim/aircraft/overflow/acf_has_beta")))
+}
+
+static void xnz_log_write(xnz_log_site *site, int level, const char *format, ...)
+{
+    static const char *tag[] = { "[debug]: ", "[info]: ", "[error]: ", };
+    uint64_t now = xnz_time_ns(); char string[1024]; int length; va_list ap;
+    if (site->window == 0 || now - site->window >= XNZ_LOG_WINDOW_NS)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[0])\n"); goto fail;
+        if (site->suppressed)
+        {
+            length = snprintf(string, sizeof(string), XNZ_LOG_PREFIX"%s(%u similar messages suppressed)\n", tag[level], site->suppressed);
+            xnz_log_append(string, length);
+        }
+        site->window = now;
+        site->suppressed = 0;
+        site->count = 0;
     }
-    if (NULL == (global_context->rev_info[1] = XPLMFindDataRef("sim/aircraft/prop/acf_revthrust_eq")))
+    if (site->count >= XNZ_LOG_BURST)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[1])\n"); goto fail;
+        site->suppressed++;
+        return;
     }
-    if (NULL == (global_context->rev_info[2] = XPLMFindDataRef("sim/aircraft/engine/acf_throtmax_REV")))
+    site->count++;
+    length = snprintf(string, sizeof(string), XNZ_LOG_PREFIX"%s", tag[level]);
+    va_start(ap, format);
+    int ret = vsnprintf(string + length, sizeof(string) - length, format, ap);
+    va_end(ap);
+    if (ret < 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[2])\n"); goto fail;
+        return;
     }
-    if (NULL == (global_context->betto[0] = XPLMFindCommand("sim/engines/beta_toggle_1")))
+    if ((size_t)(length += ret) >= sizeof(string)) // truncated
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[0])\n"); goto fail;
+        length = sizeof(string) - 1;
+        string[length - 1] = '\n';
     }
-    if (NULL == (global_context->betto[1] = XPLMFindCommand("sim/engines/beta_toggle_2")))
+    xnz_log_append(string, length);
+}
+
+static void xnz_log_flush(void)
+{
+    xnz_logger *l = &xnz_logger_state;
+    if (l->dropped)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[1])\n"); goto fail;
+        l->used += snprintf(l->buffer + l->used, sizeof(l->buffer) - l->used,
+                            XNZ_LOG_PREFIX"[error]: log buffer full, %u messages dropped\n", l->dropped);
+        l->dropped = 0;
     }
-    if (NULL == (global_context->betto[2] = XPLMFindCommand("sim/engines/beta_toggle_3")))
+    if (l->used)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[2])\n"); goto fail;
+        XPLMDebugString(l->buffer);
+        l->buffer[(l->used = 0)] = '\0';
     }
-    if (NULL == (global_context->betto[3] = XPLMFindCommand("sim/engines/beta_toggle_4")))
+}
+
+static float log_hdlr_fnc(float inElapsedSinceLastCall,
+                          float inElapsedTimeSinceLastFlightLoop,
+                          int   inCounter,
+                          void *inRefcon)
+{
+    uint64_t t = xnz_perf_enter(&global_context->cold->perf);
+    xnz_log_flush();
+    xnz_logger_state.scheduled = 0;
+    xnz_perf_leave(&global_context->cold->perf, XNZ_PERF_LOG, t);
+    return 0; // until next message
+}
+
+PLUGIN_API void XPluginStop(void)
+{
+    return;
+}
+
+static float XNZGetDataf(void *inRefcon) // XPLMGetDataf_f
+{
+    return ((float*)inRefcon)[0]; // https://developer.x-plane.com/sdk/XPLMRegisterDataAccessor/
+}
+
+static int XNZGetDatai(void *inRefcon) // XPLMGetDatai_f
+{
+    return ((int*)inRefcon)[0];
+}
+
+static void XNZSetLogLevel(void *inRefcon, int inValue) // XPLMSetDatai_f
+{
+    if (inValue >= XNZ_LOG_DEBUG && inValue <= XNZ_LOG_ERROR)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[3])\n"); goto fail;
+        ((int*)inRefcon)[0] = inValue;
     }
-    if (NULL == (global_context->betto[4] = XPLMFindCommand("sim/engines/beta_toggle_5")))
+}
+
+static int xnz_copy_vector(void *outValues, const void *inValues, int inCount, int inOffset, int inMax, size_t inSize)
+{
+    if (outValues == NULL)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[4])\n"); goto fail;
+        return inCount; // caller wants the array size
     }
-    if (NULL == (global_context->betto[5] = XPLMFindCommand("sim/engines/beta_toggle_6")))
+    if (inOffset < 0 || inOffset >= inCount || inMax <= 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[5])\n"); goto fail;
+        return 0;
     }
-    if (NULL == (global_context->betto[6] = XPLMFindCommand("sim/engines/beta_toggle_7")))
+    if (inMax > inCount - inOffset)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[6])\n"); goto fail;
+        inMax = inCount - inOffset;
     }
-    if (NULL == (global_context->betto[7] = XPLMFindCommand("sim/engines/beta_toggle_8")))
+    memcpy(outValues, (const char*)inValues + (inOffset * inSize), inMax * inSize);
+    return inMax;
+}
+
+static int XNZGetLeverInn(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    xnz_context *ctx = inRefcon;
+    return xnz_copy_vector(outValues, ctx->published.lever_inn, 2, inOffset, inMax, sizeof(float));
+}
+
+static int XNZGetLeverZon(void *inRefcon, int *outValues, int inOffset, int inMax) // XPLMGetDatavi_f
+{
+    xnz_context *ctx = inRefcon;
+    return xnz_copy_vector(outValues, ctx->published.lever_zone, 2, inOffset, inMax, sizeof(int));
+}
+
+static int XNZGetEnginOut(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    xnz_context *ctx = inRefcon;
+    return xnz_copy_vector(outValues, ctx->published.engine_out, ctx->arcrft_engine_count, inOffset, inMax, sizeof(float));
+}
+
+static int XNZGetTimings(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    xnz_timing *timing = inRefcon;
+    return xnz_copy_vector(outValues, timing->ms, XNZ_PHASE_COUNT, inOffset, inMax, sizeof(float));
+}
+
+static int xnz_perf_quantiles(const xnz_context *ctx, double q, float *outValues, int inOffset, int inMax)
+{
+    float us[XNZ_PERF_COUNT];
+    if (outValues)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[7])\n"); goto fail;
+        for (int i = 0; i < XNZ_PERF_COUNT; i++)
+        {
+            us[i] = (float)((double)xnz_hist_quantile(&ctx->cold->perf.task[i], q) / 1000.0);
+        }
     }
-    if (NULL == (global_context->betto[8] = XPLMFindCommand("sim/engines/beta_toggle")))
+    return xnz_copy_vector(outValues, us, XNZ_PERF_COUNT, inOffset, inMax, sizeof(float));
+}
+
+static int XNZGetPerfP50(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    return xnz_perf_quantiles(inRefcon, 0.50, outValues, inOffset, inMax);
+}
+
+static int XNZGetPerfP99(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    return xnz_perf_quantiles(inRefcon, 0.99, outValues, inOffset, inMax);
+}
+
+static int XNZGetPerfMax(void *inRefcon, float *outValues, int inOffset, int inMax) // XPLMGetDatavf_f
+{
+    return xnz_perf_quantiles(inRefcon, 1.00, outValues, inOffset, inMax);
+}
+
+/*
+ * Record the duration of a phase started at since; returns the current time.
+ */
+static inline uint64_t xnz_timing_mark(xnz_timing *timing, int phase, uint64_t since)
+{
+    uint64_t now = xnz_time_ns();
+    timing->ms[phase] = (float)((double)(now - since) / 1000000.0);
+    return now;
+}
+
+static void xnz_timing_log(const xnz_timing *timing, int first, int last)
+{
+    static const char *names[XNZ_PHASE_COUNT] =
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[9])\n"); goto fail;
-    }
-    if (NULL == (global_context->revto[0] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_1")))
+        "enable", "context", "datarefs", "accessors", "menu", "params",
+        "staged", "overlay", "refs", "commands", "accessors",
+        "aircraft", "engines", "plugins", "cache", "probe", "store", "profile", "axes",
+    };
+    char line[512]; size_t len = 0;
+    for (int i = first; i <= last && len < sizeof(line); i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[0])\n"); goto fail;
+        int ret = snprintf(line + len, sizeof(line) - len, "%s%s=%.3f", i == first ? "" : " ", names[i], timing->ms[i]);
+        if (ret < 0)
+        {
+            break;
+        }
+        len += ret;
     }
-    if (NULL == (global_context->revto[1] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_2")))
+    xnz_log(XNZ_LOG_INFO, "timing (ms): %s\n", line);
+}
+
+#define HS_TBM9_IDLE (0.35f)
+
+static float TCA_SYNCBAND = 0.075000f; // note: maximum L/R difference was measured slightly over 6%, but we allow for noisier hardware than mine
+static float TCA_DEADBAND = XNZ_DETENT_DEADBAND; // half of the above
+static float TCA_FLEX_CTR = 0.706744f; // print_ax
+static float TCA_CLMB_CTR = 0.520279f; // print_ax
+//atic float TCA_IDLE_CTR = 0.323819f; // not held
+static float TCA_IDLE_CTR = 0.311589f; // averaged
+//atic float TCA_IDLE_CTR = 0.299359f; // yes held
+
+static void update_thrust_zones(thrust_zones *info, float idle_ctr, float clmb_ctr, float flex_ctr)
+{
+    if (info)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[1])\n"); goto fail;
+        /*
+         * Re-compute zones based on the center of each hardware detent.
+         */
+        info->max[ZONE_TGA] = (                      1.0f - TCA_DEADBAND);
+        info->min[ZONE_TGA] = (                  flex_ctr + TCA_DEADBAND);
+        info->max[ZONE_FLX] = (                  flex_ctr - TCA_DEADBAND);
+        info->min[ZONE_FLX] = (                  clmb_ctr + TCA_DEADBAND);
+        info->max[ZONE_CLB] = (                  clmb_ctr - TCA_DEADBAND);
+        info->min[ZONE_CLB] = (                  idle_ctr + TCA_DEADBAND);
+        info->max[ZONE_REV] = (                  idle_ctr - TCA_DEADBAND);
+        info->min[ZONE_REV] = (                      0.0f + TCA_DEADBAND);
+        info->len[ZONE_TGA] = (info->max[ZONE_TGA] - info->min[ZONE_TGA]);
+        info->len[ZONE_FLX] = (info->max[ZONE_FLX] - info->min[ZONE_FLX]);
+        info->len[ZONE_CLB] = (info->max[ZONE_CLB] - info->min[ZONE_CLB]);
+        info->len[ZONE_REV] = (info->max[ZONE_REV] - info->min[ZONE_REV]);
     }
-    if (NULL == (global_context->revto[2] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_3")))
+}
+
+static void default_throt_share(thrust_zones *info)
+{
+    if (info)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[2])\n"); goto fail;
+        info->share[ZONE_CLB] = 0.500f;
+        info->share[ZONE_FLX] = 0.875f - info->share[ZONE_CLB];
+        info->share[ZONE_TGA] = 1.000f - info->share[ZONE_FLX] - info->share[ZONE_CLB];
     }
-    if (NULL == (global_context->revto[3] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_4")))
+}
+
+/*
+ * Build a parameter block from baseline zones and a profile (if any); takes
+ * ownership of the profile's mapping. No XPLM calls (used by the watcher).
+ */
+static xnz_params* xnz_params_create(const thrust_zones *base, int apply_shares, xnz_profile_map *map)
+{
+    xnz_params *params = calloc(1, sizeof(xnz_params));
+    if (params == NULL)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[3])\n"); goto fail;
+        xnz_profile_close(map);
+        return NULL;
     }
-    if (NULL == (global_context->revto[4] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_5")))
+    params->zones = *base;
+    if (map && map->profile)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[4])\n"); goto fail;
+        const xnz_profile *p = map->profile;
+        if (p->flags & XNZ_PROFILE_DETENTS)
+        {
+            update_thrust_zones(&params->zones, p->detent[0], p->detent[1], p->detent[2]);
+        }
+        if (p->flags & XNZ_PROFILE_SHARES && apply_shares)
+        {
+            params->zones.share[ZONE_CLB] = p->share[0];
+            params->zones.share[ZONE_FLX] = p->share[1] - params->zones.share[ZONE_CLB];
+            params->zones.share[ZONE_TGA] = p->share[2] - params->zones.share[ZONE_FLX] - params->zones.share[ZONE_CLB];
+        }
+        params->map = *map;
+        memset(map, 0, sizeof(*map));
     }
-    if (NULL == (global_context->revto[5] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_6")))
+#ifndef PUBLIC_RELEASE_BUILD
+    for (int i = 0; i < XNZ_SCHED_COUNT; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[5])\n"); goto fail;
+        const xnz_profile *p = params->map.profile;
+        const xnz_curve *c = &xnz_sched_info[i].curve;
+        if (p && (p->flags & xnz_sched_info[i].flag))
+        {
+            c = i == XNZ_SCHED_ROLL ? &p->roll : &p->nullzone[i - XNZ_SCHED_NZ_PR];
+        }
+        xnz_lut_bake(&params->sched[i], c);
     }
-    if (NULL == (global_context->revto[6] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_7")))
+#endif
+    return params;
+}
+
+static void xnz_params_destroy(xnz_params *params)
+{
+    if (params)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[6])\n"); goto fail;
+        xnz_profile_close(&params->map);
+        free(params);
     }
-    if (NULL == (global_context->revto[7] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_8")))
+}
+
+/*
+ * Main thread only: install a new block, return the previous one.
+ */
+static xnz_params* xnz_params_swap(xnz_context *ctx, xnz_params *params)
+{
+    xnz_params *previous = ctx->params;
+    ctx->params = params;
+    ctx->cold->commands.profile = params->map.profile;
+    return previous;
+}
+
+/*
+ * Called at the start of each flight loop callback: picks up a block
+ * published by the watcher (single atomic exchange, no locking), and
+ * reports the watcher's errors (rare, so the lock is acceptable there).
+ */
+static inline void xnz_params_acquire(xnz_context *ctx)
+{
+    if (xnz_atomic_load_ptr(&ctx->params_pending) != NULL)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[7])\n"); goto fail;
+        xnz_params *params = xnz_atomic_xchg_ptr(&ctx->params_pending, NULL);
+        if (params)
+        {
+            xnz_params_destroy(xnz_atomic_xchg_ptr(&ctx->cold->watch.retired, xnz_params_swap(ctx, params))); // NULL unless the watcher fell behind
+            xnz_log(XNZ_LOG_INFO, "profile reloaded (flags 0x%02x)\n", params->map.profile ? params->map.profile->flags : 0);
+        }
     }
-    if (NULL == (global_context->revto[8] = XPLMFindCommand("sim/engines/thrust_reverse_toggle")))
+    if (xnz_atomic_load_u32(&ctx->params_errors) != ctx->params_errors_seen)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[9])\n"); goto fail;
+        xnz_mutex_lock(&ctx->cold->watch.lock);
+        ctx->params_errors_seen = xnz_atomic_load_u32(&ctx->params_errors);
+        xnz_log(XNZ_LOG_ERROR, "profile %s\n", ctx->cold->watch.err);
+        xnz_mutex_unlock(&ctx->cold->watch.lock);
     }
-    XPLMRegisterFlightLoopCallback((global_context->f_l_th = &axes_hdlr_fnc), 0, global_context);
+}
 
 #ifndef PUBLIC_RELEASE_BUILD
-    /* TCA thrust quadrant support: buttons */
-    if (NULL == (global_context->commands.xp.at_at_on = XPLMFindCommand("sim/autopilot/autothrottle_on")))
+static inline float xnz_sched_eval(const xnz_context *ctx, int index, float speed)
+{
+    return xnz_lut_eval(&ctx->params->sched[index], speed);
+}
+
+/*
+ * Returns non-zero if value should be written (and records it as such).
+ */
+static inline int xnz_sched_update(xnz_context *ctx, int index, float value)
+{
+    if (fabsf(value - ctx->sched_out[index]) < xnz_sched_info[index].threshold)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/autothrottle_on)\n"); goto fail;
+        return 0;
     }
-    if (NULL == (global_context->commands.xp.at_at_no = XPLMFindCommand("sim/autopilot/autothrottle_off")))
+    ctx->sched_out[index] = value;
+    return 1;
+}
+
+/*
+ * The outputs were written behind the scheduler's back: rewrite on next tick.
+ */
+static void xnz_sched_invalidate(xnz_context *ctx)
+{
+    for (int i = 0; i < XNZ_SCHED_COUNT; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/autothrottle_off)\n"); goto fail;
+        ctx->sched_out[i] = -1.0f;
     }
-    if (NULL == (global_context->commands.xp.at_at_n1 = XPLMFindCommand("sim/autopilot/autothrottle_n1epr")))
+}
+#endif
+
+/*
+ * Profile watcher: polls the current aircraft's profile about once per
+ * second; on change, compiles and maps it, builds a new parameter block
+ * and publishes it to params_pending (one at a time). Frees retired blocks.
+ */
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL xnz_params_watcher(void *arg)
+{
+    xnz_context *ctx = arg; xnz_params_watch *w = &ctx->cold->watch;
+    for (uint32_t tick = 1; xnz_atomic_load_u32(&w->running); tick++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[info]: sim/autopilot/autothrottle_n1epr unavailable\n"); // new command (optional)
+        xnz_sleep_ms(250);
+        xnz_params_destroy(xnz_atomic_xchg_ptr(&w->retired, NULL));
+        if (tick % 4)
+        {
+            continue;
+        }
+        char dir[1024], name[41], src[sizeof(dir) + sizeof(name) + 4], err[1280];
+        thrust_zones zones; int apply_shares, ret; uint32_t generation;
+        int64_t size = -1, mtime = 0; struct stat st; xnz_profile_map map;
+        xnz_mutex_lock(&w->lock);
+        if (w->request.active == 0 || xnz_atomic_load_ptr(&ctx->params_pending) != NULL)
+        {
+            xnz_mutex_unlock(&w->lock);
+            continue;
+        }
+        memcpy(dir, w->request.dir, sizeof(dir));
+        memcpy(name, w->request.name, sizeof(name));
+        generation = w->request.generation;
+        apply_shares = w->request.apply_shares;
+        zones = w->request.zones;
+        xnz_mutex_unlock(&w->lock);
+
+        snprintf(src, sizeof(src), "%s%s.txt", dir, name);
+        if (stat(src, &st) == 0)
+        {
+            size = st.st_size;
+            mtime = st.st_mtime;
+        }
+        xnz_mutex_lock(&w->lock);
+        ret = size == w->request.size && mtime == w->request.mtime;
+        xnz_mutex_unlock(&w->lock);
+        if (ret)
+        {
+            continue;
+        }
+        xnz_params *params = NULL;
+        if ((ret = xnz_profile_open(&map, dir, name, err, sizeof(err))) >= 0 &&
+            (params = xnz_params_create(&zones, apply_shares, &map)) == NULL)
+        {
+            snprintf(err, sizeof(err), "%s: out of memory", src);
+        }
+        xnz_mutex_lock(&w->lock);
+        if (w->request.active && w->request.generation == generation)
+        {
+            w->request.size = size; // don't retry until the file changes again
+            w->request.mtime = mtime;
+            if (params)
+            {
+                xnz_atomic_store_ptr(&ctx->params_pending, params);
+                params = NULL;
+            }
+            else
+            {
+                memcpy(w->err, err, sizeof(w->err));
+                xnz_atomic_add_u32(&ctx->params_errors, 1);
+            }
+        }
+        xnz_mutex_unlock(&w->lock);
+        xnz_params_destroy(params); // aircraft changed in the meantime
     }
-    if (NULL == (global_context->commands.xp.ap_to_ga = XPLMFindCommand("sim/autopilot/take_off_go_around")))
+    xnz_params_destroy(xnz_atomic_xchg_ptr(&w->retired, NULL));
+    return 0;
+}
+
+static int xnz_params_watch_start(xnz_context *ctx)
+{
+    xnz_mutex_init(&ctx->cold->watch.lock);
+    xnz_atomic_store_u32(&ctx->cold->watch.running, 1);
+    if (xnz_thread_create(&ctx->cold->watch.thread, &xnz_params_watcher, ctx))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/take_off_go_around)\n"); goto fail;
+        xnz_atomic_store_u32(&ctx->cold->watch.running, 0);
+        xnz_mutex_destroy(&ctx->cold->watch.lock);
+        return -1;
     }
-    if (NULL == (global_context->commands.xp.ap_cw_st = XPLMFindCommand("sim/autopilot/control_wheel_steer")))
+    return 0;
+}
+
+static void xnz_params_watch_stop(xnz_context *ctx)
+{
+    if (xnz_atomic_load_u32(&ctx->cold->watch.running))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/control_wheel_steer)\n"); goto fail;
+        xnz_atomic_store_u32(&ctx->cold->watch.running, 0);
+        xnz_thread_join(ctx->cold->watch.thread);
+        xnz_mutex_destroy(&ctx->cold->watch.lock);
     }
-    if (NULL == (global_context->commands.xp.ap_fd_dn = XPLMFindCommand("sim/autopilot/fdir_servos_down_one")))
+    xnz_params_destroy(xnz_atomic_xchg_ptr(&ctx->params_pending, NULL));
+    xnz_params_destroy(xnz_atomic_xchg_ptr(&ctx->cold->watch.retired, NULL));
+}
+
+/*
+ * Main thread only: (re-)target the watcher; size and mtime are those of the
+ * source file as just loaded, so that only later changes trigger a reload.
+ */
+static void xnz_params_watch_set(xnz_context *ctx, const char *dir, const char *name, int apply_shares, const struct stat *st)
+{
+    xnz_params_watch *w = &ctx->cold->watch;
+    xnz_mutex_lock(&w->lock);
+    w->request.active = 1;
+    w->request.generation++;
+    snprintf(w->request.dir, sizeof(w->request.dir), "%s", dir);
+    snprintf(w->request.name, sizeof(w->request.name), "%s", name);
+    w->request.zones = ctx->cold->zones_base;
+    w->request.apply_shares = apply_shares;
+    w->request.size = st ? st->st_size : -1;
+    w->request.mtime = st ? st->st_mtime : 0;
+    xnz_mutex_unlock(&w->lock);
+}
+
+static void xnz_params_watch_clear(xnz_context *ctx)
+{
+    xnz_params_watch *w = &ctx->cold->watch; xnz_params *pending;
+    xnz_mutex_lock(&w->lock);
+    w->request.active = 0;
+    w->request.generation++;
+    pending = xnz_atomic_xchg_ptr(&ctx->params_pending, NULL);
+    xnz_mutex_unlock(&w->lock);
+    xnz_params_destroy(pending);
+}
+
+#ifndef PUBLIC_RELEASE_BUILD
+/*
+ * Staged initialization tables (see xnz_init_state): sim references used by the TCA button
+ * handlers, and the commands (with their handlers) we create; both also name the journal's
+ * downstream targets and commands (see XNZjournal.h).
+ */
+typedef struct
+{
+    size_t offset; // XPLMCommandRef or XPLMDataRef in xnz_cmd_context
+    const char *name;
+    int is_dataref;
+    int optional;
+}
+xnz_init_ref;
+
+typedef struct
+{
+    size_t offset; // XPLMCommandRef in xnz_cmd_context
+    const char *name;
+    const char *desc;
+    XPLMCommandCallback_f handler; // called via chandler_journal
+    int family; // XNZ_JOURNAL_FAMILY_*: backend selector journaled with each phase
+}
+xnz_init_cmd;
+
+static const xnz_init_ref xnz_init_refs[] =
+{
+    { offsetof(xnz_cmd_context, xp.at_at_on),    "sim/autopilot/autothrottle_on",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.at_at_no),    "sim/autopilot/autothrottle_off",                  0, 0, },
+    { offsetof(xnz_cmd_context, xp.at_at_n1),    "sim/autopilot/autothrottle_n1epr",                0, 1, },
+    { offsetof(xnz_cmd_context, xp.ap_to_ga),    "sim/autopilot/take_off_go_around",                0, 0, },
+    { offsetof(xnz_cmd_context, xp.ap_cw_st),    "sim/autopilot/control_wheel_steer",               0, 0, },
+    { offsetof(xnz_cmd_context, xp.ap_fd_dn),    "sim/autopilot/fdir_servos_down_one",              0, 0, },
+    { offsetof(xnz_cmd_context, xp.ap_ap_on),    "sim/autopilot/servos_on",                         0, 0, },
+    { offsetof(xnz_cmd_context, xp.ap_yd_no),    "sim/systems/yaw_damper_off",                      0, 0, },
+    { offsetof(xnz_cmd_context, xp.ap_yd_on),    "sim/systems/yaw_damper_on",                       0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_start1),    "sim/starters/engage_starter_1",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_start2),    "sim/starters/engage_starter_2",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_start3),    "sim/starters/engage_starter_3",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_start4),    "sim/starters/engage_starter_4",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mboth1),    "sim/magnetos/magnetos_both_1",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mboth2),    "sim/magnetos/magnetos_both_2",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mboth3),    "sim/magnetos/magnetos_both_3",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mboth4),    "sim/magnetos/magnetos_both_4",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_lft1),    "sim/magnetos/magnetos_left_1",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_lft2),    "sim/magnetos/magnetos_left_2",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_lft3),    "sim/magnetos/magnetos_left_3",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_lft4),    "sim/magnetos/magnetos_left_4",                    0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_rgt1),    "sim/magnetos/magnetos_right_1",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_rgt2),    "sim/magnetos/magnetos_right_2",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_rgt3),    "sim/magnetos/magnetos_right_3",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_m_rgt4),    "sim/magnetos/magnetos_right_4",                   0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mstop1),    "sim/magnetos/magnetos_off_1",                     0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mstop2),    "sim/magnetos/magnetos_off_2",                     0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mstop3),    "sim/magnetos/magnetos_off_3",                     0, 0, },
+    { offsetof(xnz_cmd_context, xp.p_mstop4),    "sim/magnetos/magnetos_off_4",                     0, 0, },
+    { offsetof(xnz_cmd_context, xp.ld_gr_up),    "sim/flight_controls/landing_gear_up",             0, 0, },
+    { offsetof(xnz_cmd_context, xp.ld_gr_dn),    "sim/flight_controls/landing_gear_down",           0, 0, },
+    { offsetof(xnz_cmd_context, xp.auto_pil_on), "sim/cockpit2/autopilot/servos_on",                1, 0, },
+    { offsetof(xnz_cmd_context, xp.auto_vvi_on), "sim/cockpit2/autopilot/vvi_status",               1, 0, },
+    { offsetof(xnz_cmd_context, xp.auto_thr_on), "sim/cockpit2/autopilot/autothrottle_on",          1, 0, },
+    { offsetof(xnz_cmd_context, xp.eng_running), "sim/flightmodel/engine/ENGN_running",             1, 0, },
+    { offsetof(xnz_cmd_context, xp.igniters_on), "sim/cockpit2/engine/actuators/igniter_on",        1, 0, },
+    { offsetof(xnz_cmd_context, xp.auto_ignite), "sim/cockpit2/engine/actuators/auto_ignite_on",    1, 0, },
+    { offsetof(xnz_cmd_context, xp.groundspeed), "sim/flightmodel/position/groundspeed",            1, 0, },
+    { offsetof(xnz_cmd_context, xp.ongroundany), "sim/flightmodel/failures/onground_any",           1, 0, },
+    { offsetof(xnz_cmd_context, xp.l_rgb_ratio), "sim/cockpit2/controls/left_brake_ratio",          1, 0, },
+    { offsetof(xnz_cmd_context, xp.r_rgb_ratio), "sim/cockpit2/controls/right_brake_ratio",         1, 0, },
+    { offsetof(xnz_cmd_context, xp.pbrak_ratio), "sim/cockpit2/controls/parking_brake_ratio",       1, 0, },
+    { offsetof(xnz_cmd_context, xp.gear_handle), "sim/cockpit2/controls/gear_handle_down",          1, 0, },
+    { offsetof(xnz_cmd_context, xp.mixture_all), "sim/cockpit2/engine/actuators/mixture_ratio_all", 1, 0, },
+    { offsetof(xnz_cmd_context, xp.sim_paused),  "sim/time/paused",                                 1, 0, },
+    { offsetof(xnz_cmd_context, xp.sim_speedup), "sim/time/sim_speed_actual",                       1, 1, },
+};
+
+static const xnz_init_cmd xnz_init_cmds[] =
+{
+    { offsetof(xnz_cmd_context, cmd_ldg_upp), "xnz/landing/gear/up",         "landing gear up",                         &chandler_ldg_upp, XNZ_JOURNAL_FAMILY_NONE, },
+    { offsetof(xnz_cmd_context, cmd_ldg_dwn), "xnz/landing/gear/down",       "landing gear down",                       &chandler_ldg_dwn, XNZ_JOURNAL_FAMILY_NONE, },
+    { offsetof(xnz_cmd_context, cmd_ldg_tog), "xnz/landing/gear/toggle",     "landing gear toggle",                     &chandler_ldg_tog, XNZ_JOURNAL_FAMILY_NONE, },
+    { offsetof(xnz_cmd_context, cmd_rgb_pkb), "xnz/brakes/regular/park",     "hold brakes regular + set parking brake", &chandler_rgb_pkb, XNZ_JOURNAL_FAMILY_BT, },
+    { offsetof(xnz_cmd_context, cmd_rgb_hld), "xnz/brakes/regular/hold",     "hold brakes regular",                     &chandler_rgb_hld, XNZ_JOURNAL_FAMILY_BT, },
+    { offsetof(xnz_cmd_context, cmd_pkb_tog), "xnz/brakes/park/toggle",      "parking brake toggle",                    &chandler_pkb_tog, XNZ_JOURNAL_FAMILY_PB, },
+    { offsetof(xnz_cmd_context, cmd_pkb_onh), "xnz/brakes/park/on/hold",     "parking brake hold",                      &chandler_pkb_onh, XNZ_JOURNAL_FAMILY_PB, },
+    { offsetof(xnz_cmd_context, cmd_pkb_onn), "xnz/brakes/park/on/set",      "parking brake set",                       &chandler_pkb_onn, XNZ_JOURNAL_FAMILY_PB, },
+    { offsetof(xnz_cmd_context, cmd_pkb_off), "xnz/brakes/park/unset",       "parking brake release",                   &chandler_pkb_off, XNZ_JOURNAL_FAMILY_PB, },
+    { offsetof(xnz_cmd_context, cmd_a_p_onn), "xnz/auto/pilot/pu/sh",        "autopilot engage servos",                 &chandler_a_p_onn, XNZ_JOURNAL_FAMILY_AP, },
+    { offsetof(xnz_cmd_context, cmd_a_p_off), "xnz/auto/pilot/di/sc",        "autopilot disconnect servos",             &chandler_a_p_off, XNZ_JOURNAL_FAMILY_AP, },
+    { offsetof(xnz_cmd_context, cmd_at_toga), "xnz/auto/thrust/to/ga",       "A/T takeoff/go-around",                   &chandler_at_toga, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_at_disc), "xnz/auto/thrust/di/sc",       "A/T disconnect",                          &chandler_at_disc, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_a_12_lt), "xnz/tca/12/at/disc/lt",       "TCA 1&2: lt A/T disconnect",              &chandler_a_12_lt, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_a_12_rt), "xnz/tca/12/at/disc/rt",       "TCA 1&2: rt A/T disconnect",              &chandler_a_12_rt, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_x_12_lt), "xnz/tca/12/extra/lt",         "TCA 1&2: lt extra button",                &chandler_x_12_lt, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_x_12_rt), "xnz/tca/12/extra/rt",         "TCA 1&2: rt extra button",                &chandler_x_12_rt, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_a_34_lt), "xnz/tca/34/at/disc/lt",       "TCA 3&4: lt A/T disconnect",              &chandler_a_34_lt, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_a_34_rt), "xnz/tca/34/at/disc/rt",       "TCA 3&4: rt A/T disconnect",              &chandler_a_34_rt, XNZ_JOURNAL_FAMILY_AT, },
+    { offsetof(xnz_cmd_context, cmd_x_34_lt), "xnz/tca/34/extra/lt",         "TCA 3&4: lt extra button",                &chandler_x_34_lt, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_x_34_rt), "xnz/tca/34/extra/rt",         "TCA 3&4: rt extra button",                &chandler_x_34_rt, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_12_ch), "xnz/tca/12/modes/crank/hold", "TCA 1&2: crank mode hold",                &chandler_m_12_ch, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_12_cr), "xnz/tca/12/modes/crank",      "TCA 1&2: crank mode set",                 &chandler_m_12_cr, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_12_no), "xnz/tca/12/modes/norm",       "TCA 1&2: norm mode set",                  &chandler_m_12_no, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_12_st), "xnz/tca/12/modes/start",      "TCA 1&2: start mode set",                 &chandler_m_12_st, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_12_sh), "xnz/tca/12/modes/start/hold", "TCA 1&2: start mode hold",                &chandler_m_12_sh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_34_ch), "xnz/tca/34/modes/crank/hold", "TCA 3&4: crank mode hold",                &chandler_m_34_ch, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_34_cr), "xnz/tca/34/modes/crank",      "TCA 3&4: crank mode set",                 &chandler_m_34_cr, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_34_no), "xnz/tca/34/modes/norm",       "TCA 3&4: norm mode set",                  &chandler_m_34_no, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_34_st), "xnz/tca/34/modes/start",      "TCA 3&4: start mode set",                 &chandler_m_34_st, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_m_34_sh), "xnz/tca/34/modes/start/hold", "TCA 3&4: start mode hold",                &chandler_m_34_sh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_1_onh), "xnz/tca/engines/1/on/hold",   "TCA: engine 1 ON hold",                   &chandler_e_1_onh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_1_onn), "xnz/tca/engines/1/on",        "TCA: engine 1 to ON",                     &chandler_e_1_onn, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_1_off), "xnz/tca/engines/1/off",       "TCA: engine 1 to OFF",                    &chandler_e_1_off, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_2_onh), "xnz/tca/engines/2/on/hold",   "TCA: engine 2 ON hold",                   &chandler_e_2_onh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_2_onn), "xnz/tca/engines/2/on",        "TCA: engine 2 to ON",                     &chandler_e_2_onn, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_2_off), "xnz/tca/engines/2/off",       "TCA: engine 2 to OFF",                    &chandler_e_2_off, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_3_onh), "xnz/tca/engines/3/on/hold",   "TCA: engine 3 ON hold",                   &chandler_e_3_onh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_3_onn), "xnz/tca/engines/3/on",        "TCA: engine 3 to ON",                     &chandler_e_3_onn, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_3_off), "xnz/tca/engines/3/off",       "TCA: engine 3 to OFF",                    &chandler_e_3_off, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_4_onh), "xnz/tca/engines/4/on/hold",   "TCA: engine 4 ON hold",                   &chandler_e_4_onh, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_4_onn), "xnz/tca/engines/4/on",        "TCA: engine 4 to ON",                     &chandler_e_4_onn, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_e_4_off), "xnz/tca/engines/4/off",       "TCA: engine 4 to OFF",                    &chandler_e_4_off, XNZ_JOURNAL_FAMILY_ET, },
+    { offsetof(xnz_cmd_context, cmd_jrn_dmp), "xnz/debug/journal/dump",      "dump the command journal",                &chandler_jrn_dmp, XNZ_JOURNAL_FAMILY_NONE, },
+};
+
+/*
+ * Overlay window (see xnz_overlay): drawn by X-Plane while visible, updated
+ * from the flight loop callback via overlay_text/overlay_show/overlay_hide.
+ */
+#define XNZ_OVERLAY_W 64
+#define XNZ_OVERLAY_H 56
+
+static void overlay_draw(XPLMWindowID inWindowID, void *inRefcon)
+{
+    xnz_overlay *o = inRefcon;
+    static float color[3] = { 1.0f, 1.0f, 1.0f, };
+    XPLMDrawTranslucentDarkBox(o->box[0], o->box[1], o->box[2], o->box[3]);
+    XPLMDrawString(color, o->text_xy[0], o->text_xy[1], o->text, NULL, xplmFont_Proportional);
+}
+
+static int overlay_click(XPLMWindowID inWindowID, int x, int y, XPLMMouseStatus inMouse, void *inRefcon)
+{
+    return 0; // pass through
+}
+
+static void overlay_key(XPLMWindowID inWindowID, char inKey, XPLMKeyFlags inFlags, char inVirtualKey, void *inRefcon, int losingFocus)
+{
+    return;
+}
+
+static XPLMCursorStatus overlay_cursor(XPLMWindowID inWindowID, int x, int y, void *inRefcon)
+{
+    return xplm_CursorDefault;
+}
+
+static int overlay_wheel(XPLMWindowID inWindowID, int x, int y, int wheel, int clicks, void *inRefcon)
+{
+    return 0;
+}
+
+static void overlay_layout_text(xnz_overlay *o)
+{
+    int width = (int)XPLMMeasureString(xplmFont_Proportional, o->text, (int)strlen(o->text));
+    o->text_xy[0] = o->box[0] + (XNZ_OVERLAY_W - width) / 2;
+    o->text_xy[1] = o->box[3] + (XNZ_OVERLAY_H - o->font_height) / 2;
+}
+
+/*
+ * Position for a laptop display, below e.g. an Aerobask GTN 750 (~788px high):
+ * ((1120 - 788 = 332) / 1220) = (83 / 280) of the screen height from the top.
+ */
+static void overlay_layout(xnz_overlay *o, int outW, int outH)
+{
+    o->screen[0] = outW;
+    o->screen[1] = outH;
+    o->box[0] = (outW - XNZ_OVERLAY_W) / 2;
+    o->box[3] = (outH - ((outH * 83) / 280));
+    o->box[2] = o->box[0] + XNZ_OVERLAY_W;
+    o->box[1] = o->box[3] + XNZ_OVERLAY_H;
+    XPLMSetWindowGeometry(o->window, o->box[0], o->box[1], o->box[2], o->box[3]);
+    overlay_layout_text(o);
+    xnz_log(XNZ_LOG_INFO, "overlay: W: %d | H: %d | X: %d -> %d | Y: %d -> %d\n", outW, outH, o->box[0], o->box[2], o->box[3], o->box[1]);
+}
+
+static void overlay_text(xnz_context *ctx, int kind, float value)
+{
+    xnz_overlay *o = &ctx->cold->overlay; int key;
+    switch (kind)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/fdir_servos_down_one)\n"); goto fail;
+        case XNZ_OVERLAY_PERCENT:
+            key = (int)lroundf(value * 100.0f);
+            break;
+        case XNZ_OVERLAY_RATIO_4:
+            key = (int)lroundf(value * 10000.0f);
+            break;
+        case XNZ_OVERLAY_RATIO_5:
+            key = (int)lroundf(value * 100000.0f);
+            break;
+        case XNZ_OVERLAY_GRDSPD:
+            key = (int)lroundf(value);
+            break;
+        default:
+            key = 0;
+            break;
     }
-    if (NULL == (global_context->commands.xp.ap_ap_on = XPLMFindCommand("sim/autopilot/servos_on")))
+    if (o->kind == kind && o->key == key)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/autopilot/servos_on)\n"); goto fail;
+        return;
     }
-    if (NULL == (global_context->commands.xp.ap_yd_no = XPLMFindCommand("sim/systems/yaw_damper_off")))
+    switch ((o->kind = kind))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/systems/yaw_damper_off)\n"); goto fail;
+        case XNZ_OVERLAY_ICE:
+            snprintf(o->text, sizeof(o->text), "ICE");
+            break;
+        case XNZ_OVERLAY_PERCENT:
+            snprintf(o->text, sizeof(o->text), "%4d %%", key);
+            break;
+        case XNZ_OVERLAY_RATIO_4:
+            snprintf(o->text, sizeof(o->text), "%7.4f", (double)key / 10000.0);
+            break;
+        case XNZ_OVERLAY_RATIO_5:
+            snprintf(o->text, sizeof(o->text), "%7.5f", (double)key / 100000.0);
+            break;
+        case XNZ_OVERLAY_GRDSPD:
+            snprintf(o->text, sizeof(o->text), "%2d kts", key);
+            break;
+        default:
+            o->text[0] = '\0';
+            break;
     }
-    if (NULL == (global_context->commands.xp.ap_yd_on = XPLMFindCommand("sim/systems/yaw_damper_on")))
+    o->key = key;
+    overlay_layout_text(o);
+}
+
+static void overlay_show(xnz_context *ctx)
+{
+    xnz_overlay *o = &ctx->cold->overlay; int outW, outH;
+    XPLMGetScreenSize(&outW, &outH);
+    if (o->screen[0] != outW || o->screen[1] != outH)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/systems/yaw_damper_on)\n"); goto fail;
+        uint64_t t = xnz_perf_enter(&ctx->cold->perf);
+        overlay_layout(o, outW, outH);
+        xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_OVERLAY, t);
     }
-    if (NULL == (global_context->commands.xp.p_start1 = XPLMFindCommand("sim/starters/engage_starter_1")))
+    if (o->visible == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/starters/engage_starter_1)\n"); goto fail;
+        XPLMSetWindowIsVisible(o->window, (o->visible = 1));
     }
-    if (NULL == (global_context->commands.xp.p_start2 = XPLMFindCommand("sim/starters/engage_starter_2")))
+}
+
+static void overlay_hide(xnz_context *ctx)
+{
+    xnz_overlay *o = &ctx->cold->overlay;
+    if (o->visible)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/starters/engage_starter_2)\n"); goto fail;
+        XPLMSetWindowIsVisible(o->window, (o->visible = 0));
     }
-    if (NULL == (global_context->commands.xp.p_start3 = XPLMFindCommand("sim/starters/engage_starter_3")))
+}
+
+static int xnz_init_overlay(xnz_context *ctx)
+{
+    if (NULL == (ctx->cold->print_ax = XPLMCreateCommand("xnz/print/axes/average", "")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/starters/engage_starter_3)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (print_ax)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_start4 = XPLMFindCommand("sim/starters/engage_starter_4")))
+    else
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/starters/engage_starter_4)\n"); goto fail;
+        XPLMRegisterCommandHandler(ctx->cold->print_ax, &chandler_printax, 0, ctx);
     }
-    if (NULL == (global_context->commands.xp.p_mboth1 = XPLMFindCommand("sim/magnetos/magnetos_both_1")))
+    if (NULL == (ctx->nullzone[0] = XPLMFindDataRef("sim/joystick/joystick_pitch_nullzone")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_both_1)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (nullzone[0])\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_mboth2 = XPLMFindCommand("sim/magnetos/magnetos_both_2")))
+    if (NULL == (ctx->nullzone[1] = XPLMFindDataRef("sim/joystick/joystick_roll_nullzone")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_both_2)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (nullzone[1])\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_mboth3 = XPLMFindCommand("sim/magnetos/magnetos_both_3")))
+    if (NULL == (ctx->nullzone[2] = XPLMFindDataRef("sim/joystick/joystick_heading_nullzone")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_both_3)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (nullzone[2])\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_mboth4 = XPLMFindCommand("sim/magnetos/magnetos_both_4")))
+    if (NULL == (ctx->f_grd_speed = XPLMFindDataRef("sim/flightmodel/position/groundspeed")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_both_4)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (f_grd_speed)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_lft1 = XPLMFindCommand("sim/magnetos/magnetos_left_1")))
+    if (NULL == (ctx->f_air_speed = XPLMFindDataRef("sim/flightmodel/position/indicated_airspeed")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_left_1)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (f_air_speed)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_lft2 = XPLMFindCommand("sim/magnetos/magnetos_left_2")))
+    if (NULL == (ctx->acf_roll_co = XPLMFindDataRef("sim/aircraft/overflow/acf_roll_co")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_left_2)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (acf_roll_co)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_lft3 = XPLMFindCommand("sim/magnetos/magnetos_left_3")))
+    if (NULL == (ctx->ongroundany = XPLMFindDataRef("sim/flightmodel/failures/onground_any")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_left_3)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (ongroundany)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_lft4 = XPLMFindCommand("sim/magnetos/magnetos_left_4")))
+    if (NULL == (ctx->cold->f_ice_rf[0] = XPLMFindDataRef("sim/flightmodel/failures/pitot_ice")) ||
+        NULL == (ctx->cold->f_ice_rf[1] = XPLMFindDataRef("sim/flightmodel/failures/inlet_ice")) ||
+        NULL == (ctx->cold->f_ice_rf[2] = XPLMFindDataRef("sim/flightmodel/failures/prop_ice")) ||
+        NULL == (ctx->cold->f_ice_rf[3] = XPLMFindDataRef("sim/flightmodel/failures/frm_ice")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_left_4)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (f_ice_rf)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_rgt1 = XPLMFindCommand("sim/magnetos/magnetos_right_1")))
+    XPLMCreateWindow_t window =
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_right_1)\n"); goto fail;
-    }
-    if (NULL == (global_context->commands.xp.p_m_rgt2 = XPLMFindCommand("sim/magnetos/magnetos_right_2")))
+        .structSize = sizeof(window),
+        .left = 0, .top = XNZ_OVERLAY_H, .right = XNZ_OVERLAY_W, .bottom = 0,
+        .visible = 0,
+        .drawWindowFunc = &overlay_draw,
+        .handleMouseClickFunc = &overlay_click,
+        .handleKeyFunc = &overlay_key,
+        .handleCursorFunc = &overlay_cursor,
+        .handleMouseWheelFunc = &overlay_wheel,
+        .refcon = &ctx->cold->overlay,
+    };
+    memset(&ctx->cold->overlay, 0, sizeof(ctx->cold->overlay)); // X-Plane window's actual boundaries not yet available/reliable
+    if (NULL == (ctx->cold->overlay.window = XPLMCreateWindowEx(&window)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_right_2)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (overlay)\n"); return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_rgt3 = XPLMFindCommand("sim/magnetos/magnetos_right_3")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_right_3)\n"); goto fail;
+    XPLMGetFontDimensions(xplmFont_Proportional, NULL, &ctx->cold->overlay.font_height, NULL);
+
+    /* flight loop callback */
+    XPLMRegisterFlightLoopCallback((ctx->cold->f_l_cb = &callback_hdlr), 0, ctx);
+    return 0;
+}
+#endif
+
+static int xnz_init_accessor(xnz_context *ctx, int index)
+{
+    switch (index)
+    {
+        case 0:
+            if (NULL == (ctx->cold->f_lever_inn = XPLMRegisterDataAccessor("xnz/throttle/lever/inn",
+                                                                           xplmType_FloatArray, 0,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &XNZGetLeverInn, NULL,
+                                                                           NULL, NULL,
+                                                                           ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 1:
+            if (NULL == (ctx->cold->i_lever_zon = XPLMRegisterDataAccessor("xnz/throttle/lever/zone",
+                                                                           xplmType_IntArray, 0,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &XNZGetLeverZon, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 2:
+            if (NULL == (ctx->cold->f_engin_out = XPLMRegisterDataAccessor("xnz/throttle/engine/out",
+                                                                           xplmType_FloatArray, 0,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &XNZGetEnginOut, NULL,
+                                                                           NULL, NULL,
+                                                                           ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 3:
+            if (NULL == (ctx->cold->i_pipe_stat = XPLMRegisterDataAccessor("xnz/throttle/state",
+                                                                           xplmType_Int, 0,
+                                                                           &XNZGetDatai, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &ctx->published.pipeline_st, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 4:
+            if (NULL == (ctx->cold->i_publi_gen = XPLMRegisterDataAccessor("xnz/throttle/generation",
+                                                                           xplmType_Int, 0,
+                                                                           &XNZGetDatai, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &ctx->published_gen, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 5:
+            if (NULL == (ctx->cold->i_log_level = XPLMRegisterDataAccessor("xnz/log/level",
+                                                                           xplmType_Int, 1,
+                                                                           &XNZGetDatai, &XNZSetLogLevel,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           NULL, NULL,
+                                                                           &xnz_logger_state.level, &xnz_logger_state.level)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 6:
+            if (NULL == (ctx->cold->perf.f_p50_us = XPLMRegisterDataAccessor("xnz/perf/p50_us",
+                                                                             xplmType_FloatArray, 0,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             &XNZGetPerfP50, NULL,
+                                                                             NULL, NULL,
+                                                                             ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 7:
+            if (NULL == (ctx->cold->perf.f_p99_us = XPLMRegisterDataAccessor("xnz/perf/p99_us",
+                                                                             xplmType_FloatArray, 0,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             &XNZGetPerfP99, NULL,
+                                                                             NULL, NULL,
+                                                                             ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        case 8:
+            if (NULL == (ctx->cold->perf.f_max_us = XPLMRegisterDataAccessor("xnz/perf/max_us",
+                                                                             xplmType_FloatArray, 0,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             NULL, NULL,
+                                                                             &XNZGetPerfMax, NULL,
+                                                                             NULL, NULL,
+                                                                             ctx, NULL)))
+            {
+                XPLMDebugString(XNZ_LOG_PREFIX"[error]: staged init failed (XPLMRegisterDataAccessor)\n"); return -1;
+            }
+            return 0;
+
+        default:
+            return -1;
     }
-    if (NULL == (global_context->commands.xp.p_m_rgt4 = XPLMFindCommand("sim/magnetos/magnetos_right_4")))
+}
+
+static int xnz_init_count(int stage)
+{
+    switch (stage)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_right_4)\n"); goto fail;
+#ifndef PUBLIC_RELEASE_BUILD
+        case XNZ_INIT_OVERLAY:
+            return 1;
+
+        case XNZ_INIT_REFS:
+            return sizeof(xnz_init_refs) / sizeof(xnz_init_refs[0]);
+
+        case XNZ_INIT_COMMANDS:
+            return sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]);
+#endif
+
+        case XNZ_INIT_ACCESSOR:
+            return XNZ_INIT_ACCESSORS;
+
+        default:
+            return 0;
     }
-    if (NULL == (global_context->commands.xp.p_mstop1 = XPLMFindCommand("sim/magnetos/magnetos_off_1")))
+}
+
+static int xnz_init_step(xnz_context *ctx, int stage, int index)
+{
+    switch (stage)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_off_1)\n"); goto fail;
+#ifndef PUBLIC_RELEASE_BUILD
+        case XNZ_INIT_OVERLAY:
+            return xnz_init_overlay(ctx);
+
+        case XNZ_INIT_REFS:
+        {
+            const xnz_init_ref *r = &xnz_init_refs[index];
+            XPLMDataRef *ref = (XPLMDataRef*)((char*)&ctx->cold->commands + r->offset); // XPLMCommandRef too
+            if (NULL == (*ref = r->is_dataref ? XPLMFindDataRef(r->name) : XPLMFindCommand(r->name)))
+            {
+                if (r->optional)
+                {
+                    xnz_log(XNZ_LOG_INFO, "%s unavailable\n", r->name);
+                    return 0;
+                }
+                xnz_log(XNZ_LOG_ERROR, "%s failed (%s)\n", r->is_dataref ? "XPLMFindDataRef" : "XPLMFindCommand", r->name);
+                return -1;
+            }
+            return 0;
+        }
+
+        case XNZ_INIT_COMMANDS:
+        {
+            const xnz_init_cmd *c = &xnz_init_cmds[index];
+            XPLMCommandRef *cmd = (XPLMCommandRef*)((char*)&ctx->cold->commands + c->offset);
+            if (NULL == (*cmd = XPLMCreateCommand(c->name, c->desc)))
+            {
+                xnz_log(XNZ_LOG_ERROR, "XPLMCreateCommand failed (%s)\n", c->name);
+                return -1;
+            }
+            if (index >= XNZ_JOURNAL_COMMANDS)
+            {
+                xnz_log(XNZ_LOG_ERROR, "too many commands for the journal (%s)\n", c->name);
+                return -1;
+            }
+            XPLMRegisterCommandHandler(*cmd, &chandler_journal, 0, (void*)(uintptr_t)index);
+            return 0;
+        }
+#endif
+
+        case XNZ_INIT_ACCESSOR:
+            return xnz_init_accessor(ctx, index);
+
+        default:
+            return -1;
     }
-    if (NULL == (global_context->commands.xp.p_mstop2 = XPLMFindCommand("sim/magnetos/magnetos_off_2")))
+}
+
+/*
+ * Undo everything the staged initialization did so far (on failure, or when
+ * disabling the plugin); references resolved so far are harmless and kept.
+ */
+static void xnz_init_release(xnz_context *ctx)
+{
+#ifndef PUBLIC_RELEASE_BUILD
+    if (ctx->cold->f_l_cb)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_off_2)\n"); goto fail;
+        XPLMUnregisterFlightLoopCallback(ctx->cold->f_l_cb, ctx);
+        ctx->cold->f_l_cb = NULL;
     }
-    if (NULL == (global_context->commands.xp.p_mstop3 = XPLMFindCommand("sim/magnetos/magnetos_off_3")))
+    if (ctx->cold->overlay.window)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_off_3)\n"); goto fail;
+        XPLMDestroyWindow(ctx->cold->overlay.window);
+        memset(&ctx->cold->overlay, 0, sizeof(ctx->cold->overlay));
     }
-    if (NULL == (global_context->commands.xp.p_mstop4 = XPLMFindCommand("sim/magnetos/magnetos_off_4")))
+    if (ctx->cold->print_ax)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/magnetos/magnetos_off_4)\n"); goto fail;
+        XPLMUnregisterCommandHandler(ctx->cold->print_ax, &chandler_printax, 0, ctx);
+        ctx->cold->print_ax = NULL;
     }
-    if (NULL == (global_context->commands.xp.ld_gr_up = XPLMFindCommand("sim/flight_controls/landing_gear_up")))
+    for (size_t i = 0; i < sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]); i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/flight_controls/landing_gear_up)\n"); goto fail;
+        XPLMCommandRef *cmd = (XPLMCommandRef*)((char*)&ctx->cold->commands + xnz_init_cmds[i].offset);
+        if (*cmd)
+        {
+            XPLMUnregisterCommandHandler(*cmd, &chandler_journal, 0, (void*)(uintptr_t)i);
+            *cmd = NULL;
+        }
     }
-    if (NULL == (global_context->commands.xp.ld_gr_dn = XPLMFindCommand("sim/flight_controls/landing_gear_down")))
-    {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindCommand failed (sim/flight_controls/landing_gear_down)\n"); goto fail;
+#endif
+    XPLMDataRef *accessors[XNZ_INIT_ACCESSORS] =
+    {
+        &ctx->cold->f_lever_inn,
+        &ctx->cold->i_lever_zon,
+        &ctx->cold->f_engin_out,
+        &ctx->cold->i_pipe_stat,
+        &ctx->cold->i_publi_gen,
+        &ctx->cold->i_log_level,
+        &ctx->cold->perf.f_p50_us,
+        &ctx->cold->perf.f_p99_us,
+        &ctx->cold->perf.f_max_us,
+    };
+    for (int i = 0; i < XNZ_INIT_ACCESSORS; i++)
+    {
+        if (*accessors[i])
+        {
+            XPLMUnregisterDataAccessor(*accessors[i]);
+            *accessors[i] = NULL;
+        }
     }
-    if (NULL == (global_context->commands.xp.auto_pil_on = XPLMFindDataRef("sim/cockpit2/autopilot/servos_on")))
+}
+
+/*
+ * Run initialization items until all done or budget (nanoseconds) exhausted,
+ * at least one item per call; returns non-zero while work remains.
+ */
+static int xnz_init_run(xnz_context *ctx, uint64_t budget)
+{
+    xnz_init_state *init = &ctx->cold->init;
+    xnz_timing *timing = &ctx->cold->timing;
+    if (init->stage >= XNZ_INIT_DONE)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/autopilot/servos_on)\n"); goto fail;
+        return 0;
     }
-    if (NULL == (global_context->commands.xp.auto_vvi_on = XPLMFindDataRef("sim/cockpit2/autopilot/vvi_status")))
+    uint64_t t0 = xnz_time_ns(), t = t0;
+    while (1)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/autopilot/vvi_status)\n"); goto fail;
+        while (init->stage < XNZ_INIT_DONE && init->index >= xnz_init_count(init->stage))
+        {
+            init->stage++;
+            init->index = 0;
+        }
+        if (init->stage >= XNZ_INIT_DONE || t - t0 >= budget)
+        {
+            break;
+        }
+        if (xnz_init_step(ctx, init->stage, init->index))
+        {
+            xnz_init_release(ctx);
+            init->stage = XNZ_INIT_FAILED;
+            break;
+        }
+        uint64_t now = xnz_time_ns();
+        timing->ms[XNZ_PHASE_IN_OVERLAY + init->stage] += (float)((double)(now - t) / 1000000.0);
+        init->index++;
+        init->done++;
+        t = now;
     }
-    if (NULL == (global_context->commands.xp.auto_thr_on = XPLMFindDataRef("sim/cockpit2/autopilot/autothrottle_on")))
+    init->slices++;
+    init->slice_ms = (float)((double)(xnz_time_ns() - t0) / 1000000.0);
+    if (init->slice_max_ms < init->slice_ms)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/autopilot/autothrottle_on)\n"); goto fail;
+        init->slice_max_ms = init->slice_ms;
     }
-    if (NULL == (global_context->commands.xp.eng_running = XPLMFindDataRef("sim/flightmodel/engine/ENGN_running")))
+    timing->ms[XNZ_PHASE_IN_TOTAL] += init->slice_ms;
+    init->progress = init->total > 0 ? (float)init->done / (float)init->total : 1.0f;
+    switch (init->stage)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/flightmodel/engine/ENGN_running)\n"); goto fail;
+        case XNZ_INIT_DONE:
+            xnz_log(XNZ_LOG_INFO, "staged init OK (%d items, %d slices, longest %.3f ms)\n", init->done, init->slices, init->slice_max_ms);
+            xnz_timing_log(timing, XNZ_PHASE_IN_TOTAL, XNZ_PHASE_IN_ACCESSOR);
+            return 0;
+
+        case XNZ_INIT_FAILED:
+            xnz_log(XNZ_LOG_ERROR, "staged init failed (%d of %d items), TCA buttons and overlay unavailable\n", init->done, init->total);
+            return 0;
+
+        default:
+            return 1;
     }
-    if (NULL == (global_context->commands.xp.igniters_on = XPLMFindDataRef("sim/cockpit2/engine/actuators/igniter_on")))
+}
+
+static float init_hdlr_fnc(float inElapsedSinceLastCall,
+                           float inElapsedTimeSinceLastFlightLoop,
+                           int   inCounter,
+                           void *inRefcon)
+{
+    xnz_context *ctx = inRefcon;
+    if (ctx->cold->init.stage >= XNZ_INIT_DONE) // complete (or failed) as of the previous frame
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/engine/actuators/igniter_on)\n"); goto fail;
+        if (ctx->cold->init.detect_pending)
+        {
+            ctx->cold->init.detect_pending = 0;
+            xnz_aircraft_detect(ctx);
+        }
+        return 0;
     }
-    if (NULL == (global_context->commands.xp.auto_ignite = XPLMFindDataRef("sim/cockpit2/engine/actuators/auto_ignite_on")))
+    uint64_t t = xnz_perf_enter(&ctx->cold->perf);
+    int more = xnz_init_run(ctx, XNZ_INIT_BUDGET_NS);
+    xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_INIT, t);
+    return more || ctx->cold->init.detect_pending ? -1.0f : 0.0f;
+}
+
+PLUGIN_API int XPluginEnable(void)
+{
+    xnz_timing timing = { { 0 } };
+    uint64_t t0 = xnz_time_ns(), t = t0;
+
+    /* check for unsupported versions */
+    XPLMHostApplicationID outHostID;
+    int outXPlaneVersion, outXPLMVersion;
+    XPLMGetVersions(&outXPlaneVersion, &outXPLMVersion, &outHostID);
+    if (outXPLMVersion < 210) // currently pointless as we target XPLM210 at build time
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/engine/actuators/auto_ignite_on)\n"); goto fail;
+        xnz_log(XNZ_LOG_ERROR, "XPluginEnable failed (outXPLMVersion: %d < 210)\n", outXPLMVersion);
+        return 0;
     }
-    if (NULL == (global_context->commands.xp.groundspeed = XPLMFindDataRef("sim/flightmodel/position/groundspeed")))
+    if (outXPlaneVersion > 11999)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/flightmodel/position/groundspeed)\n"); goto fail;
+        xnz_log(XNZ_LOG_ERROR, "XPluginEnable failed (outXPlaneVersion: %d > 11999)\n", outXPlaneVersion);
+        return 0;
     }
-    if (NULL == (global_context->commands.xp.ongroundany = XPLMFindDataRef("sim/flightmodel/failures/onground_any")))
+
+    /* Initialize context */
+    if (NULL == (global_context = xnz_aligned_calloc(sizeof(xnz_context))))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/flightmodel/failures/onground_any)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (xnz_aligned_calloc)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.xp.l_rgb_ratio = XPLMFindDataRef("sim/cockpit2/controls/left_brake_ratio")))
+    if (NULL == (global_context->cold = calloc(1, sizeof(xnz_cold_context))))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/controls/left_brake_ratio)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (calloc)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.xp.r_rgb_ratio = XPLMFindDataRef("sim/cockpit2/controls/right_brake_ratio")))
+#ifndef PUBLIC_RELEASE_BUILD
+    if (NULL == (global_context->cold->perf.handler = calloc(sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]), sizeof(*global_context->cold->perf.handler))))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/controls/right_brake_ratio)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (calloc)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.xp.pbrak_ratio = XPLMFindDataRef("sim/cockpit2/controls/parking_brake_ratio")))
+#endif
+    t = xnz_timing_mark(&timing, XNZ_PHASE_EN_CONTEXT, t);
+
+    /* common datarefs */
+    if (NULL == (global_context->f_throttall = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio_all")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/controls/parking_brake_ratio)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_throt_all)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.xp.gear_handle = XPLMFindDataRef("sim/cockpit2/controls/gear_handle_down")))
+
+    /* TCA thrust quadrant support */
+    if (NULL == (global_context->cold->i_stick_ass = XPLMFindDataRef("sim/joystick/joystick_axis_assignments")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/controls/gear_handle_down)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_stick_ass)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.xp.mixture_all = XPLMFindDataRef("sim/cockpit2/engine/actuators/mixture_ratio_all")))
+    if (NULL == (global_context->f_stick_val = XPLMFindDataRef("sim/joystick/joystick_axis_values")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMFindDataRef failed (sim/cockpit2/engine/actuators/mixture_ratio_all)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_stick_val)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_ldg_upp = XPLMCreateCommand("xnz/landing/gear/up", "landing gear up")))
+    if (NULL == (global_context->f_thr_array = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/landing/gear/up)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (f_thr_array)\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->i_prop_mode = XPLMFindDataRef("sim/cockpit2/engine/actuators/prop_mode")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_ldg_upp, &chandler_ldg_upp, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_prop_mode)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_ldg_dwn = XPLMCreateCommand("xnz/landing/gear/down", "landing gear down")))
+    if (NULL == (global_context->cold->i_ngine_num = XPLMFindDataRef("sim/aircraft/engine/acf_num_engines")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/landing/gear/down)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_ngine_num)\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->i_ngine_typ = XPLMFindDataRef("sim/aircraft/prop/acf_en_type")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_ldg_dwn, &chandler_ldg_dwn, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (i_ngine_typ)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_ldg_tog = XPLMCreateCommand("xnz/landing/gear/toggle", "landing gear toggle")))
+    if (NULL == (global_context->cold->rev_info[0] = XPLMFindDataRef("sim/aircraft/overflow/acf_has_beta")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/landing/gear/toggle)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[0])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->rev_info[1] = XPLMFindDataRef("sim/aircraft/prop/acf_revthrust_eq")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_ldg_tog, &chandler_ldg_tog, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[1])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_rgb_pkb = XPLMCreateCommand("xnz/brakes/regular/park", "hold brakes regular + set parking brake")))
+    if (NULL == (global_context->cold->rev_info[2] = XPLMFindDataRef("sim/aircraft/engine/acf_throtmax_REV")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/regular/park)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (rev_info[2])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->betto[0] = XPLMFindCommand("sim/engines/beta_toggle_1")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_rgb_pkb, &chandler_rgb_pkb, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[0])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_rgb_hld = XPLMCreateCommand("xnz/brakes/regular/hold", "hold brakes regular")))
+    if (NULL == (global_context->cold->betto[1] = XPLMFindCommand("sim/engines/beta_toggle_2")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/regular/hold)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[1])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->betto[2] = XPLMFindCommand("sim/engines/beta_toggle_3")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_rgb_hld, &chandler_rgb_hld, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[2])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_pkb_tog = XPLMCreateCommand("xnz/brakes/park/toggle", "parking brake toggle")))
+    if (NULL == (global_context->cold->betto[3] = XPLMFindCommand("sim/engines/beta_toggle_4")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/park/toggle)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[3])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->betto[4] = XPLMFindCommand("sim/engines/beta_toggle_5")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_pkb_tog, &chandler_pkb_tog, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[4])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_pkb_onh = XPLMCreateCommand("xnz/brakes/park/on/hold", "parking brake hold")))
+    if (NULL == (global_context->cold->betto[5] = XPLMFindCommand("sim/engines/beta_toggle_6")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/park/on/hold)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[5])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->betto[6] = XPLMFindCommand("sim/engines/beta_toggle_7")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_pkb_onh, &chandler_pkb_onh, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[6])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_pkb_onn = XPLMCreateCommand("xnz/brakes/park/on/set", "parking brake set")))
+    if (NULL == (global_context->cold->betto[7] = XPLMFindCommand("sim/engines/beta_toggle_8")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/park/on/set)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[7])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->betto[8] = XPLMFindCommand("sim/engines/beta_toggle")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_pkb_onn, &chandler_pkb_onn, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (betto[9])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_pkb_off = XPLMCreateCommand("xnz/brakes/park/unset", "parking brake release")))
+    if (NULL == (global_context->cold->revto[0] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_1")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/brakes/park/unset)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[0])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->revto[1] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_2")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_pkb_off, &chandler_pkb_off, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[1])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_p_onn = XPLMCreateCommand("xnz/auto/pilot/pu/sh", "autopilot engage servos")))
+    if (NULL == (global_context->cold->revto[2] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_3")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/auto/pilot/pu/sh)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[2])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->revto[3] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_4")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_p_onn, &chandler_a_p_onn, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[3])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_p_off = XPLMCreateCommand("xnz/auto/pilot/di/sc", "autopilot disconnect servos")))
+    if (NULL == (global_context->cold->revto[4] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_5")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/auto/pilot/di/sc)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[4])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->revto[5] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_6")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_p_off, &chandler_a_p_off, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[5])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_at_toga = XPLMCreateCommand("xnz/auto/thrust/to/ga", "A/T takeoff/go-around")))
+    if (NULL == (global_context->cold->revto[6] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_7")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/auto/thrust/to/ga)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[6])\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->revto[7] = XPLMFindCommand("sim/engines/thrust_reverse_toggle_8")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_at_toga, &chandler_at_toga, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[7])\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_at_disc = XPLMCreateCommand("xnz/auto/thrust/di/sc", "A/T disconnect")))
+    if (NULL == (global_context->cold->revto[8] = XPLMFindCommand("sim/engines/thrust_reverse_toggle")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/auto/thrust/di/sc)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (revto[9])\n"); goto fail;
     }
-    else
+    XPLMRegisterFlightLoopCallback((global_context->cold->f_l_th = &axes_hdlr_fnc), 0, global_context);
+    XPLMRegisterFlightLoopCallback((global_context->cold->commands.callouts.f_l_co = &callout_hdlr_fnc), 0, &global_context->cold->commands);
+    global_context->cold->commands.callouts.last_id = -1;
+    t = xnz_timing_mark(&timing, XNZ_PHASE_EN_DATAREFS, t);
+
+#ifndef PUBLIC_RELEASE_BUILD
+    global_context->cold->commands.xp_11_00_or_later = (outXPlaneVersion > 10999);
+    global_context->cold->commands.xp_11_50_or_later = (outXPlaneVersion > 11499);
+#endif
+
+    /* Datarefs: axis input and XNZ-processed output */
+    if (NULL == (global_context->cold->f_throt_inn = XPLMRegisterDataAccessor("xnz/throttle/ratio/inn",
+                                                                        xplmType_Float, 0,
+                                                                        NULL, NULL,
+                                                                        &XNZGetDataf, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        &global_context->avrg_throttle_inn, NULL)))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_at_disc, &chandler_at_disc, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_12_lt = XPLMCreateCommand("xnz/tca/12/at/disc/lt", "TCA 1&2: lt A/T disconnect")))
+    if (NULL == (global_context->cold->f_throt_out = XPLMRegisterDataAccessor("xnz/throttle/ratio/out",
+                                                                        xplmType_Float, 0,
+                                                                        NULL, NULL,
+                                                                        &XNZGetDataf, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        &global_context->avrg_throttle_out, NULL)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/at/disc/lt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
     }
-    else
+
+    /* Datarefs: load phase timing */
+    if (NULL == (global_context->cold->f_timing_ph = XPLMRegisterDataAccessor("xnz/timing/phases",
+                                                                        xplmType_FloatArray, 0,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        NULL, NULL,
+                                                                        &XNZGetTimings, NULL,
+                                                                        NULL, NULL,
+                                                                        &global_context->cold->timing, NULL)))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_12_lt, &chandler_a_12_lt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_12_rt = XPLMCreateCommand("xnz/tca/12/at/disc/rt", "TCA 1&2: rt A/T disconnect")))
+
+    /* Datarefs: staged initialization progress */
+    if (NULL == (global_context->cold->init.f_progress = XPLMRegisterDataAccessor("xnz/init/progress",
+                                                                            xplmType_Float, 0,
+                                                                            NULL, NULL,
+                                                                            &XNZGetDataf, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            &global_context->cold->init.progress, NULL)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/at/disc/rt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->init.f_slice_ms = XPLMRegisterDataAccessor("xnz/init/slice_ms",
+                                                                            xplmType_Float, 0,
+                                                                            NULL, NULL,
+                                                                            &XNZGetDataf, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            NULL, NULL,
+                                                                            &global_context->cold->init.slice_ms, NULL)))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_12_rt, &chandler_a_12_rt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_x_12_lt = XPLMCreateCommand("xnz/tca/12/extra/lt", "TCA 1&2: lt extra button")))
+    t = xnz_timing_mark(&timing, XNZ_PHASE_EN_ACCESSOR, t);
+
+    /* TCA quadrant support: toggle on/off via menu */
+    if (NULL == (global_context->cold->id_th_on_off = XPLMCreateMenu(XNZ_XPLM_TITLE, NULL, 0, &menu_hdlr_fnc, global_context)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/extra/lt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMCreateMenu)\n"); goto fail;
     }
-    else
+    if (0 > (global_context->cold->id_menu_item_on_off = XPLMAppendMenuItem(global_context->cold->id_th_on_off, "TCA Throttle Quadrant", &global_context->cold->id_menu_item_on_off, 0)))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_x_12_lt, &chandler_x_12_lt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMAppendMenuItem)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_x_12_rt = XPLMCreateCommand("xnz/tca/12/extra/rt", "TCA 1&2: rt extra button")))
+    XPLMCheckMenuItem(global_context->cold->id_th_on_off, global_context->cold->id_menu_item_on_off, xplm_Menu_Checked);
+    if (0 > (global_context->cold->perf.id_menu_item_dump = XPLMAppendMenuItem(global_context->cold->id_th_on_off, "Dump latency histograms", &global_context->cold->perf.id_menu_item_dump, 0)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/extra/rt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMAppendMenuItem)\n"); goto fail;
     }
-    else
+    if (NULL == (global_context->cold->trace_tog = XPLMCreateCommand("xnz/trace/axes/toggle", "toggle axis pipeline trace recording")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_x_12_rt, &chandler_x_12_rt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (trace_tog)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_34_lt = XPLMCreateCommand("xnz/tca/34/at/disc/lt", "TCA 3&4: lt A/T disconnect")))
+    XPLMRegisterCommandHandler(global_context->cold->trace_tog, &chandler_trc_tog, 0, global_context);
+#ifndef PUBLIC_RELEASE_BUILD
+    if (NULL == (global_context->cold->ffrec_tog = XPLMCreateCommand("xnz/ffrec/toggle", "toggle FlightFactor A320 value recording")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/at/disc/lt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (ffrec_tog)\n"); goto fail;
     }
-    else
+    XPLMRegisterCommandHandler(global_context->cold->ffrec_tog, &chandler_ffr_tog, 0, global_context);
+#endif
+#if LIN
+    if (NULL == (global_context->cold->direct_tog = XPLMCreateCommand("xnz/tca/direct/toggle", "toggle direct TCA lever input (evdev)")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_34_lt, &chandler_a_34_lt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (direct_tog)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_a_34_rt = XPLMCreateCommand("xnz/tca/34/at/disc/rt", "TCA 3&4: rt A/T disconnect")))
+    XPLMRegisterCommandHandler(global_context->cold->direct_tog, &chandler_dir_tog, 0, global_context);
+#endif
+    t = xnz_timing_mark(&timing, XNZ_PHASE_EN_MENU, t);
+
+    /* initialize detents, corresponding zone data */
+    update_thrust_zones(&global_context->cold->zones_base, TCA_IDLE_CTR, TCA_CLMB_CTR, TCA_FLEX_CTR);
+    default_throt_share(&global_context->cold->zones_base);
+    if (NULL == (global_context->params = xnz_params_create(&global_context->cold->zones_base, 0, NULL)))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/at/disc/rt)\n"); goto fail;
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (xnz_params_create)\n"); goto fail;
     }
-    else
+    if (xnz_params_watch_start(global_context))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_a_34_rt, &chandler_a_34_rt, 0, &global_context->commands);
+        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (xnz_params_watch_start)\n"); goto fail;
     }
-    if (NULL == (global_context->commands.cmd_x_34_lt = XPLMCreateCommand("xnz/tca/34/extra/lt", "TCA 3&4: lt extra button")))
+    t = xnz_timing_mark(&timing, XNZ_PHASE_EN_PARAMS, t);
+    xnz_telemetry_start(global_context);
+    xnz_ingress_start(global_context);
+#if LIN
+    if (getenv(XNZ_EVDEV_ENV)) // opt-in
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/extra/lt)\n"); goto fail;
+        xnz_direct_start(global_context, getenv(XNZ_EVDEV_ENV));
     }
-    else
+#endif
+    xnz_timing_mark(&timing, XNZ_PHASE_EN_TOTAL, t0);
+    memcpy(global_context->cold->timing.ms, timing.ms, sizeof(timing.ms));
+    xnz_timing_log(&timing, XNZ_PHASE_EN_TOTAL, XNZ_PHASE_EN_PARAMS);
+
+    /* all good */
+    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginEnable OK\n");
+    global_context->i_version_simulator = outXPlaneVersion;
+    global_context->cold->i_version_xplm_apis = outXPLMVersion;
+    global_context->cold->commands.xnz_ab = XNZ_AB_ERRR;
+    global_context->cold->commands.xnz_ap = XNZ_AP_ERRR;
+    global_context->cold->commands.xnz_at = XNZ_AT_ERRR;
+    global_context->cold->commands.xnz_bt = XNZ_BT_ERRR;
+    global_context->cold->commands.xnz_et = XNZ_ET_ERRR;
+    global_context->cold->commands.xnz_pb = XNZ_PB_ERRR;
+    xnz_cmd_ops_resolve(&global_context->cold->commands);
+    global_context->idx_throttle_axis_1 = -1;
+    global_context->tca_support_enabled = 1;
+    global_context->i_got_axis_input[0] = 0;
+    global_context->skip_idle_overwrite = 0;
+    global_context->cold->i_context_init_done = 0;
+    global_context->xnz_tt = XNZ_TT_ERRR;
+
+    /* everything else: a little at a time, starting next frame */
+    for (int i = XNZ_INIT_OVERLAY; i < XNZ_INIT_DONE; i++)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_x_34_lt, &chandler_x_34_lt, 0, &global_context->commands);
+        global_context->cold->init.total += xnz_init_count(i);
     }
-    if (NULL == (global_context->commands.cmd_x_34_rt = XPLMCreateCommand("xnz/tca/34/extra/rt", "TCA 3&4: rt extra button")))
+    XPLMRegisterFlightLoopCallback((global_context->cold->init.f_l_in = &init_hdlr_fnc), -1.0f, global_context);
+    XPLMRegisterFlightLoopCallback((xnz_logger_state.f_l_lg = &log_hdlr_fnc), 0, NULL);
+    XPLMRegisterFlightLoopCallback((global_context->cold->perf.stutter.f_l_st = &stutter_hdlr_fnc), -1.0f, global_context);
+#ifdef XNZ_XPLM_CALLSTATS
+    XPLMRegisterFlightLoopCallback((xnz_calls_state.f_l_cs = &calls_hdlr_fnc), -1.0f, NULL);
+#endif
+    return 1;
+
+fail:
+    if (NULL != global_context)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/extra/rt)\n"); goto fail;
+        if (NULL != global_context->cold)
+        {
+#ifndef PUBLIC_RELEASE_BUILD
+            free(global_context->cold->perf.handler);
+#endif
+            free(global_context->cold);
+        }
+        xnz_params_destroy(global_context->params);
+        xnz_aligned_free(global_context);
+        global_context = NULL;
     }
-    else
+    return 0;
+}
+
+static void xnz_context_sync(xnz_context *ctx)
+{
+    if (ctx)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_x_34_rt, &chandler_x_34_rt, 0, &global_context->commands);
+        xnz_cmd_ops_resolve(&ctx->cold->commands);
+        ctx->xnz_at = ctx->cold->commands.xnz_at;
+        ctx->xnz_et = ctx->cold->commands.xnz_et;
+        ctx->auto_pil_on = ctx->cold->commands.xp.auto_pil_on;
+        ctx->auto_thr_on = ctx->cold->commands.xp.auto_thr_on;
     }
-    if (NULL == (global_context->commands.cmd_m_12_ch = XPLMCreateCommand("xnz/tca/12/modes/crank/hold", "TCA 1&2: crank mode hold")))
+}
+
+static void xnz_context_reset(xnz_context *ctx)
+{
+    if (ctx)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/modes/crank/hold)\n"); goto fail;
+#ifndef PUBLIC_RELEASE_BUILD
+        xnz_ffrec_stop(ctx); // while the aircraft's shared values still exist
+        if (ctx->cold->f_l_cb) // else overlay not (yet) initialized
+        {
+            XPLMSetFlightLoopCallbackInterval(ctx->cold->f_l_cb, 0, 1, ctx);
+            XPLMSetDataf(ctx->nullzone[0], ctx->cold->prefs_nullzone[0]);
+            XPLMSetDataf(ctx->nullzone[1], ctx->cold->prefs_nullzone[1]);
+            XPLMSetDataf(ctx->nullzone[2], ctx->cold->prefs_nullzone[2]);
+            XPLMSetDataf(ctx->acf_roll_co, ctx->nominal_roll_coef);
+            xnz_sched_invalidate(ctx);
+            overlay_hide(ctx);
+        }
+#endif
+        XPLMSetFlightLoopCallbackInterval(ctx->cold->f_l_th, 0, 1, ctx);
+        update_thrust_zones(&ctx->cold->zones_base, TCA_IDLE_CTR, TCA_CLMB_CTR, TCA_FLEX_CTR);
+        default_throt_share(&ctx->cold->zones_base);
+        xnz_params_watch_clear(ctx);
+        xnz_params *params = xnz_params_create(&ctx->cold->zones_base, 0, NULL);
+        if (params)
+        {
+            xnz_params_destroy(xnz_params_swap(ctx, params));
+        }
+        ctx->cold->commands.xnz_at = XNZ_AT_ERRR;
+        ctx->cold->commands.xnz_ab = XNZ_AB_ERRR;
+        ctx->cold->commands.xnz_ap = XNZ_AP_ERRR;
+        ctx->cold->commands.xnz_bt = XNZ_BT_ERRR;
+        ctx->cold->commands.xnz_et = XNZ_ET_ERRR;
+        ctx->cold->commands.xnz_pb = XNZ_PB_ERRR;
+        ctx->cold->i_context_init_done = 0;
+        ctx->cold->init.detect_pending = 0;
+        ctx->skip_idle_overwrite = 0;
+        ctx->xnz_tt = XNZ_TT_ERRR;
+        memset(&ctx->published, 0, sizeof(ctx->published));
+        ctx->published_gen++;
+        xnz_context_sync(ctx);
     }
-    else
+}
+
+PLUGIN_API void XPluginDisable(void)
+{
+    /* pending messages first, then write the rest immediately */
+    xnz_log_flush();
+    XPLMUnregisterFlightLoopCallback(xnz_logger_state.f_l_lg, NULL);
+    xnz_logger_state.f_l_lg = NULL;
+    xnz_logger_state.scheduled = 0;
+    XPLMUnregisterFlightLoopCallback(global_context->cold->perf.stutter.f_l_st, global_context);
+    xnz_stutter_report(global_context);
+#ifdef XNZ_XPLM_CALLSTATS
+    XPLMUnregisterFlightLoopCallback(xnz_calls_state.f_l_cs, NULL);
+    xnz_perf_dump(global_context); // final summary
+#endif
+
+    /* release held commands while their handlers are still registered */
+    xnz_ingress_stop(global_context);
+    xnz_context_reset(global_context);
+
+    XPLMUnregisterFlightLoopCallback(global_context->cold->init.f_l_in, global_context);
+#ifndef PUBLIC_RELEASE_BUILD
+    if (global_context->cold->f_l_cb)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_12_ch, &chandler_m_12_ch, 0, &global_context->commands);
+        XPLMSetDataf(global_context->nullzone[0], global_context->cold->prefs_nullzone[0]);
+        XPLMSetDataf(global_context->nullzone[1], global_context->cold->prefs_nullzone[1]);
+        XPLMSetDataf(global_context->nullzone[2], global_context->cold->prefs_nullzone[2]);
+        XPLMSetDataf(global_context->acf_roll_co, global_context->nominal_roll_coef);
     }
-    if (NULL == (global_context->commands.cmd_m_12_cr = XPLMCreateCommand("xnz/tca/12/modes/crank", "TCA 1&2: crank mode set")))
+#endif
+    xnz_init_release(global_context);
+
+    XPLMUnregisterFlightLoopCallback(global_context->cold->f_l_th, global_context);
+    XPLMUnregisterCommandHandler(global_context->cold->trace_tog, &chandler_trc_tog, 0, global_context);
+    xnz_trace_stop(global_context);
+#ifndef PUBLIC_RELEASE_BUILD
+    XPLMUnregisterCommandHandler(global_context->cold->ffrec_tog, &chandler_ffr_tog, 0, global_context);
+#endif
+#if LIN
+    XPLMUnregisterCommandHandler(global_context->cold->direct_tog, &chandler_dir_tog, 0, global_context);
+    xnz_direct_stop(global_context);
+#endif
+    xnz_telemetry_stop(global_context);
+    XPLMUnregisterFlightLoopCallback(global_context->cold->commands.callouts.f_l_co, &global_context->cold->commands);
+    global_context->cold->commands.callouts.f_l_co = NULL;
+    global_context->cold->commands.callouts.count = 0;
+
+    /* Datarefs: axis input and XNZ-processed output */
+    if (global_context->cold->f_throt_inn)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/modes/crank)\n"); goto fail;
+        XPLMUnregisterDataAccessor(global_context->cold->f_throt_inn);
+        global_context->cold->f_throt_inn = NULL;
     }
-    else
+    if (global_context->cold->f_throt_out)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_12_cr, &chandler_m_12_cr, 0, &global_context->commands);
+        XPLMUnregisterDataAccessor(global_context->cold->f_throt_out);
+        global_context->cold->f_throt_out = NULL;
     }
-    if (NULL == (global_context->commands.cmd_m_12_no = XPLMCreateCommand("xnz/tca/12/modes/norm", "TCA 1&2: norm mode set")))
+    if (global_context->cold->f_timing_ph)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/modes/norm)\n"); goto fail;
+        XPLMUnregisterDataAccessor(global_context->cold->f_timing_ph);
+        global_context->cold->f_timing_ph = NULL;
     }
-    else
+    if (global_context->cold->init.f_progress)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_12_no, &chandler_m_12_no, 0, &global_context->commands);
+        XPLMUnregisterDataAccessor(global_context->cold->init.f_progress);
+        global_context->cold->init.f_progress = NULL;
     }
-    if (NULL == (global_context->commands.cmd_m_12_st = XPLMCreateCommand("xnz/tca/12/modes/start", "TCA 1&2: start mode set")))
+    if (global_context->cold->init.f_slice_ms)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/modes/start)\n"); goto fail;
+        XPLMUnregisterDataAccessor(global_context->cold->init.f_slice_ms);
+        global_context->cold->init.f_slice_ms = NULL;
     }
-    else
+
+    /* re-enable throttle 1/2 axes */
+    if (global_context->idx_throttle_axis_1 >= 0)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_12_st, &chandler_m_12_st, 0, &global_context->commands);
+        int th_axis_ass[2] = { 20, 21, };
+        xnz_log(XNZ_LOG_INFO, "releasing joystick axes (XPluginDisable)\n");
+        XPLMSetDatavi(global_context->cold->i_stick_ass, th_axis_ass, global_context->idx_throttle_axis_1, 2);
     }
-    if (NULL == (global_context->commands.cmd_m_12_sh = XPLMCreateCommand("xnz/tca/12/modes/start/hold", "TCA 1&2: start mode hold")))
+
+    /* close context */
+    if (NULL != global_context)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/12/modes/start/hold)\n"); goto fail;
+        xnz_params_watch_stop(global_context);
+        xnz_params_destroy(global_context->params);
+#ifndef PUBLIC_RELEASE_BUILD
+        free(global_context->cold->perf.handler);
+#endif
+        free(global_context->cold);
+        xnz_aligned_free(global_context);
+        global_context = NULL;
     }
-    else
+
+    /* all good */
+    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginDisable OK\n");
+}
+
+static inline void dref_read_str(XPLMDataRef ref, char *buf, size_t siz)
+{
+    if (ref && buf && siz)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_12_sh, &chandler_m_12_sh, 0, &global_context->commands);
+        int len = XPLMGetDatab(ref, buf, 0, siz - 1);
+        if (len > 0)
+        {
+            buf[siz - 1] = '\0';
+            return;
+        }
+        buf[0] = '\0';
+        return;
     }
-    if (NULL == (global_context->commands.cmd_m_34_ch = XPLMCreateCommand("xnz/tca/34/modes/crank/hold", "TCA 3&4: crank mode hold")))
+    return;
+}
+
+/*
+ * TODO: future: XNZ_AP_COMM
+ *
+ * ToLiSS A319, A321
+ * ctx->otto.conn.cc.name = "toliss_airbus/ap1_push";
+ * ctx->otto.disc.cc.name = "toliss_airbus/ap_disc_left_stick";
+ *
+ * FlightFactor A350 (X-Plane 10)
+ * ctx->otto.conn.cc.name = "airbus_qpac/ap1_push";
+ * ctx->otto.disc.cc.name = "sim/autopilot/fdir_servos_down_one";
+ *
+ * FlightFactor A350 (X-Plane 11)
+ * ctx->otto.conn.cc.name = "airbus_qpac/ap1_push";
+ * ctx->otto.disc.cc.name = "airbus_qpac/ap_disc_left_stick";
+ *
+ * IXEG 737-300 Classic
+ * ctx->otto.conn.cc.name = "ixeg/733/autopilot/AP_A_cmd_toggle";
+ * ctx->otto.disc.cc.name = "ixeg/733/autopilot/AP_disengage";
+ *
+ * FlightFactor 757, 767
+ * ctx->otto.conn.cc.name = NULL; // try to find a dataref maybe???
+ * ctx->otto.disc.cc.name = "1-sim/comm/AP/ap_disc";
+ */
+
+static inline uint32_t xnz_plugin_index_hash(const char *signature)
+{
+    uint32_t hash = 2166136261u;
+    while (*signature)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/modes/crank/hold)\n"); goto fail;
+        hash ^= (uint8_t)*signature++;
+        hash *= 16777619u;
     }
-    else
-    {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_34_ch, &chandler_m_34_ch, 0, &global_context->commands);
+    return hash;
+}
+
+static void xnz_plugin_index_build(xnz_plugin_index *idx)
+{
+    char signature[256];
+    int count = XPLMCountPlugins();
+    memset(idx->slot, 0, sizeof(idx->slot));
+    idx->pool_used = idx->count = idx->count_enabled = 0;
+    idx->complete = count <= XNZ_PLUGIN_INDEX_LIMIT;
+    for (int i = 0; i < count && idx->complete; i++)
+    {
+        XPLMPluginID id = XPLMGetNthPlugin(i);
+        signature[0] = '\0'; XPLMGetPluginInfo(id, NULL, NULL, signature, NULL);
+        size_t len = strnlen(signature, sizeof(signature) - 1);
+        if (len + 1 > sizeof(idx->pool) - idx->pool_used)
+        {
+            idx->complete = 0;
+            break;
+        }
+        uint32_t hash = xnz_plugin_index_hash(signature), mask = XNZ_PLUGIN_INDEX_SLOTS - 1;
+        for (uint32_t j = hash & mask; ; j = (j + 1) & mask)
+        {
+            if (idx->slot[j].name == 0)
+            {
+                memcpy(idx->pool + idx->pool_used, signature, len);
+                idx->pool[idx->pool_used + len] = '\0';
+                idx->slot[j].name = idx->pool_used + 1;
+                idx->slot[j].hash = hash;
+                idx->slot[j].id = id;
+                idx->slot[j].enabled = XPLMIsPluginEnabled(id);
+                idx->count_enabled += idx->slot[j].enabled != 0;
+                idx->pool_used += len + 1;
+                idx->count++;
+                break;
+            }
+            if (idx->slot[j].hash == hash && !strcmp(idx->pool + idx->slot[j].name - 1, signature))
+            {
+                break; // duplicate signature, keep the first one
+            }
+        }
     }
-    if (NULL == (global_context->commands.cmd_m_34_cr = XPLMCreateCommand("xnz/tca/34/modes/crank", "TCA 3&4: crank mode set")))
+    if (idx->complete == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/modes/crank)\n"); goto fail;
+        xnz_log(XNZ_LOG_INFO, "plugin index: %d plugins, falling back to XPLMFindPluginBySignature\n", count);
+        return;
     }
-    else
+    xnz_log(XNZ_LOG_INFO, "plugin index: %d plugins (%d enabled)\n", idx->count, idx->count_enabled);
+    if (XNZ_LOG_INFO >= XNZ_LOG_LEVEL_MIN && XNZ_LOG_INFO >= xnz_logger_state.level)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_34_cr, &chandler_m_34_cr, 0, &global_context->commands);
+        /* one entry per plugin: bypass the per-site rate limit (like xnz_perf_dump) */
+        char *buffer = malloc(XNZ_LOG_BUFFER); size_t used = 0;
+        if (buffer == NULL)
+        {
+            xnz_log(XNZ_LOG_ERROR, "plugin index: dump failed (malloc)\n");
+            return;
+        }
+        xnz_log_flush();
+        for (uint32_t j = 0; j < XNZ_PLUGIN_INDEX_SLOTS; j++)
+        {
+            if (idx->slot[j].name)
+            {
+                if (XNZ_LOG_BUFFER - used < 512)
+                {
+                    XPLMDebugString(buffer); used = 0;
+                }
+                used += snprintf(buffer + used, XNZ_LOG_BUFFER - used, XNZ_LOG_PREFIX"[info]: plugin index: [%c] %3d \"%s\"\n",
+                                 idx->slot[j].enabled ? 'x' : ' ', idx->slot[j].id, idx->pool + idx->slot[j].name - 1);
+            }
+        }
+        if (used)
+        {
+            XPLMDebugString(buffer);
+        }
+        free(buffer);
     }
-    if (NULL == (global_context->commands.cmd_m_34_no = XPLMCreateCommand("xnz/tca/34/modes/norm", "TCA 3&4: norm mode set")))
+}
+
+static XPLMPluginID xnz_plugin_index_find(const xnz_plugin_index *idx, const char *signature, int *outEnabled)
+{
+    if (idx->complete == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/modes/norm)\n"); goto fail;
+        XPLMPluginID id = XPLMFindPluginBySignature(signature);
+        if (outEnabled)
+        {
+            *outEnabled = XPLM_NO_PLUGIN_ID != id && XPLMIsPluginEnabled(id);
+        }
+        return id;
     }
-    else
+    uint32_t hash = xnz_plugin_index_hash(signature), mask = XNZ_PLUGIN_INDEX_SLOTS - 1;
+    for (uint32_t j = hash & mask; idx->slot[j].name; j = (j + 1) & mask)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_34_no, &chandler_m_34_no, 0, &global_context->commands);
+        if (idx->slot[j].hash == hash && !strcmp(idx->pool + idx->slot[j].name - 1, signature))
+        {
+            if (outEnabled)
+            {
+                *outEnabled = idx->slot[j].enabled;
+            }
+            return idx->slot[j].id;
+        }
     }
-    if (NULL == (global_context->commands.cmd_m_34_st = XPLMCreateCommand("xnz/tca/34/modes/start", "TCA 3&4: start mode set")))
+    if (outEnabled)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/modes/start)\n"); goto fail;
+        *outEnabled = 0;
     }
-    else
+    return XPLM_NO_PLUGIN_ID;
+}
+
+/*
+ * Aircraft-specific backends: each profile lists its match predicates,
+ * the refs it requires and the resulting backend types. Profiles are
+ * evaluated in order (first match wins), but a profile whose gate (its
+ * leading plugin signatures) matches ends the search even when the rest
+ * of its predicates don't, like the plugin branches of the former if/else
+ * chain; adding an aircraft only takes a new entry in xnz_acf_profiles[].
+ */
+#define XNZ_ACF_KEEP (-2) // leave backend type as determined by the generic defaults
+
+typedef struct
+{
+    enum
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_34_st, &chandler_m_34_st, 0, &global_context->commands);
-    }
-    if (NULL == (global_context->commands.cmd_m_34_sh = XPLMCreateCommand("xnz/tca/34/modes/start/hold", "TCA 3&4: start mode hold")))
+        XNZ_ACF_NONE = 0,
+        XNZ_ACF_AUTH = 1, // sim/aircraft/view/acf_author
+        XNZ_ACF_DESC = 2, // sim/aircraft/view/acf_descrip
+        XNZ_ACF_ICAO = 3, // sim/aircraft/view/acf_ICAO
+    } field;
+    const char *prefix[2]; // any of (case-insensitive prefix)
+}
+xnz_acf_string;
+
+typedef struct
+{
+    const char *signature[4]; // any of
+    int require_enabled;
+}
+xnz_acf_plugin;
+
+typedef struct
+{
+    enum
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/34/modes/start/hold)\n"); goto fail;
-    }
-    else
+        XNZ_ACF_REF_NONE = 0,
+        XNZ_ACF_CMD_DREF = 1, // XPLMDataRef in xnz_cmd_context
+        XNZ_ACF_CMD_CMND = 2, // XPLMCommandRef in xnz_cmd_context
+        XNZ_ACF_CTX_DREF = 3, // XPLMDataRef in xnz_context
+    } type;
+    size_t offset;
+    const char *name;
+}
+xnz_acf_ref;
+
+#define XNZ_ACF_CMD_DREF(_member, _name) { XNZ_ACF_CMD_DREF, offsetof(xnz_cmd_context, _member), _name, }
+#define XNZ_ACF_CMD_CMND(_member, _name) { XNZ_ACF_CMD_CMND, offsetof(xnz_cmd_context, _member), _name, }
+#define XNZ_ACF_CTX_DREF(_member, _name) { XNZ_ACF_CTX_DREF, offsetof(xnz_context,     _member), _name, }
+
+typedef struct
+{
+    const char *name;
+    xnz_acf_string string[3]; // all of (cheap, tested first)
+    xnz_acf_plugin plugin[2]; // all of
+    int gate; // leading plugin[] entries which, once matched, end the search
+    xnz_acf_ref    refs[16];  // all required
+    int xnz_ab;
+    int xnz_ap;
+    int xnz_at;
+    int xnz_bt;
+    int xnz_et;
+    int xnz_pb;
+    int xnz_tt;
+    float share[3]; // cumulative CLB, FLX, TGA thrust share (if non-zero)
+    void (*on_match)(xnz_context*);
+}
+xnz_acf_profile;
+
+static void xnz_acf_ff32_init(xnz_context *ctx)
+{
+    ctx->tt.ff32.pid = xnz_plugin_index_find(&ctx->cold->plugins, XPLM_FF_SIGNATURE, NULL);
+    ctx->tt.ff32.api_has_initialized = 0;
+}
+
+static void xnz_acf_to32_init(xnz_context *ctx)
+{
+    XPLMSetDatai(ctx->cold->commands.bt.to32.br_override, 1);
+}
+
+static void xnz_acf_tbm9_init(xnz_context *ctx)
+{
+    XPLMSetDatai(ctx->cold->commands.bt.tbm9.br_override, 1);
+}
+
+static const xnz_acf_profile xnz_acf_profiles[] =
+{
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_m_34_sh, &chandler_m_34_sh, 0, &global_context->commands);
-    }
-    if (NULL == (global_context->commands.cmd_e_1_onh = XPLMCreateCommand("xnz/tca/engines/1/on/hold", "TCA: engine 1 ON hold")))
+        .name = "FF32",
+        .plugin = { { { XPLM_FF_SIGNATURE, }, 1, }, },
+        .gate = 1,
+        .xnz_ab = XNZ_AB_FF32,
+        .xnz_ap = XNZ_AP_FF32,
+        .xnz_at = XNZ_AT_FF32,
+        .xnz_bt = XNZ_BT_FF32,
+        .xnz_et = XNZ_ET_FF32,
+        .xnz_pb = XNZ_PB_FF32,
+        .xnz_tt = XNZ_TT_FF32,
+        .on_match = &xnz_acf_ff32_init,
+    },
+    {
+        .name = "TO32",
+        .plugin =
+        {
+            { { "XP10.ToLiss.A319.systems", "XP10.ToLiss.A321.systems", "XP11.ToLiss.A319.systems", "XP11.ToLiss.A321.systems", }, 1, },
+        },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CTX_DREF(tt.toli.f_thr_array, "AirbusFBW/throttle_input"                 ),
+            XNZ_ACF_CMD_DREF(pb.to32.pbrak_onoff, "AirbusFBW/ParkBrake"                      ),
+            XNZ_ACF_CMD_DREF(bt.to32.l_rgb_ratio, "AirbusFBW/BrakePedalInputLeft"            ), // not "…Inputleft" (that was the bug)
+            XNZ_ACF_CMD_DREF(bt.to32.r_rgb_ratio, "AirbusFBW/BrakePedalInputRight"           ),
+            XNZ_ACF_CMD_DREF(bt.to32.br_override, "AirbusFBW/BrakePedalInputOverride"        ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_e_1_onn, "toliss_airbus/engcommands/Master1On"      ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_e_1_off, "toliss_airbus/engcommands/Master1Off"     ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_e_2_onn, "toliss_airbus/engcommands/Master2On"      ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_e_2_off, "toliss_airbus/engcommands/Master2Off"     ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_m_12_cr, "toliss_airbus/engcommands/EngineModeSwitchToCrank"),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_m_12_no, "toliss_airbus/engcommands/EngineModeSwitchToNorm" ),
+            XNZ_ACF_CMD_CMND(et.to32.cmd_m_12_st, "toliss_airbus/engcommands/EngineModeSwitchToStart"),
+        },
+        .xnz_ab = XNZ_AB_TO32,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_TOLI,
+        .xnz_bt = XNZ_BT_TO32,
+        .xnz_et = XNZ_ET_TO32,
+        .xnz_pb = XNZ_PB_TO32,
+        .xnz_tt = XNZ_TT_TOLI,
+        .on_match = &xnz_acf_to32_init,
+    },
+    {
+        .name = "FF35 (XP10)",
+        .plugin =
+        {
+            { { "ToLiSs.Airbus.systems", }, 1, }, // A350v1.4--
+            { { "FFSTSmousehandler", "ru.ffsts.mousehandler", }, 0, }, // A350v1.3--, A350v1.4.x
+        },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CTX_DREF(tt.toli.f_thr_array, "AirbusFBW/throttle_input"),
+            XNZ_ACF_CMD_DREF(pb.ff35.pbrak_offon, "1-sim/parckBrake"        ),
+        },
+        .xnz_ab = XNZ_AB_FF35,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_TOLI,
+        .xnz_bt = XNZ_BT_FF35,
+        .xnz_et = XNZ_ET_ERRR,
+        .xnz_pb = XNZ_PB_FF35,
+        .xnz_tt = XNZ_TT_TOLI,
+    },
+    {
+        .name = "FF35 (XP11)",
+        .plugin =
+        {
+            { { "XP11.ToLiss.Airbus.systems", }, 1, }, // A350v1.6++
+            { { "ru.stsff.mousehandler", }, 0, },
+        },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CTX_DREF(tt.toli.f_thr_array, "AirbusFBW/throttle_input"   ),
+            XNZ_ACF_CMD_DREF(pb.ff35.pbrak_offon, "1-sim/parckBrake"           ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_e_1_onn, "1-sim/comm/cutOnLeft"       ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_e_1_off, "1-sim/comm/cutOffLeft"      ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_e_2_onn, "1-sim/comm/cutOnRight"      ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_e_2_off, "1-sim/comm/cutOffRight"     ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_m_12_cr, "1-sim/comm/startSwitchCrank"),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_m_12_no, "1-sim/comm/startSwitchNorm" ),
+            XNZ_ACF_CMD_CMND(et.ff35.cmd_m_12_st, "1-sim/comm/startSwitchStart"),
+        },
+        .xnz_ab = XNZ_AB_FF35,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_TOLI,
+        .xnz_bt = XNZ_BT_FF35,
+        .xnz_et = XNZ_ET_FF35,
+        .xnz_pb = XNZ_PB_FF35,
+        .xnz_tt = XNZ_TT_TOLI,
+    },
+    {
+        .name = "FlightFactor 757/767",
+        .plugin =
+        {
+            { { "ru.stsff.757767avionics", "ru.flightfactor-steptosky.757767avionics", "de-ru.philippmuenzel-den_rain.757avionics", }, 0, },
+        },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_CMND(at.comm.cmd_at_disc, "1-sim/comm/AP/at_disc"          ),
+            XNZ_ACF_CMD_CMND(at.comm.cmd_at_toga, "1-sim/comm/AP/at_toga"          ),
+            XNZ_ACF_CMD_DREF(et.ff75.drf_e_1_cut, "1-sim/fuel/fuelCutOffLeft"      ),
+            XNZ_ACF_CMD_DREF(et.ff75.drf_e_2_cut, "1-sim/fuel/fuelCutOffRight"     ),
+            XNZ_ACF_CMD_DREF(et.ff75.drf_e_1_knb, "1-sim/engine/leftStartSelector" ),
+            XNZ_ACF_CMD_DREF(et.ff75.drf_e_2_knb, "1-sim/engine/rightStartSelector"),
+        },
+        .xnz_ab = XNZ_AB_FF75,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_COMM,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_FF75,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+    },
+    {
+        .name = "E35L",
+        .string = { { XNZ_ACF_ICAO, { "E35L", }, }, },
+        .plugin = { { { "ERJ_Functions", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.e35l.drf_e_1_knb, "XCrafts/ERJ/engine1_starter_knob"),
+            XNZ_ACF_CMD_DREF(et.e35l.drf_e_2_knb, "XCrafts/ERJ/engine2_starter_knob"),
+            XNZ_ACF_CMD_CMND(et.e35l.cmd_e_1_lft, "XCrafts/Starter_Eng_1_down_CCW"  ),
+            XNZ_ACF_CMD_CMND(et.e35l.cmd_e_2_lft, "XCrafts/Starter_Eng_2_down_CCW"  ),
+            XNZ_ACF_CMD_CMND(et.e35l.cmd_e_1_rgt, "XCrafts/Starter_Eng_1_up_CW"     ),
+            XNZ_ACF_CMD_CMND(et.e35l.cmd_e_2_rgt, "XCrafts/Starter_Eng_2_up_CW"     ),
+            XNZ_ACF_CMD_CMND(at.toga.cmd_ap_toga, "XCrafts/ERJ/TOGA"                ),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XPLM,
+        .xnz_at = XNZ_AT_APTO,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_E35L,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+        .share = { 0.50f, 0.75f, 1.00f, },
+    },
+    {
+        .name = "TBM9",
+        .plugin = { { { "hotstart.tbm900", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CTX_DREF(tt.tbm9.engn_rng,    "tbm900/systems/engine/range"        ),
+            XNZ_ACF_CMD_DREF(bt.tbm9.rbrak_array, "tbm900/controls/gear/brake_req"     ),
+            XNZ_ACF_CMD_DREF(pb.tbm9.pbrak_ratio, "tbm900/switches/gear/park_brake"    ),
+            XNZ_ACF_CMD_DREF(bt.tbm9.br_override, "tbm900/controls/gear/brake_req_ovrd"),
+//          XNZ_ACF_CMD_DREF(et.tbm9.drf_fuelsel, "tbm900/switches/fuel/auto_man"      ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_e_1_onn, "sim/engines/mixture_up"             ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_e_1_off, "sim/engines/mixture_down"           ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_x_12_lt, "tbm900/actuators/elec/starter_up"   ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_x_12_rt, "tbm900/actuators/elec/starter_down" ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_m_12_cr, "tbm900/actuators/elec/ignition_off" ),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_m_12_no, "tbm900/actuators/elec/ignition_auto"),
+            XNZ_ACF_CMD_CMND(et.tbm9.cmd_m_12_st, "tbm900/actuators/elec/ignition_on"  ),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_NONE,
+        .xnz_bt = XNZ_BT_TBM9,
+        .xnz_et = XNZ_ET_TBM9,
+        .xnz_pb = XNZ_PB_TBM9,
+        .xnz_tt = XNZ_TT_TBM9,
+        .on_match = &xnz_acf_tbm9_init,
+    },
+    {
+        .name = "DA62",
+        .plugin = { { { "1-sim Diamond_DA62", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.da62.drf_mod_ec1, "aerobask/eng/sw_ecu_ab1"),
+            XNZ_ACF_CMD_DREF(et.da62.drf_mod_ec2, "aerobask/eng/sw_ecu_ab2"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_ecu1_up, "aerobask/eng/ecu_ab1_up"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_ecu1_dn, "aerobask/eng/ecu_ab1_dn"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_ecu2_up, "aerobask/eng/ecu_ab2_up"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_ecu2_dn, "aerobask/eng/ecu_ab2_dn"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_e_1_onn, "aerobask/eng/master1_up"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_e_1_off, "aerobask/eng/master1_dn"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_e_2_onn, "aerobask/eng/master2_up"),
+            XNZ_ACF_CMD_CMND(et.da62.cmd_e_2_off, "aerobask/eng/master2_dn"),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XGFC,
+        .xnz_at = XNZ_AT_NONE,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_DA62,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+        .share = { 0.50f, 0.94f, 1.00f, }, // FLX safely below maximum continuous thrust
+    },
+    {
+        .name = "LEG2",
+        .plugin = { { { "1-sim Legacy_RG", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_f_sl_rt, "aerobask/legacy/fuel_sel_right"),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_f_sl_lt, "aerobask/legacy/fuel_sel_left" ),
+            XNZ_ACF_CMD_DREF(et.leg2.drf_fuelsel, "aerobask/legacy/fuel_selector" ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_m_12_no, "sim/fuel/fuel_pump_1_off"      ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_m_12_st, "sim/fuel/fuel_pump_1_on"       ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_e_1_off, "aerobask/mag1_off"             ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_e_2_off, "aerobask/mag2_off"             ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_e_1_onn, "aerobask/mag1_on"              ),
+            XNZ_ACF_CMD_CMND(et.leg2.cmd_e_2_onn, "aerobask/mag2_on"              ),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XPLM,
+        .xnz_at = XNZ_AT_NONE,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_LEG2,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+    },
+    {
+        .name = "E55P",
+        .plugin = { { { "1-sim Phenom_300", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.e55p.drf_e_1_ign, "aerobask/engines/sw_ignition_1"    ),
+            XNZ_ACF_CMD_DREF(et.e55p.drf_e_2_ign, "aerobask/engines/sw_ignition_2"    ),
+            XNZ_ACF_CMD_DREF(et.e55p.drf_e_1_knb, "aerobask/engines/knob_start_stop_1"),
+            XNZ_ACF_CMD_DREF(et.e55p.drf_e_2_knb, "aerobask/engines/knob_start_stop_2"),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_ig_1_up, "aerobask/engines/ignition_1_up"    ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_ig_1_dn, "aerobask/engines/ignition_1_dn"    ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_ig_2_up, "aerobask/engines/ignition_2_up"    ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_ig_2_dn, "aerobask/engines/ignition_2_dn"    ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_e_1_lft, "aerobask/engines/knob_1_lt"        ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_e_1_rgt, "aerobask/engines/knob_1_rt"        ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_e_2_lft, "aerobask/engines/knob_2_lt"        ),
+            XNZ_ACF_CMD_CMND(et.e55p.cmd_e_2_rgt, "aerobask/engines/knob_2_rt"        ),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XGFC,
+        .xnz_at = XNZ_AT_NONE, // note: CSC controlled via A/P panel only
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_E55P,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+    },
+    {
+        .name = "EVIC",
+        .plugin = { { { "1-sim Victory G1000", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.evic.drf_fuel_at, "aerobask/lt_fuel_auto"            ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_e_1_onn, "sim/fuel/fuel_pump_1_on"          ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_e_1_off, "sim/fuel/fuel_pump_1_off"         ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_x_12_rt, "sim/starters/shut_down_1"         ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_e_2_tog, "aerobask/fuel_auto_toggle"        ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_x_12_lt, "sim/starters/engage_starter_1"    ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_m_12_st, "sim/igniters/igniter_contin_on_1" ),
+            XNZ_ACF_CMD_CMND(et.evic.cmd_m_12_no, "sim/igniters/igniter_contin_off_1"),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XGFC,
+        .xnz_at = XNZ_AT_NONE, // note: CSC controlled via A/P panel only
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_EVIC,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+        .share = { 0.500000f, 0.872725f, 0.971875f, }, // ~94% N1 @ PMDY/06, ~100% N1
+    },
+    /* must test SASL and Gizmo last */
+    {
+        .name = "PC12",
+        .string =
+        {
+            { XNZ_ACF_AUTH, { "Carenado", }, },
+            { XNZ_ACF_DESC, { "Pilatus PC12", }, },
+        },
+        .plugin =
+        {
+            { { "1-sim.sasl", }, 1, },
+            { { "thranda.xpl3d.cockpit", }, 1, },
+        },
+        .gate = 2, // SASL and thranda: CL30, EA50 not tested
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.rptp.drf_e_1_ign, "thranda/electrical/StarterIgn"),
+            XNZ_ACF_CMD_DREF(et.rptp.drf_e_1_eng, "thranda/electrical/StarterEng"),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XPLM,
+        .xnz_at = XNZ_AT_XPLM,
+        .xnz_bt = XNZ_BT_SIMC,
+        .xnz_et = XNZ_ET_RPTP,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+        .share = { 0.450000f, 0.700000f, 0.984375f, }, // low end of economy cruise (~28,000ft), ~95% NG @ PMDY/06, (1-(1/64))
+    },
+    {
+        .name = "CL30",
+        .string =
+        {
+            { XNZ_ACF_AUTH, { "Denis 'ddenn' Krupin", }, },
+            { XNZ_ACF_DESC, { "Bombardier Challenger 300", }, },
+        },
+        .plugin = { { { "1-sim.sasl", }, 1, }, }, // no gate: EA50 ends the SASL search
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XPLM,
+        .xnz_at = XNZ_AT_NONE, // note: MACH HOLD controlled via dedicated button only
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_CL30,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+    },
+    {
+        .name = "EA50",
+        .string =
+        {
+            { XNZ_ACF_AUTH, { "Aerobask", "Stephane Buon", }, },
+            { XNZ_ACF_ICAO, { "EA50", }, },
+        },
+        .plugin = { { { "1-sim.sasl", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.ea50.drf_mod_en1, "aerobask/eclipse/start_eng_0"),
+            XNZ_ACF_CMD_DREF(et.ea50.drf_mod_en2, "aerobask/eclipse/start_eng_1"),
+        },
+        .xnz_ab = XNZ_AB_NONE,
+        .xnz_ap = XNZ_AP_XPLM,
+        .xnz_at = XNZ_AT_XPLM,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_EA50,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+        .share = { 0.500000f, 0.872425f, 0.943875f, }, // ~94% N1 @ PMDY/06, ~100% N1
+    },
+    {
+        .name = "IXEG 737 Classic",
+        .string =
+        {
+            { XNZ_ACF_AUTH, { "IXEG", }, },
+            { XNZ_ACF_DESC, { "Boeing 737-300", }, },
+        },
+        .plugin = { { { "gizmo.x-plugins.com", }, 1, }, },
+        .gate = 1,
+        .refs =
+        {
+            XNZ_ACF_CMD_DREF(et.ix73.drf_e_1_cut, "ixeg/733/fuel/fuel_start_lever1_act"),
+            XNZ_ACF_CMD_DREF(et.ix73.drf_e_2_cut, "ixeg/733/fuel/fuel_start_lever2_act"),
+            XNZ_ACF_CMD_CMND(at.comm.cmd_at_disc, "ixeg/733/autopilot/at_disengage"    ),
+            XNZ_ACF_CMD_DREF(et.ix73.drf_e_1_knb, "ixeg/733/engine/eng1_start_act"     ),
+            XNZ_ACF_CMD_DREF(et.ix73.drf_e_2_knb, "ixeg/733/engine/eng2_start_act"     ),
+            XNZ_ACF_CMD_CMND(at.comm.cmd_at_toga, "sim/engines/TOGA_power"             ),
+        },
+        .xnz_ab = XNZ_AB_IX33,
+        .xnz_ap = XNZ_ACF_KEEP,
+        .xnz_at = XNZ_AT_COMM,
+        .xnz_bt = XNZ_BT_XPLM,
+        .xnz_et = XNZ_ET_IX73,
+        .xnz_pb = XNZ_PB_XPLM,
+        .xnz_tt = XNZ_TT_XPLM,
+    },
+};
+
+static int xnz_acf_string_match(const xnz_acf_string *s, const char *auth, const char *desc, const char *icao)
+{
+    const char *value;
+    switch (s->field)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/1/on/hold)\n"); goto fail;
+        case XNZ_ACF_AUTH:
+            value = auth;
+            break;
+        case XNZ_ACF_DESC:
+            value = desc;
+            break;
+        case XNZ_ACF_ICAO:
+            value = icao;
+            break;
+        default:
+            return 1;
     }
-    else
+    if (value == NULL)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_1_onh, &chandler_e_1_onh, 0, &global_context->commands);
+        return 0;
     }
-    if (NULL == (global_context->commands.cmd_e_1_onn = XPLMCreateCommand("xnz/tca/engines/1/on", "TCA: engine 1 to ON")))
+    for (size_t i = 0; i < sizeof(s->prefix) / sizeof(s->prefix[0]) && s->prefix[i]; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/1/on)\n"); goto fail;
+        if (!strncasecmp(value, s->prefix[i], strlen(s->prefix[i])))
+        {
+            return 1;
+        }
     }
-    else
+    return 0;
+}
+
+static int xnz_acf_plugin_match(const xnz_acf_plugin *p, const xnz_plugin_index *idx)
+{
+    if (p->signature[0] == NULL)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_1_onn, &chandler_e_1_onn, 0, &global_context->commands);
+        return 1;
     }
-    if (NULL == (global_context->commands.cmd_e_1_off = XPLMCreateCommand("xnz/tca/engines/1/off", "TCA: engine 1 to OFF")))
+    for (size_t i = 0; i < sizeof(p->signature) / sizeof(p->signature[0]) && p->signature[i]; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/1/off)\n"); goto fail;
+        int enabled; XPLMPluginID pid = xnz_plugin_index_find(idx, p->signature[i], &enabled);
+        if (XPLM_NO_PLUGIN_ID != pid && (p->require_enabled == 0 || enabled))
+        {
+            return 1;
+        }
     }
-    else
+    return 0;
+}
+
+static int xnz_acf_gate_match(const xnz_acf_profile *acf, const xnz_plugin_index *idx)
+{
+    for (int i = 0; i < acf->gate; i++)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_1_off, &chandler_e_1_off, 0, &global_context->commands);
+        if (xnz_acf_plugin_match(&acf->plugin[i], idx) == 0)
+        {
+            return 0;
+        }
     }
-    if (NULL == (global_context->commands.cmd_e_2_onh = XPLMCreateCommand("xnz/tca/engines/2/on/hold", "TCA: engine 2 ON hold")))
+    return acf->gate > 0;
+}
+
+static int xnz_acf_refs_resolve(const xnz_acf_profile *acf, xnz_context *ctx)
+{
+    for (size_t i = 0; i < sizeof(acf->refs) / sizeof(acf->refs[0]) && acf->refs[i].type != XNZ_ACF_REF_NONE; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/2/on/hold)\n"); goto fail;
+        const xnz_acf_ref *r = &acf->refs[i];
+        switch (r->type)
+        {
+            case XNZ_ACF_CMD_DREF:
+                if (NULL == (*(XPLMDataRef*)((char*)&ctx->cold->commands + r->offset) = XPLMFindDataRef(r->name)))
+                {
+                    xnz_log(XNZ_LOG_ERROR, "%s: dataref not found (%s)\n", acf->name, r->name);
+                    return -1;
+                }
+                break;
+            case XNZ_ACF_CMD_CMND:
+                if (NULL == (*(XPLMCommandRef*)((char*)&ctx->cold->commands + r->offset) = XPLMFindCommand(r->name)))
+                {
+                    xnz_log(XNZ_LOG_ERROR, "%s: command not found (%s)\n", acf->name, r->name);
+                    return -1;
+                }
+                break;
+            case XNZ_ACF_CTX_DREF:
+                if (NULL == (*(XPLMDataRef*)((char*)ctx + r->offset) = XPLMFindDataRef(r->name)))
+                {
+                    xnz_log(XNZ_LOG_ERROR, "%s: dataref not found (%s)\n", acf->name, r->name);
+                    return -1;
+                }
+                break;
+            default:
+                return -1;
+        }
     }
-    else
+    return 0;
+}
+
+/*
+ * Find the first matching profile, resolve its refs and set backend types;
+ * string predicates are tested before (more expensive) plugin lookups, and
+ * the search stops at the first profile whose gate matches.
+ * Returns the matched profile (NULL if none matched, or if its refs could
+ * not all be resolved, in which case all types are set to XNZ_*_ERRR).
+ */
+static const xnz_acf_profile* xnz_acf_detect(xnz_context *ctx, const char *auth, const char *desc, const char *icao)
+{
+    xnz_timing *timing = &ctx->cold->timing; const xnz_acf_profile *found = NULL; int stop = 0;
+    timing->probe_count = 0;
+    for (size_t i = 0; stop == 0 && i < sizeof(xnz_acf_profiles) / sizeof(xnz_acf_profiles[0]); i++)
+    {
+        const xnz_acf_profile *acf = &xnz_acf_profiles[i]; uint64_t t = xnz_time_ns();
+        if (xnz_acf_string_match(&acf->string[0], auth, desc, icao) &&
+            xnz_acf_string_match(&acf->string[1], auth, desc, icao) &&
+            xnz_acf_string_match(&acf->string[2], auth, desc, icao) &&
+            xnz_acf_plugin_match(&acf->plugin[0], &ctx->cold->plugins) &&
+            xnz_acf_plugin_match(&acf->plugin[1], &ctx->cold->plugins))
+        {
+            if (xnz_acf_refs_resolve(acf, ctx))
+            {
+                xnz_log(XNZ_LOG_ERROR, "could not self-configure for %s\n", acf->name);
+                ctx->cold->commands.xnz_ab = XNZ_AB_ERRR;
+                ctx->cold->commands.xnz_ap = XNZ_AP_ERRR;
+                ctx->cold->commands.xnz_at = XNZ_AT_ERRR;
+                ctx->cold->commands.xnz_bt = XNZ_BT_ERRR;
+                ctx->cold->commands.xnz_et = XNZ_ET_ERRR;
+                ctx->cold->commands.xnz_pb = XNZ_PB_ERRR;
+                ctx->                xnz_tt = XNZ_TT_ERRR;
+            }
+            else
+            {
+                if (acf->xnz_ab != XNZ_ACF_KEEP) ctx->cold->commands.xnz_ab = acf->xnz_ab;
+                if (acf->xnz_ap != XNZ_ACF_KEEP) ctx->cold->commands.xnz_ap = acf->xnz_ap;
+                if (acf->xnz_at != XNZ_ACF_KEEP) ctx->cold->commands.xnz_at = acf->xnz_at;
+                if (acf->xnz_bt != XNZ_ACF_KEEP) ctx->cold->commands.xnz_bt = acf->xnz_bt;
+                if (acf->xnz_et != XNZ_ACF_KEEP) ctx->cold->commands.xnz_et = acf->xnz_et;
+                if (acf->xnz_pb != XNZ_ACF_KEEP) ctx->cold->commands.xnz_pb = acf->xnz_pb;
+                if (acf->xnz_tt != XNZ_ACF_KEEP) ctx->                xnz_tt = acf->xnz_tt;
+                if (acf->on_match)
+                {
+                    acf->on_match(ctx);
+                }
+                found = acf;
+            }
+            stop = 1;
+        }
+        else if (xnz_acf_gate_match(acf, &ctx->cold->plugins))
+        {
+            xnz_log(XNZ_LOG_INFO, "%s: plugin found but aircraft not supported\n", acf->name);
+            stop = 1;
+        }
+        if (i < XNZ_TIMING_PROBES)
+        {
+            timing->probe_ms[i] = (float)((double)(xnz_time_ns() - t) / 1000000.0);
+            timing->probe_count = (int)i + 1;
+        }
+    }
+    return found;
+}
+
+/*
+ * Per-profile breakdown of the last detection (see xnz_acf_detect).
+ */
+static void xnz_acf_timing_log(const xnz_timing *timing)
+{
+    char line[512]; size_t len = 0;
+    if (timing->probe_count == 0)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_2_onh, &chandler_e_2_onh, 0, &global_context->commands);
+        return;
     }
-    if (NULL == (global_context->commands.cmd_e_2_onn = XPLMCreateCommand("xnz/tca/engines/2/on", "TCA: engine 2 to ON")))
+    for (int i = 0; i < timing->probe_count && len < sizeof(line); i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/2/on)\n"); goto fail;
+        int ret = snprintf(line + len, sizeof(line) - len, "%s%s=%.3f", i ? ", " : "", xnz_acf_profiles[i].name, timing->probe_ms[i]);
+        if (ret < 0)
+        {
+            break;
+        }
+        len += ret;
     }
-    else
+    xnz_log(XNZ_LOG_INFO, "timing (ms): probes: %s\n", line);
+}
+
+/*
+ * Generic defaults and aircraft profile detection (full probe chain):
+ * reads the aircraft's author, description and ICAO strings, assumes default
+ * X-Plane backends where nothing more specific is known, then matches the
+ * profile table. Returns the matched profile (NULL if none).
+ */
+static const xnz_acf_profile* xnz_acf_probe(xnz_context *ctx, const int acf_en_type[8])
+{
+    const xnz_acf_profile *acf;
+    XPLMDataRef ref; int enabled;
+    char auth[501] = "", desc[261] = "", icao[41] = ""; // empty: no profile string predicate matches
+    if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_author")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_2_onn, &chandler_e_2_onn, 0, &global_context->commands);
+        dref_read_str(ref, auth, sizeof(auth));
     }
-    if (NULL == (global_context->commands.cmd_e_2_off = XPLMCreateCommand("xnz/tca/engines/2/off", "TCA: engine 2 to OFF")))
+    if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_descrip")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/2/off)\n"); goto fail;
+        dref_read_str(ref, desc, sizeof(desc));
     }
-    else
+    if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_ICAO")))
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_2_off, &chandler_e_2_off, 0, &global_context->commands);
+        dref_read_str(ref, icao, sizeof(icao));
     }
-    if (NULL == (global_context->commands.cmd_e_3_onh = XPLMCreateCommand("xnz/tca/engines/3/on/hold", "TCA: engine 3 ON hold")))
+    if (ctx->cold->commands.xnz_ab == XNZ_AB_ERRR)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/1/on/hold)\n"); goto fail;
+        ctx->cold->commands.xnz_ab = XNZ_AB_NONE; // no reliable way to detect, enable on case-by-case basis below
     }
-    else
+    if (ctx->cold->commands.xnz_ap == XNZ_AP_ERRR)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_3_onh, &chandler_e_3_onh, 0, &global_context->commands);
+        if (ctx->cold->commands.xp_11_00_or_later)
+        {
+            if ((ref = XPLMFindDataRef("sim/aircraft/autopilot/preconfigured_ap_type")))
+            {
+                if (2 == XPLMGetDatai(ref)) // 2=GFC-700
+                {
+                    ctx->cold->commands.xnz_ap = XNZ_AP_XGFC;
+                }
+                else
+                {
+                    ctx->cold->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
+                }
+            }
+            else
+            {
+                ctx->cold->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
+            }
+        }
+        else
+        {
+            ctx->cold->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
+        }
     }
-    if (NULL == (global_context->commands.cmd_e_3_onn = XPLMCreateCommand("xnz/tca/engines/3/on", "TCA: engine 3 to ON")))
+    if (ctx->cold->commands.xnz_at == XNZ_AT_ERRR)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/3/on)\n"); goto fail;
+        if (ctx->cold->commands.xp_11_00_or_later)
+        {
+            if ((ref = XPLMFindDataRef("sim/aircraft/autopilot/preconfigured_ap_type")))
+            {
+                if (1 == XPLMGetDatai(ref)) // 1=Airliner
+                {
+                    ctx->cold->commands.xnz_ap = XNZ_AT_XP11;
+                }
+                else
+                {
+                    ctx->cold->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
+                }
+            }
+            else
+            {
+                ctx->cold->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
+            }
+        }
+        else
+        {
+            ctx->cold->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
+        }
     }
-    else
+    if (ctx->cold->commands.xnz_bt == XNZ_BT_ERRR)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_3_onn, &chandler_e_3_onn, 0, &global_context->commands);
+        if (((XPLM_NO_PLUGIN_ID != xnz_plugin_index_find(&ctx->cold->plugins, "com.simcoders.rep", &enabled)) && (enabled)))
+        {
+            ctx->cold->commands.xnz_bt = XNZ_BT_SIMC; // use parkbrake and slightly increased strength
+            ctx->cold->commands.xp.pbrak_onoff = -1; // initialize our parking brake tracking variable
+        }
+        else
+        {
+            ctx->cold->commands.xnz_bt = XNZ_BT_XPLM; // assume default X-Plane until proven otherwise
+            ctx->cold->commands.xp.pbrak_onoff = -1; // initialize our parking brake tracking variable
+        }
     }
-    if (NULL == (global_context->commands.cmd_e_3_off = XPLMCreateCommand("xnz/tca/engines/3/off", "TCA: engine 3 to OFF")))
+    if (ctx->cold->commands.xnz_et == XNZ_ET_ERRR)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/3/off)\n"); goto fail;
+        if (ctx->arcrft_engine_count >= 1 && ctx->arcrft_engine_count <= 4)
+        {
+            switch (acf_en_type[0])
+            {
+                case 0:
+                case 1: // carbureted/injected recip. engines
+                    ctx->cold->commands.xnz_et = XNZ_ET_XPPI;
+                    break;
+
+                case 2:
+                case 8: // free/fixed turbine engines
+                case 9: // turbine engine too (XP11+)
+                    ctx->cold->commands.xnz_et = XNZ_ET_XPTP;
+                    break;
+
+                case 4:
+                case 5: // low/high bypass jet engines
+                    ctx->cold->commands.xnz_et = XNZ_ET_XPJT;
+                    break;
+
+                default:
+                    ctx->cold->commands.xnz_et = XNZ_ET_NONE;
+                    break;
+            }
+        }
+        else
+        {
+            ctx->cold->commands.xnz_et = XNZ_ET_NONE;
+        }
     }
-    else
+    if (ctx->cold->commands.xnz_pb == XNZ_PB_ERRR)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_3_off, &chandler_e_3_off, 0, &global_context->commands);
+        ctx->cold->commands.xnz_pb = XNZ_PB_XPLM; // assume default X-Plane until proven otherwise
     }
-    if (NULL == (global_context->commands.cmd_e_4_onh = XPLMCreateCommand("xnz/tca/engines/4/on/hold", "TCA: engine 4 ON hold")))
+    if (ctx->xnz_tt == XNZ_TT_ERRR)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/4/on/hold)\n"); goto fail;
+        ctx->xnz_tt = XNZ_TT_XPLM; // assume default X-Plane until proven otherwise
     }
-    else
+    acf = xnz_acf_detect(ctx, auth, desc, icao);
+    if (ctx->xnz_tt == XNZ_TT_XPLM)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_4_onh, &chandler_e_4_onh, 0, &global_context->commands);
+#ifdef PUBLIC_RELEASE_BUILD
+        // built-in shares unused: per-aircraft profile files only (see xnz_profile_load)
+#else
+        if (acf && acf->share[2] > 0.0f)
+        {
+            ctx->cold->zones_base.share[ZONE_CLB] = acf->share[0];
+            ctx->cold->zones_base.share[ZONE_FLX] = acf->share[1] - ctx->cold->zones_base.share[ZONE_CLB];
+            ctx->cold->zones_base.share[ZONE_TGA] = acf->share[2] - ctx->cold->zones_base.share[ZONE_FLX] - ctx->cold->zones_base.share[ZONE_CLB];
+        }
+#endif
     }
-    if (NULL == (global_context->commands.cmd_e_4_onn = XPLMCreateCommand("xnz/tca/engines/4/on", "TCA: engine 4 to ON")))
+    return acf;
+}
+
+/*
+ * Order-independent combination of the loaded plugins' signature hashes and
+ * enabled states; zero if the index is incomplete (no caching possible).
+ */
+static uint64_t xnz_plugin_index_fingerprint(const xnz_plugin_index *idx)
+{
+    uint64_t fingerprint = idx->count;
+    if (idx->complete == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/4/on)\n"); goto fail;
+        return 0;
     }
-    else
+    for (uint32_t j = 0; j < XNZ_PLUGIN_INDEX_SLOTS; j++)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_4_onn, &chandler_e_4_onn, 0, &global_context->commands);
+        if (idx->slot[j].name)
+        {
+            uint64_t x = ((uint64_t)idx->slot[j].hash << 1) | (idx->slot[j].enabled != 0);
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull; // splitmix64 finalizer
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            fingerprint += x ^ (x >> 31);
+        }
+    }
+    return fingerprint ? fingerprint : 1;
+}
+
+/*
+ * X-Plane's preferences folder, with a trailing directory separator.
+ */
+static void xnz_prefs_dir(char *out, size_t size)
+{
+    char path[512];
+    XPLMGetPrefsPath(path); XPLMExtractFileAndPath(path);
+    snprintf(out, size, "%s%s", path, XPLMGetDirectorySeparator());
+}
+
+static void xnz_acf_cache_load(xnz_acf_cache *c)
+{
+    char path[512]; FILE *f;
+    xnz_prefs_dir(path, sizeof(path));
+    snprintf(c->filepath, sizeof(c->filepath), "%s%s", path, XNZ_XPLM_CACHE);
+    memset(c->entry, 0, sizeof(c->entry));
+    memset(&c->header, 0, sizeof(c->header));
+    if ((f = fopen(c->filepath, "rb")))
+    {
+        size_t size = offsetof(xnz_acf_cache, key);
+        if (fread(&c->header, 1, size, f) != size ||
+            c->header.magic != XNZ_ACF_CACHE_MAGIC ||
+            c->header.version != XNZ_ACF_CACHE_VERSION ||
+            c->header.entry_size != sizeof(xnz_acf_cache_entry))
+        {
+            xnz_log(XNZ_LOG_INFO, "ignoring detection cache \"%s\" (invalid or outdated)\n", c->filepath);
+            memset(c->entry, 0, sizeof(c->entry));
+            memset(&c->header, 0, sizeof(c->header));
+        }
+        fclose(f);
     }
-    if (NULL == (global_context->commands.cmd_e_4_off = XPLMCreateCommand("xnz/tca/engines/4/off", "TCA: engine 4 to OFF")))
+    c->header.magic = XNZ_ACF_CACHE_MAGIC;
+    c->header.version = XNZ_ACF_CACHE_VERSION;
+    c->header.entry_size = sizeof(xnz_acf_cache_entry);
+}
+
+static void xnz_acf_cache_save(xnz_acf_cache *c)
+{
+    char temp[sizeof(c->filepath) + 4]; FILE *f;
+    snprintf(temp, sizeof(temp), "%s.tmp", c->filepath);
+    if (NULL == (f = fopen(temp, "wb")))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPLMCreateCommand failed (xnz/tca/engines/4/off)\n"); goto fail;
+        xnz_log(XNZ_LOG_ERROR, "could not write detection cache \"%s\"\n", temp);
+        return;
     }
-    else
+    size_t size = offsetof(xnz_acf_cache, key);
+    if (fwrite(&c->header, 1, size, f) != size)
     {
-        XPLMRegisterCommandHandler(global_context->commands.cmd_e_4_off, &chandler_e_4_off, 0, &global_context->commands);
+        xnz_log(XNZ_LOG_ERROR, "could not write detection cache \"%s\"\n", temp);
+        fclose(f); remove(temp); return;
     }
-    global_context->commands.xp_11_00_or_later = (outXPlaneVersion > 10999);
-    global_context->commands.xp_11_50_or_later = (outXPlaneVersion > 11499);
+    fclose(f);
+#if IBM
+    remove(c->filepath); // rename does not replace existing files on Windows
 #endif
+    if (rename(temp, c->filepath))
+    {
+        xnz_log(XNZ_LOG_ERROR, "could not write detection cache \"%s\"\n", c->filepath);
+        remove(temp);
+    }
+}
 
-    /* Datarefs: axis input and XNZ-processed output */
-    if (NULL == (global_context->f_throt_inn = XPLMRegisterDataAccessor("xnz/throttle/ratio/inn",
-                                                                        xplmType_Float, 0,
-                                                                        NULL, NULL,
-                                                                        &XNZGetDataf, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        &global_context->avrg_throttle_inn, NULL)))
+/*
+ * Compute the current aircraft's cache key and look it up: on a hit, only
+ * the matched profile's refs are re-resolved. Sets *outCached to non-zero
+ * on success; on any mismatch or failure, the caller runs xnz_acf_probe.
+ */
+static const xnz_acf_profile* xnz_acf_cache_lookup(xnz_context *ctx, int *outCached)
+{
+    xnz_acf_cache *c = &ctx->cold->acf_cache; char file[256]; struct stat st;
+    *outCached = c->key_valid = 0;
+    if (c->filepath[0] == '\0')
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
+        xnz_acf_cache_load(c);
     }
-    if (NULL == (global_context->f_throt_out = XPLMRegisterDataAccessor("xnz/throttle/ratio/out",
-                                                                        xplmType_Float, 0,
-                                                                        NULL, NULL,
-                                                                        &XNZGetDataf, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        NULL, NULL,
-                                                                        &global_context->avrg_throttle_out, NULL)))
+    memset(&c->key, 0, sizeof(c->key));
+    XPLMGetNthAircraftModel(XPLM_USER_AIRCRAFT, file, c->key.path);
+    if (c->key.path[0] == '\0' || stat(c->key.path, &st))
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMRegisterDataAccessor)\n"); goto fail;
+        return NULL;
     }
-
-    /* TCA quadrant support: toggle on/off via menu */
-    if (NULL == (global_context->id_th_on_off = XPLMCreateMenu(XNZ_XPLM_TITLE, NULL, 0, &menu_hdlr_fnc, global_context)))
+    if ((c->key.plugins = xnz_plugin_index_fingerprint(&ctx->cold->plugins)) == 0)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMCreateMenu)\n"); goto fail;
+        return NULL;
     }
-    if (0 > (global_context->id_menu_item_on_off = XPLMAppendMenuItem(global_context->id_th_on_off, "TCA Throttle Quadrant", &global_context->id_menu_item_on_off, 0)))
+    c->key.fsize = st.st_size;
+    c->key.mtime = st.st_mtime;
+    c->key_valid = 1;
+    for (int i = 0; i < XNZ_ACF_CACHE_ENTRIES; i++)
     {
-        XPLMDebugString(XNZ_LOG_PREFIX"[error]: XPluginEnable failed (XPLMAppendMenuItem)\n"); goto fail;
+        xnz_acf_cache_entry *e = &c->entry[i];
+        if (e->last_use == 0 || strcmp(e->path, c->key.path))
+        {
+            continue;
+        }
+        if (e->fsize != c->key.fsize || e->mtime != c->key.mtime || e->plugins != c->key.plugins)
+        {
+            return NULL; // aircraft or plugins changed, entry will be replaced
+        }
+        const xnz_acf_profile *acf = NULL;
+        if (e->profile[0])
+        {
+            for (size_t j = 0; j < sizeof(xnz_acf_profiles) / sizeof(xnz_acf_profiles[0]); j++)
+            {
+                if (!strcmp(xnz_acf_profiles[j].name, e->profile))
+                {
+                    acf = &xnz_acf_profiles[j];
+                    break;
+                }
+            }
+            if (acf == NULL || xnz_acf_refs_resolve(acf, ctx))
+            {
+                return NULL;
+            }
+        }
+        ctx->cold->commands.xnz_ab = e->xnz_ab;
+        ctx->cold->commands.xnz_ap = e->xnz_ap;
+        ctx->cold->commands.xnz_at = e->xnz_at;
+        ctx->cold->commands.xnz_bt = e->xnz_bt;
+        ctx->cold->commands.xnz_et = e->xnz_et;
+        ctx->cold->commands.xnz_pb = e->xnz_pb;
+        ctx->cold->commands.xnz_sb = e->xnz_sb;
+        ctx->                xnz_tt = e->xnz_tt;
+        ctx->cold->commands.xp.pbrak_onoff = -1; // initialize our parking brake tracking variable
+        memcpy(ctx->cold->zones_base.share, e->share, sizeof(ctx->cold->zones_base.share));
+        if (acf && acf->on_match)
+        {
+            acf->on_match(ctx);
+        }
+        e->last_use = ++c->header.clock;
+        *outCached = 1;
+        return acf;
     }
-    XPLMCheckMenuItem(global_context->id_th_on_off, global_context->id_menu_item_on_off, xplm_Menu_Checked);
-
-    /* initialize detents, corresponding zone data */
-    update_thrust_zones(&global_context->zones_info);
-    default_throt_share(&global_context->zones_info);
-
-    /* all good */
-    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginEnable OK\n");
-    global_context->i_version_simulator = outXPlaneVersion;
-    global_context->i_version_xplm_apis = outXPLMVersion;
-    global_context->commands.xnz_ab = XNZ_AB_ERRR;
-    global_context->commands.xnz_ap = XNZ_AP_ERRR;
-    global_context->commands.xnz_at = XNZ_AT_ERRR;
-    global_context->commands.xnz_bt = XNZ_BT_ERRR;
-    global_context->commands.xnz_et = XNZ_ET_ERRR;
-    global_context->commands.xnz_pb = XNZ_PB_ERRR;
-    global_context->idx_throttle_axis_1 = -1;
-    global_context->tca_support_enabled = 1;
-    global_context->i_got_axis_input[0] = 0;
-    global_context->skip_idle_overwrite = 0;
-    global_context->i_context_init_done = 0;
-    global_context->xnz_tt = XNZ_TT_ERRR;
-    return 1;
+    return NULL;
+}
 
-fail:
-#ifndef PUBLIC_RELEASE_BUILD
-    if (global_context->widgetid[0] != 0)
+static void xnz_acf_cache_store(xnz_context *ctx, const xnz_acf_profile *acf)
+{
+    xnz_acf_cache *c = &ctx->cold->acf_cache; xnz_acf_cache_entry *e = NULL;
+    if (c->key_valid == 0 || ctx->xnz_tt == XNZ_TT_ERRR)
     {
-        XPDestroyWidget(global_context->widgetid[0], 1);
+        return; // no key, or detection failed (don't cache errors)
     }
-#endif
-    if (NULL != global_context)
+    for (int i = 0; i < XNZ_ACF_CACHE_ENTRIES; i++)
     {
-        free(global_context);
-        global_context = NULL;
+        if (c->entry[i].last_use && !strcmp(c->entry[i].path, c->key.path))
+        {
+            e = &c->entry[i]; // same aircraft: replace
+            break;
+        }
+        if (e == NULL || c->entry[i].last_use < e->last_use)
+        {
+            e = &c->entry[i]; // least recently used (or unused)
+        }
     }
-    return 0;
+    memcpy(e, &c->key, sizeof(*e));
+    snprintf(e->profile, sizeof(e->profile), "%s", acf ? acf->name : "");
+    e->xnz_ab = ctx->cold->commands.xnz_ab;
+    e->xnz_ap = ctx->cold->commands.xnz_ap;
+    e->xnz_at = ctx->cold->commands.xnz_at;
+    e->xnz_bt = ctx->cold->commands.xnz_bt;
+    e->xnz_et = ctx->cold->commands.xnz_et;
+    e->xnz_pb = ctx->cold->commands.xnz_pb;
+    e->xnz_sb = ctx->cold->commands.xnz_sb;
+    e->xnz_tt = ctx->                xnz_tt;
+    memcpy(e->share, ctx->cold->zones_base.share, sizeof(e->share));
+    e->last_use = ++c->header.clock;
+    xnz_acf_cache_save(c);
 }
 
-static void xnz_context_reset(xnz_context *ctx)
+/*
+ * Per-aircraft profile: <preferences>/<XNZ_XPLM_FOLDER>/<ICAO>.txt, applied
+ * on top of the detected backends (see XNZprofile.h for the file format);
+ * installs the aircraft's parameter block and points the watcher at it.
+ */
+static void xnz_profile_load(xnz_context *ctx)
 {
-    if (ctx)
+    char icao[41] = "", dir[1024], src[sizeof(dir) + sizeof(icao) + 4], err[1280];
+    XPLMDataRef ref; xnz_profile_map map = { 0, }; xnz_params *params; struct stat st; int ret = 1;
+    int apply_shares = ctx->xnz_tt == XNZ_TT_XPLM;
+    xnz_params_watch_clear(ctx);
+    if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_ICAO")))
     {
-#ifndef PUBLIC_RELEASE_BUILD
-        XPLMSetFlightLoopCallbackInterval(ctx->f_l_cb, 0, 1, ctx);
-        XPLMSetDataf(ctx->nullzone[0], ctx->prefs_nullzone[0]);
-        XPLMSetDataf(ctx->nullzone[1], ctx->prefs_nullzone[1]);
-        XPLMSetDataf(ctx->nullzone[2], ctx->prefs_nullzone[2]);
-        XPLMSetDataf(ctx->acf_roll_co, ctx->nominal_roll_coef);
-        if (XPIsWidgetVisible(ctx->widgetid[1]) != 0)
+        dref_read_str(ref, icao, sizeof(icao));
+    }
+    for (size_t i = 0; icao[i]; i++)
+    {
+        if (!isalnum((unsigned char)icao[i]) && icao[i] != '-' && icao[i] != '_')
         {
-            XPHideWidget(ctx->widgetid[0]);
-            XPHideWidget(ctx->widgetid[1]);
+            icao[0] = '\0'; // not usable as a file name
+            break;
         }
-#endif
-        XPLMSetFlightLoopCallbackInterval(ctx->f_l_th, 0, 1, ctx);
-        default_throt_share(&ctx->zones_info);
-        ctx->commands.xnz_at = XNZ_AT_ERRR;
-        ctx->commands.xnz_ab = XNZ_AB_ERRR;
-        ctx->commands.xnz_ap = XNZ_AP_ERRR;
-        ctx->commands.xnz_bt = XNZ_BT_ERRR;
-        ctx->commands.xnz_et = XNZ_ET_ERRR;
-        ctx->commands.xnz_pb = XNZ_PB_ERRR;
-        ctx->i_context_init_done = 0;
-        ctx->skip_idle_overwrite = 0;
-        ctx->xnz_tt = XNZ_TT_ERRR;
+    }
+    if (icao[0] != '\0')
+    {
+        xnz_prefs_dir(dir, sizeof(dir) - sizeof(XNZ_XPLM_FOLDER) - 1);
+        strcat(dir, XNZ_XPLM_FOLDER); strcat(dir, XPLMGetDirectorySeparator());
+        snprintf(src, sizeof(src), "%s%s.txt", dir, icao);
+        xnz_params_watch_set(ctx, dir, icao, apply_shares, stat(src, &st) ? NULL : &st);
+        if ((ret = xnz_profile_open(&map, dir, icao, err, sizeof(err))) < 0)
+        {
+            xnz_log(XNZ_LOG_ERROR, "profile %s\n", err); // watcher retries once the file changes
+        }
+    }
+    if (NULL == (params = xnz_params_create(&ctx->cold->zones_base, apply_shares, &map)))
+    {
+        xnz_log(XNZ_LOG_ERROR, "xnz_params_create failed\n");
+        return;
+    }
+    xnz_params_destroy(xnz_params_swap(ctx, params));
+    if (ret == 0)
+    {
+        xnz_log(XNZ_LOG_INFO, "using profile %s (flags 0x%02x%s)\n", src, params->map.profile->flags, params->map.mapped ? "" : ", not mapped");
     }
 }
 
-PLUGIN_API void XPluginDisable(void)
+/*
+ * Aircraft detection and axis capture, after the first livery of the user's
+ * aircraft was loaded (custom aircraft plugins are loaded by then, if any);
+ * run by init_hdlr_fnc once staged initialization is complete, since it needs
+ * the overlay and button references.
+ */
+static void xnz_aircraft_detect(xnz_context *ctx)
 {
-    xnz_context_reset(global_context);
-
+    uint64_t since = xnz_perf_enter(&ctx->cold->perf);
+    xnz_timing *timing = &ctx->cold->timing;
+    uint64_t t0 = xnz_time_ns(), t = t0;
 #ifndef PUBLIC_RELEASE_BUILD
-    XPLMUnregisterFlightLoopCallback(global_context->f_l_cb, global_context);
-    XPLMSetDataf(global_context->nullzone[0], global_context->prefs_nullzone[0]);
-    XPLMSetDataf(global_context->nullzone[1], global_context->prefs_nullzone[1]);
-    XPLMSetDataf(global_context->nullzone[2], global_context->prefs_nullzone[2]);
-    XPLMSetDataf(global_context->acf_roll_co, global_context->nominal_roll_coef);
-    if (XPIsWidgetVisible(global_context->widgetid[1]) != 0)
-    {
-        XPHideWidget(global_context->widgetid[0]);
-        XPHideWidget(global_context->widgetid[1]);
-    }
-    if (global_context->widgetid[0] != 0)
-    {
-        XPDestroyWidget(global_context->widgetid[0], 1);
-    }
-    if (global_context->print_ax)
-    {
-        XPLMUnregisterCommandHandler(global_context->print_ax, &chandler_printax, 0, global_context);
-    }
-    if (global_context->commands.cmd_ldg_upp) XPLMUnregisterCommandHandler(global_context->commands.cmd_ldg_upp, &chandler_ldg_upp, 0, &global_context->commands);
-    if (global_context->commands.cmd_ldg_dwn) XPLMUnregisterCommandHandler(global_context->commands.cmd_ldg_dwn, &chandler_ldg_dwn, 0, &global_context->commands);
-    if (global_context->commands.cmd_ldg_tog) XPLMUnregisterCommandHandler(global_context->commands.cmd_ldg_tog, &chandler_ldg_tog, 0, &global_context->commands);
-    if (global_context->commands.cmd_rgb_pkb) XPLMUnregisterCommandHandler(global_context->commands.cmd_rgb_pkb, &chandler_rgb_pkb, 0, &global_context->commands);
-    if (global_context->commands.cmd_rgb_hld) XPLMUnregisterCommandHandler(global_context->commands.cmd_rgb_hld, &chandler_rgb_hld, 0, &global_context->commands);
-    if (global_context->commands.cmd_pkb_tog) XPLMUnregisterCommandHandler(global_context->commands.cmd_pkb_tog, &chandler_pkb_tog, 0, &global_context->commands);
-    if (global_context->commands.cmd_pkb_onh) XPLMUnregisterCommandHandler(global_context->commands.cmd_pkb_onh, &chandler_pkb_onh, 0, &global_context->commands);
-    if (global_context->commands.cmd_pkb_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_pkb_onn, &chandler_pkb_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_pkb_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_pkb_off, &chandler_pkb_off, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_p_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_p_onn, &chandler_a_p_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_p_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_p_off, &chandler_a_p_off, 0, &global_context->commands);
-    if (global_context->commands.cmd_at_toga) XPLMUnregisterCommandHandler(global_context->commands.cmd_at_toga, &chandler_at_toga, 0, &global_context->commands);
-    if (global_context->commands.cmd_at_disc) XPLMUnregisterCommandHandler(global_context->commands.cmd_at_disc, &chandler_at_disc, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_12_lt) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_12_lt, &chandler_a_12_lt, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_12_rt) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_12_rt, &chandler_a_12_rt, 0, &global_context->commands);
-    if (global_context->commands.cmd_x_12_lt) XPLMUnregisterCommandHandler(global_context->commands.cmd_x_12_lt, &chandler_x_12_lt, 0, &global_context->commands);
-    if (global_context->commands.cmd_x_12_rt) XPLMUnregisterCommandHandler(global_context->commands.cmd_x_12_rt, &chandler_x_12_rt, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_34_lt) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_34_lt, &chandler_a_34_lt, 0, &global_context->commands);
-    if (global_context->commands.cmd_a_34_rt) XPLMUnregisterCommandHandler(global_context->commands.cmd_a_34_rt, &chandler_a_34_rt, 0, &global_context->commands);
-    if (global_context->commands.cmd_x_34_lt) XPLMUnregisterCommandHandler(global_context->commands.cmd_x_34_lt, &chandler_x_34_lt, 0, &global_context->commands);
-    if (global_context->commands.cmd_x_34_rt) XPLMUnregisterCommandHandler(global_context->commands.cmd_x_34_rt, &chandler_x_34_rt, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_12_ch) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_12_ch, &chandler_m_12_ch, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_12_cr) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_12_cr, &chandler_m_12_cr, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_12_no) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_12_no, &chandler_m_12_no, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_12_st) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_12_st, &chandler_m_12_st, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_12_sh) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_12_sh, &chandler_m_12_sh, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_34_ch) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_34_ch, &chandler_m_34_ch, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_34_cr) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_34_cr, &chandler_m_34_cr, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_34_no) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_34_no, &chandler_m_34_no, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_34_st) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_34_st, &chandler_m_34_st, 0, &global_context->commands);
-    if (global_context->commands.cmd_m_34_sh) XPLMUnregisterCommandHandler(global_context->commands.cmd_m_34_sh, &chandler_m_34_sh, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_1_onh) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_1_onh, &chandler_e_1_onh, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_1_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_1_onn, &chandler_e_1_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_1_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_1_off, &chandler_e_1_off, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_2_onh) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_2_onh, &chandler_e_2_onh, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_2_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_2_onn, &chandler_e_2_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_2_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_2_off, &chandler_e_2_off, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_3_onh) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_3_onh, &chandler_e_3_onh, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_3_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_3_onn, &chandler_e_3_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_3_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_3_off, &chandler_e_3_off, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_4_onh) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_4_onh, &chandler_e_4_onh, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_4_onn) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_4_onn, &chandler_e_4_onn, 0, &global_context->commands);
-    if (global_context->commands.cmd_e_4_off) XPLMUnregisterCommandHandler(global_context->commands.cmd_e_4_off, &chandler_e_4_off, 0, &global_context->commands);
+    ctx->nominal_roll_coef = XPLMGetDataf(ctx->acf_roll_co);
+    ctx->cold->prefs_nullzone[0] = XPLMGetDataf(ctx->nullzone[0]);
+    ctx->cold->prefs_nullzone[1] = XPLMGetDataf(ctx->nullzone[1]);
+    ctx->cold->prefs_nullzone[2] = XPLMGetDataf(ctx->nullzone[2]);
+    xnz_sched_invalidate(ctx);
+    xnz_log(XNZ_LOG_INFO, "new aircraft: original nullzones %.3lf %.3lf %.3lf (minimum %.3lf)\n",
+            ctx->cold->prefs_nullzone[0],
+            ctx->cold->prefs_nullzone[1],
+            ctx->cold->prefs_nullzone[2],
+            NULLZONE_MIN);
+    if (ctx->i_version_simulator < 11000)
+    {
+        float rc0 = ctx->nominal_roll_coef + xnz_sched_eval(ctx, XNZ_SCHED_ROLL, GROUNDSP_KTS_MIN);
+        float rc1 = ctx->nominal_roll_coef + xnz_sched_eval(ctx, XNZ_SCHED_ROLL, GROUNDSP_KTS_MID);
+        float rc2 = ctx->nominal_roll_coef + xnz_sched_eval(ctx, XNZ_SCHED_ROLL, GROUNDSP_KTS_MAX);
+        xnz_log(XNZ_LOG_INFO, "new aircraft: original roll coefficient %.3lf (%.3lf -> %.3lf -> %.3lf)\n",
+                ctx->nominal_roll_coef, rc0, rc1, rc2);
+    }
 #endif
+    // check for engine count, type and related info
+    if ((ctx->arcrft_engine_count = XPLMGetDatai(ctx->cold->i_ngine_num)) > 8)
+    {
+        ctx->arcrft_engine_count = 8;
+    }
+    else if (ctx->arcrft_engine_count < 1)
+    {
+        ctx->arcrft_engine_count = 1;
+    }
+    int acf_en_type[8]; XPLMGetDatavi(ctx->cold->i_ngine_typ, acf_en_type, 0, ctx->arcrft_engine_count);
+    if (ctx->arcrft_engine_count >= 2)
+    {
+        for (int i = ctx->arcrft_engine_count; i > 0; i--)
+        {
+            if (acf_en_type[i] != acf_en_type[0]) // some Carenado have extra engine for special effects
+            {
+                ctx->arcrft_engine_count--;
+                continue;
+            }
+            continue;
+        }
+    }
+    switch (acf_en_type[0])
+    {
+        case 2: // turboprop
+        case 8: // turboprop
+        case 9: // turboprop (XP11+, not documented in Datarefs.txt)
+            ctx->acf_has_beta_thrust = XPLMGetDatai(ctx->cold->rev_info[0]) != 0;
+            ctx->acft_has_rev_thrust =
+            (XPLMGetDatai(ctx->cold->rev_info[1]) != 0 &&
+             XPLMGetDataf(ctx->cold->rev_info[2]) >= .01f);
+            break;
 
-    XPLMUnregisterFlightLoopCallback(global_context->f_l_th, global_context);
+        case 4: // turbojet
+        case 5: // turbofan
+            ctx->acf_has_beta_thrust = 0;
+            ctx->acft_has_rev_thrust =
+            (XPLMGetDatai(ctx->cold->rev_info[1]) != 0 &&
+             XPLMGetDataf(ctx->cold->rev_info[2]) >= .01f);
+            break;
 
-    /* Datarefs: axis input and XNZ-processed output */
-    if (global_context->f_throt_inn)
+        default:
+            ctx->acf_has_beta_thrust = 0;
+            ctx->acft_has_rev_thrust = 0;
+            break;
+    }
+    /*
+     * XXX: disable globally; re-enable on a case-by-case basis until
+     * I can get a better understanding of X-Plane's default behavior…
+     */
+    ctx->acf_has_beta_thrust = 0;
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_ENGINES, t);
+
+    /* check for custom thrust datarefs/API */
+    xnz_plugin_index_build(&ctx->cold->plugins);
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_PLUGINS, t);
+    int cached; const xnz_acf_profile *acf = xnz_acf_cache_lookup(ctx, &cached);
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_CACHE, t);
+    if (cached == 0)
     {
-        XPLMUnregisterDataAccessor(global_context->f_throt_inn);
-        global_context->f_throt_inn = NULL;
+        acf = xnz_acf_probe(ctx, acf_en_type);
     }
-    if (global_context->f_throt_out)
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_PROBE, t);
+    if (cached == 0)
     {
-        XPLMUnregisterDataAccessor(global_context->f_throt_out);
-        global_context->f_throt_out = NULL;
+        xnz_acf_cache_store(ctx, acf);
     }
-
-    /* re-enable throttle 1/2 axes */
-    if (global_context->idx_throttle_axis_1 >= 0)
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_STORE, t);
+    xnz_log(XNZ_LOG_INFO, "determined aircraft profile %s%s\n", acf ? acf->name : "(none)", cached ? " (cached)" : "");
+    xnz_profile_load(ctx);
+    t = xnz_timing_mark(timing, XNZ_PHASE_LV_PROFILE, t);
+    if (cached == 0)
     {
-        int th_axis_ass[2] = { 20, 21, };
-        xnz_log("[info]: releasing joystick axes (XPluginDisable)\n");
-        XPLMSetDatavi(global_context->i_stick_ass, th_axis_ass, global_context->idx_throttle_axis_1, 2);
+        xnz_acf_timing_log(timing);
     }
+    xnz_log(XNZ_LOG_INFO, "determined engine type %d\n",     ctx->cold->commands.xnz_et);
+    xnz_log(XNZ_LOG_INFO, "determined braking type %d\n",    ctx->cold->commands.xnz_bt);
+    xnz_log(XNZ_LOG_INFO, "determined a/brake type %d\n",    ctx->cold->commands.xnz_ab);
+    xnz_log(XNZ_LOG_INFO, "determined a/pilot type %d\n",    ctx->cold->commands.xnz_ap);
+    xnz_log(XNZ_LOG_INFO, "determined throttle type %d\n",   ctx->         xnz_tt);
+    xnz_log(XNZ_LOG_INFO, "determined a/thrust type %d\n",   ctx->cold->commands.xnz_at);
+    xnz_log(XNZ_LOG_INFO, "determined park brake type %d\n", ctx->cold->commands.xnz_pb);
 
-    /* close context */
-    if (NULL != global_context)
+    /* TCA thrust quadrant support */
+    if (ctx->idx_throttle_axis_1 < 0) // detection: runs only once
     {
-        free(global_context);
-        global_context = NULL;
+        size_t size = ctx->i_version_simulator < 11000 ? 100 : 500;
+        for (size_t i = 0; i < size - 1; i++)
+        {
+            int i_stick_ass[2]; XPLMGetDatavi(ctx->cold->i_stick_ass, i_stick_ass, i, 2);
+            if (i_stick_ass[0] == 20 && i_stick_ass[1] == 21)
+            {
+                xnz_log(XNZ_LOG_INFO, "found throttle 1/2 axes at index (%02zd, %02zd) with assignment (%02d, %02d)\n", i, i + 1, i_stick_ass[0], i_stick_ass[1]);
+                ctx->idx_throttle_axis_1 = i;
+                break;
+            }
+        }
+        if (ctx->idx_throttle_axis_1 >= 0 && 0 /* debug */)
+        {
+            xnz_log(XNZ_LOG_DEBUG, "throttle_mapping ---------------\n");
+            float last = -2.0f;
+            int detents[3] =
+            {
+                roundf(TCA_IDLE_CTR * 200.0f),
+                roundf(TCA_CLMB_CTR * 200.0f),
+                roundf(TCA_FLEX_CTR * 200.0f),
+            };
+            for (int i = 0; i <= 200; i++)
+            {
+                float input, value = throttle_mapping((input = ((float)i / 200.0f)), ctx->params->zones);
+                if (value < last)
+                {
+                    xnz_log(XNZ_LOG_DEBUG, "non-monotonically increasing throttle mapping, %.4f -> %.4f\n", last, value);
+                    exit(-1);
+                }
+                if (i == detents[0] || i == detents[1] || i == detents[2])
+                {
+                    xnz_log(XNZ_LOG_DEBUG, "throttle_mapping ---------------\n");
+                }
+                if (value < 0.0f)
+                {
+                    xnz_log(XNZ_LOG_DEBUG, "throttle_mapping(%.3f) = %.3f\n", input, (last = value));
+                }
+                else
+                {
+                    xnz_log(XNZ_LOG_DEBUG, "throttle_mapping(%.3f) = %.4f\n", input, (last = value));
+                }
+                if (i == detents[0] || i == detents[1] || i == detents[2])
+                {
+                    xnz_log(XNZ_LOG_DEBUG, "throttle_mapping ---------------\n");
+                }
+            }
+            xnz_log(XNZ_LOG_DEBUG, "throttle_mapping ---------------\n");
+        }
     }
-
-    /* all good */
-    XPLMDebugString(XNZ_LOG_PREFIX"[info]: XPluginDisable OK\n");
-}
-
-static inline void dref_read_str(XPLMDataRef ref, char *buf, size_t siz)
-{
-    if (ref && buf && siz)
+    xnz_context_sync(ctx);
+    if (ctx->idx_throttle_axis_1 >= 0) // capture: run every initial aircraft+livery reload
     {
-        int len = XPLMGetDatab(ref, buf, 0, siz - 1);
-        if (len > 0)
+#ifdef PUBLIC_RELEASE_BUILD
+        // TODO: implement A320 API support
+        if (ctx->xnz_tt == XNZ_TT_FF32)
         {
-            buf[siz - 1] = '\0';
-            return;
+            int th_axis_ass[2] = { 20, 21, };
+            xnz_log(XNZ_LOG_INFO, "releasing joystick axes (XNZ_TT_FF32)\n");
+            XPLMSetDatavi(ctx->cold->i_stick_ass, th_axis_ass, ctx->idx_throttle_axis_1, 2);
         }
-        buf[0] = '\0';
-        return;
+        else
+#endif
+        {
+            if (ctx->tca_support_enabled)
+            {
+                int no_axis_ass[2] = { 0, 0, };
+                xnz_log(XNZ_LOG_INFO, "capturing/re-capturing joystick axes (flight loop enabled)\n");
+                XPLMSetDatavi(ctx->cold->i_stick_ass, no_axis_ass, ctx->idx_throttle_axis_1, 2);
+            }
+        }
+        ctx->skip_idle_overwrite = 0; XPLMSetFlightLoopCallbackInterval(ctx->cold->f_l_th, 1, 1, ctx);
+        xnz_log(XNZ_LOG_INFO, "setting TCA flight loop callback interval (enabled: %d)\n", ctx->tca_support_enabled);
+        xnz_log(XNZ_LOG_INFO, "engine type %d beta %d (%d) reverse %d (%d, %f)\n",
+                acf_en_type[0],
+                ctx->acf_has_beta_thrust,
+                XPLMGetDatai(ctx->cold->rev_info[0]),
+                ctx->acft_has_rev_thrust,
+                XPLMGetDatai(ctx->cold->rev_info[1]),
+                XPLMGetDataf(ctx->cold->rev_info[2]));
+    }
+    xnz_perf_record(&ctx->cold->perf, XNZ_PERF_CAPTURE, xnz_timing_mark(timing, XNZ_PHASE_LV_AXES, t) - t);
+    xnz_timing_mark(timing, XNZ_PHASE_LV_TOTAL, t0);
+    xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_LIVERY, since);
+    xnz_timing_log(timing, XNZ_PHASE_LV_TOTAL, XNZ_PHASE_LV_AXES);
+
+#ifndef PUBLIC_RELEASE_BUILD
+    ctx->ice_detect_positive = 0;
+    ctx->icecheck_required = 0.0f;
+    ctx->show_throttle_all = 0.0f;
+    ctx->last_throttle_all = XPLMGetDataf(ctx->f_throttall);
+    if (ctx->cold->f_l_cb)
+    {
+        XPLMSetFlightLoopCallbackInterval(ctx->cold->f_l_cb, 1, 1, ctx);
     }
-    return;
+#endif
+    ctx->cold->i_context_init_done = 1;
 }
 
-/*
- * TODO: future: XNZ_AP_COMM
- *
- * ToLiSS A319, A321
- * ctx->otto.conn.cc.name = "toliss_airbus/ap1_push";
- * ctx->otto.disc.cc.name = "toliss_airbus/ap_disc_left_stick";
- *
- * FlightFactor A350 (X-Plane 10)
- * ctx->otto.conn.cc.name = "airbus_qpac/ap1_push";
- * ctx->otto.disc.cc.name = "sim/autopilot/fdir_servos_down_one";
- *
- * FlightFactor A350 (X-Plane 11)
- * ctx->otto.conn.cc.name = "airbus_qpac/ap1_push";
- * ctx->otto.disc.cc.name = "airbus_qpac/ap_disc_left_stick";
- *
- * IXEG 737-300 Classic
- * ctx->otto.conn.cc.name = "ixeg/733/autopilot/AP_A_cmd_toggle";
- * ctx->otto.disc.cc.name = "ixeg/733/autopilot/AP_disengage";
- *
- * FlightFactor 757, 767
- * ctx->otto.conn.cc.name = NULL; // try to find a dataref maybe???
- * ctx->otto.disc.cc.name = "1-sim/comm/AP/ap_disc";
- */
-
 PLUGIN_API void XPluginReceiveMessage(XPLMPluginID inFromWho, long inMessage, void *inParam)
 {
-    if (global_context->msg_will_write_pref != 0)
+    if (global_context->cold->msg_will_write_pref != 0)
     {
         if (global_context->idx_throttle_axis_1 >= 0 && global_context->tca_support_enabled != 0)
         {
             int no_axis_ass[2] = { 0, 0, };
-            xnz_log("[info]: re-capturing joystick axes (XPLM_MSG_WILL_WRITE_PREFS done)\n");
-            XPLMSetDatavi(global_context->i_stick_ass, no_axis_ass, global_context->idx_throttle_axis_1, 2);
+            xnz_log(XNZ_LOG_INFO, "re-capturing joystick axes (XPLM_MSG_WILL_WRITE_PREFS done)\n");
+            XPLMSetDatavi(global_context->cold->i_stick_ass, no_axis_ass, global_context->idx_throttle_axis_1, 2);
         }
-        global_context->msg_will_write_pref = 0;
+        global_context->cold->msg_will_write_pref = 0;
     }
     switch (inMessage)
     {
         case XPLM_MSG_WILL_WRITE_PREFS:
 #ifndef PUBLIC_RELEASE_BUILD
-            XPLMSetDataf(global_context->nullzone[0], global_context->prefs_nullzone[0]);
-            XPLMSetDataf(global_context->nullzone[1], global_context->prefs_nullzone[1]);
-            XPLMSetDataf(global_context->nullzone[2], global_context->prefs_nullzone[2]);
-            XPLMSetDataf(global_context->acf_roll_co, global_context->nominal_roll_coef);
+            if (global_context->cold->f_l_cb)
+            {
+                XPLMSetDataf(global_context->nullzone[0], global_context->cold->prefs_nullzone[0]);
+                XPLMSetDataf(global_context->nullzone[1], global_context->cold->prefs_nullzone[1]);
+                XPLMSetDataf(global_context->nullzone[2], global_context->cold->prefs_nullzone[2]);
+                XPLMSetDataf(global_context->acf_roll_co, global_context->nominal_roll_coef);
+                xnz_sched_invalidate(global_context);
+            }
 #endif
             if (global_context->idx_throttle_axis_1 >= 0)
             {
                 int th_axis_ass[2] = { 20, 21, };
-                global_context->msg_will_write_pref = 1;
-                xnz_log("[info]: releasing joystick axes (XPLM_MSG_WILL_WRITE_PREFS)\n");
-                XPLMSetDatavi(global_context->i_stick_ass, th_axis_ass, global_context->idx_throttle_axis_1, 2);
+                global_context->cold->msg_will_write_pref = 1;
+                xnz_log(XNZ_LOG_INFO, "releasing joystick axes (XPLM_MSG_WILL_WRITE_PREFS)\n");
+                XPLMSetDatavi(global_context->cold->i_stick_ass, th_axis_ass, global_context->idx_throttle_axis_1, 2);
             }
             return;
 
@@ -1782,7 +4768,7 @@ PLUGIN_API void XPluginReceiveMessage(XPLMPluginID inFromWho, long inMessage, vo
         case XPLM_MSG_PLANE_LOADED:
             if (inParam == XPLM_USER_AIRCRAFT) // user's plane changing
             {
-                global_context->i_context_init_done = 0;
+                global_context->cold->i_context_init_done = 0;
                 return;
             }
             break;
@@ -1794,3342 +4780,5282 @@ PLUGIN_API void XPluginReceiveMessage(XPLMPluginID inFromWho, long inMessage, vo
             }
             else // deferred initialization: wait for initial livery load after aircraft load -> custom aircraft plugins loaded, if any (for custom datarefs)
             {
-                if (global_context->i_context_init_done)
+                if (global_context->cold->i_context_init_done)
                 {
                     break; // don't re-init on subsequent livery changes
                 }
+                global_context->cold->init.detect_pending = 1; // once staged init is complete
+                XPLMSetFlightLoopCallbackInterval(global_context->cold->init.f_l_in, -1.0f, 1, global_context);
+                return;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static int autothrottle_active(xnz_context *ctx)
+{
+    switch (ctx->xnz_at)
+    {
+        case XNZ_AT_FF32:
+        case XNZ_AT_TOLI:
+            return 0;
+
+        default:
+            if (ctx->xnz_tt == XNZ_TT_XPLM)
+            {
+                return 0 < XPLMGetDatai(ctx->auto_thr_on);
+            }
+            break;
+    }
+    return 0;
+}
+
+static int servos_on(xnz_context *ctx)
+{
+    return 0 < XPLMGetDatai(ctx->auto_pil_on);
+}
+
 #ifndef PUBLIC_RELEASE_BUILD
-                global_context->minimum_null_zone = 0.04f; // hardcoded for now
-                global_context->nominal_roll_coef = XPLMGetDataf(global_context->acf_roll_co);
-                global_context->prefs_nullzone[0] = XPLMGetDataf(global_context->nullzone[0]);
-                global_context->prefs_nullzone[1] = XPLMGetDataf(global_context->nullzone[1]);
-                global_context->prefs_nullzone[2] = XPLMGetDataf(global_context->nullzone[2]);
-                xnz_log("new aircraft: original nullzones %.3lf %.3lf %.3lf (minimum %.3lf)\n",
-                        global_context->prefs_nullzone[0],
-                        global_context->prefs_nullzone[1],
-                        global_context->prefs_nullzone[2],
-                        global_context->minimum_null_zone);
-                if (global_context->i_version_simulator < 11000)
-                {
-                    float rc0; ACF_ROLL_SET(rc0, GROUNDSP_KTS_MIN, global_context->nominal_roll_coef);
-                    float rc1; ACF_ROLL_SET(rc1, GROUNDSP_KTS_MID, global_context->nominal_roll_coef);
-                    float rc2; ACF_ROLL_SET(rc2, GROUNDSP_KTS_MAX, global_context->nominal_roll_coef);
-                    xnz_log("new aircraft: original roll coefficient %.3lf (%.3lf -> %.3lf -> %.3lf)\n",
-                            global_context->nominal_roll_coef, rc0, rc1, rc2);
-                }
-#endif
-                // check for engine count, type and related info
-                if ((global_context->arcrft_engine_count = XPLMGetDatai(global_context->i_ngine_num)) > 8)
-                {
-                    global_context->arcrft_engine_count = 8;
-                }
-                else if (global_context->arcrft_engine_count < 1)
+
+static float callback_hdlr(float inElapsedSinceLastCall,
+                           float inElapsedTimeSinceLastFlightLoop,
+                           int   inCounter,
+                           void *inRefcon)
+{
+    if (inRefcon)
+    {
+        xnz_context *ctx = inRefcon; uint64_t t0 = xnz_perf_enter(&ctx->cold->perf); xnz_params_acquire(ctx);
+        float f_throttall, array[2];
+        float airspeed = XPLMGetDataf(ctx->f_air_speed);
+        float groundsp = MPS2KTS(XPLMGetDataf(ctx->f_grd_speed));
+
+        /* X-Plane 10: update ground roll friction coefficient as required */
+        if (ctx->i_version_simulator < 11000)
+        {
+            float roll_coef = ctx->nominal_roll_coef;
+            if (XPLMGetDatai(ctx->ongroundany))
+            {
+                roll_coef += xnz_sched_eval(ctx, XNZ_SCHED_ROLL, groundsp);
+            }
+            if (xnz_sched_update(ctx, XNZ_SCHED_ROLL, roll_coef))
+            {
+                XPLMSetDataf(ctx->acf_roll_co, roll_coef);
+            }
+        }
+
+        if (ctx->xnz_tt == XNZ_TT_FF32 && !ctx->tt.ff32.api_has_initialized)
+        {
+            XPLMSendMessageToPlugin(ctx->tt.ff32.pid, XPLM_FF_MSG_GET_SHARED_INTERFACE, &ctx->cold->ff32);
+            if (ctx->cold->ff32.DataVersion != NULL && ctx->cold->ff32.DataAddUpdate != NULL)
+            {
+                ctx->tt.ff32.id_f32_eng_lever_lt = ctx->cold->ff32.ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever1");
+                ctx->tt.ff32.id_f32_eng_lever_rt = ctx->cold->ff32.ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever2");
+                if (ctx->tt.ff32.id_f32_eng_lever_lt > -1 && ctx->tt.ff32.id_f32_eng_lever_rt > -1)
                 {
-                    global_context->arcrft_engine_count = 1;
+                    ctx->tt.ff32.api_has_initialized = 1;
                 }
-                int acf_en_type[8]; XPLMGetDatavi(global_context->i_ngine_typ, acf_en_type, 0, global_context->arcrft_engine_count);
-                if (global_context->arcrft_engine_count >= 2)
+            }
+        }
+
+        /* throttle readout (overlay) */
+        switch (ctx->xnz_tt)
+        {
+            case XNZ_TT_FF32:
+            {
+                if (ctx->tt.ff32.api_has_initialized)
                 {
-                    for (int i = global_context->arcrft_engine_count; i > 0; i--)
+                    // Pedestal.EngineLever*: 0-20-65 (reverse-idle-max)
+                    ctx->cold->ff32.ValueGet(ctx->tt.ff32.id_f32_eng_lever_lt, &array[0]);
+                    ctx->cold->ff32.ValueGet(ctx->tt.ff32.id_f32_eng_lever_rt, &array[1]);
+                    if ((f_throttall = (((array[0] + array[1]) / 2.0f) - 20.0f) / 45.0f) < 0.0f)
                     {
-                        if (acf_en_type[i] != acf_en_type[0]) // some Carenado have extra engine for special effects
-                        {
-                            global_context->arcrft_engine_count--;
-                            continue;
-                        }
-                        continue;
+                        (f_throttall = (((array[0] + array[1]) / 2.0f) - 20.0f) / 20.0f);
                     }
+                    break;
                 }
-                switch (acf_en_type[0])
-                {
-                    case 2: // turboprop
-                    case 8: // turboprop
-                    case 9: // turboprop (XP11+, not documented in Datarefs.txt)
-                        global_context->acf_has_beta_thrust = XPLMGetDatai(global_context->rev_info[0]) != 0;
-                        global_context->acft_has_rev_thrust =
-                        (XPLMGetDatai(global_context->rev_info[1]) != 0 &&
-                         XPLMGetDataf(global_context->rev_info[2]) >= .01f);
-                        break;
-
-                    case 4: // turbojet
-                    case 5: // turbofan
-                        global_context->acf_has_beta_thrust = 0;
-                        global_context->acft_has_rev_thrust =
-                        (XPLMGetDatai(global_context->rev_info[1]) != 0 &&
-                         XPLMGetDataf(global_context->rev_info[2]) >= .01f);
-                        break;
+            } // fallthrough
+            case XNZ_TT_ERRR:
+                f_throttall = ctx->last_throttle_all;
+                break;
 
-                    default:
-                        global_context->acf_has_beta_thrust = 0;
-                        global_context->acft_has_rev_thrust = 0;
-                        break;
-                }
-                /*
-                 * XXX: disable globally; re-enable on a case-by-case basis until
-                 * I can get a better understanding of X-Plane's default behavior…
-                 */
-                global_context->acf_has_beta_thrust = 0;
-
-                /* check for custom thrust datarefs/API */
-                int auth_desc_icao = 0;
-                XPLMDataRef ref; XPLMPluginID pid;
-                char auth[501], desc[261], icao[41];
-                if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_author")))
-                {
-                    dref_read_str(ref, auth, sizeof(auth));
-                    if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_descrip")))
-                    {
-                        dref_read_str(ref, desc, sizeof(desc));
-                        if ((ref = XPLMFindDataRef("sim/aircraft/view/acf_ICAO")))
-                        {
-                            dref_read_str(ref, icao, sizeof(icao));
-                            auth_desc_icao = 1;
-                        }
-                    }
-                }
-                if (global_context->commands.xnz_ab == XNZ_AB_ERRR)
-                {
-                    global_context->commands.xnz_ab = XNZ_AB_NONE; // no reliable way to detect, enable on case-by-case basis below
-                }
-                if (global_context->commands.xnz_ap == XNZ_AP_ERRR)
-                {
-                    if (global_context->commands.xp_11_00_or_later)
-                    {
-                        if ((ref = XPLMFindDataRef("sim/aircraft/autopilot/preconfigured_ap_type")))
-                        {
-                            if (2 == XPLMGetDatai(ref)) // 2=GFC-700
-                            {
-                                global_context->commands.xnz_ap = XNZ_AP_XGFC;
-                            }
-                            else
-                            {
-                                global_context->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
-                            }
-                        }
-                        else
-                        {
-                            global_context->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
-                        }
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ap = XNZ_AP_XPLM; // assume default X-Plane until proven otherwise
-                    }
-                }
-                if (global_context->commands.xnz_at == XNZ_AT_ERRR)
-                {
-                    if (global_context->commands.xp_11_00_or_later)
-                    {
-                        if ((ref = XPLMFindDataRef("sim/aircraft/autopilot/preconfigured_ap_type")))
-                        {
-                            if (1 == XPLMGetDatai(ref)) // 1=Airliner
-                            {
-                                global_context->commands.xnz_ap = XNZ_AT_XP11;
-                            }
-                            else
-                            {
-                                global_context->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
-                            }
-                        }
-                        else
-                        {
-                            global_context->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
-                        }
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_at = XNZ_AT_NONE; // no reliable way to detect, enable on case-by-case basis below
-                    }
-                }
-                if (global_context->commands.xnz_bt == XNZ_BT_ERRR)
-                {
-                    if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("com.simcoders.rep"))) && (XPLMIsPluginEnabled(pid))))
-                    {
-                        global_context->commands.xnz_bt = XNZ_BT_SIMC; // use parkbrake and slightly increased strength
-                        global_context->commands.xp.pbrak_onoff = -1; // initialize our parking brake tracking variable
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM; // assume default X-Plane until proven otherwise
-                        global_context->commands.xp.pbrak_onoff = -1; // initialize our parking brake tracking variable
-                    }
-                }
-                if (global_context->commands.xnz_et == XNZ_ET_ERRR)
-                {
-                    if (global_context->arcrft_engine_count >= 1 && global_context->arcrft_engine_count <= 4)
-                    {
-                        switch (acf_en_type[0])
-                        {
-                            case 0:
-                            case 1: // carbureted/injected recip. engines
-                                global_context->commands.xnz_et = XNZ_ET_XPPI;
-                                break;
-
-                            case 2:
-                            case 8: // free/fixed turbine engines
-                            case 9: // turbine engine too (XP11+)
-                                global_context->commands.xnz_et = XNZ_ET_XPTP;
-                                break;
-
-                            case 4:
-                            case 5: // low/high bypass jet engines
-                                global_context->commands.xnz_et = XNZ_ET_XPJT;
-                                break;
-
-                            default:
-                                global_context->commands.xnz_et = XNZ_ET_NONE;
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_et = XNZ_ET_NONE;
-                    }
-                }
-                if (global_context->commands.xnz_pb == XNZ_PB_ERRR)
-                {
-                    global_context->commands.xnz_pb = XNZ_PB_XPLM; // assume default X-Plane until proven otherwise
-                }
-                if (global_context->xnz_tt == XNZ_TT_ERRR)
-                {
-                    global_context->xnz_tt = XNZ_TT_XPLM; // assume default X-Plane until proven otherwise
-                }
-                if ((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature(XPLM_FF_SIGNATURE))) && (XPLMIsPluginEnabled(pid)))
-                {
-                    global_context->  commands.xnz_ab = XNZ_AB_FF32;
-                    global_context->  commands.xnz_ap = XNZ_AP_FF32;
-                    global_context->  commands.xnz_at = XNZ_AT_FF32;
-                    global_context->  commands.xnz_bt = XNZ_BT_FF32;
-                    global_context->  commands.xnz_et = XNZ_ET_FF32;
-                    global_context->  commands.xnz_pb = XNZ_PB_FF32;
-                    global_context->           xnz_tt = XNZ_TT_FF32;
-                    global_context->tt.ff32.api_has_initialized = 0;
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("XP10.ToLiss.A319.systems"))) && (XPLMIsPluginEnabled(pid))) ||
-                         ((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("XP10.ToLiss.A321.systems"))) && (XPLMIsPluginEnabled(pid))) ||
-                         ((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("XP11.ToLiss.A319.systems"))) && (XPLMIsPluginEnabled(pid))) ||
-                         ((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("XP11.ToLiss.A321.systems"))) && (XPLMIsPluginEnabled(pid))))
-                {
-                    if (NULL == (global_context->         tt.toli.f_thr_array = XPLMFindDataRef("AirbusFBW/throttle_input"                         )) ||
-                        NULL == (global_context->commands.pb.to32.pbrak_onoff = XPLMFindDataRef("AirbusFBW/ParkBrake"                              )) ||
-// that was the bug :-( NULL == (global_context->commands.bt.to32.l_rgb_ratio = XPLMFindDataRef("AirbusFBW/BrakePedalInputleft"                    )) || // studid typo :-(
-                        NULL == (global_context->commands.bt.to32.l_rgb_ratio = XPLMFindDataRef("AirbusFBW/BrakePedalInputLeft"                    )) ||
-                        NULL == (global_context->commands.bt.to32.r_rgb_ratio = XPLMFindDataRef("AirbusFBW/BrakePedalInputRight"                   )) ||
-                        NULL == (global_context->commands.bt.to32.br_override = XPLMFindDataRef("AirbusFBW/BrakePedalInputOverride"                )) ||
-                        NULL == (global_context->commands.et.to32.cmd_e_1_onn = XPLMFindCommand("toliss_airbus/engcommands/Master1On"              )) ||
-                        NULL == (global_context->commands.et.to32.cmd_e_1_off = XPLMFindCommand("toliss_airbus/engcommands/Master1Off"             )) ||
-                        NULL == (global_context->commands.et.to32.cmd_e_2_onn = XPLMFindCommand("toliss_airbus/engcommands/Master2On"              )) ||
-                        NULL == (global_context->commands.et.to32.cmd_e_2_off = XPLMFindCommand("toliss_airbus/engcommands/Master2Off"             )) ||
-                        NULL == (global_context->commands.et.to32.cmd_m_12_cr = XPLMFindCommand("toliss_airbus/engcommands/EngineModeSwitchToCrank")) ||
-                        NULL == (global_context->commands.et.to32.cmd_m_12_no = XPLMFindCommand("toliss_airbus/engcommands/EngineModeSwitchToNorm" )) ||
-                        NULL == (global_context->commands.et.to32.cmd_m_12_st = XPLMFindCommand("toliss_airbus/engcommands/EngineModeSwitchToStart")))
-                    {
-                        xnz_log("[error]: could not self-configure for TO32\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        XPLMSetDatai(global_context->commands.bt.to32.br_override, 1);
-                        global_context->commands.xnz_ab = XNZ_AB_TO32;
-//                        global_context->commands.xnz_ab = XNZ_AP_COMM;
-                        global_context->commands.xnz_at = XNZ_AT_TOLI;
-                        global_context->commands.xnz_bt = XNZ_BT_TO32;
-                        global_context->commands.xnz_et = XNZ_ET_TO32;
-                        global_context->commands.xnz_pb = XNZ_PB_TO32;
-                        global_context->         xnz_tt = XNZ_TT_TOLI;
-                    }
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ToLiSs.Airbus.systems"))) && (XPLMIsPluginEnabled(pid)))) // A350v1.4--
-                {
-                    if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature(  "FFSTSmousehandler")))) || // A350v1.3--
-                        ((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ru.ffsts.mousehandler"))))) // A350v1.4.x
-                    {
-                        if (NULL == (global_context->tt.toli.f_thr_array = XPLMFindDataRef("AirbusFBW/throttle_input" )) ||
-                            NULL == (global_context->commands.pb.ff35.pbrak_offon = XPLMFindDataRef("1-sim/parckBrake")))
-                        {
-                            xnz_log("[error]: could not self-configure for FF35 (XP10)\n");
-                            global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                            global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                            global_context->commands.xnz_at = XNZ_AT_ERRR;
-                            global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                            global_context->commands.xnz_et = XNZ_ET_ERRR;
-                            global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                            global_context->         xnz_tt = XNZ_TT_ERRR;
-                        }
-                        else
-                        {
-                            global_context->commands.xnz_ab = XNZ_AB_FF35;
-//                            global_context->commands.xnz_ap = XNZ_AP_COMM;
-                            global_context->commands.xnz_at = XNZ_AT_TOLI;
-                            global_context->commands.xnz_bt = XNZ_BT_FF35;
-                            global_context->commands.xnz_et = XNZ_ET_ERRR;
-                            global_context->commands.xnz_pb = XNZ_PB_FF35;
-                            global_context->         xnz_tt = XNZ_TT_TOLI;
-                        }
-                    }
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("XP11.ToLiss.Airbus.systems"))) && (XPLMIsPluginEnabled(pid)))) // A350v1.6++
-                {
-                    if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ru.stsff.mousehandler"))))) // A350v1.6++
-                    {
-                        if (NULL == (global_context->         tt.toli.f_thr_array = XPLMFindDataRef("AirbusFBW/throttle_input"      )) ||
-                            NULL == (global_context->commands.pb.ff35.pbrak_offon = XPLMFindDataRef("1-sim/parckBrake"              )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_e_1_onn = XPLMFindCommand("1-sim/comm/cutOnLeft"          )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_e_1_off = XPLMFindCommand("1-sim/comm/cutOffLeft"         )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_e_2_onn = XPLMFindCommand("1-sim/comm/cutOnRight"         )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_e_2_off = XPLMFindCommand("1-sim/comm/cutOffRight"        )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_m_12_cr = XPLMFindCommand("1-sim/comm/startSwitchCrank"   )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_m_12_no = XPLMFindCommand("1-sim/comm/startSwitchNorm"    )) ||
-                            NULL == (global_context->commands.et.ff35.cmd_m_12_st = XPLMFindCommand("1-sim/comm/startSwitchStart")))
-                        {
-                            xnz_log("[error]: could not self-configure for FF35 (XP11)\n");
-                            global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                            global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                            global_context->commands.xnz_at = XNZ_AT_ERRR;
-                            global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                            global_context->commands.xnz_et = XNZ_ET_ERRR;
-                            global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                            global_context->         xnz_tt = XNZ_TT_ERRR;
-                        }
-                        else
-                        {
-                            global_context->commands.xnz_ab = XNZ_AB_FF35;
-//                            global_context->commands.xnz_ap = XNZ_AP_COMM;
-                            global_context->commands.xnz_at = XNZ_AT_TOLI;
-                            global_context->commands.xnz_bt = XNZ_BT_FF35;
-                            global_context->commands.xnz_et = XNZ_ET_FF35;
-                            global_context->commands.xnz_pb = XNZ_PB_FF35;
-                            global_context->         xnz_tt = XNZ_TT_TOLI;
-                        }
-                    }
-                }
-                else if (XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ru.stsff.757767avionics")) ||
-                         XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ru.flightfactor-steptosky.757767avionics")) ||
-                         XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("de-ru.philippmuenzel-den_rain.757avionics")))
+            case XNZ_TT_TOLI:
+            {
+                XPLMGetDatavf(ctx->tt.toli.f_thr_array, array, 0, 2);
+                f_throttall = ((array[0] + array[1]) / 2.0f);
+                break;
+            }
+
+            case XNZ_TT_TBM9:
+            {
+                int engn_rng = XPLMGetDatai(ctx->tt.tbm9.engn_rng);
+                switch (engn_rng)
                 {
-                    if (NULL == (global_context->commands.at.comm.cmd_at_disc = XPLMFindCommand("1-sim/comm/AP/at_disc")) ||
-                        NULL == (global_context->commands.at.comm.cmd_at_toga = XPLMFindCommand("1-sim/comm/AP/at_toga")) ||
-                        NULL == (global_context->commands.et.ff75.drf_e_1_cut = XPLMFindDataRef("1-sim/fuel/fuelCutOffLeft")) ||
-                        NULL == (global_context->commands.et.ff75.drf_e_2_cut = XPLMFindDataRef("1-sim/fuel/fuelCutOffRight")) ||
-                        NULL == (global_context->commands.et.ff75.drf_e_1_knb = XPLMFindDataRef("1-sim/engine/leftStartSelector")) ||
-                        NULL == (global_context->commands.et.ff75.drf_e_2_knb = XPLMFindDataRef("1-sim/engine/rightStartSelector")))
-                    {
-                        xnz_log("[error]: could not self-configure for FlightFactor 757/767\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ab = XNZ_AB_FF75;
-//                        global_context->commands.xnz_ap = XNZ_AP_COMM;
-                        global_context->commands.xnz_at = XNZ_AT_COMM;
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                        global_context->commands.xnz_et = XNZ_ET_FF75;
-                        global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                        global_context->         xnz_tt = XNZ_TT_XPLM;
-                    }
+                    case 3:
+                    case 4:
+                    case 5:
+                        /*
+                         * map f_throttall to percent of forward throttle travel
+                         * (ended up confusing me more than necessary: disabled)
+                         */
+//                      if (HS_TBM9_IDLE > (f_throttall = XPLMGetDataf(ctx->f_throttall)))
+//                      {
+//                          f_throttall = (0.0f - (1.0f - (f_throttall / HS_TBM9_IDLE)));
+//                          break;
+//                      }
+//                      f_throttall = ((f_throttall - HS_TBM9_IDLE) / (1.0f - HS_TBM9_IDLE));
+                        f_throttall = XPLMGetDataf(ctx->f_throttall);
+                        break;
+                    default:
+                        f_throttall = HS_TBM9_IDLE; // not in flight/beta/reverse range: throttle_ratio_all dataref has no effect on this TBM
+                        break;
                 }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("ERJ_Functions"))) && (XPLMIsPluginEnabled(pid))))
+                break;
+            }
+
+            default:
+            {
+                if (ctx->acft_has_rev_thrust) // TODO: beta range support?
                 {
-                    if (!strncasecmp(icao, "E35L", strlen("E35L")))
+                    if ((f_throttall = XPLMGetDataf(ctx->f_throttall)) > 0.0f)
                     {
-                        if (NULL == (global_context->commands.et.e35l.drf_e_1_knb = XPLMFindDataRef("XCrafts/ERJ/engine1_starter_knob")) ||
-                            NULL == (global_context->commands.et.e35l.drf_e_2_knb = XPLMFindDataRef("XCrafts/ERJ/engine2_starter_knob")) ||
-                            NULL == (global_context->commands.et.e35l.cmd_e_1_lft = XPLMFindCommand("XCrafts/Starter_Eng_1_down_CCW"  )) ||
-                            NULL == (global_context->commands.et.e35l.cmd_e_2_lft = XPLMFindCommand("XCrafts/Starter_Eng_2_down_CCW"  )) ||
-                            NULL == (global_context->commands.et.e35l.cmd_e_1_rgt = XPLMFindCommand("XCrafts/Starter_Eng_1_up_CW"     )) ||
-                            NULL == (global_context->commands.et.e35l.cmd_e_2_rgt = XPLMFindCommand("XCrafts/Starter_Eng_2_up_CW"     )) ||
-                            NULL == (global_context->commands.at.toga.cmd_ap_toga = XPLMFindCommand("XCrafts/ERJ/TOGA"               )))
+                        if (1)
                         {
-                            xnz_log("[error]: could not self-configure for E35L\n");
-                            global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                            global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                            global_context->commands.xnz_at = XNZ_AT_ERRR;
-                            global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                            global_context->commands.xnz_et = XNZ_ET_ERRR;
-                            global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                            global_context->         xnz_tt = XNZ_TT_ERRR;
+                            XPLMGetDatavi(ctx->i_prop_mode, ctx->i_propmode_value, 0, 2);
                         }
-                        else
+                        if (ctx->i_propmode_value[0] == 3 || ctx->i_propmode_value[1] == 3)
                         {
-                            global_context->commands.xnz_ab = XNZ_AB_NONE;
-                            global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                            global_context->commands.xnz_at = XNZ_AT_APTO;
-                            global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                            global_context->commands.xnz_et = XNZ_ET_E35L;
-                            global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                            global_context->         xnz_tt = XNZ_TT_XPLM;
+                            f_throttall = 0.0f - f_throttall;
+                            break;
                         }
+                        break;
                     }
+                    break;
                 }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("hotstart.tbm900"))) && (XPLMIsPluginEnabled(pid))))
-                {
-                    if (NULL == (global_context->            tt.tbm9.engn_rng = XPLMFindDataRef("tbm900/systems/engine/range"        )) ||
-                        NULL == (global_context->commands.bt.tbm9.rbrak_array = XPLMFindDataRef("tbm900/controls/gear/brake_req"     )) ||
-                        NULL == (global_context->commands.pb.tbm9.pbrak_ratio = XPLMFindDataRef("tbm900/switches/gear/park_brake"    )) ||
-                        NULL == (global_context->commands.bt.tbm9.br_override = XPLMFindDataRef("tbm900/controls/gear/brake_req_ovrd")) ||
-//                      NULL == (global_context->commands.et.tbm9.drf_fuelsel = XPLMFindDataRef("tbm900/switches/fuel/auto_man"      )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_e_1_onn = XPLMFindCommand("sim/engines/mixture_up"             )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_e_1_off = XPLMFindCommand("sim/engines/mixture_down"           )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_x_12_lt = XPLMFindCommand("tbm900/actuators/elec/starter_up"   )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_x_12_rt = XPLMFindCommand("tbm900/actuators/elec/starter_down" )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_m_12_cr = XPLMFindCommand("tbm900/actuators/elec/ignition_off" )) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_m_12_no = XPLMFindCommand("tbm900/actuators/elec/ignition_auto")) ||
-                        NULL == (global_context->commands.et.tbm9.cmd_m_12_st = XPLMFindCommand("tbm900/actuators/elec/ignition_on")))
-                    {
-                        xnz_log("[error]: could not self-configure for TBM9\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        XPLMSetDatai(global_context->commands.bt.tbm9.br_override, 1);
-                        global_context->commands.xnz_ab = XNZ_AB_NONE;
-//                        global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                        global_context->commands.xnz_at = XNZ_AT_NONE;
-                        global_context->commands.xnz_bt = XNZ_BT_TBM9;
-                        global_context->commands.xnz_et = XNZ_ET_TBM9;
-                        global_context->commands.xnz_pb = XNZ_PB_TBM9;
-                        global_context->         xnz_tt = XNZ_TT_TBM9;
-                    }
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("1-sim Diamond_DA62"))) && (XPLMIsPluginEnabled(pid))))
-                {
-                    if (NULL == (global_context->commands.et.da62.drf_mod_ec1 = XPLMFindDataRef("aerobask/eng/sw_ecu_ab1")) ||
-                        NULL == (global_context->commands.et.da62.drf_mod_ec2 = XPLMFindDataRef("aerobask/eng/sw_ecu_ab2")) ||
-                        NULL == (global_context->commands.et.da62.cmd_ecu1_up = XPLMFindCommand("aerobask/eng/ecu_ab1_up")) ||
-                        NULL == (global_context->commands.et.da62.cmd_ecu1_dn = XPLMFindCommand("aerobask/eng/ecu_ab1_dn")) ||
-                        NULL == (global_context->commands.et.da62.cmd_ecu2_up = XPLMFindCommand("aerobask/eng/ecu_ab2_up")) ||
-                        NULL == (global_context->commands.et.da62.cmd_ecu2_dn = XPLMFindCommand("aerobask/eng/ecu_ab2_dn")) ||
-                        NULL == (global_context->commands.et.da62.cmd_e_1_onn = XPLMFindCommand("aerobask/eng/master1_up")) ||
-                        NULL == (global_context->commands.et.da62.cmd_e_1_off = XPLMFindCommand("aerobask/eng/master1_dn")) ||
-                        NULL == (global_context->commands.et.da62.cmd_e_2_onn = XPLMFindCommand("aerobask/eng/master2_up")) ||
-                        NULL == (global_context->commands.et.da62.cmd_e_2_off = XPLMFindCommand("aerobask/eng/master2_dn")))
-                    {
-                        xnz_log("[error]: could not self-configure for DA62\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ab = XNZ_AB_NONE;
-                        global_context->commands.xnz_ap = XNZ_AP_XGFC;
-                        global_context->commands.xnz_at = XNZ_AT_NONE;
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                        global_context->commands.xnz_et = XNZ_ET_DA62;
-                        global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                        global_context->         xnz_tt = XNZ_TT_XPLM;
-                    }
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("1-sim Legacy_RG"))) && (XPLMIsPluginEnabled(pid))))
-                {
-                    if (NULL == (global_context->commands.et.leg2.cmd_f_sl_rt = XPLMFindCommand("aerobask/legacy/fuel_sel_right")) ||
-                        NULL == (global_context->commands.et.leg2.cmd_f_sl_lt = XPLMFindCommand("aerobask/legacy/fuel_sel_left" )) ||
-                        NULL == (global_context->commands.et.leg2.drf_fuelsel = XPLMFindDataRef("aerobask/legacy/fuel_selector" )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_m_12_no = XPLMFindCommand("sim/fuel/fuel_pump_1_off"      )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_m_12_st = XPLMFindCommand("sim/fuel/fuel_pump_1_on"       )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_e_1_off = XPLMFindCommand("aerobask/mag1_off"             )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_e_2_off = XPLMFindCommand("aerobask/mag2_off"             )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_e_1_onn = XPLMFindCommand("aerobask/mag1_on"              )) ||
-                        NULL == (global_context->commands.et.leg2.cmd_e_2_onn = XPLMFindCommand("aerobask/mag2_on"             )))
-                    {
-                        xnz_log("[error]: could not self-configure for LEG2\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ab = XNZ_AB_NONE;
-                        global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                        global_context->commands.xnz_at = XNZ_AT_NONE;
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                        global_context->commands.xnz_et = XNZ_ET_LEG2;
-                        global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                        global_context->         xnz_tt = XNZ_TT_XPLM;
-                    }
-                }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("1-sim Phenom_300"))) && (XPLMIsPluginEnabled(pid))))
+                f_throttall = XPLMGetDataf(ctx->f_throttall);
+                break;
+            }
+        }
+        if (fabsf(ctx->last_throttle_all - f_throttall) >= T_SMALL)
+        {
+            ctx->throttle_did_change = 1;
+            ctx->show_throttle_all = 3.0f;
+            ctx->last_throttle_all = f_throttall;
+            if (ctx->tca_support_enabled &&
+                ctx->idx_throttle_axis_1 >= 0 &&
+                ctx->skip_idle_overwrite == 0)
+            {
+                ctx->show_throttle_all = 1.5f;
+            }
+        }
+        if (ctx->show_throttle_all < T_ZERO ||
+            ctx->ice_detect_positive ||
+            autothrottle_active(ctx))
+        {
+            ctx->throttle_did_change = 0;
+            ctx->show_throttle_all = 0.0f;
+        }
+        else
+        {
+            ctx->show_throttle_all -= inElapsedSinceLastCall;
+        }
+
+        /* icing detection: every 10 seconds */
+        if ((ctx->icecheck_required += inElapsedSinceLastCall) >= 10.0f)
+        {
+            uint64_t t1 = xnz_perf_enter(&ctx->cold->perf);
+            if (XPLMGetDataf(ctx->cold->f_ice_rf[0]) > 0.04f ||
+                XPLMGetDataf(ctx->cold->f_ice_rf[1]) > 0.04f ||
+                XPLMGetDataf(ctx->cold->f_ice_rf[2]) > 0.04f ||
+                XPLMGetDataf(ctx->cold->f_ice_rf[3]) > 0.04f)
+            {
+                if (ctx->ice_detect_positive == 0)
                 {
-                    if (NULL == (global_context->commands.et.e55p.drf_e_1_ign = XPLMFindDataRef("aerobask/engines/sw_ignition_1"    )) ||
-                        NULL == (global_context->commands.et.e55p.drf_e_2_ign = XPLMFindDataRef("aerobask/engines/sw_ignition_2"    )) ||
-                        NULL == (global_context->commands.et.e55p.drf_e_1_knb = XPLMFindDataRef("aerobask/engines/knob_start_stop_1")) ||
-                        NULL == (global_context->commands.et.e55p.drf_e_2_knb = XPLMFindDataRef("aerobask/engines/knob_start_stop_2")) ||
-                        NULL == (global_context->commands.et.e55p.cmd_ig_1_up = XPLMFindCommand("aerobask/engines/ignition_1_up"    )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_ig_1_dn = XPLMFindCommand("aerobask/engines/ignition_1_dn"    )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_ig_2_up = XPLMFindCommand("aerobask/engines/ignition_2_up"    )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_ig_2_dn = XPLMFindCommand("aerobask/engines/ignition_2_dn"    )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_e_1_lft = XPLMFindCommand("aerobask/engines/knob_1_lt"        )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_e_1_rgt = XPLMFindCommand("aerobask/engines/knob_1_rt"        )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_e_2_lft = XPLMFindCommand("aerobask/engines/knob_2_lt"        )) ||
-                        NULL == (global_context->commands.et.e55p.cmd_e_2_rgt = XPLMFindCommand("aerobask/engines/knob_2_rt"       )))
-                    {
-                        xnz_log("[error]: could not self-configure for E55P\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ab = XNZ_AB_NONE;
-                        global_context->commands.xnz_ap = XNZ_AP_XGFC;
-                        global_context->commands.xnz_at = XNZ_AT_NONE; // note: CSC controlled via A/P panel only
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                        global_context->commands.xnz_et = XNZ_ET_E55P;
-                        global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                        global_context->         xnz_tt = XNZ_TT_XPLM;
-                    }
+                    overlay_text(ctx, XNZ_OVERLAY_ICE, 0.0f);
+                    xnz_callout(&ctx->cold->commands, XNZ_CALLOUT_ICE);
                 }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("1-sim Victory G1000"))) && (XPLMIsPluginEnabled(pid))))
+                ctx->ice_detect_positive = 1;
+                ctx->throttle_did_change = 0;
+            }
+            else if (XPLMGetDataf(ctx->cold->f_ice_rf[0]) < 0.02f &&
+                     XPLMGetDataf(ctx->cold->f_ice_rf[1]) < 0.02f &&
+                     XPLMGetDataf(ctx->cold->f_ice_rf[2]) < 0.02f &&
+                     XPLMGetDataf(ctx->cold->f_ice_rf[3]) < 0.02f)
+            {
+                ctx->ice_detect_positive = 0;
+            }
+            ctx->icecheck_required = 0.0f;
+            xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_ICECHECK, t1);
+        }
+        if (ctx->ice_detect_positive || ctx->throttle_did_change)
+        {
+            if (ctx->throttle_did_change)
+            {
+                if (ctx->tca_support_enabled != 0 &&
+                    ctx->idx_throttle_axis_1 >= 0 &&
+                    ctx->skip_idle_overwrite == 0 &&
+                    ctx->i_got_axis_input[0] != 0)
                 {
-                    if (NULL == (global_context->commands.et.evic.drf_fuel_at = XPLMFindDataRef("aerobask/lt_fuel_auto"           )) ||
-                        NULL == (global_context->commands.et.evic.cmd_e_1_onn = XPLMFindCommand("sim/fuel/fuel_pump_1_on"         )) ||
-                        NULL == (global_context->commands.et.evic.cmd_e_1_off = XPLMFindCommand("sim/fuel/fuel_pump_1_off"        )) ||
-                        NULL == (global_context->commands.et.evic.cmd_x_12_rt = XPLMFindCommand("sim/starters/shut_down_1"        )) ||
-                        NULL == (global_context->commands.et.evic.cmd_e_2_tog = XPLMFindCommand("aerobask/fuel_auto_toggle"       )) ||
-                        NULL == (global_context->commands.et.evic.cmd_x_12_lt = XPLMFindCommand("sim/starters/engage_starter_1"   )) ||
-                        NULL == (global_context->commands.et.evic.cmd_m_12_st = XPLMFindCommand("sim/igniters/igniter_contin_on_1")) ||
-                        NULL == (global_context->commands.et.evic.cmd_m_12_no = XPLMFindCommand("sim/igniters/igniter_contin_off_1")))
-                    {
-                        xnz_log("[error]: could not self-configure for EVIC\n");
-                        global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                        global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                        global_context->commands.xnz_at = XNZ_AT_ERRR;
-                        global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                        global_context->commands.xnz_et = XNZ_ET_ERRR;
-                        global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                        global_context->         xnz_tt = XNZ_TT_ERRR;
-                    }
-                    else
-                    {
-                        global_context->commands.xnz_ab = XNZ_AB_NONE;
-                        global_context->commands.xnz_ap = XNZ_AP_XGFC;
-                        global_context->commands.xnz_at = XNZ_AT_NONE; // note: CSC controlled via A/P panel only
-                        global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                        global_context->commands.xnz_et = XNZ_ET_EVIC;
-                        global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                        global_context->         xnz_tt = XNZ_TT_XPLM;
-                    }
+                    overlay_text(ctx, XNZ_OVERLAY_PERCENT, f_throttall);
                 }
-                /* must test SASL and Gizmo last */
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("1-sim.sasl"))) && (XPLMIsPluginEnabled(pid))))
+                else if (f_throttall < (0.0f - T_ZERO))
                 {
-                    if (auth_desc_icao)
-                    {
-                        if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("thranda.xpl3d.cockpit"))) && (XPLMIsPluginEnabled(pid))))
-                        {
-                            if (!strncasecmp(auth, "Carenado", strlen("Carenado")) &&
-                                !strncasecmp(desc, "Pilatus PC12", strlen("Pilatus PC12")))
-                            {
-                                if (NULL == (global_context->commands.et.rptp.drf_e_1_ign = XPLMFindDataRef("thranda/electrical/StarterIgn")) ||
-                                    NULL == (global_context->commands.et.rptp.drf_e_1_eng = XPLMFindDataRef("thranda/electrical/StarterEng")))
-                                {
-                                    xnz_log("[error]: could not self-configure for PC12\n");
-                                    global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                                    global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                                    global_context->commands.xnz_at = XNZ_AT_ERRR;
-                                    global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                                    global_context->commands.xnz_et = XNZ_ET_ERRR;
-                                    global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                                    global_context->         xnz_tt = XNZ_TT_ERRR;
-                                }
-                                else
-                                {
-                                    global_context->commands.xnz_ab = XNZ_AB_NONE;
-                                    global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                                    global_context->commands.xnz_at = XNZ_AT_XPLM;
-                                    global_context->commands.xnz_bt = XNZ_BT_SIMC;
-                                    global_context->commands.xnz_et = XNZ_ET_RPTP;
-                                    global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                                    global_context->         xnz_tt = XNZ_TT_XPLM;
-                                }
-                            }
-                        }
-                        else if (!strncasecmp(auth, "Denis 'ddenn' Krupin", strlen("Denis 'ddenn' Krupin")) &&
-                                 !strncasecmp(desc, "Bombardier Challenger 300", strlen("Bombardier Challenger 300")))
-                        {
-                            global_context->commands.xnz_ab = XNZ_AB_NONE;
-                            global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                            global_context->commands.xnz_at = XNZ_AT_NONE; // note: MACH HOLD controlled via dedicated button only
-                            global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                            global_context->commands.xnz_et = XNZ_ET_CL30;
-                            global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                            global_context->         xnz_tt = XNZ_TT_XPLM;
-                        }
-                        else if (!strncasecmp(auth, "Aerobask", strlen("Aerobask")) ||
-                                 !strncasecmp(auth, "Stephane Buon", strlen("Stephane Buon")))
-                        {
-                            if (!strncasecmp(icao, "EA50", strlen("EA50")))
-                            {
-                                if (NULL == (global_context->commands.et.ea50.drf_mod_en1 = XPLMFindDataRef("aerobask/eclipse/start_eng_0")) ||
-                                    NULL == (global_context->commands.et.ea50.drf_mod_en2 = XPLMFindDataRef("aerobask/eclipse/start_eng_1")))
-                                {
-                                    xnz_log("[error]: could not self-configure for EA50\n");
-                                    global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                                    global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                                    global_context->commands.xnz_at = XNZ_AT_ERRR;
-                                    global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                                    global_context->commands.xnz_et = XNZ_ET_ERRR;
-                                    global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                                    global_context->         xnz_tt = XNZ_TT_ERRR;
-                                }
-                                else
-                                {
-                                    global_context->commands.xnz_ab = XNZ_AB_NONE;
-                                    global_context->commands.xnz_ap = XNZ_AP_XPLM;
-                                    global_context->commands.xnz_at = XNZ_AT_XPLM;
-                                    global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                                    global_context->commands.xnz_et = XNZ_ET_EA50;
-                                    global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                                    global_context->         xnz_tt = XNZ_TT_XPLM;
-                                }
-                            }
-                        }
-                    }
+                    overlay_text(ctx, XNZ_OVERLAY_RATIO_4, f_throttall);
                 }
-                else if (((XPLM_NO_PLUGIN_ID != (pid = XPLMFindPluginBySignature("gizmo.x-plugins.com"))) && (XPLMIsPluginEnabled(pid))))
+                else
                 {
-                    if (auth_desc_icao)
-                    {
-                        if (!strncasecmp(auth, "IXEG", strlen("IXEG")) &&
-                            !strncasecmp(desc, "Boeing 737-300", strlen("Boeing 737-300")))
-                        {
-                            if (NULL == (global_context->commands.et.ix73.drf_e_1_cut = XPLMFindDataRef("ixeg/733/fuel/fuel_start_lever1_act")) ||
-                                NULL == (global_context->commands.et.ix73.drf_e_2_cut = XPLMFindDataRef("ixeg/733/fuel/fuel_start_lever2_act")) ||
-                                NULL == (global_context->commands.at.comm.cmd_at_disc = XPLMFindCommand("ixeg/733/autopilot/at_disengage")) ||
-                                NULL == (global_context->commands.et.ix73.drf_e_1_knb = XPLMFindDataRef("ixeg/733/engine/eng1_start_act")) ||
-                                NULL == (global_context->commands.et.ix73.drf_e_2_knb = XPLMFindDataRef("ixeg/733/engine/eng2_start_act")) ||
-                                NULL == (global_context->commands.at.comm.cmd_at_toga = XPLMFindCommand("sim/engines/TOGA_power")))
-                            {
-                                xnz_log("[error]: could not self-configure for IXEG 737 Classic\n");
-                                global_context->commands.xnz_ab = XNZ_AB_ERRR;
-                                global_context->commands.xnz_ap = XNZ_AP_ERRR;
-                                global_context->commands.xnz_at = XNZ_AT_ERRR;
-                                global_context->commands.xnz_bt = XNZ_BT_ERRR;
-                                global_context->commands.xnz_et = XNZ_ET_ERRR;
-                                global_context->commands.xnz_pb = XNZ_PB_ERRR;
-                                global_context->         xnz_tt = XNZ_TT_ERRR;
-                            }
-                            else
-                            {
-                                global_context->commands.xnz_ab = XNZ_AB_IX33;
-//                                global_context->commands.xnz_ap = XNZ_AP_COMM;
-                                global_context->commands.xnz_at = XNZ_AT_COMM;
-                                global_context->commands.xnz_bt = XNZ_BT_XPLM;
-                                global_context->commands.xnz_et = XNZ_ET_IX73;
-                                global_context->commands.xnz_pb = XNZ_PB_XPLM;
-                                global_context->         xnz_tt = XNZ_TT_XPLM;
-                            }
-                        }
-                    }
+                    overlay_text(ctx, XNZ_OVERLAY_RATIO_5, f_throttall);
                 }
-                if (global_context->xnz_tt == XNZ_TT_XPLM)
-                {
-#ifdef PUBLIC_RELEASE_BUILD
-                    // TODO: per-aircraft configuration file (initialized by user via custom commands)
-#else
-                    switch (global_context->commands.xnz_et)
-                    {
-                        case XNZ_ET_DA62:
-                            global_context->zones_info.share[ZONE_CLB] = 0.50f;
-                            global_context->zones_info.share[ZONE_FLX] = 0.94f - global_context->zones_info.share[ZONE_CLB]; // safely below maximum continuous thrust
-                            global_context->zones_info.share[ZONE_TGA] = 1.00f - global_context->zones_info.share[ZONE_FLX] - global_context->zones_info.share[ZONE_CLB];
-                            break;
+            }
+            overlay_show(ctx);
+        }
+        else if (groundsp > GROUNDSP_KTS_MIN &&
+                 groundsp < GROUNDSP_KTS_MAX &&
+                 XPLMGetDatai(ctx->ongroundany))
+        {
+            overlay_text(ctx, XNZ_OVERLAY_GRDSPD, groundsp);
+            overlay_show(ctx);
+        }
+        else
+        {
+            overlay_hide(ctx);
+        }
 
-                        case XNZ_ET_E35L:
-                            global_context->zones_info.share[ZONE_CLB] = 0.50f;
-                            global_context->zones_info.share[ZONE_FLX] = 0.75f - global_context->zones_info.share[ZONE_CLB];
-                            global_context->zones_info.share[ZONE_TGA] = 1.00f - global_context->zones_info.share[ZONE_FLX] - global_context->zones_info.share[ZONE_CLB];
-                            break;
+        /* variable nullzones */
+        float nullzone_pitch_roll = 0.500f, nullzone_yaw_tiller = 0.500f;
+        if (servos_on(ctx) == 0)
+        {
+            nullzone_pitch_roll = xnz_sched_eval(ctx, XNZ_SCHED_NZ_PR, airspeed);
+            nullzone_yaw_tiller = xnz_sched_eval(ctx, XNZ_SCHED_NZ_YT, groundsp);
+        }
+        if (xnz_sched_update(ctx, XNZ_SCHED_NZ_PR, nullzone_pitch_roll))
+        {
+            XPLMSetDataf(ctx->nullzone[0], nullzone_pitch_roll);
+            XPLMSetDataf(ctx->nullzone[1], nullzone_pitch_roll);
+        }
+        if (xnz_sched_update(ctx, XNZ_SCHED_NZ_YT, nullzone_yaw_tiller))
+        {
+            XPLMSetDataf(ctx->nullzone[2], nullzone_yaw_tiller);
+        }
+        if (ctx->tca_support_enabled == 0 || ctx->idx_throttle_axis_1 < 0)
+        {
+            ctx->last_throttle_all = f_throttall;
+        }
+        xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_NULLZONES, t0);
+        return (1.0f / 20.0f); // run often
+    }
+    XPLMDebugString(XNZ_LOG_PREFIX"[error]: callback_hdlr: inRefcon == NULL, disabling callback\n");
+    return 0;
+}
+#endif
 
-                        case XNZ_ET_EA50:
-                            global_context->zones_info.share[ZONE_CLB] = 0.500000f;
-                            global_context->zones_info.share[ZONE_FLX] = 0.872425f - global_context->zones_info.share[ZONE_CLB]; // ~94% N1 @ PMDY/06
-                            global_context->zones_info.share[ZONE_TGA] = 0.943875f - global_context->zones_info.share[ZONE_FLX] - global_context->zones_info.share[ZONE_CLB]; // ~100% N1
-                            break;
+static inline float linear_standard(float linear_val)
+{
+    return linear_val;
+}
+
+static inline float non_linear_standard(float linear_val)
+{
+    return sqrtf(linear_val);
+}
+
+static inline float non_linear_inverted(float linear_val)
+{
+    return 1.0f - sqrtf(1.0f - linear_val);
+}
+
+static inline float non_linear_centered(float linear_val)
+{
+    if (linear_val < 0.0f)
+    {
+        return 0.0f;
+    }
+    if (linear_val > 1.0f)
+    {
+        return 1.0f;
+    }
+    if (linear_val < 0.5f)
+    {
+        float min = 0.0f, max = 0.5f;
+        float val = (linear_val - min) / (max - min);
+        return min + 0.5f * non_linear_inverted(val);
+    }
+    if (linear_val > 0.5f)
+    {
+        float min = 0.5f, max = 1.0f;
+        float val = (linear_val - min) / (max - min);
+        return min + 0.5f * non_linear_standard(val);
+    }
+    return 0.5f;
+}
+
+static inline float jitter_protection(float input)
+{
+    return roundf(input / T_SMALL) * T_SMALL;
+}
+
+/*
+ * https://forums.x-plane.org/index.php?/forums/topic/244181-phenom-300-throttle-quadrant-detents/&do=findComment&comment=2178232
+ * https://www.omnicalculator.com/math/rounding
+ * travel = angle / max_angle = angle / 73
+ * 69 to 73°: MAX RSV
+ * 59 to 63°: MAX TO/GA
+ * 49 to 53°: MAX CON/CLB
+ * 38 to 42°: MAX CRZ
+ * 00 to 04°: IDLE
+ */
+static inline float throttle_mapping_abe55p(float input, thrust_zones z)
+{
+    if (input > z.min[ZONE_TGA])
+    {
+        return 61.0f / 73.0f; // TO
+    }
+//  if (input > z.max[ZONE_FLX])
+//  {
+//      return 51.0f / 73.0f; // CLB
+//  }
+    if (input > z.min[ZONE_FLX])
+    {
+        return 51.0f / 73.0f; // CLB
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return 40.0f / 73.0f; // CRZ
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection((4.0f + ((38.0f - 4.0f) * linear_standard(t))) / 73.0f);
+    }
+    return 0.0f; // no reverse
+}
+
+static inline float throttle_mapping_ddcl30(float input, thrust_zones z)
+{
+    if (input > z.min[ZONE_TGA])
+    {
+        return 2.8f / 3.0f; // TO
+    }
+//  if (input > z.max[ZONE_FLX])
+//  {
+//      return 2.6f / 3.0f; // CL
+//  }
+    if (input > z.min[ZONE_FLX])
+    {
+        return 2.6f / 3.0f; // CL
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return 2.5f / 3.0f; // CR
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection(2.4f / 3.0f * linear_standard(t));
+    }
+    if (input > z.max[ZONE_REV])
+    {
+        return 0.0f;
+    }
+#ifdef PUBLIC_RELEASE_BUILD
+    if (input < z.min[ZONE_REV])
+    {
+        return -1.0f; // max reverse
+    }
+    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
+    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
+#else
+    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    {
+        return -1.0f; // max reverse
+    }
+    return -0.1f; // idle reverse
+#endif
+}
+
+static inline float throttle_mapping_toliss(float input, thrust_zones z)
+{
+    if (input > z.min[ZONE_TGA])
+    {
+        return 1.0f; // TO/GA
+    }
+//  if (input > z.max[ZONE_FLX])
+//  {
+//      return 0.87f; // FLEX
+//  }
+    if (input > z.min[ZONE_FLX])
+    {
+        return 0.87f; // FLEX
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return 0.69f; // CLB
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection(0.68f * linear_standard(t));
+    }
+    if (input > z.max[ZONE_REV])
+    {
+        return 0.0f;
+    }
+#ifdef PUBLIC_RELEASE_BUILD
+    if (input < z.min[ZONE_REV])
+    {
+        return -1.0f; // max reverse
+    }
+    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
+    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
+#else
+    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    {
+        return -1.0f; // max reverse
+    }
+    return -0.1f; // idle reverse
+#endif
+}
+
+static inline float throttle_mapping_nl_rev(float input, thrust_zones z)
+{
+    if (input > z.max[ZONE_TGA])
+    {
+        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+    }
+    if (input > z.min[ZONE_TGA])
+    {
+        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
+        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_FLX])
+    {
+        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_FLX])
+    {
+        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
+        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+    }
+    if (input > z.max[ZONE_REV])
+    {
+        return 0.0f;
+    }
+    if (input < z.min[ZONE_REV])
+    {
+        return -1.0f; // max reverse
+    }
+    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
+    return jitter_protection(non_linear_standard(t)-1.0f); // beta and reverse ranges
+}
+
+static inline float throttle_mapping_w_rev(float input, thrust_zones z)
+{
+    if (input > z.max[ZONE_TGA])
+    {
+        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+    }
+    if (input > z.min[ZONE_TGA])
+    {
+        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
+        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_FLX])
+    {
+        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_FLX])
+    {
+        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
+        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+    }
+    if (input > z.max[ZONE_REV])
+    {
+        return 0.0f;
+    }
+#ifdef PUBLIC_RELEASE_BUILD
+    if (input < z.min[ZONE_REV])
+    {
+        return -1.0f; // max reverse
+    }
+    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
+    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
+#else
+    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    {
+        return -1.0f; // max reverse
+    }
+    return -0.1f; // idle reverse
+#endif
+}
+
+static inline float throttle_mapping(float input, thrust_zones z)
+{
+    if (input > z.max[ZONE_TGA])
+    {
+        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+    }
+    if (input > z.min[ZONE_TGA])
+    {
+        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
+        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_FLX])
+    {
+        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_FLX])
+    {
+        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
+        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+    }
+    if (input > z.max[ZONE_CLB])
+    {
+        return z.share[ZONE_CLB];
+    }
+    if (input > z.min[ZONE_CLB])
+    {
+        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
+        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+    }
+    return 0.0f; // no reverse
+}
+
+static inline void xnz_trace_command(xnz_context *ctx)
+{
+    if (ctx->trace)
+    {
+        ctx->trace->tick.commands++;
+    }
+}
+
+static int fwd_beta_rev_thrust_for_index(xnz_context *ctx, float f_stick_val[1], int i)
+{
+    if (ctx->i_propmode_value[i] < 1 || // probably feathered
+        ctx->i_propmode_value[i] > 3)  // should never happen
+    {
+//      f_stick_val[0] = 0.0f; // don't force idle thrust: it would only confuse users (myself included -- e.g. Carenado PC12 + REP automatically feathered until engine start)
+        return 0;
+    }
+    if ((T_ZERO + f_stick_val[0]) < 0.0f) // reverse or beta range
+    {
+        if ((T_ZERO + f_stick_val[0]) >= -0.5f) // beta range or idle reverse
+        {
+            if (ctx->acf_has_beta_thrust) // TODO: implement
+            {
+                f_stick_val[0] = 0.0f;
+                return 0;
+            }
+        }
+        if (ctx->acft_has_rev_thrust)
+        {
+            if (ctx->i_propmode_value[i] != 3)
+            {
+                XPLMCommandOnce(ctx->cold->revto[i]);
+                xnz_trace_command(ctx);
+                return 1;
+            }
+            f_stick_val[0] = fabsf(f_stick_val[0]);
+            return 0;
+        }
+        f_stick_val[0] = 0.0f;
+        return 0;
+    }
+    if (ctx->acf_has_beta_thrust && ctx->i_propmode_value[i] == 2)
+    {
+        XPLMCommandOnce(ctx->cold->betto[i]);
+        xnz_trace_command(ctx);
+        return 1;
+    }
+    if (ctx->acft_has_rev_thrust && ctx->i_propmode_value[i] == 3)
+    {
+        XPLMCommandOnce(ctx->cold->revto[i]);
+        xnz_trace_command(ctx);
+        return 1;
+    }
+    return 0;
+}
+static int fwd_beta_rev_thrust(xnz_context *ctx, float f_stick_val[2])
+{
+    switch (ctx->xnz_tt)
+    {
+        case XNZ_TT_TOLI:
+            return 0; // handled by ToLiSS plugin based on positive/begative value of f_stick_val
+
+        case XNZ_TT_TBM9:
+            if ((T_ZERO + f_stick_val[0]) < 0.0f)
+            {
+                if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) == 3)
+                {
+                    XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE - T_ZERO); // flight -> taxi range
+                    XPLMCommandOnce(ctx->cold->revto[8]); // lift gate (engn_rng goes from 3 to 4)
+                    xnz_trace_command(ctx);
+                    return 1;
+                }
+                return 0;
+            }
+            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) > 3)
+            {
+                XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE + T_ZERO); // beta/reverse -> flight idle
+                return 1;
+            }
+            return 0;
+
+        default:
+            break;
+    }
+    if (ctx->arcrft_engine_count == 2)
+    {
+        int l = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], 0);
+        int r = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[1], 1);
+        return (l + r) > 0;
+    }
+    else
+    {
+        int toggled_count = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], 0);
+        for (int i = 1; i < ctx->arcrft_engine_count; i++)
+        {
+            toggled_count += fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], i);
+        }
+        return toggled_count > 0;
+    }
+    return 0;
+}
+
+static int skip_idle_overwrite(xnz_context *ctx, float f_stick_val[2])
+{
+    if (0.0f == f_stick_val[0] && (ctx->arcrft_engine_count < 2 || f_stick_val[1] == 0.0f))
+    {
+        /*
+         * as soon as the user overrides the throttle via commands, then
+         * f_throttall is no longer zero, so we need the return 1 clause
+         * before we check the latter, else we will keep overwriting any
+         * throttle ratio modifications triggered by the user; hence, we
+         * must have it here early, otherwise said override is pointless
+         */
+        if (ctx->skip_idle_overwrite > 9)
+        {
+            return 1;
+        }
+        float f_simul_val[2];
+        switch (ctx->xnz_tt)
+        {
+            case XNZ_TT_FF32: // TODO: implement
+                return ctx->skip_idle_overwrite = 0;
+
+            case XNZ_TT_TBM9:
+                if (fabsf((f_simul_val[0] = (XPLMGetDataf(ctx->f_throttall) - HS_TBM9_IDLE)) - 0.0f) < T_ZERO)
+                {
+                    f_simul_val[0] = 0.0f;
+                }
+                break;
+
+            case XNZ_TT_TOLI:
+                XPLMGetDatavf(ctx->tt.toli.f_thr_array, f_simul_val, 0, 2);
+                break;
+
+            default:
+                f_simul_val[0] = f_simul_val[1] = XPLMGetDataf(ctx->f_throttall);
+                break;
+        }
+        if (0.0f == f_simul_val[0] && (ctx->arcrft_engine_count < 2 || f_simul_val[1] == 0.0f))
+        {
+            for (int i = 0; i < ctx->arcrft_engine_count; i++)
+            {
+                switch (ctx->xnz_tt)
+                {
+                    case XNZ_TT_FF32: // TODO: implement
+                        return ctx->skip_idle_overwrite = 0;
+
+                    case XNZ_TT_TBM9:
+                        if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) != 3)
+                        {
+                            return ctx->skip_idle_overwrite = 0;
+                        }
+                        break;
+
+                    default:
+                        if (ctx->i_propmode_value[i] != 1)
+                        {
+                            return ctx->skip_idle_overwrite = 0;
+                        }
+                        break;
+                }
+                continue;
+            }
+            ctx->skip_idle_overwrite++;
+            return 0;
+        }
+        return ctx->skip_idle_overwrite = 0;
+    }
+    return ctx->skip_idle_overwrite = 0;
+}
+
+static inline int throttle_zone_index(float t, thrust_zones z)
+{
+    if (t > z.max[ZONE_FLX])
+    {
+        return ZONE_TGA;
+    }
+    if (t > z.max[ZONE_CLB])
+    {
+        return ZONE_FLX;
+    }
+    if (t > z.max[ZONE_REV])
+    {
+        return ZONE_CLB;
+    }
+    return ZONE_REV;
+}
+
+static void throttle_axes(xnz_context *ctx)
+{
+    float f_stick_val[2], avrg_throttle_out;
+    XPLMGetDatavf(ctx->f_stick_val, f_stick_val, ctx->idx_throttle_axis_1, 2);
+#if LIN
+    if (ctx->direct.reader)
+    {
+        xnz_direct_levers(ctx, f_stick_val);
+    }
+#endif
+    if (ctx->trace)
+    {
+        ctx->trace->tick.raw[0] = f_stick_val[0];
+        ctx->trace->tick.raw[1] = f_stick_val[1];
+    }
+    XPLMGetDatavi(ctx->i_prop_mode, ctx->i_propmode_value, 0, ctx->arcrft_engine_count);
+    ctx->published.lever_inn[0] = (1.0f - f_stick_val[0]);
+    ctx->published.lever_inn[1] = (1.0f - f_stick_val[1]);
+    if (autothrottle_active(ctx))
+    {
+        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
+        ctx->avrg_throttle_out = XNZ_THOUT_AT;
+        ctx->published.pipeline_st = XNZ_PIPE_AUTO;
+        return;
+    }
+    if (ctx->i_got_axis_input[0] == 0)
+    {
+        if (f_stick_val[0] < TCA_DEADBAND || f_stick_val[1] < TCA_DEADBAND)
+        {
+            ctx->avrg_throttle_out = XPLMGetDataf(ctx->f_throttall);
+            ctx->avrg_throttle_inn = XNZ_THINN_NO;
+            ctx->published.lever_zone[0] = ctx->published.lever_zone[1] = -1;
+            ctx->published.pipeline_st = XNZ_PIPE_NOIN;
+            return;
+        }
+        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
+        ctx->i_got_axis_input[0] = 1;
+    }
+    else
+    {
+        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
+    }
+#ifdef PUBLIC_RELEASE_BUILD
+    if (ctx->arcrft_engine_count != 2 || fabsf(f_stick_val[0] - f_stick_val[1]) < TCA_SYNCBAND)
+#endif
+    {
+        f_stick_val[0] = f_stick_val[1] = ((f_stick_val[0] + f_stick_val[1]) / 2.0f); // cannot re-use ctx->avrg_throttle_inn (inverted)
+    }
+    if (ctx->trace)
+    {
+        ctx->trace->tick.sync[0] = f_stick_val[0];
+        ctx->trace->tick.sync[1] = f_stick_val[1];
+    }
+    ctx->published.lever_zone[0] = throttle_zone_index(1.0f - f_stick_val[0], ctx->params->zones);
+    ctx->published.lever_zone[1] = throttle_zone_index(1.0f - f_stick_val[1], ctx->params->zones);
+    switch (ctx->xnz_tt)
+    {
+        case XNZ_TT_FF32: // TODO: implement
+            ctx->published.pipeline_st = XNZ_PIPE_NSUP;
+            return;
+
+        case XNZ_TT_TOLI:
+            f_stick_val[0] = throttle_mapping_toliss(1.0f - f_stick_val[0], ctx->params->zones);
+            f_stick_val[1] = throttle_mapping_toliss(1.0f - f_stick_val[1], ctx->params->zones);
+            break;
+
+        case XNZ_TT_TBM9:
+            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) < 3)
+            {
+                XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE);
+                ctx->published.engine_out[0] = HS_TBM9_IDLE;
+                ctx->published.pipeline_st = XNZ_PIPE_WRIT;
+                return;
+            }
+            f_stick_val[0] = throttle_mapping_nl_rev(1.0f - f_stick_val[0], ctx->params->zones);
+            break;
+
+        default:
+            switch (ctx->xnz_et)
+            {
+#ifndef PUBLIC_RELEASE_BUILD
+                case XNZ_ET_CL30:
+                    f_stick_val[0] = throttle_mapping_ddcl30(1.0f - f_stick_val[0], ctx->params->zones);
+                    f_stick_val[1] = throttle_mapping_ddcl30(1.0f - f_stick_val[1], ctx->params->zones);
+                    break;
+
+                case XNZ_ET_E55P:
+                    f_stick_val[0] = throttle_mapping_abe55p(1.0f - f_stick_val[0], ctx->params->zones);
+                    f_stick_val[1] = throttle_mapping_abe55p(1.0f - f_stick_val[1], ctx->params->zones);
+                    break;
+#endif
+                case XNZ_ET_XPTP:
+                case XNZ_ET_RPTP:
+                    if (ctx->acft_has_rev_thrust)
+                    {
+                        f_stick_val[0] = throttle_mapping_nl_rev(1.0f - f_stick_val[0], ctx->params->zones);
+                        f_stick_val[1] = throttle_mapping_nl_rev(1.0f - f_stick_val[1], ctx->params->zones);
+                        break;
+                    } // fall through
+                default:
+                    if (ctx->acft_has_rev_thrust)
+                    {
+                        f_stick_val[0] = throttle_mapping_w_rev(1.0f - f_stick_val[0], ctx->params->zones);
+                        f_stick_val[1] = throttle_mapping_w_rev(1.0f - f_stick_val[1], ctx->params->zones);
+                        break;
+                    }
+                    f_stick_val[0] = throttle_mapping(1.0f - f_stick_val[0], ctx->params->zones);
+                    f_stick_val[1] = throttle_mapping(1.0f - f_stick_val[1], ctx->params->zones);
+                    break;
+            }
+            break;
+    }
+    if (ctx->trace)
+    {
+        ctx->trace->tick.mapped[0] = f_stick_val[0];
+        ctx->trace->tick.mapped[1] = f_stick_val[1];
+    }
+    if (skip_idle_overwrite(ctx, f_stick_val))
+    {
+        ctx->avrg_throttle_out = XNZ_THOUT_SK;
+        ctx->published.pipeline_st = XNZ_PIPE_SKIP;
+        return;
+    }
+    if (ctx->xnz_tt != XNZ_TT_TBM9)
+    {
+        // store before sign possibly changed by fwd_beta_rev_thrust()
+        // but only set variable later (if actually writing th. ratio)
+        avrg_throttle_out = ((f_stick_val[0] + f_stick_val[1]) / 2.0f);
+    }
+    if (fwd_beta_rev_thrust(ctx, f_stick_val))
+    {
+        ctx->published.pipeline_st = XNZ_PIPE_TOGG;
+        return;
+    }
+    ctx->published.pipeline_st = XNZ_PIPE_WRIT;
+    switch (ctx->xnz_tt)
+    {
+        case XNZ_TT_TOLI:
+            XPLMSetDatavf(ctx->tt.toli.f_thr_array, f_stick_val, 0, 2);
+            ctx->published.engine_out[0] = f_stick_val[0];
+            ctx->published.engine_out[1] = f_stick_val[1];
+            ctx->avrg_throttle_out = avrg_throttle_out;
+            return;
+
+        case XNZ_TT_TBM9:
+            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) > 3)
+            {
+                ctx->avrg_throttle_out = (HS_TBM9_IDLE + ((HS_TBM9_IDLE) * f_stick_val[0]));
+                XPLMSetDataf(ctx->f_throttall, ctx->avrg_throttle_out);
+                ctx->published.engine_out[0] = ctx->avrg_throttle_out;
+                return; // beta or reverse range
+            }
+            ctx->avrg_throttle_out = (HS_TBM9_IDLE + ((1.0f - HS_TBM9_IDLE) * f_stick_val[0]));
+            XPLMSetDataf(ctx->f_throttall, ctx->avrg_throttle_out);
+            ctx->published.engine_out[0] = ctx->avrg_throttle_out;
+            return; // flight range
+
+        default:
+            ctx->avrg_throttle_out = avrg_throttle_out;
+            break;
+    }
+    if (ctx->arcrft_engine_count == 2)
+    {
+        XPLMSetDatavf(ctx->f_thr_array, f_stick_val, 0, 2);
+        ctx->published.engine_out[0] = f_stick_val[0];
+        ctx->published.engine_out[1] = f_stick_val[1];
+        return;
+    }
+    XPLMSetDataf(ctx->f_throttall, f_stick_val[0]); // sign may differ from avrg_throttle_out
+    for (int i = 0; i < ctx->arcrft_engine_count; i++)
+    {
+        ctx->published.engine_out[i] = f_stick_val[0];
+    }
+    return;
+}
+
+static void throttle_publish(xnz_context *ctx)
+{
+    /*
+     * Bump the generation counter whenever any published value changed,
+     * so that readers of the vector datarefs can skip unchanged frames.
+     */
+    if (memcmp(&ctx->published, &ctx->cold->previous, sizeof(ctx->published)))
+    {
+        memcpy(&ctx->cold->previous, &ctx->published, sizeof(ctx->published));
+        ctx->published_gen++;
+    }
+}
+
+/*
+ * Telemetry (see XNZtelemetry.h): a missing segment is not an error, the
+ * plugin works the same without it.
+ */
+static void xnz_telemetry_start(xnz_context *ctx)
+{
+    xnz_telemetry *t;
+    if (xnz_shm_create(&ctx->cold->telemetry_shm, XNZ_XPLM_TELEM, sizeof(xnz_telemetry)))
+    {
+        xnz_log(XNZ_LOG_INFO, "telemetry: shared memory \"%s\" not available\n", XNZ_XPLM_TELEM);
+        return;
+    }
+    t = ctx->cold->telemetry_shm.base;
+    t->version = XNZ_TELEMETRY_VERSION;
+    t->frame_size = sizeof(xnz_telemetry_frame);
+    t->frame_count = XNZ_TELEMETRY_FRAMES;
+    t->started = xnz_time_ns();
+    t->live = 1;
+    xnz_atomic_store_u32(&t->magic, XNZ_TELEMETRY_MAGIC); // last: header complete
+    ctx->telemetry = t;
+}
+
+static void xnz_telemetry_stop(xnz_context *ctx)
+{
+    if (ctx->telemetry)
+    {
+        xnz_atomic_store_u32(&ctx->telemetry->live, 0);
+        ctx->telemetry = NULL;
+    }
+    xnz_shm_destroy(&ctx->cold->telemetry_shm);
+}
+
+/*
+ * Flight loop only: publish the current tick's frame (never waits).
+ */
+static void xnz_telemetry_write(xnz_context *ctx)
+{
+    xnz_telemetry *t = ctx->telemetry; xnz_cmd_context *c = &ctx->cold->commands;
+    uint32_t head = t->head; xnz_telemetry_frame *f = &t->frame[head & (XNZ_TELEMETRY_FRAMES - 1)];
+    uint32_t sequence = f->sequence;
+    xnz_atomic_store_u32(&f->sequence, sequence + 1);
+    xnz_atomic_fence(); // odd sequence visible before any of the data
+    f->index = head;
+    f->time = xnz_time_ns();
+    memcpy(f->lever_inn, ctx->published.lever_inn, sizeof(f->lever_inn));
+    memcpy(f->engine_out, ctx->published.engine_out, sizeof(f->engine_out));
+    f->lever_zone[0] = ctx->published.lever_zone[0];
+    f->lever_zone[1] = ctx->published.lever_zone[1];
+    f->pipeline = ctx->published.pipeline_st;
+    f->generation = ctx->published_gen;
+    f->throttle_inn = ctx->avrg_throttle_inn;
+    f->throttle_out = ctx->avrg_throttle_out;
+    f->brake_output = c->brake.output;
+    f->brake_decel = c->brake.decel;
+#ifndef PUBLIC_RELEASE_BUILD
+    f->nullzone[0] = ctx->sched_out[XNZ_SCHED_NZ_PR];
+    f->nullzone[1] = ctx->sched_out[XNZ_SCHED_NZ_YT];
+#else
+    f->nullzone[0] = f->nullzone[1] = -1.0f;
+#endif
+    f->backend[XNZ_TELEMETRY_BACKEND_TT] = ctx->xnz_tt;
+    f->backend[XNZ_TELEMETRY_BACKEND_AB] = c->xnz_ab;
+    f->backend[XNZ_TELEMETRY_BACKEND_AP] = c->xnz_ap;
+    f->backend[XNZ_TELEMETRY_BACKEND_AT] = c->xnz_at;
+    f->backend[XNZ_TELEMETRY_BACKEND_BT] = c->xnz_bt;
+    f->backend[XNZ_TELEMETRY_BACKEND_ET] = c->xnz_et;
+    f->backend[XNZ_TELEMETRY_BACKEND_PB] = c->xnz_pb;
+    f->backend[XNZ_TELEMETRY_BACKEND_SB] = c->xnz_sb;
+    xnz_atomic_store_u32(&f->sequence, sequence + 2);
+    xnz_atomic_store_u32(&t->head, head + 1);
+}
+
+/*
+ * Flight loop only: complete the current tick's trace record and push it to
+ * the ring, unless it is full; never waits, never allocates.
+ */
+static void xnz_trace_push(xnz_context *ctx)
+{
+    xnz_trace *t = ctx->trace; uint32_t head = t->head;
+    if (head - xnz_atomic_load_u32(&t->tail) >= XNZ_TRACE_RING)
+    {
+        t->sequence++;
+        t->dropped++;
+        return;
+    }
+    xnz_trace_record *r = &t->ring[head & (XNZ_TRACE_RING - 1)];
+    memcpy(r, &t->tick, sizeof(*r));
+    r->time = xnz_time_ns();
+    r->sequence = t->sequence++;
+    r->written[0] = ctx->published.engine_out[0];
+    r->written[1] = ctx->published.engine_out[1];
+    r->tt = ctx->xnz_tt;
+    r->et = ctx->xnz_et;
+    r->zone[0] = ctx->published.lever_zone[0];
+    r->zone[1] = ctx->published.lever_zone[1];
+    for (int i = 0; i < 8; i++)
+    {
+        r->propmode[i] = ctx->i_propmode_value[i];
+    }
+    r->pipeline = ctx->published.pipeline_st;
+    r->skip = ctx->skip_idle_overwrite < 255 ? ctx->skip_idle_overwrite : 255;
+    xnz_atomic_store_u32(&t->head, head + 1);
+}
+
+/*
+ * Trace writer: encodes whatever the flight loop pushed since the last poll
+ * and appends it to the trace file; drains the ring one last time on stop.
+ */
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL xnz_trace_writer(void *arg)
+{
+    xnz_trace *t = arg; xnz_trace_record previous; uint32_t running;
+    memset(&previous, 0, sizeof(previous));
+    do
+    {
+        running = xnz_atomic_load_u32(&t->running); // before draining: the last pass sees every record
+        uint32_t head = xnz_atomic_load_u32(&t->head), tail = t->tail;
+        while (tail != head)
+        {
+            size_t used = 0; uint32_t count = 0;
+            while (tail != head && used <= sizeof(t->chunk) - XNZ_TRACE_ENCODED_MAX)
+            {
+                const xnz_trace_record *r = &t->ring[tail++ & (XNZ_TRACE_RING - 1)];
+                used += xnz_trace_encode(&previous, r, t->chunk + used);
+                memcpy(&previous, r, sizeof(previous));
+                count++;
+            }
+            xnz_atomic_store_u32(&t->tail, tail); // slots are free again
+            if (t->failed == 0 && fwrite(t->chunk, 1, used, t->file) != used)
+            {
+                t->failed = 1;
+            }
+            if (t->failed == 0)
+            {
+                t->written += count;
+            }
+        }
+        if (running)
+        {
+            xnz_sleep_ms(XNZ_TRACE_SLEEP);
+        }
+    }
+    while (running);
+    return 0;
+}
+
+/*
+ * Main thread only (not from the flight loop): start and stop recording.
+ */
+static void xnz_trace_start(xnz_context *ctx)
+{
+    xnz_trace *t; xnz_trace_header h =
+    {
+        .magic = XNZ_TRACE_MAGIC,
+        .version = XNZ_TRACE_VERSION,
+        .record_size = sizeof(xnz_trace_record),
+        .started = xnz_time_ns(),
+    };
+    if (NULL == (t = xnz_aligned_calloc(sizeof(xnz_trace))))
+    {
+        xnz_log(XNZ_LOG_ERROR, "axis trace: out of memory\n");
+        return;
+    }
+    xnz_prefs_dir(t->path, sizeof(t->path) - sizeof(XNZ_XPLM_TRACE));
+    strcat(t->path, XNZ_XPLM_TRACE);
+    if (NULL == (t->file = fopen(t->path, "wb")) || fwrite(&h, sizeof(h), 1, t->file) != 1)
+    {
+        xnz_log(XNZ_LOG_ERROR, "axis trace: could not write \"%s\"\n", t->path);
+        goto fail;
+    }
+    xnz_atomic_store_u32(&t->running, 1);
+    if (xnz_thread_create(&t->thread, &xnz_trace_writer, t))
+    {
+        xnz_log(XNZ_LOG_ERROR, "axis trace: could not start writer thread\n");
+        goto fail;
+    }
+    ctx->trace = t;
+    xnz_log(XNZ_LOG_INFO, "axis trace: recording to \"%s\"\n", t->path);
+    return;
+
+fail:
+    if (t->file)
+    {
+        fclose(t->file);
+        remove(t->path);
+    }
+    xnz_aligned_free(t);
+    return;
+}
+
+static void xnz_trace_stop(xnz_context *ctx)
+{
+    xnz_trace *t = ctx->trace;
+    if (t)
+    {
+        ctx->trace = NULL; // no more records
+        xnz_atomic_store_u32(&t->running, 0);
+        xnz_thread_join(t->thread);
+        if (fclose(t->file) || t->failed)
+        {
+            xnz_log(XNZ_LOG_ERROR, "axis trace: write error, \"%s\" is incomplete\n", t->path);
+        }
+        xnz_log(XNZ_LOG_INFO, "axis trace: %u records written, %u dropped\n", t->written, t->dropped);
+        xnz_aligned_free(t);
+    }
+}
+
+static int chandler_trc_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            if (((xnz_context*)inRefcon)->trace)
+            {
+                xnz_trace_stop(inRefcon);
+                return 0;
+            }
+            xnz_trace_start(inRefcon);
+            return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
+
+#ifndef PUBLIC_RELEASE_BUILD
+static void xnz_ffrec_publish(xnz_ffrec *r)
+{
+    r->block[r->head & (XNZ_FFREC_RING - 1)].frames = r->fill;
+    r->fill = 0;
+    xnz_atomic_store_u32(&r->head, r->head + 1);
+}
+
+/*
+ * FlightFactor update callback: once per frame, main thread (no lookups by
+ * name here, only ids resolved by xnz_ffrec_select).
+ */
+static void __stdcall xnz_ffrec_update(double step, void *tag)
+{
+    xnz_ffrec *r = tag; uint32_t slot = r->head & (XNZ_FFREC_RING - 1);
+    if (r->fill == 0)
+    {
+        if (r->head - xnz_atomic_load_u32(&r->tail) >= XNZ_FFREC_RING)
+        {
+            r->sequence++; r->dropped++; return; // writer behind: drop the frame
+        }
+        r->block[slot].first = r->sequence;
+    }
+    uint8_t *b = r->ring + slot * r->block_size;
+    ((uint64_t*)b)[r->fill] = xnz_time_ns();
+    ((double*)(b + XNZ_FFREC_FRAMES * sizeof(uint64_t)))[r->fill] = step;
+    for (uint32_t c = 0; c < r->column_count; c++)
+    {
+        r->s->ValueGet(r->column[c].id, b + r->offset[c] + r->fill * r->column[c].size);
+    }
+    r->sequence++;
+    if (++r->fill == XNZ_FFREC_FRAMES)
+    {
+        xnz_ffrec_publish(r);
+    }
+}
+
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL xnz_ffrec_writer(void *arg)
+{
+    xnz_ffrec *r = arg; uint32_t running;
+    do
+    {
+        running = xnz_atomic_load_u32(&r->running); // before draining: the last pass sees every block
+        uint32_t head = xnz_atomic_load_u32(&r->head), tail = r->tail;
+        while (tail != head)
+        {
+            uint32_t slot = tail & (XNZ_FFREC_RING - 1), frames = r->block[slot].frames;
+            const uint8_t *b = r->ring + slot * r->block_size;
+            if (r->failed == 0)
+            {
+                r->failed = (fwrite(&r->block[slot], sizeof(xnz_ffrec_block), 1, r->file) != 1 ||
+                             fwrite(b, sizeof(uint64_t), frames, r->file) != frames ||
+                             fwrite(b + XNZ_FFREC_FRAMES * sizeof(uint64_t), sizeof(double), frames, r->file) != frames);
+                for (uint32_t c = 0; c < r->column_count && r->failed == 0; c++)
+                {
+                    r->failed = fwrite(b + r->offset[c], r->column[c].size, frames, r->file) != frames;
+                }
+                if (r->failed == 0)
+                {
+                    r->written += frames;
+                }
+            }
+            xnz_atomic_store_u32(&r->tail, ++tail); // block is free again
+        }
+        if (running)
+        {
+            xnz_sleep_ms(XNZ_TRACE_SLEEP);
+        }
+    }
+    while (running);
+    return 0;
+}
+
+static void xnz_ffrec_add(xnz_ffrec *r, int id)
+{
+    uint32_t type, size; const char *name;
+    if (id < 0)
+    {
+        return;
+    }
+    for (uint32_t c = 0; c < r->column_count; c++)
+    {
+        if (r->column[c].id == id)
+        {
+            return; // listed twice
+        }
+    }
+    if ((size = xnz_ffrec_type_size((type = r->s->ValueType(id)))) == 0)
+    {
+        return; // string, object, deleted
+    }
+    if (r->column_count >= XNZ_FFREC_COLUMNS)
+    {
+        r->skipped++;
+        return;
+    }
+    xnz_ffrec_column *c = &r->column[r->column_count++];
+    c->id = id;
+    c->type = type;
+    c->size = size;
+    c->units = r->s->ValueUnits(id);
+    snprintf(c->name, sizeof(c->name), "%s", (name = r->s->ValueName(id)) ? name : "");
+}
+
+/*
+ * Resolve the values to record (see XNZffrec.h) to ids; returns the number
+ * of columns.
+ */
+static uint32_t xnz_ffrec_select(xnz_ffrec *r)
+{
+    char path[1024], line[256]; FILE *f;
+    xnz_prefs_dir(path, sizeof(path) - sizeof(XNZ_XPLM_FFREC ".txt"));
+    strcat(path, XNZ_XPLM_FFREC ".txt");
+    if (NULL == (f = fopen(path, "r")))
+    {
+        xnz_ffrec_add(r, r->s->ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever1"));
+        xnz_ffrec_add(r, r->s->ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever2"));
+        return r->column_count;
+    }
+    while (fgets(line, sizeof(line), f))
+    {
+        char *p = line, *comment = strchr(line, '#'); size_t n;
+        if (comment)
+        {
+            *comment = '\0';
+        }
+        while (isspace((unsigned char)*p))
+        {
+            p++;
+        }
+        for (n = strlen(p); n && isspace((unsigned char)p[n - 1]); p[--n] = '\0');
+        if (n == 0)
+        {
+            continue;
+        }
+        if (p[n - 1] == '*')
+        {
+            p[--n] = '\0';
+            for (unsigned int i = 0, count = r->s->ValuesCount(); i < count; i++)
+            {
+                int id = r->s->ValueIdByIndex(i); const char *name = id < 0 ? NULL : r->s->ValueName(id);
+                if (name && strncmp(name, p, n) == 0)
+                {
+                    xnz_ffrec_add(r, id);
+                }
+            }
+            continue;
+        }
+        int id = r->s->ValueIdByName(p);
+        if (id < 0)
+        {
+            xnz_log(XNZ_LOG_ERROR, "FF recorder: no such value \"%s\"\n", p);
+            continue;
+        }
+        xnz_ffrec_add(r, id);
+    }
+    fclose(f);
+    return r->column_count;
+}
+
+/*
+ * Main thread only: start and stop recording.
+ */
+static void xnz_ffrec_start(xnz_context *ctx)
+{
+    xnz_ffrec *r; size_t row = 0; xnz_ffrec_header h =
+    {
+        .magic = XNZ_FFREC_MAGIC,
+        .version = XNZ_FFREC_VERSION,
+        .block_frames = XNZ_FFREC_FRAMES,
+        .started = xnz_time_ns(),
+    };
+    if (ctx->xnz_tt != XNZ_TT_FF32 || ctx->tt.ff32.api_has_initialized == 0)
+    {
+        xnz_log(XNZ_LOG_INFO, "FF recorder: FlightFactor A320 shared values not available\n");
+        return;
+    }
+    if (NULL == (r = xnz_aligned_calloc(sizeof(xnz_ffrec))))
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: out of memory\n");
+        return;
+    }
+    r->s = &ctx->cold->ff32;
+    r->pid = ctx->tt.ff32.pid;
+    if (xnz_ffrec_select(r) == 0)
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: no values to record\n");
+        goto fail;
+    }
+    for (uint32_t c = 0; c < r->column_count; c++)
+    {
+        r->offset[c] = xnz_ffrec_block_size(row, XNZ_FFREC_FRAMES); // after time, step and the previous columns
+        row += r->column[c].size;
+    }
+    r->row_size = row;
+    r->block_size = xnz_ffrec_block_size(row, XNZ_FFREC_FRAMES);
+    if (NULL == (r->ring = malloc(XNZ_FFREC_RING * r->block_size)))
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: out of memory\n");
+        goto fail;
+    }
+    h.column_count = r->column_count;
+    xnz_prefs_dir(r->path, sizeof(r->path) - sizeof(XNZ_XPLM_FFREC));
+    strcat(r->path, XNZ_XPLM_FFREC);
+    if (NULL == (r->file = fopen(r->path, "wb")) ||
+        fwrite(&h, sizeof(h), 1, r->file) != 1 ||
+        fwrite(r->column, sizeof(xnz_ffrec_column), r->column_count, r->file) != r->column_count)
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: could not write \"%s\"\n", r->path);
+        goto fail;
+    }
+    xnz_atomic_store_u32(&r->running, 1);
+    if (xnz_thread_create(&r->thread, &xnz_ffrec_writer, r))
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: could not start writer thread\n");
+        goto fail;
+    }
+    r->s->DataAddUpdate(&xnz_ffrec_update, r);
+    ctx->cold->ffrec = r;
+    if (r->skipped)
+    {
+        xnz_log(XNZ_LOG_ERROR, "FF recorder: too many values, %u skipped\n", r->skipped);
+    }
+    xnz_log(XNZ_LOG_INFO, "FF recorder: recording %u values (%zu bytes/frame) to \"%s\"\n", r->column_count, row, r->path);
+    return;
+
+fail:
+    if (r->file)
+    {
+        fclose(r->file);
+        remove(r->path);
+    }
+    free(r->ring);
+    xnz_aligned_free(r);
+    return;
+}
+
+static void xnz_ffrec_stop(xnz_context *ctx)
+{
+    xnz_ffrec *r = ctx->cold->ffrec;
+    if (r)
+    {
+        ctx->cold->ffrec = NULL;
+        if (XPLMIsPluginEnabled(r->pid)) // else the aircraft is gone already
+        {
+            r->s->DataDelUpdate(&xnz_ffrec_update, r); // no more frames
+        }
+        if (r->fill)
+        {
+            xnz_ffrec_publish(r);
+        }
+        xnz_atomic_store_u32(&r->running, 0);
+        xnz_thread_join(r->thread);
+        if (fclose(r->file) || r->failed)
+        {
+            xnz_log(XNZ_LOG_ERROR, "FF recorder: write error, \"%s\" is incomplete\n", r->path);
+        }
+        xnz_log(XNZ_LOG_INFO, "FF recorder: %u frames written, %u dropped\n", r->written, r->dropped);
+        free(r->ring);
+        xnz_aligned_free(r);
+    }
+}
+
+static int chandler_ffr_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            if (((xnz_context*)inRefcon)->cold->ffrec)
+            {
+                xnz_ffrec_stop(inRefcon);
+                return 0;
+            }
+            xnz_ffrec_start(inRefcon);
+            return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
+#endif
+
+#if LIN
+/*
+ * Direct TCA input (see XNZevdev.h): X-Plane's joystick_axis_values remain the
+ * fallback, until the reader's first sample and whenever it stops by itself.
+ */
+static void xnz_direct_start(xnz_context *ctx, const char *path)
+{
+    xnz_evdev *e;
+    if (NULL == (e = xnz_aligned_calloc(sizeof(xnz_evdev))))
+    {
+        xnz_log(XNZ_LOG_ERROR, "direct input: out of memory\n");
+        return;
+    }
+    if (xnz_evdev_open(e, path))
+    {
+        xnz_log(XNZ_LOG_ERROR, "direct input: no TCA quadrant found (%s)\n", path ? path : "auto");
+        goto fail;
+    }
+    if (xnz_evdev_start(e))
+    {
+        xnz_log(XNZ_LOG_ERROR, "direct input: could not start reader thread\n");
+        close(e->fd);
+        goto fail;
+    }
+    ctx->direct.reader = e;
+    ctx->direct.count = ctx->direct.used = 0;
+    ctx->direct.age_sum = 0;
+    ctx->direct.invert[0] = ctx->direct.invert[1] = -1;
+    xnz_log(XNZ_LOG_INFO, "direct input: \"%s\" (%s)%s\n", e->axes.name, e->path, e->replay ? ", replay" : "");
+    return;
+
+fail:
+    xnz_aligned_free(e);
+    return;
+}
+
+static void xnz_direct_stop(xnz_context *ctx)
+{
+    xnz_evdev *e = ctx->direct.reader;
+    if (e)
+    {
+        ctx->direct.reader = NULL; // X-Plane's values from now on
+        xnz_evdev_stop(e);
+        xnz_log(xnz_atomic_load_u32(&e->failed) ? XNZ_LOG_ERROR : XNZ_LOG_INFO,
+                "direct input: %s, %llu events, %u reports, %llu resyncs, %u samples used (mean age %.2f ms)\n",
+                xnz_atomic_load_u32(&e->failed) ? "device lost" : "stopped", (unsigned long long)e->events, e->mailbox.count, (unsigned long long)e->resyncs,
+                ctx->direct.used, ctx->direct.used ? (double)ctx->direct.age_sum / (double)ctx->direct.used / 1e6 : 0.0);
+        xnz_aligned_free(e);
+    }
+}
+
+/*
+ * Flight loop only: replace X-Plane's lever values (f_stick_val, 0: lever
+ * forward) with the freshest direct sample. Which end of an axis' range is
+ * forward is resolved against X-Plane's value, once that is unambiguous.
+ */
+static void xnz_direct_levers(xnz_context *ctx, float f_stick_val[2])
+{
+    xnz_evdev_sample s;
+    if (xnz_atomic_load_u32(&ctx->direct.reader->failed))
+    {
+        xnz_direct_stop(ctx);
+        return;
+    }
+    if (xnz_evdev_latest(&ctx->direct.reader->mailbox, &s))
+    {
+        return;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        if (ctx->direct.invert[i] < 0)
+        {
+            if (fabsf(f_stick_val[i] - 0.5f) < 0.25f)
+            {
+                return; // lever mid-range: try again next tick
+            }
+            ctx->direct.invert[i] = fabsf((1.0f - s.value[i]) - f_stick_val[i]) < fabsf(s.value[i] - f_stick_val[i]);
+            xnz_log(XNZ_LOG_INFO, "direct input: lever %d %s\n", i + 1, ctx->direct.invert[i] ? "inverted" : "not inverted");
+        }
+    }
+    f_stick_val[0] = ctx->direct.invert[0] ? 1.0f - s.value[0] : s.value[0];
+    f_stick_val[1] = ctx->direct.invert[1] ? 1.0f - s.value[1] : s.value[1];
+    ctx->direct.age_sum += xnz_time_ns() - s.time;
+    ctx->direct.count = s.count;
+    ctx->direct.used++;
+}
+
+static int chandler_dir_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            if (((xnz_context*)inRefcon)->direct.reader)
+            {
+                xnz_direct_stop(inRefcon);
+                return 0;
+            }
+            xnz_direct_start(inRefcon, getenv(XNZ_EVDEV_ENV));
+            return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
+#endif
+
+/*
+ * Command ingress (see XNZingress.h): requests run the same xnz/ commands
+ * a button would, through X-Plane, at most XNZ_INGRESS_BUDGET per frame.
+ */
+#define XNZ_INGRESS_BUDGET 16
+
+static void xnz_ingress_name(xnz_context *ctx, const char *name, XPLMCommandRef *ref)
+{
+    xnz_ingress *q = ctx->cold->ingress.queue;
+    uint32_t i = ctx->cold->ingress.count;
+    if (i < XNZ_INGRESS_COMMANDS && strlen(name) < XNZ_INGRESS_NAME_MAX)
+    {
+        snprintf(q->names[i], XNZ_INGRESS_NAME_MAX, "%s", name);
+        ctx->cold->ingress.refs[i] = ref;
+        q->command_count = ctx->cold->ingress.count = i + 1;
+    }
+}
+
+static float ingress_hdlr_fnc(float inElapsedSinceLastCall,
+                              float inElapsedTimeSinceLastFlightLoop,
+                              int   inCounter,
+                              void *inRefcon)
+{
+    xnz_context *ctx = inRefcon; xnz_ingress *q = ctx->cold->ingress.queue; xnz_ingress_slot r;
+    uint64_t t = xnz_perf_enter(&ctx->cold->perf);
+    for (int i = 0; i < XNZ_INGRESS_BUDGET && xnz_ingress_pop(q, &r); i++)
+    {
+        XPLMCommandRef cmd = r.command < ctx->cold->ingress.count ? *ctx->cold->ingress.refs[r.command] : NULL;
+        if (cmd == NULL)
+        {
+            xnz_log(XNZ_LOG_ERROR, "ingress: client %u: command %u not available\n", r.client, r.command);
+            continue;
+        }
+        switch (r.phase)
+        {
+            case XNZ_INGRESS_BEGIN:
+                if (ctx->cold->ingress.held[r.command] == 0)
+                {
+                    ctx->cold->ingress.held[r.command] = 1;
+                    XPLMCommandBegin(cmd);
+                }
+                continue;
+
+            case XNZ_INGRESS_END:
+                if (ctx->cold->ingress.held[r.command])
+                {
+                    ctx->cold->ingress.held[r.command] = 0;
+                    XPLMCommandEnd(cmd);
+                }
+                continue;
+
+            case XNZ_INGRESS_ONCE:
+                XPLMCommandOnce(cmd);
+                continue;
+
+            default:
+                xnz_log(XNZ_LOG_ERROR, "ingress: client %u: invalid phase %u\n", r.client, r.phase);
+                continue;
+        }
+    }
+    xnz_perf_leave(&ctx->cold->perf, XNZ_PERF_INGRESS, t);
+    return -1.0f; // every frame
+}
+
+static void xnz_ingress_start(xnz_context *ctx)
+{
+    xnz_ingress *q;
+    if (xnz_shm_create(&ctx->cold->ingress.shm, XNZ_XPLM_INGRS, sizeof(xnz_ingress)))
+    {
+        xnz_log(XNZ_LOG_INFO, "ingress: shared memory \"%s\" not available\n", XNZ_XPLM_INGRS);
+        return;
+    }
+    q = ctx->cold->ingress.queue = ctx->cold->ingress.shm.base;
+#ifndef PUBLIC_RELEASE_BUILD
+    for (size_t i = 0; i < sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]); i++)
+    {
+        xnz_ingress_name(ctx, xnz_init_cmds[i].name, (XPLMCommandRef*)((char*)&ctx->cold->commands + xnz_init_cmds[i].offset));
+    }
+#endif
+    xnz_ingress_name(ctx, "xnz/trace/axes/toggle", &ctx->cold->trace_tog);
+#if LIN
+    xnz_ingress_name(ctx, "xnz/tca/direct/toggle", &ctx->cold->direct_tog);
+#endif
+#ifndef PUBLIC_RELEASE_BUILD
+    xnz_ingress_name(ctx, "xnz/ffrec/toggle", &ctx->cold->ffrec_tog);
+#endif
+    xnz_ingress_init(q);
+    q->version = XNZ_INGRESS_VERSION;
+    q->slot_count = XNZ_INGRESS_SLOTS;
+    q->live = 1;
+    xnz_atomic_store_u32(&q->magic, XNZ_INGRESS_MAGIC); // last: names complete
+    XPLMRegisterFlightLoopCallback((ctx->cold->ingress.f_l_ig = &ingress_hdlr_fnc), -1.0f, ctx);
+}
+
+static void xnz_ingress_stop(xnz_context *ctx)
+{
+    if (ctx->cold->ingress.queue)
+    {
+        xnz_atomic_store_u32(&ctx->cold->ingress.queue->live, 0);
+        XPLMUnregisterFlightLoopCallback(ctx->cold->ingress.f_l_ig, ctx);
+        for (uint32_t i = 0; i < ctx->cold->ingress.count; i++)
+        {
+            if (ctx->cold->ingress.held[i] && *ctx->cold->ingress.refs[i])
+            {
+                XPLMCommandEnd(*ctx->cold->ingress.refs[i]);
+            }
+        }
+    }
+    xnz_shm_destroy(&ctx->cold->ingress.shm);
+    memset(&ctx->cold->ingress, 0, sizeof(ctx->cold->ingress));
+}
+
+static float axes_hdlr_fnc(float inElapsedSinceLastCall,
+                           float inElapsedTimeSinceLastFlightLoop,
+                           int   inCounter,
+                           void *inRefcon)
+{
+    if (inRefcon)
+    {
+        uint64_t t0 = xnz_perf_enter(&((xnz_context*)inRefcon)->cold->perf), t1;
+        xnz_params_acquire(inRefcon);
+
+        /* shall we be doing something? */
+        if (((xnz_context*)inRefcon)->tca_support_enabled == 0)
+        {
+            ((xnz_context*)inRefcon)->published.pipeline_st = XNZ_PIPE_OFF;
+            throttle_publish(inRefcon);
+            if (((xnz_context*)inRefcon)->telemetry)
+            {
+                xnz_telemetry_write(inRefcon);
+            }
+            xnz_perf_leave(&((xnz_context*)inRefcon)->cold->perf, XNZ_PERF_AXES, t0);
+            return (1.0f / 20.0f);
+        }
+        t1 = xnz_perf_enter(&((xnz_context*)inRefcon)->cold->perf);
+        throttle_axes(inRefcon);
+        xnz_perf_leave(&((xnz_context*)inRefcon)->cold->perf, XNZ_PERF_THROTTLE, t1);
+        throttle_publish(inRefcon);
+        if (((xnz_context*)inRefcon)->telemetry)
+        {
+            xnz_telemetry_write(inRefcon);
+        }
+        if (((xnz_context*)inRefcon)->trace)
+        {
+            xnz_trace_push(inRefcon);
+            memset(&((xnz_context*)inRefcon)->trace->tick, 0, sizeof(xnz_trace_record));
+        }
+        xnz_perf_leave(&((xnz_context*)inRefcon)->cold->perf, XNZ_PERF_AXES, t0);
+        return (1.0f / 20.0f);
+    }
+    XPLMDebugString(XNZ_LOG_PREFIX"[error]: callback_hdlr: inRefcon == NULL, disabling callback\n");
+    return 0;
+}
+
+#define XNZ_PERF_DUMP_BUFFER (16 * 1024)
+
+#ifdef XNZ_XPLM_CALLSTATS
+static float calls_hdlr_fnc(float inElapsedSinceLastCall,
+                            float inElapsedTimeSinceLastFlightLoop,
+                            int   inCounter,
+                            void *inRefcon)
+{
+    xnz_calls *c = &xnz_calls_state;
+    if (c->frame_calls_max < c->frame_calls)
+    {
+        c->frame_calls_max = c->frame_calls;
+    }
+    if (c->frame_ns_max < c->frame_ns)
+    {
+        c->frame_ns_max = c->frame_ns;
+    }
+    c->frame_calls = 0;
+    c->frame_ns = 0;
+    c->frame++;
+    return -1.0f; // every frame
+}
+
+static int xnz_calls_compare(const void *a, const void *b) // by time, descending
+{
+    const xnz_calls_site *sa = &xnz_calls_state.site[*(const int*)a];
+    const xnz_calls_site *sb = &xnz_calls_state.site[*(const int*)b];
+    return sa->ns < sb->ns ? 1 : sa->ns > sb->ns ? -1 : 0;
+}
+
+/*
+ * Summary table: the call sites (lines in this file) that spent the most
+ * time in the XPLM, with per-frame averages and maximums.
+ */
+static void xnz_calls_dump(char *buffer)
+{
+    static const char *functions[XNZ_CALLS_COUNT] =
+    {
+        "XPLMFindDataRef", "XPLMFindCommand",
+        "XPLMGetDatai", "XPLMGetDataf", "XPLMGetDatavi", "XPLMGetDatavf", "XPLMGetDatab",
+        "XPLMSetDatai", "XPLMSetDataf", "XPLMSetDatavi", "XPLMSetDatavf",
+        "XPLMCommandOnce", "XPLMCommandBegin", "XPLMCommandEnd",
+    };
+    xnz_calls *c = &xnz_calls_state; int *lines, count = 0; size_t used = 0;
+    uint32_t frames = c->frame ? c->frame : 1;
+    if (NULL == (lines = malloc(sizeof(int) * XNZ_CALLS_LINES)))
+    {
+        xnz_log(XNZ_LOG_ERROR, "calls: dump failed (malloc)\n");
+        return;
+    }
+    for (int i = 0; i < XNZ_CALLS_LINES; i++)
+    {
+        if (c->site[i].calls)
+        {
+            lines[count++] = i;
+        }
+    }
+    qsort(lines, count, sizeof(int), &xnz_calls_compare);
+    used += snprintf(buffer, XNZ_PERF_DUMP_BUFFER, XNZ_LOG_PREFIX"[info]: calls: %llu in %u frames (%.1f/frame, max %u), %.3f ms (%.3f us/frame, max %.3f us), %d sites\n",
+                     (unsigned long long)c->calls, c->frame, (double)c->calls / frames, c->frame_calls_max,
+                     c->ns / 1e6, c->ns / 1e3 / frames, c->frame_ns_max / 1e3, count);
+    used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, XNZ_LOG_PREFIX"[info]: calls: %5s %-16s %10s %8s %9s %9s %10s %9s\n",
+                     "line", "function", "calls", "frames", "per frame", "max/frame", "total ms", "mean us");
+    for (int i = 0; i < count && i < XNZ_CALLS_TOP; i++)
+    {
+        const xnz_calls_site *s = &c->site[lines[i]];
+        if (XNZ_PERF_DUMP_BUFFER - used < 256)
+        {
+            XPLMDebugString(buffer); used = 0;
+        }
+        used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, XNZ_LOG_PREFIX"[info]: calls: %5d %-16s %10u %8u %9.2f %9u %10.3f %9.3f\n",
+                         lines[i], functions[s->function], s->calls, s->frames, (double)s->calls / frames,
+                         s->frame_max, s->ns / 1e6, s->ns / 1e3 / s->calls);
+    }
+    XPLMDebugString(buffer);
+    free(lines);
+}
+#endif
+
+/*
+ * Summary line, then one line per non-empty bucket (bounds in microseconds,
+ * share and cumulative share of samples); written in a few large chunks.
+ */
+static void xnz_perf_dump_hist(char *buffer, const char *name, const xnz_hist *h)
+{
+    size_t used = 0; uint64_t seen = 0;
+    used += snprintf(buffer, XNZ_PERF_DUMP_BUFFER, XNZ_LOG_PREFIX"[info]: perf: %s: count %llu mean %.3f p50 %.3f p90 %.3f p99 %.3f p99.9 %.3f max %.3f (us)\n", name,
+                     (unsigned long long)h->count, h->count ? (double)h->sum / (double)h->count / 1000.0 : 0.0,
+                     xnz_hist_quantile(h, 0.500) / 1000.0, xnz_hist_quantile(h, 0.900) / 1000.0,
+                     xnz_hist_quantile(h, 0.990) / 1000.0, xnz_hist_quantile(h, 0.999) / 1000.0, h->max / 1000.0);
+    for (int i = 0; i < XNZ_HIST_BUCKETS; i++)
+    {
+        if (h->bucket[i])
+        {
+            if (XNZ_PERF_DUMP_BUFFER - used < 256)
+            {
+                XPLMDebugString(buffer); used = 0;
+            }
+            seen += h->bucket[i];
+            used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, XNZ_LOG_PREFIX"[info]: perf: %s: %12.3f .. %12.3f %10u %6.2f%% %7.2f%%\n", name,
+                             xnz_hist_lower(i) / 1000.0, xnz_hist_upper(i) / 1000.0, h->bucket[i],
+                             100.0 * h->bucket[i] / (double)h->count, 100.0 * seen / (double)h->count);
+        }
+    }
+    XPLMDebugString(buffer);
+}
+
+/*
+ * Full distributions to Log.txt, bypassing the logger's rate limits (after
+ * flushing it, so the output isn't interleaved with older messages).
+ */
+static void xnz_perf_dump(xnz_context *ctx)
+{
+    char *buffer = malloc(XNZ_PERF_DUMP_BUFFER);
+    if (buffer == NULL)
+    {
+        xnz_log(XNZ_LOG_ERROR, "perf: dump failed (malloc)\n");
+        return;
+    }
+    xnz_log_flush();
+    for (int i = 0; i < XNZ_PERF_COUNT; i++)
+    {
+        xnz_perf_dump_hist(buffer, xnz_perf_names[i], &ctx->cold->perf.task[i]);
+    }
+#ifndef PUBLIC_RELEASE_BUILD
+    static const char *phases[3] = { "begin", "continue", "end", };
+    for (size_t i = 0; i < sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]); i++)
+    {
+        for (int p = xplm_CommandBegin; p <= xplm_CommandEnd; p++)
+        {
+            if (ctx->cold->perf.handler[i][p].count)
+            {
+                char name[128]; snprintf(name, sizeof(name), "%s (%s)", xnz_init_cmds[i].name, phases[p]);
+                xnz_perf_dump_hist(buffer, name, &ctx->cold->perf.handler[i][p]);
+            }
+        }
+    }
+#endif
+#ifdef XNZ_XPLM_CALLSTATS
+    xnz_calls_dump(buffer);
+#endif
+    free(buffer);
+}
+
+static float stutter_hdlr_fnc(float inElapsedSinceLastCall,
+                              float inElapsedTimeSinceLastFlightLoop,
+                              int   inCounter,
+                              void *inRefcon)
+{
+    xnz_perf *perf = &((xnz_context*)inRefcon)->cold->perf; uint64_t now = xnz_time_ns();
+    if (perf->stutter.last)
+    {
+        double period = (double)(now - perf->stutter.last), average = perf->stutter.baseline.average;
+        if (xnz_stutter_check(&perf->stutter.baseline, period))
+        {
+            xnz_stutter_event *e = &perf->stutter.event[perf->stutter.stutters++ % XNZ_STUTTER_EVENTS];
+            e->time = now;
+            e->frame = perf->stutter.frames;
+            e->period_us = (uint32_t)(period / 1000.0);
+            e->average_us = (uint32_t)(average / 1000.0);
+            e->plugin_us = (uint32_t)(perf->stutter.plugin_ns / 1000);
+            for (int i = 0; i < XNZ_PERF_COUNT; i++)
+            {
+                e->task_us[i] = (uint32_t)(perf->stutter.task_ns[i] / 1000);
+            }
+            perf->stutter.plugin += (e->plugin = 2.0 * (double)perf->stutter.plugin_ns >= period - average);
+        }
+        if (perf->stutter.plugin_ns_max < perf->stutter.plugin_ns)
+        {
+            perf->stutter.plugin_ns_max = perf->stutter.plugin_ns;
+        }
+        perf->stutter.plugin_ns_sum += perf->stutter.plugin_ns;
+        perf->stutter.period_ns_sum += now - perf->stutter.last;
+        perf->stutter.frames++;
+    }
+    else
+    {
+        perf->stutter.started = now;
+    }
+    memset(perf->stutter.task_ns, 0, sizeof(perf->stutter.task_ns));
+    perf->stutter.plugin_ns = 0;
+    perf->stutter.last = now;
+    return -1.0f; // every frame
+}
+
+/*
+ * Summary, then one line per recorded stutter (oldest first) with the tasks
+ * that took at least 0.1 ms during that frame.
+ */
+static void xnz_stutter_report(xnz_context *ctx)
+{
+    xnz_perf *perf = &ctx->cold->perf; uint32_t frames = perf->stutter.frames ? perf->stutter.frames : 1;
+    uint32_t first = perf->stutter.stutters > XNZ_STUTTER_EVENTS ? perf->stutter.stutters - XNZ_STUTTER_EVENTS : 0;
+    char *buffer = malloc(XNZ_PERF_DUMP_BUFFER); size_t used = 0;
+    if (buffer == NULL)
+    {
+        xnz_log(XNZ_LOG_ERROR, "stutter: report failed (malloc)\n");
+        return;
+    }
+    xnz_log_flush();
+    used += snprintf(buffer, XNZ_PERF_DUMP_BUFFER, XNZ_LOG_PREFIX"[info]: stutter: %u frames (mean %.2f ms), %u stutters: %u plugin, %u external; plugin %.1f us/frame (max %.1f us)\n",
+                     perf->stutter.frames, (double)perf->stutter.period_ns_sum / 1e6 / frames,
+                     perf->stutter.stutters, perf->stutter.plugin, perf->stutter.stutters - perf->stutter.plugin,
+                     (double)perf->stutter.plugin_ns_sum / 1e3 / frames, (double)perf->stutter.plugin_ns_max / 1e3);
+    for (uint32_t n = first; n < perf->stutter.stutters; n++)
+    {
+        const xnz_stutter_event *e = &perf->stutter.event[n % XNZ_STUTTER_EVENTS];
+        if (XNZ_PERF_DUMP_BUFFER - used < 1024)
+        {
+            XPLMDebugString(buffer); used = 0;
+        }
+        used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, XNZ_LOG_PREFIX"[info]: stutter: frame %u at %.3f s: %.2f ms (average %.2f), plugin %.2f ms, %s",
+                         e->frame, (double)(e->time - perf->stutter.started) / 1e9, e->period_us / 1e3,
+                         e->average_us / 1e3, e->plugin_us / 1e3, e->plugin ? "plugin" : "external");
+        for (int i = 0; i < XNZ_PERF_COUNT; i++)
+        {
+            if (e->task_us[i] >= 100)
+            {
+                used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, " %s %.2f", xnz_perf_names[i], e->task_us[i] / 1e3);
+            }
+        }
+        used += snprintf(buffer + used, XNZ_PERF_DUMP_BUFFER - used, "\n");
+    }
+    XPLMDebugString(buffer);
+    free(buffer);
+}
+
+static void menu_hdlr_fnc(void *inMenuRef, void *inItemRef)
+{
+    if (inMenuRef)
+    {
+        if (inItemRef)
+        {
+            int *item = inItemRef;
+            xnz_context *ctx = inMenuRef;
+            if (*item == ctx->cold->perf.id_menu_item_dump)
+            {
+                xnz_perf_dump(ctx);
+                xnz_stutter_report(ctx);
+                return;
+            }
+            if (*item == ctx->cold->id_menu_item_on_off)
+            {
+                XPLMMenuCheck s; XPLMCheckMenuItemState(ctx->cold->id_th_on_off, ctx->cold->id_menu_item_on_off, &s);
+                if (s == xplm_Menu_Checked)
+                {
+                    XPLMCheckMenuItem(ctx->cold->id_th_on_off, ctx->cold->id_menu_item_on_off, xplm_Menu_NoCheck);
+                    xnz_log(XNZ_LOG_INFO, "menu: disabling TCA flight loop callback\n");
+                    global_context->tca_support_enabled = 0;
+                    global_context->skip_idle_overwrite = 0;
+#ifdef PUBLIC_RELEASE_BUILD
+                    if (ctx->idx_throttle_axis_1 >= 0)
+                    {
+                        int th_axis_ass[2] = { 20, 21, };
+                        xnz_log(XNZ_LOG_INFO, "releasing joystick axes (flight loop disabled)\n");
+                        XPLMSetDatavi(ctx->cold->i_stick_ass, th_axis_ass, ctx->idx_throttle_axis_1, 2);
+                    }
+#endif
+                    return;
+                }
+                XPLMCheckMenuItem(ctx->cold->id_th_on_off, ctx->cold->id_menu_item_on_off, xplm_Menu_Checked);
+                xnz_log(XNZ_LOG_INFO, "menu: enabling TCA flight loop callback\n");
+                global_context->tca_support_enabled = 1;
+                global_context->skip_idle_overwrite = 0;
+#ifdef PUBLIC_RELEASE_BUILD
+                if (ctx->idx_throttle_axis_1 >= 0)
+                {
+                    int no_axis_ass[2] = { 0, 0, };
+                    XPLMSetDatavi(ctx->cold->i_stick_ass, no_axis_ass, ctx->idx_throttle_axis_1, 2);
+                    xnz_log(XNZ_LOG_INFO, "menu: re-capturing joystick axes (flight loop enabled)\n");
+                }
+#endif
+                return;
+            }
+            return;
+        }
+        return;
+    }
+    return;
+}
+
+#ifndef PUBLIC_RELEASE_BUILD
+/*
+ * Command journal (see XNZjournal.h): chandler_journal runs every handler from
+ * xnz_init_cmds (its refcon is the handler's index) and fills in one record
+ * per begin and end phase, counting the continue phases in between; while a
+ * handler runs, the XPLM call wrappers below note its downstream commands and
+ * datarefs in the current record. Main thread only: X-Plane calls command
+ * handlers there.
+ */
+#define XNZ_JOURNAL_FILE "x-nullzones.journal"
+
+static xnz_journal_record *xnz_journal_active = NULL;
+
+static inline void xnz_journal_note(int call, const void *target)
+{
+    xnz_journal_record *r = xnz_journal_active;
+    if (r)
+    {
+        if (r->calls == 0)
+        {
+            r->call = (uint8_t)call;
+            r->target = (uint64_t)(uintptr_t)target;
+        }
+        if (r->calls < UINT8_MAX)
+        {
+            r->calls++;
+        }
+    }
+}
+
+static void xnz_journal_XPLMCommandOnce(XNZ_CALLS_SITE_PARAM XPLMCommandRef inCommand)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_ONCE, inCommand); XNZ_CALLS_XPLM(XPLMCommandOnce)(XNZ_CALLS_SITE_ARG inCommand);
+}
+
+static void xnz_journal_XPLMCommandBegin(XNZ_CALLS_SITE_PARAM XPLMCommandRef inCommand)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_BEGIN, inCommand); XNZ_CALLS_XPLM(XPLMCommandBegin)(XNZ_CALLS_SITE_ARG inCommand);
+}
+
+static void xnz_journal_XPLMCommandEnd(XNZ_CALLS_SITE_PARAM XPLMCommandRef inCommand)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_END, inCommand); XNZ_CALLS_XPLM(XPLMCommandEnd)(XNZ_CALLS_SITE_ARG inCommand);
+}
+
+static void xnz_journal_XPLMSetDatai(XNZ_CALLS_SITE_PARAM XPLMDataRef inDataRef, int inValue)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_SETI, inDataRef); XNZ_CALLS_XPLM(XPLMSetDatai)(XNZ_CALLS_SITE_ARG inDataRef, inValue);
+}
+
+static void xnz_journal_XPLMSetDataf(XNZ_CALLS_SITE_PARAM XPLMDataRef inDataRef, float inValue)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_SETF, inDataRef); XNZ_CALLS_XPLM(XPLMSetDataf)(XNZ_CALLS_SITE_ARG inDataRef, inValue);
+}
+
+static void xnz_journal_XPLMSetDatavi(XNZ_CALLS_SITE_PARAM XPLMDataRef inDataRef, int *inValues, int inOffset, int inCount)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_SETVI, inDataRef); XNZ_CALLS_XPLM(XPLMSetDatavi)(XNZ_CALLS_SITE_ARG inDataRef, inValues, inOffset, inCount);
+}
+
+static void xnz_journal_XPLMSetDatavf(XNZ_CALLS_SITE_PARAM XPLMDataRef inDataRef, float *inValues, int inOffset, int inCount)
+{
+    xnz_journal_note(XNZ_JOURNAL_CALL_SETVF, inDataRef); XNZ_CALLS_XPLM(XPLMSetDatavf)(XNZ_CALLS_SITE_ARG inDataRef, inValues, inOffset, inCount);
+}
+
+/* from here on, all handlers and backends call the XPLM through the above */
+#ifdef XNZ_XPLM_CALLSTATS
+#undef XPLMCommandOnce
+#undef XPLMCommandBegin
+#undef XPLMCommandEnd
+#undef XPLMSetDatai
+#undef XPLMSetDataf
+#undef XPLMSetDatavi
+#undef XPLMSetDatavf
+#endif
+#define XPLMCommandOnce(...)  xnz_journal_XPLMCommandOnce(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMCommandBegin(...) xnz_journal_XPLMCommandBegin(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMCommandEnd(...)   xnz_journal_XPLMCommandEnd(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMSetDatai(...)     xnz_journal_XPLMSetDatai(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMSetDataf(...)     xnz_journal_XPLMSetDataf(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMSetDatavi(...)    xnz_journal_XPLMSetDatavi(XNZ_CALLS_SITE __VA_ARGS__)
+#define XPLMSetDatavf(...)    xnz_journal_XPLMSetDatavf(XNZ_CALLS_SITE __VA_ARGS__)
+
+static int xnz_journal_backend(const xnz_cmd_context *commands, int family)
+{
+    switch (family)
+    {
+        case XNZ_JOURNAL_FAMILY_AP:
+            return commands->xnz_ap;
+        case XNZ_JOURNAL_FAMILY_AT:
+            return commands->xnz_at;
+        case XNZ_JOURNAL_FAMILY_BT:
+            return commands->xnz_bt;
+        case XNZ_JOURNAL_FAMILY_ET:
+            return commands->xnz_et;
+        case XNZ_JOURNAL_FAMILY_PB:
+            return commands->xnz_pb;
+        default:
+            return 0;
+    }
+}
+
+static int chandler_journal(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    size_t i = (size_t)(uintptr_t)inRefcon; xnz_cmd_context *commands = &global_context->cold->commands;
+    xnz_journal *j = &commands->journal; xnz_journal_record *r = NULL;
+    xnz_journal_record *outer = xnz_journal_active; // handler triggered by another one's XPLMCommandOnce
+    uint64_t time = xnz_perf_enter(&global_context->cold->perf), duration; int ret;
+    if (inPhase == xplm_CommandContinue)
+    {
+        if (j->holds[i] < UINT32_MAX)
+        {
+            j->holds[i]++;
+        }
+    }
+    else
+    {
+        r = &j->record[j->next & (XNZ_JOURNAL_RECORDS - 1)];
+        memset(r, 0, sizeof(*r));
+        r->time = time;
+        r->sequence = j->next++;
+        r->holds = inPhase == xplm_CommandEnd ? j->holds[i] : 0;
+        r->command = (uint16_t)i;
+        r->phase = (uint8_t)inPhase;
+        r->family = (uint8_t)xnz_init_cmds[i].family;
+        r->backend = (int16_t)xnz_journal_backend(commands, xnz_init_cmds[i].family);
+        j->holds[i] = 0;
+    }
+    xnz_journal_active = r; // continue phases: downstream calls aren't noted
+    ret = xnz_init_cmds[i].handler(inCommand, inPhase, commands);
+    duration = xnz_time_ns() - time;
+    xnz_journal_active = outer;
+    if (r)
+    {
+        r->duration = duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration;
+    }
+    if (inPhase >= xplm_CommandBegin && inPhase <= xplm_CommandEnd)
+    {
+        xnz_hist_record(&global_context->cold->perf.handler[i][inPhase], duration);
+    }
+    xnz_perf_leave(&global_context->cold->perf, XNZ_PERF_HANDLERS, time);
+    return ret;
+}
+
+static int xnz_journal_write_name(FILE *f, const char *name)
+{
+    uint32_t length = (uint32_t)strlen(name);
+    return fwrite(&length, sizeof(length), 1, f) != 1 || fwrite(name, 1, length, f) != length;
+}
+
+/*
+ * Symbol table: every resolved reference we know by name; returns the number
+ * of symbols (written to f unless NULL), or -1 on write error.
+ */
+static int xnz_journal_symbols(const xnz_cmd_context *commands, FILE *f)
+{
+    int count = 0;
+    for (size_t i = 0; i < sizeof(xnz_init_refs) / sizeof(xnz_init_refs[0]); i++)
+    {
+        uint64_t target = (uint64_t)(uintptr_t)*(void**)((char*)commands + xnz_init_refs[i].offset);
+        if (target)
+        {
+            if (f && (fwrite(&target, sizeof(target), 1, f) != 1 || xnz_journal_write_name(f, xnz_init_refs[i].name)))
+            {
+                return -1;
+            }
+            count++;
+        }
+    }
+    for (size_t i = 0; i < sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]); i++)
+    {
+        uint64_t target = (uint64_t)(uintptr_t)*(void**)((char*)commands + xnz_init_cmds[i].offset);
+        if (target)
+        {
+            if (f && (fwrite(&target, sizeof(target), 1, f) != 1 || xnz_journal_write_name(f, xnz_init_cmds[i].name)))
+            {
+                return -1;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static void xnz_journal_dump(xnz_cmd_context *commands)
+{
+    char path[1024], temp[sizeof(path) + 4]; FILE *f; xnz_journal *j = &commands->journal;
+    xnz_journal_header h =
+    {
+        .magic = XNZ_JOURNAL_MAGIC,
+        .version = XNZ_JOURNAL_VERSION,
+        .record_size = sizeof(xnz_journal_record),
+        .record_count = j->next < XNZ_JOURNAL_RECORDS ? j->next : XNZ_JOURNAL_RECORDS,
+        .command_count = sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]),
+        .symbol_count = xnz_journal_symbols(commands, NULL),
+        .dumped = xnz_time_ns(),
+    };
+    xnz_prefs_dir(path, sizeof(path) - sizeof(XNZ_JOURNAL_FILE));
+    strcat(path, XNZ_JOURNAL_FILE);
+    snprintf(temp, sizeof(temp), "%s.tmp", path);
+    if (NULL == (f = fopen(temp, "wb")))
+    {
+        xnz_log(XNZ_LOG_ERROR, "could not write command journal \"%s\"\n", temp);
+        return;
+    }
+    if (fwrite(&h, sizeof(h), 1, f) != 1)
+    {
+        goto fail;
+    }
+    for (uint32_t seq = j->next - h.record_count; seq != j->next; seq++)
+    {
+        if (fwrite(&j->record[seq & (XNZ_JOURNAL_RECORDS - 1)], sizeof(xnz_journal_record), 1, f) != 1)
+        {
+            goto fail;
+        }
+    }
+    for (uint32_t i = 0; i < h.command_count; i++)
+    {
+        if (xnz_journal_write_name(f, xnz_init_cmds[i].name))
+        {
+            goto fail;
+        }
+    }
+    if (xnz_journal_symbols(commands, f) < 0)
+    {
+        goto fail;
+    }
+    fclose(f);
+#if IBM
+    remove(path); // rename does not replace existing files on Windows
+#endif
+    if (rename(temp, path))
+    {
+        xnz_log(XNZ_LOG_ERROR, "could not write command journal \"%s\"\n", path);
+        remove(temp); return;
+    }
+    xnz_log(XNZ_LOG_INFO, "command journal: %u records written to \"%s\"\n", h.record_count, path);
+    return;
+
+fail:
+    xnz_log(XNZ_LOG_ERROR, "could not write command journal \"%s\"\n", temp);
+    fclose(f); remove(temp); return;
+}
+
+static int chandler_jrn_dmp(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            xnz_journal_dump(inRefcon);
+            return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
+#endif
+
+static int xnz_op_noop(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    return 0;
+}
+
+static const struct
+{
+    const char *text;
+    int priority; // highest first
+    int opposite; // -1: none
+}
+xnz_callout_info[XNZ_CALLOUT_COUNT] =
+{
+    [XNZ_CALLOUT_GEAR_UP] = { "gear up",             1, XNZ_CALLOUT_GEAR_DN, },
+    [XNZ_CALLOUT_GEAR_DN] = { "gear down",           1, XNZ_CALLOUT_GEAR_UP, },
+    [XNZ_CALLOUT_PKB_SET] = { "park brake set",      1, XNZ_CALLOUT_PKB_REL, },
+    [XNZ_CALLOUT_PKB_REL] = { "park brake released", 1, XNZ_CALLOUT_PKB_SET, },
+    [XNZ_CALLOUT_ICE]     = { "ice detected",        2, -1,                  },
+};
+
+static void xnz_callout_remove(xnz_callouts *c, int index)
+{
+    memmove(&c->queue[index], &c->queue[index + 1], (c->count - index - 1) * sizeof(c->queue[0]));
+    c->count--;
+}
+
+/*
+ * Queue a callout (never blocks, never speaks).
+ */
+static void xnz_callout(xnz_cmd_context *commands, int id)
+{
+    xnz_callouts *c = &commands->callouts; uint64_t now = xnz_time_ns();
+    for (int i = 0; i < c->count; i++)
+    {
+        if (c->queue[i].id == id)
+        {
+            return; // already pending
+        }
+        if (c->queue[i].id == xnz_callout_info[id].opposite)
+        {
+            xnz_callout_remove(c, i); // cancel each other out
+            return;
+        }
+    }
+    if (c->last_id == id && now - c->last_spoken < XNZ_CALLOUT_REPEAT_NS)
+    {
+        return;
+    }
+    if (c->count == XNZ_CALLOUT_QUEUE)
+    {
+        int lowest = c->count - 1;
+        for (int i = c->count - 1; i >= 0; i--)
+        {
+            if (xnz_callout_info[c->queue[i].id].priority < xnz_callout_info[c->queue[lowest].id].priority)
+            {
+                lowest = i;
+            }
+        }
+        if (xnz_callout_info[c->queue[lowest].id].priority >= xnz_callout_info[id].priority)
+        {
+            return; // queue full of callouts at least as important
+        }
+        xnz_callout_remove(c, lowest);
+    }
+    c->queue[c->count].id = id;
+    c->queue[c->count].queued = now;
+    c->count++;
+    if (c->f_l_co)
+    {
+        XPLMSetFlightLoopCallbackInterval(c->f_l_co, -1.0f, 1, commands);
+    }
+}
+
+/*
+ * Speak the most important callout that's ready (oldest first among equals),
+ * then sleep until the next one could be; unscheduled while the queue's empty.
+ */
+static float callout_hdlr_fnc(float inElapsedSinceLastCall,
+                              float inElapsedTimeSinceLastFlightLoop,
+                              int   inCounter,
+                              void *inRefcon)
+{
+    xnz_callouts *c = &((xnz_cmd_context*)inRefcon)->callouts;
+    uint64_t now = xnz_time_ns(), next = UINT64_MAX;
+    uint64_t spacing = c->last_id < 0 ? 0 : c->last_spoken + XNZ_CALLOUT_SPACING_NS;
+    if (now >= spacing)
+    {
+        int best = -1;
+        for (int i = 0; i < c->count; i++)
+        {
+            if (c->queue[i].queued + XNZ_CALLOUT_SETTLE_NS <= now &&
+                (best < 0 || xnz_callout_info[c->queue[i].id].priority > xnz_callout_info[c->queue[best].id].priority))
+            {
+                best = i;
+            }
+        }
+        if (best >= 0)
+        {
+            XPLMSpeakString(xnz_callout_info[c->queue[best].id].text);
+            c->last_id = c->queue[best].id;
+            c->last_spoken = now;
+            spacing = now + XNZ_CALLOUT_SPACING_NS;
+            xnz_callout_remove(c, best);
+        }
+    }
+    for (int i = 0; i < c->count; i++)
+    {
+        uint64_t ready = c->queue[i].queued + XNZ_CALLOUT_SETTLE_NS;
+        if (ready < spacing)
+        {
+            ready = spacing;
+        }
+        if (ready < next)
+        {
+            next = ready;
+        }
+    }
+    if (next == UINT64_MAX)
+    {
+        return 0.0f; // queue empty: unschedule
+    }
+    if (next <= now)
+    {
+        return -1.0f;
+    }
+    return (float)((next - now) / 1000000ull) / 1000.0f + 0.001f;
+}
+
+/*
+ * Parking brake backends (xnz_pb).
+ */
+static int xnz_pb_errr_get(xnz_cmd_context *commands)
+{
+    return -1;
+}
+
+static int xnz_pb_errr_set(xnz_cmd_context *commands, int set)
+{
+    return -1;
+}
+
+static int xnz_pb_xplm_get(xnz_cmd_context *commands)
+{
+    if (commands->xp.pbrak_onoff < 0)
+    {
+        commands->xp.pbrak_onoff = 1.0f <= XPLMGetDataf(commands->xp.pbrak_ratio);
+    }
+    return !!commands->xp.pbrak_onoff;
+}
+
+static int xnz_pb_xplm_set(xnz_cmd_context *commands, int set)
+{
+    if (set)
+    {
+        XPLMSetDataf(commands->xp.pbrak_ratio, 1.0f);
+        commands->xp.pbrak_onoff = 1;
+        return 0;
+    }
+    XPLMSetDataf(commands->xp.pbrak_ratio, 0.0f);
+    commands->xp.pbrak_onoff = 0;
+    return 0;
+}
+
+static int xnz_pb_to32_get(xnz_cmd_context *commands)
+{
+    return !!XPLMGetDatai(commands->pb.to32.pbrak_onoff);
+}
+
+static int xnz_pb_to32_set(xnz_cmd_context *commands, int set)
+{
+    if (set)
+    {
+        XPLMSetDatai(commands->pb.to32.pbrak_onoff, 1);
+        return 0;
+    }
+    XPLMSetDatai(commands->pb.to32.pbrak_onoff, 0);
+    return 0;
+}
+
+static int xnz_pb_ff35_get(xnz_cmd_context *commands)
+{
+    return !XPLMGetDatai(commands->pb.ff35.pbrak_offon);
+}
+
+static int xnz_pb_ff35_set(xnz_cmd_context *commands, int set)
+{
+    if (set)
+    {
+        XPLMSetDatai(commands->pb.ff35.pbrak_offon, 0);
+        return 0;
+    }
+    XPLMSetDatai(commands->pb.ff35.pbrak_offon, 1);
+    return 0;
+}
+
+static int xnz_pb_tbm9_get(xnz_cmd_context *commands)
+{
+    return 1.0f <= XPLMGetDataf(commands->pb.tbm9.pbrak_ratio);
+}
+
+static int xnz_pb_tbm9_set(xnz_cmd_context *commands, int set)
+{
+    if (set)
+    {
+        if (commands->xnz_bt == XNZ_BT_TBM9)
+        {
+            float barray[4] = { 1.0f, 1.0f, 0.0f, 0.0f, };
+            XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[0], 0, 2);
+            XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 1.0f);
+//          XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[2], 0, 2); // tested -- resetting to zero immediately doesn't work
+            return 0;
+        }
+        XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 1.0f);
+        return 0;
+    }
+    if (commands->xnz_bt == XNZ_BT_TBM9)
+    {
+        /*
+         * just in case we unset parking brake right after setting it,
+         * w/out calling e.g. brake hold regular or similar in between
+         */
+        float barray[4] = { 1.0f, 1.0f, 0.0f, 0.0f, };
+        XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[2], 0, 2);
+        XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 0.0f);
+        return 0;
+    }
+    XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 0.0f);
+    return 0;
+}
+
+static const xnz_pb_ops xnz_pb_ops_errr = { .get = xnz_pb_errr_get, .set = xnz_pb_errr_set, };
+static const xnz_pb_ops xnz_pb_ops_xplm = { .get = xnz_pb_xplm_get, .set = xnz_pb_xplm_set, };
+static const xnz_pb_ops xnz_pb_ops_to32 = { .get = xnz_pb_to32_get, .set = xnz_pb_to32_set, };
+static const xnz_pb_ops xnz_pb_ops_ff35 = { .get = xnz_pb_ff35_get, .set = xnz_pb_ff35_set, };
+static const xnz_pb_ops xnz_pb_ops_tbm9 = { .get = xnz_pb_tbm9_get, .set = xnz_pb_tbm9_set, };
+
+static int parking_brake_get(xnz_cmd_context *commands)
+{
+    if (commands)
+    {
+        return commands->ops.pb->get(commands);
+    }
+    return -1;
+}
+
+static int parking_brake_set(xnz_cmd_context *commands, int set)
+{
+    if (commands)
+    {
+        return commands->ops.pb->set(commands, set);
+    }
+    return -1;
+}
+
+/*
+ * Speed range for regular braking (0: low, 1: medium, 2: high).
+ */
+static inline int brake_speed(const xnz_cmd_context *commands)
+{
+    float gs = MPS2KTS(XPLMGetDataf(commands->xp.groundspeed));
+    if (gs > 50.0f)
+    {
+        return 2;
+    }
+    if (gs > 15.0f)
+    {
+        return 1;
+    }
+    if (commands->xp_11_00_or_later && gs < GROUNDSP_KTS_MIN)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Target deceleration (m/s²) for the given speed range, from the aircraft's
+ * profile if it has one, else the built-in default.
+ */
+static inline float brake_target(const xnz_cmd_context *commands, int speed)
+{
+    static const float decel[3] = { 1.0f, 2.0f, 3.0f, };
+    if (commands->profile && (commands->profile->flags & XNZ_PROFILE_DECEL))
+    {
+        return commands->profile->decel[speed];
+    }
+    return decel[speed];
+}
+
+static void brake_ctl_reset(xnz_cmd_context *commands)
+{
+    commands->brake.t_last = 0;
+    commands->brake.gs_last = 0.0f;
+    commands->brake.decel = 0.0f;
+    commands->brake.output = 0.0f;
+}
+
+/*
+ * Brake output for the current frame. ratio: the backend's built-in brake
+ * ratios (low, medium, high speed), overridden by the profile's. Frames are
+ * sampled on the monotonic clock, but the time step is converted to sim time
+ * (sim_speed_actual: time acceleration, or a sim slowed down by a low frame
+ * rate) since that's what groundspeed changes are measured against; the output
+ * never exceeds the high speed ratio, and once (nearly) stopped, it goes to
+ * the low speed one (or medium, X-Plane 11) to hold the aircraft in place.
+ */
+static float brake_ctl_update(xnz_cmd_context *commands, const float ratio[3])
+{
+    xnz_brake_ctl *ctl = &commands->brake;
+    float gs = XPLMGetDataf(commands->xp.groundspeed);
+    uint64_t t = xnz_time_ns(); float dt, goal, step;
+    int speed = brake_speed(commands);
+    if (XPLMGetDatai(commands->xp.sim_paused))
+    {
+        ctl->t_last = 0; // restart sampling once unpaused
+        return ctl->output;
+    }
+    if (ctl->t_last == 0 || t - ctl->t_last > UINT64_C(500000000))
+    {
+        ctl->t_last = t; ctl->gs_last = gs; // first sample or long stall
+        return ctl->output;
+    }
+    if (t == ctl->t_last)
+    {
+        return ctl->output; // no new frame
+    }
+    dt = (float)((double)(t - ctl->t_last) / 1000000000.0);
+    if (commands->xp.sim_speedup)
+    {
+        dt *= XPLMGetDataf(commands->xp.sim_speedup); // groundspeed advances in sim time
+    }
+    if (dt <= 0.0f)
+    {
+        return ctl->output;
+    }
+    ctl->decel += ((ctl->gs_last - gs) / dt - ctl->decel) * fminf(1.0f, dt / BRAKE_DECEL_TAU);
+    ctl->t_last = t; ctl->gs_last = gs;
+    if (MPS2KTS(gs) < GROUNDSP_KTS_MIN)
+    {
+        goal = brake_ratio(commands, speed, ratio[speed]);
+    }
+    else
+    {
+        goal = ctl->output + BRAKE_DECEL_GAIN * (brake_target(commands, speed) - ctl->decel) * dt;
+    }
+    step = fmaxf(-BRAKE_RAMP_DN * dt, fminf(BRAKE_RAMP_UP * dt, goal - ctl->output));
+    ctl->output = fmaxf(0.0f, fminf(brake_ratio(commands, 2, ratio[2]), ctl->output + step));
+    return ctl->output;
+}
+
+/*
+ * Regular brake backends (xnz_bt).
+ */
+static int xnz_bt_xplm_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    static const float ratio[3] = { 0.3f, 0.6f, 0.9f, };
+    if (inPhase == xplm_CommandBegin)
+    {
+        commands->xp.pbrak_onoff = parking_brake_get(commands);
+        brake_ctl_reset(commands);
+        return 0; // TODO: autobrake -> manual braking
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        float output = brake_ctl_update(commands, ratio);
+        XPLMSetDataf(commands->xp.l_rgb_ratio, output);
+        XPLMSetDataf(commands->xp.r_rgb_ratio, output);
+        return 0;
+    }
+    XPLMSetDataf(commands->xp.l_rgb_ratio, 0.0f);
+    XPLMSetDataf(commands->xp.r_rgb_ratio, 0.0f);
+    return parking_brake_set(commands, commands->xp.pbrak_onoff);
+}
+
+static int xnz_bt_comm_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        if (commands->bt.comm.cmd_mxb_hld == NULL) // deferred initialization
+        {
+            commands->bt.comm.cmd_mxb_hld = XPLMFindCommand(commands->bt.comm.commnd_max_hld);
+            commands->bt.comm.cmd_mxb_hld = XPLMFindCommand(commands->bt.comm.commnd_rgb_hld);
+            commands->xp.pbrak_onoff = parking_brake_get(commands);
+            commands->bt.comm.cmd_current = NULL;
+            return 0;
+        }
+        if (commands->bt.comm.cmd_current == commands->bt.comm.cmd_mxb_hld ||
+            commands->bt.comm.cmd_current == commands->bt.comm.cmd_rgb_hld)
+        {
+            commands->xp.pbrak_onoff = parking_brake_get(commands);
+            XPLMCommandEnd(commands->bt.comm.cmd_current);
+            commands->bt.comm.cmd_current = NULL;
+            return 0;
+        }
+        commands->xp.pbrak_onoff = parking_brake_get(commands);
+        commands->bt.comm.cmd_current = NULL;
+        return 0; // TODO: autobrake -> manual braking
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        switch (brake_speed(commands))
+        {
+            case 2:
+                if (commands->bt.comm.cmd_mxb_hld)
+                {
+                    if (commands->bt.comm.cmd_current == NULL)
+                    {
+                        XPLMCommandBegin((commands->bt.comm.cmd_current = commands->bt.comm.cmd_mxb_hld));
+                        return 0;
+                    }
+                    if (commands->bt.comm.cmd_current == commands->bt.comm.cmd_mxb_hld)
+                    {
+                        return 0;
+                    }
+                    if (commands->bt.comm.cmd_current == commands->bt.comm.cmd_rgb_hld)
+                    {
+                        XPLMCommandEnd(commands->bt.comm.cmd_current);
+                        XPLMCommandBegin((commands->bt.comm.cmd_current = commands->bt.comm.cmd_mxb_hld));
+                        return 0;
+                    }
+                }
+                commands->bt.comm.cmd_current = NULL;
+                return 0;
+            default:
+                if (commands->bt.comm.cmd_rgb_hld)
+                {
+                    if (commands->bt.comm.cmd_current == NULL)
+                    {
+                        XPLMCommandBegin((commands->bt.comm.cmd_current = commands->bt.comm.cmd_rgb_hld));
+                        return 0;
+                    }
+                    if (commands->bt.comm.cmd_current == commands->bt.comm.cmd_rgb_hld)
+                    {
+                        return 0;
+                    }
+                    if (commands->bt.comm.cmd_current == commands->bt.comm.cmd_mxb_hld)
+                    {
+                        XPLMCommandEnd(commands->bt.comm.cmd_current);
+                        XPLMCommandBegin((commands->bt.comm.cmd_current = commands->bt.comm.cmd_rgb_hld));
+                        return 0;
+                    }
+                }
+                commands->bt.comm.cmd_current = NULL;
+                return 0;
+        }
+    }
+    if (commands->bt.comm.cmd_current != NULL)
+    {
+        XPLMCommandEnd(commands->bt.comm.cmd_current);
+        commands->bt.comm.cmd_current = NULL;
+        return 0;
+    }
+    return 0;
+}
+
+/*
+ * PKBR, SIMC: regular braking via the parking brake ratio (low, medium and
+ * high speed ratios differ), restored to its prior state when released.
+ */
+static int xnz_bt_pbrk_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase, const float ratio[3])
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        commands->xp.pbrak_onoff = parking_brake_get(commands);
+        brake_ctl_reset(commands);
+        return 0; // TODO: autobrake -> manual braking
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        if (commands->xnz_pb == XNZ_PB_XPLM && parking_brake_get(commands) == 1)
+        {
+            return 0;
+        }
+        XPLMSetDataf(commands->xp.pbrak_ratio, brake_ctl_update(commands, ratio));
+        return 0;
+    }
+    if (commands->xnz_pb == XNZ_PB_XPLM)
+    {
+        return parking_brake_set(commands, commands->xp.pbrak_onoff);
+    }
+    XPLMSetDataf(commands->xp.pbrak_ratio, 0.0f);
+    return parking_brake_set(commands, commands->xp.pbrak_onoff);
+}
+
+static int xnz_bt_pkbr_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    static const float ratio[3] = { 0.3f, 0.6f, 0.9f, };
+    return xnz_bt_pbrk_rgb_hld(commands, inPhase, ratio);
+}
+
+static int xnz_bt_simc_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    static const float ratio[3] = { 0.5f, .75f, 1.0f, };
+    return xnz_bt_pbrk_rgb_hld(commands, inPhase, ratio);
+}
+
+static int xnz_bt_to32_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    static const float ratio[3] = { 0.3f, 0.6f, 0.9f, };
+    if (inPhase == xplm_CommandBegin)
+    {
+        brake_ctl_reset(commands);
+        return 0;
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        float output = brake_ctl_update(commands, ratio);
+        XPLMSetDataf(commands->bt.to32.l_rgb_ratio, output);
+        XPLMSetDataf(commands->bt.to32.r_rgb_ratio, output);
+        return 0;
+    }
+    XPLMSetDataf(commands->bt.to32.l_rgb_ratio, 0.0f);
+    XPLMSetDataf(commands->bt.to32.r_rgb_ratio, 0.0f);
+    return 0;
+}
+
+/*
+ * sim/flight_controls/brakes_regular seems to use 1-sim/parckBrake too…
+ */
+static int xnz_bt_ff35_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        commands->bt.ff35.pbrak_onoff = parking_brake_get(commands);
+        return 0;
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        if (0 == parking_brake_get(commands))
+        {
+            return parking_brake_set(commands, 1);
+        }
+        return 0;
+    }
+    return parking_brake_set(commands, commands->bt.ff35.pbrak_onoff);
+}
+
+static int xnz_bt_tbm9_rgb_hld(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    static const float ratio[3] = { 0.3f, 0.6f, 0.9f, };
+    float barray[2];
+    if (inPhase == xplm_CommandBegin)
+    {
+        brake_ctl_reset(commands);
+        return 0;
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        barray[0] = barray[1] = brake_ctl_update(commands, ratio);
+        XPLMSetDatavf(commands->bt.tbm9.rbrak_array, barray, 0, 2);
+        return 0;
+    }
+    barray[0] = barray[1] = 0.0f; XPLMSetDatavf(commands->bt.tbm9.rbrak_array, barray, 0, 2);
+    return 0;
+}
 
-                        case XNZ_ET_EVIC:
-                            global_context->zones_info.share[ZONE_CLB] = 0.500000f;
-                            global_context->zones_info.share[ZONE_FLX] = 0.872725f - global_context->zones_info.share[ZONE_CLB]; // ~94% N1 @ PMDY/06
-                            global_context->zones_info.share[ZONE_TGA] = 0.971875f - global_context->zones_info.share[ZONE_FLX] - global_context->zones_info.share[ZONE_CLB]; // ~100% N1
-                            break;
+static const xnz_bt_ops xnz_bt_ops_noop = { .rgb_hld = xnz_op_noop,         };
+static const xnz_bt_ops xnz_bt_ops_xplm = { .rgb_hld = xnz_bt_xplm_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_comm = { .rgb_hld = xnz_bt_comm_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_pkbr = { .rgb_hld = xnz_bt_pkbr_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_simc = { .rgb_hld = xnz_bt_simc_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_to32 = { .rgb_hld = xnz_bt_to32_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_ff35 = { .rgb_hld = xnz_bt_ff35_rgb_hld, };
+static const xnz_bt_ops xnz_bt_ops_tbm9 = { .rgb_hld = xnz_bt_tbm9_rgb_hld, };
 
-                        case XNZ_ET_RPTP:
-                            global_context->zones_info.share[ZONE_CLB] = 0.450000f; // low end of economy cruise (~28,000ft)
-                            global_context->zones_info.share[ZONE_FLX] = 0.700000f - global_context->zones_info.share[ZONE_CLB]; // ~95% NG @ PMDY/06
-                            global_context->zones_info.share[ZONE_TGA] = 0.984375f - global_context->zones_info.share[ZONE_FLX] - global_context->zones_info.share[ZONE_CLB]; // (1-(1/64))
-                            break;
+/*
+ * Autopilot backends (xnz_ap).
+ */
+static int xnz_ap_xplm_a_p_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.ap_ap_on);
+//      XPLMCommandOnce(commands->xp.ap_yd_on); // TODO: when do we need this???
+        return 0;
+    }
+    return 0;
+}
 
-                        default:
-                            break;
-                    }
-#endif
-                }
-                xnz_log("determined engine type %d\n",     global_context->commands.xnz_et);
-                xnz_log("determined braking type %d\n",    global_context->commands.xnz_bt);
-                xnz_log("determined a/brake type %d\n",    global_context->commands.xnz_ab);
-                xnz_log("determined a/pilot type %d\n",    global_context->commands.xnz_ap);
-                xnz_log("determined throttle type %d\n",   global_context->         xnz_tt);
-                xnz_log("determined a/thrust type %d\n",   global_context->commands.xnz_at);
-                xnz_log("determined park brake type %d\n", global_context->commands.xnz_pb);
-
-                /* TCA thrust quadrant support */
-                if (global_context->idx_throttle_axis_1 < 0) // detection: runs only once
-                {
-                    size_t size = global_context->i_version_simulator < 11000 ? 100 : 500;
-                    for (size_t i = 0; i < size - 1; i++)
-                    {
-                        int i_stick_ass[2]; XPLMGetDatavi(global_context->i_stick_ass, i_stick_ass, i, 2);
-                        if (i_stick_ass[0] == 20 && i_stick_ass[1] == 21)
-                        {
-                            xnz_log("found throttle 1/2 axes at index (%02zd, %02zd) with assignment (%02d, %02d)\n", i, i + 1, i_stick_ass[0], i_stick_ass[1]);
-                            global_context->idx_throttle_axis_1 = i;
-                            break;
-                        }
-                    }
-                    if (global_context->idx_throttle_axis_1 >= 0 && 0 /* debug */)
-                    {
-                        xnz_log("[debug]: throttle_mapping ---------------\n");
-                        float last = -2.0f;
-                        int detents[3] =
-                        {
-                            roundf(TCA_IDLE_CTR * 200.0f),
-                            roundf(TCA_CLMB_CTR * 200.0f),
-                            roundf(TCA_FLEX_CTR * 200.0f),
-                        };
-                        for (int i = 0; i <= 200; i++)
-                        {
-                            float input, value = throttle_mapping((input = ((float)i / 200.0f)), global_context->zones_info);
-                            if (value < last)
-                            {
-                                xnz_log("[debug]: non-monotonically increasing throttle mapping, %.4f -> %.4f\n", last, value);
-                                exit(-1);
-                            }
-                            if (i == detents[0] || i == detents[1] || i == detents[2])
-                            {
-                                xnz_log("[debug]: throttle_mapping ---------------\n");
-                            }
-                            if (value < 0.0f)
-                            {
-                                xnz_log("[debug]: throttle_mapping(%.3f) = %.3f\n", input, (last = value));
-                            }
-                            else
-                            {
-                                xnz_log("[debug]: throttle_mapping(%.3f) = %.4f\n", input, (last = value));
-                            }
-                            if (i == detents[0] || i == detents[1] || i == detents[2])
-                            {
-                                xnz_log("[debug]: throttle_mapping ---------------\n");
-                            }
-                        }
-                        xnz_log("[debug]: throttle_mapping ---------------\n");
-                    }
-                }
-                if (global_context->idx_throttle_axis_1 >= 0) // capture: run every initial aircraft+livery reload
-                {
-#ifdef PUBLIC_RELEASE_BUILD
-                    // TODO: implement A320 API support
-                    if (global_context->xnz_tt == XNZ_TT_FF32)
-                    {
-                        int th_axis_ass[2] = { 20, 21, };
-                        xnz_log("[info]: releasing joystick axes (XNZ_TT_FF32)\n");
-                        XPLMSetDatavi(global_context->i_stick_ass, th_axis_ass, global_context->idx_throttle_axis_1, 2);
-                    }
-                    else
-#endif
-                    {
-                        if (global_context->tca_support_enabled)
-                        {
-                            int no_axis_ass[2] = { 0, 0, };
-                            xnz_log("[info]: capturing/re-capturing joystick axes (flight loop enabled)\n");
-                            XPLMSetDatavi(global_context->i_stick_ass, no_axis_ass, global_context->idx_throttle_axis_1, 2);
-                        }
-                    }
-                    global_context->skip_idle_overwrite = 0; XPLMSetFlightLoopCallbackInterval(global_context->f_l_th, 1, 1, global_context);
-                    xnz_log("setting TCA flight loop callback interval (enabled: %d)\n", global_context->tca_support_enabled);
-                    xnz_log("engine type %d beta %d (%d) reverse %d (%d, %f)\n",
-                            acf_en_type[0],
-                            global_context->acf_has_beta_thrust,
-                            XPLMGetDatai(global_context->rev_info[0]),
-                            global_context->acft_has_rev_thrust,
-                            XPLMGetDatai(global_context->rev_info[1]),
-                            XPLMGetDataf(global_context->rev_info[2]));
-                }
+static int xnz_ap_xplm_a_p_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (XPLMGetDatai(commands->xp.auto_pil_on) > 0)
+        {
+            XPLMCommandOnce(commands->xp.ap_fd_dn);
+        }
+        XPLMCommandOnce(commands->xp.ap_yd_no);
+        return 0;
+    }
+    return 0;
+}
 
-#ifndef PUBLIC_RELEASE_BUILD
-                global_context->i_context_init_done = 1;
-                global_context->ice_detect_positive = 0;
-                global_context->icecheck_required = 0.0f;
-                global_context->show_throttle_all = 0.0f;
-                global_context->last_throttle_all = XPLMGetDataf(global_context->f_throttall);
-                XPLMSetFlightLoopCallbackInterval(global_context->f_l_cb, 1, 1, global_context);
-                return;
-#else
-                global_context->i_context_init_done = 1;
-                return;
-#endif
-            }
-            break;
+static int xnz_ap_comm_a_p_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->ap.comm.cmd_ap_conn);
+        return 0;
+    }
+    return 0;
+}
 
-        default:
-            break;
+static int xnz_ap_comm_a_p_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->ap.comm.cmd_ap_disc);
+        return 0;
     }
+    return 0;
 }
 
-static int autothrottle_active(xnz_context *ctx)
+static const xnz_ap_ops xnz_ap_ops_noop =
+{
+    .a_p_onn = xnz_op_noop,
+    .a_p_off = xnz_op_noop,
+};
+
+static const xnz_ap_ops xnz_ap_ops_xplm =
 {
-    switch (ctx->commands.xnz_at)
+    .a_p_onn = xnz_ap_xplm_a_p_onn,
+    .a_p_off = xnz_ap_xplm_a_p_off,
+};
+
+static const xnz_ap_ops xnz_ap_ops_comm =
+{
+    .a_p_onn = xnz_ap_comm_a_p_onn,
+    .a_p_off = xnz_ap_comm_a_p_off,
+};
+
+/*
+ * Autothrottle backends (xnz_at).
+ */
+static int xnz_at_none_at_toga(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
     {
-        case XNZ_AT_FF32:
-        case XNZ_AT_TOLI:
+        if (commands->xnz_ap == XNZ_AP_XGFC)
+        {
+            XPLMCommandBegin(commands->xp.ap_cw_st);
+            return 0;
+        }
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (commands->xnz_ap == XNZ_AP_XGFC)
+        {
+            XPLMCommandEnd(commands->xp.ap_cw_st);
             return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
 
-        default:
-            if (ctx->xnz_tt == XNZ_TT_XPLM)
-            {
-                return 0 < XPLMGetDatai(ctx->commands.xp.auto_thr_on);
-            }
-            break;
+static int xnz_at_none_a_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.ap_to_ga);
+        return 0;
     }
     return 0;
 }
 
-static int servos_on(xnz_context *ctx)
+static int xnz_at_xplm_at_toga(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    switch (ctx->commands.xnz_ap)
+    if (inPhase == xplm_CommandEnd)
     {
-        default:
-            break;
+        XPLMCommandOnce(commands->xp.ap_to_ga);
+        XPLMCommandOnce(commands->xp.at_at_on);
+        return 0;
     }
-    return 0 < XPLMGetDatai(ctx->commands.xp.auto_pil_on);
+    return 0;
 }
 
-#ifndef PUBLIC_RELEASE_BUILD
+static int xnz_at_xplm_at_disc(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.at_at_no);
+        return 0;
+    }
+    return 0;
+}
 
-static void overlay_show(xnz_context *ctx)
+static int xnz_at_comm_at_toga(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (ctx)
+    if (inPhase == xplm_CommandEnd)
     {
-        if (ctx->overly_position_set == 0)
-        {
-            /*
-             * re-position throttle change/ice detection overlay for a laptop display
-             * Aerobask GTN 750 ~788px high: ((1120 - 788 = 332) / 1220) = (83 / 280)
-             */
-            int outW, outH, outL, yOff; XPLMGetScreenSize(&outW, &outH); yOff = (outH - ((outH * 83) / 280));
-            int outT, outR, outB, xOff; XPGetWidgetGeometry(ctx->widgetid[0], &outL, &outT, &outR, &outB);
-            xOff = ((outW - (outR - outL)) / 2); outL += xOff; outR += xOff; outT += yOff; outB += yOff;
-            XPSetWidgetGeometry(ctx->widgetid[0], outL + 0, outT - 0, outR - 0, outB + 0);
-            XPSetWidgetGeometry(ctx->widgetid[1], outL + 7, outT - 7, outR - 7, outB + 7);
-            xnz_log("[info]: overlay: W: %d | H: %d | X: %d -> %d | Y: %d -> %d\n", outW, outH, outL, outR, outB, outT);
-            ctx->overly_position_set = 1;
-        }
-        if (XPIsWidgetVisible(ctx->widgetid[0]) == 0) XPShowWidget(ctx->widgetid[0]);
-        if (XPIsWidgetVisible(ctx->widgetid[1]) == 0) XPShowWidget(ctx->widgetid[1]);
-        return;
+        XPLMCommandOnce(commands->at.comm.cmd_at_toga);
+        return 0;
     }
-    return;
+    return 0;
 }
 
-static void overlay_hide(xnz_context *ctx)
+static int xnz_at_comm_at_disc(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (ctx)
+    if (inPhase == xplm_CommandEnd)
     {
-        if (XPIsWidgetVisible(ctx->widgetid[1]) != 0) XPHideWidget(ctx->widgetid[1]);
-        if (XPIsWidgetVisible(ctx->widgetid[0]) != 0) XPHideWidget(ctx->widgetid[0]);
-        return;
+        XPLMCommandOnce(commands->at.comm.cmd_at_disc);
+        return 0;
     }
-    return;
+    return 0;
 }
 
-static float callback_hdlr(float inElapsedSinceLastCall,
-                           float inElapsedTimeSinceLastFlightLoop,
-                           int   inCounter,
-                           void *inRefcon)
+static int xnz_at_apto_a_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inRefcon)
+    if (inPhase == xplm_CommandEnd)
     {
-        xnz_context *ctx = inRefcon;
-        float f_throttall, array[2];
-        float airspeed = XPLMGetDataf(ctx->f_air_speed);
-        float groundsp = MPS2KTS(XPLMGetDataf(ctx->f_grd_speed));
+        XPLMCommandOnce(commands->at.toga.cmd_ap_toga);
+        return 0;
+    }
+    return 0;
+}
 
-        /* X-Plane 10: update ground roll friction coefficient as required */
-        if (ctx->i_version_simulator < 11000)
+static int xnz_at_xp11_at_toga(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (commands->xp.at_at_n1)
         {
-            if (XPLMGetDatai(ctx->ongroundany) && groundsp > GROUNDSP_KTS_MIN && groundsp < GROUNDSP_KTS_MAX)
-            {
-                float arc; ACF_ROLL_SET(arc, groundsp, ctx->nominal_roll_coef);
-                XPLMSetDataf(ctx->acf_roll_co, arc);
-            }
-            XPLMSetDataf(ctx->acf_roll_co, ctx->nominal_roll_coef);
+            XPLMCommandOnce(commands->xp.ap_to_ga);
+            XPLMCommandOnce(commands->xp.at_at_n1);
+            return 0;
         }
+        return xnz_at_xplm_at_toga(commands, inPhase);
+    }
+    return 0;
+}
 
-        if (ctx->xnz_tt == XNZ_TT_FF32 && !ctx->tt.ff32.api_has_initialized)
-        {
-            XPLMSendMessageToPlugin(XPLMFindPluginBySignature(XPLM_FF_SIGNATURE), XPLM_FF_MSG_GET_SHARED_INTERFACE, &ctx->tt.ff32.s);
-            if (ctx->tt.ff32.s.DataVersion != NULL && ctx->tt.ff32.s.DataAddUpdate != NULL)
-            {
-                ctx->tt.ff32.id_f32_eng_lever_lt = ctx->tt.ff32.s.ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever1");
-                ctx->tt.ff32.id_f32_eng_lever_rt = ctx->tt.ff32.s.ValueIdByName("Aircraft.Cockpit.Pedestal.EngineLever2");
-                if (ctx->tt.ff32.id_f32_eng_lever_lt > -1 && ctx->tt.ff32.id_f32_eng_lever_rt > -1)
-                {
-                    ctx->tt.ff32.api_has_initialized = 1;
-                }
-            }
-        }
+static int xnz_at_toli_at_toga(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.at_at_on);
+        return 0;
+    }
+    return 0;
+}
 
-        /* throttle readout (overlay) */
-        switch (ctx->xnz_tt)
-        {
-            case XNZ_TT_FF32:
-            {
-                if (ctx->tt.ff32.api_has_initialized)
-                {
-                    // Pedestal.EngineLever*: 0-20-65 (reverse-idle-max)
-                    ctx->tt.ff32.s.ValueGet(ctx->tt.ff32.id_f32_eng_lever_lt, &array[0]);
-                    ctx->tt.ff32.s.ValueGet(ctx->tt.ff32.id_f32_eng_lever_rt, &array[1]);
-                    if ((f_throttall = (((array[0] + array[1]) / 2.0f) - 20.0f) / 45.0f) < 0.0f)
-                    {
-                        (f_throttall = (((array[0] + array[1]) / 2.0f) - 20.0f) / 20.0f);
-                    }
-                    break;
-                }
-            } // fallthrough
-            case XNZ_TT_ERRR:
-                f_throttall = ctx->last_throttle_all;
-                break;
+static const xnz_at_ops xnz_at_ops_noop =
+{
+    .at_toga = xnz_op_noop,
+    .at_disc = xnz_op_noop,
+    .a_12_lt = xnz_op_noop,
+    .a_12_rt = xnz_op_noop,
+    .a_34_lt = xnz_op_noop,
+    .a_34_rt = xnz_op_noop,
+};
+
+static const xnz_at_ops xnz_at_ops_none =
+{
+    .at_toga = xnz_at_none_at_toga,
+    .at_disc = xnz_op_noop,
+    .a_12_lt = xnz_at_none_a_12_lt,
+    .a_12_rt = xnz_op_noop,
+    .a_34_lt = xnz_op_noop,
+    .a_34_rt = xnz_op_noop,
+};
+
+static const xnz_at_ops xnz_at_ops_xplm =
+{
+    .at_toga = xnz_at_xplm_at_toga,
+    .at_disc = xnz_at_xplm_at_disc,
+    .a_12_lt = xnz_at_xplm_at_disc,
+    .a_12_rt = xnz_at_xplm_at_disc,
+    .a_34_lt = xnz_at_xplm_at_disc,
+    .a_34_rt = xnz_at_xplm_at_disc,
+};
+
+static const xnz_at_ops xnz_at_ops_comm =
+{
+    .at_toga = xnz_at_comm_at_toga,
+    .at_disc = xnz_at_comm_at_disc,
+    .a_12_lt = xnz_at_comm_at_disc,
+    .a_12_rt = xnz_at_comm_at_disc,
+    .a_34_lt = xnz_at_comm_at_disc,
+    .a_34_rt = xnz_at_comm_at_disc,
+};
+
+static const xnz_at_ops xnz_at_ops_apto =
+{
+    .at_toga = xnz_at_none_at_toga,
+    .at_disc = xnz_op_noop,
+    .a_12_lt = xnz_at_apto_a_12_lt,
+    .a_12_rt = xnz_op_noop,
+    .a_34_lt = xnz_op_noop,
+    .a_34_rt = xnz_op_noop,
+};
+
+static const xnz_at_ops xnz_at_ops_xp11 =
+{
+    .at_toga = xnz_at_xp11_at_toga,
+    .at_disc = xnz_at_xplm_at_disc,
+    .a_12_lt = xnz_op_noop,
+    .a_12_rt = xnz_op_noop,
+    .a_34_lt = xnz_op_noop,
+    .a_34_rt = xnz_op_noop,
+};
+
+static const xnz_at_ops xnz_at_ops_toli =
+{
+    .at_toga = xnz_at_toli_at_toga,
+    .at_disc = xnz_at_xplm_at_disc,
+    .a_12_lt = xnz_at_xplm_at_disc,
+    .a_12_rt = xnz_at_xplm_at_disc,
+    .a_34_lt = xnz_at_xplm_at_disc,
+    .a_34_rt = xnz_at_xplm_at_disc,
+};
+
+/*
+ * Engine backends (xnz_et): starters, mixtures and engine on/off.
+ */
+static int xnz_et_xptp_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMSetDataf(commands->xp.mixture_all, 0.5f + XPLMGetDataf(commands->xp.mixture_all));
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xptp_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMSetDataf(commands->xp.mixture_all, XPLMGetDataf(commands->xp.mixture_all) - 0.5f);
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        XPLMCommandBegin(commands->xp.p_start1);
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandEnd(commands->xp.p_start1);
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        XPLMCommandBegin(commands->xp.p_start2);
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandEnd(commands->xp.p_start2);
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_TT_TOLI:
-            {
-                XPLMGetDatavf(ctx->tt.toli.f_thr_array, array, 0, 2);
-                f_throttall = ((array[0] + array[1]) / 2.0f);
-                break;
-            }
+static int xnz_et_xppi_x_34_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        XPLMCommandBegin(commands->xp.p_start3);
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandEnd(commands->xp.p_start3);
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_TT_TBM9:
-            {
-                int engn_rng = XPLMGetDatai(ctx->tt.tbm9.engn_rng);
-                switch (engn_rng)
-                {
-                    case 3:
-                    case 4:
-                    case 5:
-                        /*
-                         * map f_throttall to percent of forward throttle travel
-                         * (ended up confusing me more than necessary: disabled)
-                         */
-//                      if (HS_TBM9_IDLE > (f_throttall = XPLMGetDataf(ctx->f_throttall)))
-//                      {
-//                          f_throttall = (0.0f - (1.0f - (f_throttall / HS_TBM9_IDLE)));
-//                          break;
-//                      }
-//                      f_throttall = ((f_throttall - HS_TBM9_IDLE) / (1.0f - HS_TBM9_IDLE));
-                        f_throttall = XPLMGetDataf(ctx->f_throttall);
-                        break;
-                    default:
-                        f_throttall = HS_TBM9_IDLE; // not in flight/beta/reverse range: throttle_ratio_all dataref has no effect on this TBM
-                        break;
-                }
-                break;
-            }
+static int xnz_et_xppi_x_34_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        XPLMCommandBegin(commands->xp.p_start4);
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandEnd(commands->xp.p_start4);
+        return 0;
+    }
+    return 0;
+}
 
-            default:
-            {
-                if (ctx->acft_has_rev_thrust) // TODO: beta range support?
-                {
-                    if ((f_throttall = XPLMGetDataf(ctx->f_throttall)) > 0.0f)
-                    {
-                        if (1)
-                        {
-                            XPLMGetDatavi(ctx->i_prop_mode, ctx->i_propmode_value, 0, 2);
-                        }
-                        if (ctx->i_propmode_value[0] == 3 || ctx->i_propmode_value[1] == 3)
-                        {
-                            f_throttall = 0.0f - f_throttall;
-                            break;
-                        }
-                        break;
-                    }
-                    break;
-                }
-                f_throttall = XPLMGetDataf(ctx->f_throttall);
-                break;
-            }
-        }
-        if (fabsf(ctx->last_throttle_all - f_throttall) >= T_SMALL)
-        {
-            ctx->throttle_did_change = 1;
-            ctx->show_throttle_all = 3.0f;
-            ctx->last_throttle_all = f_throttall;
-            if (ctx->tca_support_enabled &&
-                ctx->idx_throttle_axis_1 >= 0 &&
-                ctx->skip_idle_overwrite == 0)
-            {
-                ctx->show_throttle_all = 1.5f;
-            }
-        }
-        if (ctx->show_throttle_all < T_ZERO ||
-            ctx->ice_detect_positive ||
-            autothrottle_active(ctx))
+static int xnz_et_xppi_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_m_lft1);
+        XPLMCommandOnce(commands->xp.p_m_lft2);
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        int eng_running[2]; XPLMGetDatavi(commands->xp.eng_running, eng_running, 0, 2);
+        if (eng_running[0])
         {
-            ctx->throttle_did_change = 0;
-            ctx->show_throttle_all = 0.0f;
+            XPLMCommandOnce(commands->xp.p_mboth1);
         }
         else
         {
-            ctx->show_throttle_all -= inElapsedSinceLastCall;
+            XPLMCommandOnce(commands->xp.p_mstop1);
         }
-
-        /* icing detection: every 10 seconds */
-        if ((ctx->icecheck_required += inElapsedSinceLastCall) >= 10.0f)
+        if (eng_running[1])
         {
-            if (XPLMGetDataf(ctx->f_ice_rf[0]) > 0.04f ||
-                XPLMGetDataf(ctx->f_ice_rf[1]) > 0.04f ||
-                XPLMGetDataf(ctx->f_ice_rf[2]) > 0.04f ||
-                XPLMGetDataf(ctx->f_ice_rf[3]) > 0.04f)
-            {
-                if (ctx->ice_detect_positive == 0)
-                {
-                    XPSetWidgetDescriptor(ctx->widgetid[1], "ICE");
-                    XPLMSpeakString("ice detected");
-                }
-                ctx->ice_detect_positive = 1;
-                ctx->throttle_did_change = 0;
-            }
-            else if (XPLMGetDataf(ctx->f_ice_rf[0]) < 0.02f &&
-                     XPLMGetDataf(ctx->f_ice_rf[1]) < 0.02f &&
-                     XPLMGetDataf(ctx->f_ice_rf[2]) < 0.02f &&
-                     XPLMGetDataf(ctx->f_ice_rf[3]) < 0.02f)
-            {
-                ctx->ice_detect_positive = 0;
-            }
-            ctx->icecheck_required = 0.0f;
+            XPLMCommandOnce(commands->xp.p_mboth2);
         }
-        if (ctx->ice_detect_positive || ctx->throttle_did_change)
+        else
         {
-            if (ctx->throttle_did_change)
-            {
-                if (ctx->tca_support_enabled != 0 &&
-                    ctx->idx_throttle_axis_1 >= 0 &&
-                    ctx->skip_idle_overwrite == 0 &&
-                    ctx->i_got_axis_input[0] != 0)
-                {
-                    snprintf(ctx->overly_txt_buf, 11, "%4.0f %%", f_throttall * 100.0f);
-                }
-                else if (f_throttall < (0.0f - T_ZERO))
-                {
-                    snprintf(ctx->overly_txt_buf, 11, "%7.4f", f_throttall);
-                }
-                else
-                {
-                    snprintf(ctx->overly_txt_buf, 11, "%7.5f", f_throttall);
-                }
-                XPSetWidgetDescriptor(ctx->widgetid[1], ctx->overly_txt_buf);
-            }
-            overlay_show(ctx);
+            XPLMCommandOnce(commands->xp.p_mstop2);
         }
-        else if (groundsp > GROUNDSP_KTS_MIN &&
-                 groundsp < GROUNDSP_KTS_MAX &&
-                 XPLMGetDatai(ctx->ongroundany))
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_m_rgt1);
+        XPLMCommandOnce(commands->xp.p_m_rgt2);
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_m_34_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_m_lft3);
+        XPLMCommandOnce(commands->xp.p_m_lft4);
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_xppi_m_34_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        int eng_running[2]; XPLMGetDatavi(commands->xp.eng_running, eng_running, 2, 2);
+        if (eng_running[0])
         {
-            snprintf(ctx->overly_txt_buf, 9, "%2.0f kts", groundsp);
-            XPSetWidgetDescriptor(ctx->widgetid[1], ctx->overly_txt_buf);
-            overlay_show(ctx);
+            XPLMCommandOnce(commands->xp.p_mboth3);
         }
         else
         {
-            overlay_hide(ctx);
+            XPLMCommandOnce(commands->xp.p_mstop3);
         }
-
-        /* variable nullzones */
-        if (servos_on(ctx))
+        if (eng_running[1])
         {
-            XPLMSetDataf(ctx->nullzone[0], 0.500f);
-            XPLMSetDataf(ctx->nullzone[1], 0.500f);
-            XPLMSetDataf(ctx->nullzone[2], 0.500f);
+            XPLMCommandOnce(commands->xp.p_mboth4);
         }
         else
         {
-            if (airspeed > AIRSPEED_MAX_KTS)
-            {
-                airspeed = AIRSPEED_MAX_KTS;
-            }
-            if (airspeed < AIRSPEED_MIN_KTS)
-            {
-                airspeed = AIRSPEED_MIN_KTS;
-            }
-            if (groundsp > GROUNDSP_MAX_KTS)
-            {
-                groundsp = GROUNDSP_MAX_KTS;
-            }
-            if (groundsp < GROUNDSP_MIN_KTS)
-            {
-                groundsp = GROUNDSP_MIN_KTS;
-            }
-            float nullzone_pitch_roll = 0.125f - ((0.125f - ctx->minimum_null_zone) * ((airspeed - AIRSPEED_MIN_KTS) / (AIRSPEED_MAX_KTS - AIRSPEED_MIN_KTS)));
-            float nullzone_yaw_tiller = 0.250f - ((0.250f - ctx->minimum_null_zone) * ((groundsp - GROUNDSP_MIN_KTS) / (GROUNDSP_MAX_KTS - GROUNDSP_MIN_KTS)));
-            XPLMSetDataf(ctx->nullzone[0], nullzone_pitch_roll);
-            XPLMSetDataf(ctx->nullzone[1], nullzone_pitch_roll);
-            XPLMSetDataf(ctx->nullzone[2], nullzone_yaw_tiller);
-        }
-        if (ctx->tca_support_enabled == 0 || ctx->idx_throttle_axis_1 < 0)
-        {
-            ctx->last_throttle_all = f_throttall;
+            XPLMCommandOnce(commands->xp.p_mstop4);
         }
-        return (1.0f / 20.0f); // run often
+        return 0;
     }
-    XPLMDebugString(XNZ_LOG_PREFIX"[error]: callback_hdlr: inRefcon == NULL, disabling callback\n");
     return 0;
 }
-#endif
-
-static inline float linear_standard(float linear_val)
-{
-    return linear_val;
-}
 
-static inline float non_linear_standard(float linear_val)
+static int xnz_et_xppi_m_34_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    return sqrtf(linear_val);
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_m_rgt3);
+        XPLMCommandOnce(commands->xp.p_m_rgt4);
+        return 0;
+    }
+    return 0;
 }
 
-static inline float non_linear_inverted(float linear_val)
+static int xnz_et_xppi_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    return 1.0f - sqrtf(1.0f - linear_val);
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_mboth1);
+        return 0;
+    }
+    return 0;
 }
 
-static inline float non_linear_centered(float linear_val)
+static int xnz_et_xppi_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (linear_val < 0.0f)
-    {
-        return 0.0f;
-    }
-    if (linear_val > 1.0f)
-    {
-        return 1.0f;
-    }
-    if (linear_val < 0.5f)
-    {
-        float min = 0.0f, max = 0.5f;
-        float val = (linear_val - min) / (max - min);
-        return min + 0.5f * non_linear_inverted(val);
-    }
-    if (linear_val > 0.5f)
+    if (inPhase == xplm_CommandEnd)
     {
-        float min = 0.5f, max = 1.0f;
-        float val = (linear_val - min) / (max - min);
-        return min + 0.5f * non_linear_standard(val);
+        XPLMCommandOnce(commands->xp.p_mstop1);
+        return 0;
     }
-    return 0.5f;
+    return 0;
 }
 
-static inline float jitter_protection(float input)
+static int xnz_et_xppi_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    return roundf(input / T_SMALL) * T_SMALL;
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->xp.p_mboth2);
+        return 0;
+    }
+    return 0;
 }
 
-/*
- * https://forums.x-plane.org/index.php?/forums/topic/244181-phenom-300-throttle-quadrant-detents/&do=findComment&comment=2178232
- * https://www.omnicalculator.com/math/rounding
- * travel = angle / max_angle = angle / 73
- * 69 to 73°: MAX RSV
- * 59 to 63°: MAX TO/GA
- * 49 to 53°: MAX CON/CLB
- * 38 to 42°: MAX CRZ
- * 00 to 04°: IDLE
- */
-static inline float throttle_mapping_abe55p(float input, thrust_zones z)
+static int xnz_et_xppi_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.min[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        return 61.0f / 73.0f; // TO
+        XPLMCommandOnce(commands->xp.p_mstop2);
+        return 0;
     }
-//  if (input > z.max[ZONE_FLX])
-//  {
-//      return 51.0f / 73.0f; // CLB
-//  }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_xppi_e_3_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 51.0f / 73.0f; // CLB
+        XPLMCommandOnce(commands->xp.p_mboth3);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_xppi_e_3_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 40.0f / 73.0f; // CRZ
+        XPLMCommandOnce(commands->xp.p_mstop3);
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_xppi_e_4_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection((4.0f + ((38.0f - 4.0f) * linear_standard(t))) / 73.0f);
+        XPLMCommandOnce(commands->xp.p_mboth4);
+        return 0;
     }
-    return 0.0f; // no reverse
+    return 0;
 }
 
-static inline float throttle_mapping_ddcl30(float input, thrust_zones z)
+static int xnz_et_xppi_e_4_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.min[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        return 2.8f / 3.0f; // TO
+        XPLMCommandOnce(commands->xp.p_mstop4);
+        return 0;
     }
-//  if (input > z.max[ZONE_FLX])
-//  {
-//      return 2.6f / 3.0f; // CL
-//  }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_rptp_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandContinue)
     {
-        return 2.6f / 3.0f; // CL
+        XPLMSetDatai(commands->et.rptp.drf_e_1_eng, 1);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_rptp_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandContinue)
     {
-        return 2.5f / 3.0f; // CR
+        XPLMSetDatai(commands->et.rptp.drf_e_1_eng, 0);
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_rptp_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection(2.4f / 3.0f * linear_standard(t));
+        XPLMSetDatai(commands->et.rptp.drf_e_1_ign, 0);
+        return 0;
     }
-    if (input > z.max[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_rptp_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.0f;
+        XPLMSetDatai(commands->et.rptp.drf_e_1_ign, 1);
+        return 0;
     }
-#ifdef PUBLIC_RELEASE_BUILD
-    if (input < z.min[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_da62_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) > 0.5f)
+        {
+            if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) > 1.5f)
+            {
+                XPLMCommandOnce(commands->et.da62.cmd_ecu1_dn);
+            }
+            XPLMCommandOnce(commands->et.da62.cmd_ecu1_dn);
+        }
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) > 0.5f)
+        {
+            if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) > 1.5f)
+            {
+                XPLMCommandOnce(commands->et.da62.cmd_ecu2_dn);
+            }
+            XPLMCommandOnce(commands->et.da62.cmd_ecu2_dn);
+        }
+        return 0;
     }
-    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
-    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
-#else
-    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    return 0;
+}
+
+static int xnz_et_da62_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) < 0.5f)
+        {
+            XPLMCommandOnce(commands->et.da62.cmd_ecu1_up);
+        }
+        else if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) > 1.5f)
+        {
+            XPLMCommandOnce(commands->et.da62.cmd_ecu1_dn);
+        }
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) < 0.5f)
+        {
+            XPLMCommandOnce(commands->et.da62.cmd_ecu2_up);
+        }
+        else if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) > 1.5f)
+        {
+            XPLMCommandOnce(commands->et.da62.cmd_ecu2_dn);
+        }
+        return 0;
     }
-    return -0.1f; // idle reverse
-#endif
+    return 0;
 }
 
-static inline float throttle_mapping_toliss(float input, thrust_zones z)
+static int xnz_et_da62_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.min[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        return 1.0f; // TO/GA
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) < 1.5f)
+        {
+            if (XPLMGetDataf(commands->et.da62.drf_mod_ec1) < 0.5f)
+            {
+                XPLMCommandOnce(commands->et.da62.cmd_ecu1_up);
+            }
+            XPLMCommandOnce(commands->et.da62.cmd_ecu1_up);
+        }
+        if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) < 1.5f)
+        {
+            if (XPLMGetDataf(commands->et.da62.drf_mod_ec2) < 0.5f)
+            {
+                XPLMCommandOnce(commands->et.da62.cmd_ecu2_up);
+            }
+            XPLMCommandOnce(commands->et.da62.cmd_ecu2_up);
+        }
+        return 0;
     }
-//  if (input > z.max[ZONE_FLX])
-//  {
-//      return 0.87f; // FLEX
-//  }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_da62_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.87f; // FLEX
+        XPLMCommandOnce(commands->et.da62.cmd_e_1_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_da62_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.69f; // CLB
+        XPLMCommandOnce(commands->et.da62.cmd_e_1_off);
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_da62_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection(0.68f * linear_standard(t));
+        XPLMCommandOnce(commands->et.da62.cmd_e_2_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_da62_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.0f;
+        XPLMCommandOnce(commands->et.da62.cmd_e_2_off);
+        return 0;
     }
-#ifdef PUBLIC_RELEASE_BUILD
-    if (input < z.min[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_e35l_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandBegin)
     {
-        return -1.0f; // max reverse
+        if (XPLMGetDatai(commands->et.e35l.drf_e_1_knb) > 0)
+        {
+            XPLMCommandBegin(commands->et.e35l.cmd_e_1_rgt);
+            return 0;
+        }
+        return 0;
     }
-    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
-    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
-#else
-    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        if (XPLMGetDatai(commands->et.e35l.drf_e_1_knb) > 0)
+        {
+            XPLMCommandEnd(commands->et.e35l.cmd_e_1_rgt);
+            return 0;
+        }
+        return 0;
     }
-    return -0.1f; // idle reverse
-#endif
+    return 0;
 }
 
-static inline float throttle_mapping_nl_rev(float input, thrust_zones z)
+static int xnz_et_e35l_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.max[ZONE_TGA])
+    if (inPhase == xplm_CommandBegin)
     {
-        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+        if (XPLMGetDatai(commands->et.e35l.drf_e_2_knb) > 0)
+        {
+            XPLMCommandBegin(commands->et.e35l.cmd_e_2_rgt);
+            return 0;
+        }
+        return 0;
     }
-    if (input > z.min[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
-        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+        if (XPLMGetDatai(commands->et.e35l.drf_e_2_knb) > 0)
+        {
+            XPLMCommandEnd(commands->et.e35l.cmd_e_2_rgt);
+            return 0;
+        }
+        return 0;
     }
-    if (input > z.max[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_e35l_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+        int auto_ignite_off[2] = { 0, 0, };
+        XPLMSetDatavi(commands->xp.auto_ignite, auto_ignite_off, 0, 2);
+        return 0;
     }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_e35l_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
-        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+        int auto_ignite_on[2] = { 1, 1, };
+        XPLMSetDatavi(commands->xp.auto_ignite, auto_ignite_on, 0, 2);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_e35l_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_CLB];
+        if (XPLMGetDatai(commands->et.e35l.drf_e_1_knb) < 1)
+        {
+            XPLMCommandOnce(commands->et.e35l.cmd_e_1_rgt);
+            return 0;
+        }
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_e35l_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+        if (XPLMGetDatai(commands->et.e35l.drf_e_1_knb) > 0)
+        {
+            XPLMCommandOnce(commands->et.e35l.cmd_e_1_lft);
+            return 0;
+        }
+        return 0;
     }
-    if (input > z.max[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_e35l_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.0f;
+        if (XPLMGetDatai(commands->et.e35l.drf_e_2_knb) < 1)
+        {
+            XPLMCommandOnce(commands->et.e35l.cmd_e_2_rgt);
+            return 0;
+        }
+        return 0;
     }
-    if (input < z.min[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_e35l_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        if (XPLMGetDatai(commands->et.e35l.drf_e_2_knb) > 0)
+        {
+            XPLMCommandOnce(commands->et.e35l.cmd_e_2_lft);
+            return 0;
+        }
+        return 0;
     }
-    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
-    return jitter_protection(non_linear_standard(t)-1.0f); // beta and reverse ranges
+    return 0;
 }
 
-static inline float throttle_mapping_w_rev(float input, thrust_zones z)
+static int xnz_et_to32_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.max[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+        XPLMCommandOnce(commands->et.to32.cmd_m_12_cr);
+        return 0;
     }
-    if (input > z.min[ZONE_TGA])
+    return 0;
+}
+
+static int xnz_et_to32_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
-        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+        XPLMCommandOnce(commands->et.to32.cmd_m_12_no);
+        return 0;
     }
-    if (input > z.max[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_to32_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+        XPLMCommandOnce(commands->et.to32.cmd_m_12_st);
+        return 0;
     }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_to32_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
-        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+        XPLMCommandOnce(commands->et.to32.cmd_e_1_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_to32_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_CLB];
+        XPLMCommandOnce(commands->et.to32.cmd_e_1_off);
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_to32_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+        XPLMCommandOnce(commands->et.to32.cmd_e_2_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_to32_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return 0.0f;
+        XPLMCommandOnce(commands->et.to32.cmd_e_2_off);
+        return 0;
     }
-#ifdef PUBLIC_RELEASE_BUILD
-    if (input < z.min[ZONE_REV])
+    return 0;
+}
+
+static int xnz_et_ff35_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        XPLMCommandOnce(commands->et.ff35.cmd_m_12_cr);
+        return 0;
     }
-    float t = (input - z.min[ZONE_REV]) / z.len[ZONE_REV];
-    return jitter_protection(non_linear_standard(t)-1.0f); // non-linear reverse range
-#else
-    if (input < (z.min[ZONE_REV] + (z.len[ZONE_REV] / 20.0f)))
+    return 0;
+}
+
+static int xnz_et_ff35_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return -1.0f; // max reverse
+        XPLMCommandOnce(commands->et.ff35.cmd_m_12_no);
+        return 0;
     }
-    return -0.1f; // idle reverse
-#endif
+    return 0;
 }
 
-static inline float throttle_mapping(float input, thrust_zones z)
+static int xnz_et_ff35_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (input > z.max[ZONE_TGA])
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_TGA] + z.share[ZONE_FLX] + z.share[ZONE_CLB]; // max forward (may be less than 1.0f)
+        XPLMCommandOnce(commands->et.ff35.cmd_m_12_st);
+        return 0;
     }
-    if (input > z.min[ZONE_TGA])
+    return 0;
+}
+
+static int xnz_et_ff35_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_TGA]) / z.len[ZONE_TGA]);
-        return jitter_protection(z.share[ZONE_TGA] * linear_standard(t) + z.share[ZONE_FLX] + z.share[ZONE_CLB]);
+        XPLMCommandOnce(commands->et.ff35.cmd_e_1_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_ff35_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_FLX] + z.share[ZONE_CLB];
+        XPLMCommandOnce(commands->et.ff35.cmd_e_1_off);
+        return 0;
     }
-    if (input > z.min[ZONE_FLX])
+    return 0;
+}
+
+static int xnz_et_ff35_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = ((input - z.min[ZONE_FLX]) / z.len[ZONE_FLX]);
-        return jitter_protection(z.share[ZONE_FLX] * linear_standard(t) + z.share[ZONE_CLB]);
+        XPLMCommandOnce(commands->et.ff35.cmd_e_2_onn);
+        return 0;
     }
-    if (input > z.max[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_ff35_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return z.share[ZONE_CLB];
+        XPLMCommandOnce(commands->et.ff35.cmd_e_2_off);
+        return 0;
     }
-    if (input > z.min[ZONE_CLB])
+    return 0;
+}
+
+static int xnz_et_e55p_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        float t = (input - z.min[ZONE_CLB]) / z.len[ZONE_CLB];
-        return jitter_protection(z.share[ZONE_CLB] * linear_standard(t));
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_knb) > 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_e_1_rgt);
+        }
+        return 0;
     }
-    return 0.0f; // no reverse
+    return 0;
 }
 
-static int fwd_beta_rev_thrust_for_index(xnz_context *ctx, float f_stick_val[1], int i)
+static int xnz_et_e55p_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (ctx->i_propmode_value[i] < 1 || // probably feathered
-        ctx->i_propmode_value[i] > 3)  // should never happen
+    if (inPhase == xplm_CommandEnd)
     {
-//      f_stick_val[0] = 0.0f; // don't force idle thrust: it would only confuse users (myself included -- e.g. Carenado PC12 + REP automatically feathered until engine start)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_knb) > 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_e_2_rgt);
+        }
         return 0;
     }
-    if ((T_ZERO + f_stick_val[0]) < 0.0f) // reverse or beta range
+    return 0;
+}
+
+static int xnz_et_e55p_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        if ((T_ZERO + f_stick_val[0]) >= -0.5f) // beta range or idle reverse
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) > 0.5f)
         {
-            if (ctx->acf_has_beta_thrust) // TODO: implement
+            if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) > 1.5f)
             {
-                f_stick_val[0] = 0.0f;
-                return 0;
+                XPLMCommandOnce(commands->et.e55p.cmd_ig_1_dn);
             }
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_1_dn);
         }
-        if (ctx->acft_has_rev_thrust)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) > 0.5f)
         {
-            if (ctx->i_propmode_value[i] != 3)
+            if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) > 1.5f)
             {
-                XPLMCommandOnce(ctx->revto[i]);
-                return 1;
+                XPLMCommandOnce(commands->et.e55p.cmd_ig_2_dn);
             }
-            f_stick_val[0] = fabsf(f_stick_val[0]);
-            return 0;
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_2_dn);
         }
-        f_stick_val[0] = 0.0f;
         return 0;
     }
-    if (ctx->acf_has_beta_thrust && ctx->i_propmode_value[i] == 2)
-    {
-        XPLMCommandOnce(ctx->betto[i]);
-        return 1;
-    }
-    if (ctx->acft_has_rev_thrust && ctx->i_propmode_value[i] == 3)
-    {
-        XPLMCommandOnce(ctx->revto[i]);
-        return 1;
-    }
     return 0;
 }
-static int fwd_beta_rev_thrust(xnz_context *ctx, float f_stick_val[2])
-{
-    switch (ctx->xnz_tt)
-    {
-        case XNZ_TT_TOLI:
-            return 0; // handled by ToLiSS plugin based on positive/begative value of f_stick_val
-
-        case XNZ_TT_TBM9:
-            if ((T_ZERO + f_stick_val[0]) < 0.0f)
-            {
-                if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) == 3)
-                {
-                    XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE - T_ZERO); // flight -> taxi range
-                    XPLMCommandOnce(ctx->revto[8]); // lift gate (engn_rng goes from 3 to 4)
-                    return 1;
-                }
-                return 0;
-            }
-            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) > 3)
-            {
-                XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE + T_ZERO); // beta/reverse -> flight idle
-                return 1;
-            }
-            return 0;
 
-        default:
-            break;
-    }
-    if (ctx->arcrft_engine_count == 2)
-    {
-        int l = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], 0);
-        int r = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[1], 1);
-        return (l + r) > 0;
-    }
-    else
+static int xnz_et_e55p_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        int toggled_count = fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], 0);
-        for (int i = 1; i < ctx->arcrft_engine_count; i++)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) < 0.5f)
         {
-            toggled_count += fwd_beta_rev_thrust_for_index(ctx, &f_stick_val[0], i);
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_1_up);
         }
-        return toggled_count > 0;
+        else if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) > 1.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_1_dn);
+        }
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) < 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_2_up);
+        }
+        else if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) > 1.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_2_dn);
+        }
+        return 0;
     }
     return 0;
 }
 
-static int skip_idle_overwrite(xnz_context *ctx, float f_stick_val[2])
+static int xnz_et_e55p_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (0.0f == f_stick_val[0] && (ctx->arcrft_engine_count < 2 || f_stick_val[1] == 0.0f))
+    if (inPhase == xplm_CommandEnd)
     {
-        /*
-         * as soon as the user overrides the throttle via commands, then
-         * f_throttall is no longer zero, so we need the return 1 clause
-         * before we check the latter, else we will keep overwriting any
-         * throttle ratio modifications triggered by the user; hence, we
-         * must have it here early, otherwise said override is pointless
-         */
-        if (ctx->skip_idle_overwrite > 9)
-        {
-            return 1;
-        }
-        float f_simul_val[2];
-        switch (ctx->xnz_tt)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) < 1.5f)
         {
-            case XNZ_TT_FF32: // TODO: implement
-                return ctx->skip_idle_overwrite = 0;
-
-            case XNZ_TT_TBM9:
-                if (fabsf((f_simul_val[0] = (XPLMGetDataf(ctx->f_throttall) - HS_TBM9_IDLE)) - 0.0f) < T_ZERO)
-                {
-                    f_simul_val[0] = 0.0f;
-                }
-                break;
-
-            case XNZ_TT_TOLI:
-                XPLMGetDatavf(ctx->tt.toli.f_thr_array, f_simul_val, 0, 2);
-                break;
-
-            default:
-                f_simul_val[0] = f_simul_val[1] = XPLMGetDataf(ctx->f_throttall);
-                break;
+            if (XPLMGetDataf(commands->et.e55p.drf_e_1_ign) < 0.5f)
+            {
+                XPLMCommandOnce(commands->et.e55p.cmd_ig_1_up);
+            }
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_1_up);
         }
-        if (0.0f == f_simul_val[0] && (ctx->arcrft_engine_count < 2 || f_simul_val[1] == 0.0f))
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) < 1.5f)
         {
-            for (int i = 0; i < ctx->arcrft_engine_count; i++)
+            if (XPLMGetDataf(commands->et.e55p.drf_e_2_ign) < 0.5f)
             {
-                switch (ctx->xnz_tt)
-                {
-                    case XNZ_TT_FF32: // TODO: implement
-                        return ctx->skip_idle_overwrite = 0;
-
-                    case XNZ_TT_TBM9:
-                        if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) != 3)
-                        {
-                            return ctx->skip_idle_overwrite = 0;
-                        }
-                        break;
-
-                    default:
-                        if (ctx->i_propmode_value[i] != 1)
-                        {
-                            return ctx->skip_idle_overwrite = 0;
-                        }
-                        break;
-                }
-                continue;
+                XPLMCommandOnce(commands->et.e55p.cmd_ig_2_up);
             }
-            ctx->skip_idle_overwrite++;
-            return 0;
+            XPLMCommandOnce(commands->et.e55p.cmd_ig_2_up);
         }
-        return ctx->skip_idle_overwrite = 0;
+        return 0;
     }
-    return ctx->skip_idle_overwrite = 0;
+    return 0;
 }
 
-static void throttle_axes(xnz_context *ctx)
+static int xnz_et_e55p_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    float f_stick_val[2], avrg_throttle_out;
-    XPLMGetDatavf(ctx->f_stick_val, f_stick_val, ctx->idx_throttle_axis_1, 2);
-    XPLMGetDatavi(ctx->i_prop_mode, ctx->i_propmode_value, 0, ctx->arcrft_engine_count);
-    if (autothrottle_active(ctx))
+    if (inPhase == xplm_CommandEnd)
     {
-        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
-        ctx->avrg_throttle_out = XNZ_THOUT_AT;
-        return;
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_knb) < 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_e_1_rgt);
+        }
+        return 0;
     }
-    if (ctx->i_got_axis_input[0] == 0)
+    return 0;
+}
+
+static int xnz_et_e55p_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        if (f_stick_val[0] < TCA_DEADBAND || f_stick_val[1] < TCA_DEADBAND)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_1_knb) > 0.5f)
         {
-            ctx->avrg_throttle_out = XPLMGetDataf(ctx->f_throttall);
-            ctx->avrg_throttle_inn = XNZ_THINN_NO;
-            return;
+            XPLMCommandOnce(commands->et.e55p.cmd_e_1_lft);
         }
-        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
-        ctx->i_got_axis_input[0] = 1;
+        return 0;
     }
-    else
+    return 0;
+}
+
+static int xnz_et_e55p_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        ctx->avrg_throttle_inn = (1.0f - ((f_stick_val[0] + f_stick_val[1]) / 2.0f));
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_knb) < 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_e_2_rgt);
+        }
+        return 0;
     }
-#ifdef PUBLIC_RELEASE_BUILD
-    if (ctx->arcrft_engine_count != 2 || fabsf(f_stick_val[0] - f_stick_val[1]) < TCA_SYNCBAND)
-#endif
+    return 0;
+}
+
+static int xnz_et_e55p_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        f_stick_val[0] = f_stick_val[1] = ((f_stick_val[0] + f_stick_val[1]) / 2.0f); // cannot re-use ctx->avrg_throttle_inn (inverted)
+        if (XPLMGetDataf(commands->et.e55p.drf_e_2_knb) > 0.5f)
+        {
+            XPLMCommandOnce(commands->et.e55p.cmd_e_2_lft);
+        }
+        return 0;
     }
-    switch (ctx->xnz_tt)
-    {
-        case XNZ_TT_FF32: // TODO: implement
-            return;
-
-        case XNZ_TT_TOLI:
-            f_stick_val[0] = throttle_mapping_toliss(1.0f - f_stick_val[0], ctx->zones_info);
-            f_stick_val[1] = throttle_mapping_toliss(1.0f - f_stick_val[1], ctx->zones_info);
-            break;
-
-        case XNZ_TT_TBM9:
-            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) < 3)
-            {
-                XPLMSetDataf(ctx->f_throttall, HS_TBM9_IDLE);
-                return;
-            }
-            f_stick_val[0] = throttle_mapping_nl_rev(1.0f - f_stick_val[0], ctx->zones_info);
-            break;
-
-        default:
-            switch (ctx->commands.xnz_et)
-            {
-#ifndef PUBLIC_RELEASE_BUILD
-                case XNZ_ET_CL30:
-                    f_stick_val[0] = throttle_mapping_ddcl30(1.0f - f_stick_val[0], ctx->zones_info);
-                    f_stick_val[1] = throttle_mapping_ddcl30(1.0f - f_stick_val[1], ctx->zones_info);
-                    break;
+    return 0;
+}
 
-                case XNZ_ET_E55P:
-                    f_stick_val[0] = throttle_mapping_abe55p(1.0f - f_stick_val[0], ctx->zones_info);
-                    f_stick_val[1] = throttle_mapping_abe55p(1.0f - f_stick_val[1], ctx->zones_info);
-                    break;
-#endif
-                case XNZ_ET_XPTP:
-                case XNZ_ET_RPTP:
-                    if (ctx->acft_has_rev_thrust)
-                    {
-                        f_stick_val[0] = throttle_mapping_nl_rev(1.0f - f_stick_val[0], ctx->zones_info);
-                        f_stick_val[1] = throttle_mapping_nl_rev(1.0f - f_stick_val[1], ctx->zones_info);
-                        break;
-                    } // fall through
-                default:
-                    if (ctx->acft_has_rev_thrust)
-                    {
-                        f_stick_val[0] = throttle_mapping_w_rev(1.0f - f_stick_val[0], ctx->zones_info);
-                        f_stick_val[1] = throttle_mapping_w_rev(1.0f - f_stick_val[1], ctx->zones_info);
-                        break;
-                    }
-                    f_stick_val[0] = throttle_mapping(1.0f - f_stick_val[0], ctx->zones_info);
-                    f_stick_val[1] = throttle_mapping(1.0f - f_stick_val[1], ctx->zones_info);
-                    break;
-            }
-            break;
-    }
-    if (skip_idle_overwrite(ctx, f_stick_val))
+static int xnz_et_leg2_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        ctx->avrg_throttle_out = XNZ_THOUT_SK;
-        return;
+        float fuelsel = XPLMGetDataf(commands->et.leg2.drf_fuelsel);
+        if (0.5f > fuelsel)
+        {
+            XPLMCommandOnce(commands->et.leg2.cmd_f_sl_lt);
+            XPLMCommandOnce(commands->et.leg2.cmd_f_sl_lt);
+            return 0; // off -> left
+        }
+        if (1.5f > fuelsel)
+        {
+            XPLMCommandOnce(commands->et.leg2.cmd_f_sl_lt);
+            return 0; // right -> left
+        }
+        XPLMCommandOnce(commands->et.leg2.cmd_f_sl_rt);
+        return 0; // left -> right
     }
-    if (ctx->xnz_tt != XNZ_TT_TBM9)
+    return 0;
+}
+
+static int xnz_et_leg2_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        // store before sign possibly changed by fwd_beta_rev_thrust()
-        // but only set variable later (if actually writing th. ratio)
-        avrg_throttle_out = ((f_stick_val[0] + f_stick_val[1]) / 2.0f);
+        XPLMCommandOnce(commands->et.leg2.cmd_m_12_no);
+        return 0;
     }
-    if (fwd_beta_rev_thrust(ctx, f_stick_val))
+    return 0;
+}
+
+static int xnz_et_leg2_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return;
+        XPLMCommandOnce(commands->et.leg2.cmd_m_12_st);
+        return 0;
     }
-    switch (ctx->xnz_tt)
+    return 0;
+}
+
+static int xnz_et_leg2_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        case XNZ_TT_TOLI:
-            XPLMSetDatavf(ctx->tt.toli.f_thr_array, f_stick_val, 0, 2);
-            ctx->avrg_throttle_out = avrg_throttle_out;
-            return;
+        XPLMCommandOnce(commands->et.leg2.cmd_e_1_onn);
+        return 0;
+    }
+    return 0;
+}
 
-        case XNZ_TT_TBM9:
-            if (XPLMGetDatai(ctx->tt.tbm9.engn_rng) > 3)
-            {
-                ctx->avrg_throttle_out = (HS_TBM9_IDLE + ((HS_TBM9_IDLE) * f_stick_val[0]));
-                XPLMSetDataf(ctx->f_throttall, ctx->avrg_throttle_out);
-                return; // beta or reverse range
-            }
-            ctx->avrg_throttle_out = (HS_TBM9_IDLE + ((1.0f - HS_TBM9_IDLE) * f_stick_val[0]));
-            XPLMSetDataf(ctx->f_throttall, ctx->avrg_throttle_out);
-            return; // flight range
+static int xnz_et_leg2_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->et.leg2.cmd_e_1_off);
+        return 0;
+    }
+    return 0;
+}
 
-        default:
-            ctx->avrg_throttle_out = avrg_throttle_out;
-            break;
+static int xnz_et_leg2_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->et.leg2.cmd_e_2_onn);
+        return 0;
     }
-    if (ctx->arcrft_engine_count == 2)
+    return 0;
+}
+
+static int xnz_et_leg2_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        XPLMSetDatavf(ctx->f_thr_array, f_stick_val, 0, 2);
-        return;
+        XPLMCommandOnce(commands->et.leg2.cmd_e_2_off);
+        return 0;
     }
-    XPLMSetDataf(ctx->f_throttall, f_stick_val[0]); // sign may differ from avrg_throttle_out
-    return;
+    return 0;
 }
 
-static float axes_hdlr_fnc(float inElapsedSinceLastCall,
-                           float inElapsedTimeSinceLastFlightLoop,
-                           int   inCounter,
-                           void *inRefcon)
+static int xnz_et_ea50_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inRefcon)
+    if (inPhase == xplm_CommandEnd)
     {
-        /* shall we be doing something? */
-        if (((xnz_context*)inRefcon)->tca_support_enabled == 0)
+        int eng_running[2]; XPLMGetDatavi(commands->xp.eng_running, eng_running, 0, 2);
+        if (eng_running[0])
         {
-            return (1.0f / 20.0f);
+            XPLMSetDatai(commands->et.ea50.drf_mod_en1, 1);
         }
-        throttle_axes(inRefcon);
-        return (1.0f / 20.0f);
+        else
+        {
+            XPLMSetDatai(commands->et.ea50.drf_mod_en1, 0);
+        }
+        if (eng_running[1])
+        {
+            XPLMSetDatai(commands->et.ea50.drf_mod_en2, 1);
+        }
+        else
+        {
+            XPLMSetDatai(commands->et.ea50.drf_mod_en2, 0);
+        }
+        return 0;
     }
-    XPLMDebugString(XNZ_LOG_PREFIX"[error]: callback_hdlr: inRefcon == NULL, disabling callback\n");
     return 0;
 }
 
-static void menu_hdlr_fnc(void *inMenuRef, void *inItemRef)
+static int xnz_et_ea50_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inMenuRef)
+    if (inPhase == xplm_CommandEnd)
     {
-        if (inItemRef)
+        int eng_running[2]; XPLMGetDatavi(commands->xp.eng_running, eng_running, 0, 2);
+        if (eng_running[0])
         {
-            int *item = inItemRef;
-            xnz_context *ctx = inMenuRef;
-            if (*item == ctx->id_menu_item_on_off)
-            {
-                XPLMMenuCheck s; XPLMCheckMenuItemState(ctx->id_th_on_off, ctx->id_menu_item_on_off, &s);
-                if (s == xplm_Menu_Checked)
-                {
-                    XPLMCheckMenuItem(ctx->id_th_on_off, ctx->id_menu_item_on_off, xplm_Menu_NoCheck);
-                    xnz_log("[info]: menu: disabling TCA flight loop callback\n");
-                    global_context->tca_support_enabled = 0;
-                    global_context->skip_idle_overwrite = 0;
-#ifdef PUBLIC_RELEASE_BUILD
-                    if (ctx->idx_throttle_axis_1 >= 0)
-                    {
-                        int th_axis_ass[2] = { 20, 21, };
-                        xnz_log("[info]: releasing joystick axes (flight loop disabled)\n");
-                        XPLMSetDatavi(ctx->i_stick_ass, th_axis_ass, ctx->idx_throttle_axis_1, 2);
-                    }
-#endif
-                    return;
-                }
-                XPLMCheckMenuItem(ctx->id_th_on_off, ctx->id_menu_item_on_off, xplm_Menu_Checked);
-                xnz_log("[info]: menu: enabling TCA flight loop callback\n");
-                global_context->tca_support_enabled = 1;
-                global_context->skip_idle_overwrite = 0;
-#ifdef PUBLIC_RELEASE_BUILD
-                if (ctx->idx_throttle_axis_1 >= 0)
-                {
-                    int no_axis_ass[2] = { 0, 0, };
-                    XPLMSetDatavi(ctx->i_stick_ass, no_axis_ass, ctx->idx_throttle_axis_1, 2);
-                    xnz_log("[info]: menu: re-capturing joystick axes (flight loop enabled)\n");
-                }
-#endif
-                return;
-            }
-            return;
+            XPLMSetDatai(commands->et.ea50.drf_mod_en1, 2);
         }
-        return;
+        if (eng_running[1])
+        {
+            XPLMSetDatai(commands->et.ea50.drf_mod_en2, 2);
+        }
+        return 0;
+    }
+    return 0;
+}
+
+static int xnz_et_ea50_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMSetDatai(commands->et.ea50.drf_mod_en1, 1);
+        return 0;
     }
-    return;
+    return 0;
 }
 
-static int parking_brake_get(xnz_cmd_context *commands)
+static int xnz_et_ea50_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (commands)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (commands->xnz_pb)
-        {
-            case XNZ_PB_FF35:
-                return !XPLMGetDatai(commands->pb.ff35.pbrak_offon);
-
-            case XNZ_PB_TO32:
-                return !!XPLMGetDatai(commands->pb.to32.pbrak_onoff);
-
-            case XNZ_PB_TBM9:
-                return 1.0f <= XPLMGetDataf(commands->pb.tbm9.pbrak_ratio);
-
-            case XNZ_PB_XPLM:
-                if (commands->xp.pbrak_onoff < 0)
-                {
-                    commands->xp.pbrak_onoff = 1.0f <= XPLMGetDataf(commands->xp.pbrak_ratio);
-                }
-                return !!commands->xp.pbrak_onoff;
-
-            case XNZ_PB_ERRR:
-            default:
-                return -1;
-        }
-        return -1;
+        XPLMSetDatai(commands->et.ea50.drf_mod_en1, 0);
+        return 0;
     }
-    return -1;
+    return 0;
 }
 
-static int parking_brake_set(xnz_cmd_context *commands, int set)
+static int xnz_et_ea50_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (commands)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (commands->xnz_pb)
-        {
-            case XNZ_PB_FF35:
-                if (set)
-                {
-                    XPLMSetDatai(commands->pb.ff35.pbrak_offon, 0);
-                    return 0;
-                }
-                XPLMSetDatai(commands->pb.ff35.pbrak_offon, 1);
-                return 0;
-
-            case XNZ_PB_TO32:
-                if (set)
-                {
-                    XPLMSetDatai(commands->pb.to32.pbrak_onoff, 1);
-                    return 0;
-                }
-                XPLMSetDatai(commands->pb.to32.pbrak_onoff, 0);
-                return 0;
-
-            case XNZ_PB_TBM9:
-                if (set)
-                {
-                    if (commands->xnz_bt == XNZ_BT_TBM9)
-                    {
-                        float barray[4] = { 1.0f, 1.0f, 0.0f, 0.0f, };
-                        XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[0], 0, 2);
-                        XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 1.0f);
-//                      XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[2], 0, 2); // tested -- resetting to zero immediately doesn't work
-                        return 0;
-                    }
-                    XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 1.0f);
-                    return 0;
-                }
-                if (commands->xnz_bt == XNZ_BT_TBM9)
-                {
-                    /*
-                     * just in case we unset parking brake right after setting it,
-                     * w/out calling e.g. brake hold regular or similar in between
-                     */
-                    float barray[4] = { 1.0f, 1.0f, 0.0f, 0.0f, };
-                    XPLMSetDatavf(commands->bt.tbm9.rbrak_array, &barray[2], 0, 2);
-                    XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 0.0f);
-                    return 0;
-                }
-                XPLMSetDataf(commands->pb.tbm9.pbrak_ratio, 0.0f);
-                return 0;
+        XPLMSetDatai(commands->et.ea50.drf_mod_en2, 1);
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_PB_XPLM:
-                if (set)
-                {
-                    XPLMSetDataf(commands->xp.pbrak_ratio, 1.0f);
-                    commands->xp.pbrak_onoff = 1;
-                    return 0;
-                }
-                XPLMSetDataf(commands->xp.pbrak_ratio, 0.0f);
-                commands->xp.pbrak_onoff = 0;
-                return 0;
+static int xnz_et_ea50_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMSetDatai(commands->et.ea50.drf_mod_en2, 0);
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_PB_ERRR:
-            default:
-                return -1;
-        }
-        return -1;
+static int xnz_et_evic_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->et.evic.cmd_x_12_lt);
+        return 0;
     }
-    return -1;
+    return 0;
 }
 
-static int chandler_ldg_upp(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_evic_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        if (inRefcon)
-        {
-            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_up);
-            XPLMSpeakString("gear up");
-            return 0;
-        }
+        XPLMCommandOnce(commands->et.evic.cmd_x_12_rt);
         return 0;
     }
     return 0;
 }
 
-static int chandler_ldg_dwn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_evic_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        if (inRefcon)
-        {
-            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_dn);
-            XPLMSpeakString("gear down");
-            return 0;
-        }
+        XPLMCommandOnce(commands->et.evic.cmd_m_12_no);
         return 0;
     }
     return 0;
 }
 
-static int chandler_ldg_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_evic_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        if (inRefcon)
-        {
-            if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.gear_handle) == 1)
-            {
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_up);
-                XPLMSpeakString("gear up");
-                return 0;
-            }
-            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_dn);
-            XPLMSpeakString("gear down");
-            return 0;
-        }
+        XPLMCommandOnce(commands->et.evic.cmd_m_12_st);
         return 0;
     }
     return 0;
 }
 
-static int chandler_rgb_pkb(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_evic_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inPhase == xplm_CommandBegin)
+    if (inPhase == xplm_CommandEnd)
     {
-        if ((((xnz_cmd_context*)inRefcon)->xp.pbrakonoff2 = parking_brake_get(inRefcon))) // if set, release parking brake
-        {
-            chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
-        }
-        return chandler_rgb_hld(((xnz_cmd_context*)inRefcon)->cmd_rgb_hld, xplm_CommandBegin, inRefcon);
+        XPLMCommandOnce(commands->et.evic.cmd_e_1_onn);
+        return 0;
     }
+    return 0;
+}
+
+static int xnz_et_evic_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        if (0 == chandler_rgb_hld(((xnz_cmd_context*)inRefcon)->cmd_rgb_hld, xplm_CommandEnd, inRefcon))
-        {
-            if (((xnz_cmd_context*)inRefcon)->xp.pbrakonoff2 == 0) // if was NOT set on command begin, set parking brake
-            {
-                if (GROUNDSP_KTS_MIN > MPS2KTS(XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.groundspeed))) // only when groundspeed is very low
-                {
-                    return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
-                }
-                return 0;
-            }
-            return 0;
-        }
+        XPLMCommandOnce(commands->et.evic.cmd_e_1_off);
         return 0;
     }
     return 0;
 }
-static int chandler_rgb_hld(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+
+static int xnz_et_evic_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    float barray[2];
-    switch (inPhase)
+    if (inPhase == xplm_CommandEnd)
     {
-        case xplm_CommandBegin:
+        if (XPLMGetDatai(commands->et.evic.drf_fuel_at) == 0)
         {
-            switch (((xnz_cmd_context*)inRefcon)->xnz_bt)
-            {
-                case XNZ_BT_XPLM:
-                case XNZ_BT_PKBR:
-                case XNZ_BT_SIMC:
-                    ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff = parking_brake_get(inRefcon);
-                    return 0; // TODO: autobrake -> manual braking
-
-                case XNZ_BT_COMM: // deferred initialization
-                    if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld == NULL)
-                    {
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld = XPLMFindCommand(((xnz_cmd_context*)inRefcon)->bt.comm.commnd_max_hld);
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld = XPLMFindCommand(((xnz_cmd_context*)inRefcon)->bt.comm.commnd_rgb_hld);
-                        ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff = parking_brake_get(inRefcon);
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                        return 0;
-                    }
-                    if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld ||
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld)
-                    {
-                        ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff = parking_brake_get(inRefcon);
-                        XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current);
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                        return 0;
-                    }
-                    ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff = parking_brake_get(inRefcon);
-                    ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                    return 0; // TODO: autobrake -> manual braking
-
-                case XNZ_BT_FF35:
-                    ((xnz_cmd_context*)inRefcon)->bt.ff35.pbrak_onoff = parking_brake_get(inRefcon);
-                    return 0;
-
-                case XNZ_BT_TO32:
-                case XNZ_BT_TBM9:
-                case XNZ_BT_ERRR:
-                default:
-                    return 0;
-            }
-            return 0;
+            XPLMCommandOnce(commands->et.evic.cmd_e_2_tog);
         }
+        return 0;
+    }
+    return 0;
+}
 
-        case xplm_CommandContinue:
+static int xnz_et_evic_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (XPLMGetDatai(commands->et.evic.drf_fuel_at) != 0)
         {
-            int speed = 0; float gs = MPS2KTS(XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.groundspeed));
-            if (((xnz_cmd_context*)inRefcon)->xp_11_00_or_later && gs < GROUNDSP_KTS_MIN)
-            {
-                speed = 1;
-            }
-            if (gs > 15.0f)
-            {
-                speed = 1;
-            }
-            if (gs > 50.0f)
-            {
-                speed = 2;
-            }
-            switch (((xnz_cmd_context*)inRefcon)->xnz_bt)
-            {
-                case XNZ_BT_XPLM:
-                    switch (speed)
-                    {
-                        case 2:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.l_rgb_ratio, 0.9f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.r_rgb_ratio, 0.9f);
-                            return 0;
-                        case 1:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.l_rgb_ratio, 0.6f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.r_rgb_ratio, 0.6f);
-                            return 0;
-                        default:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.l_rgb_ratio, 0.3f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.r_rgb_ratio, 0.3f);
-                            return 0;
-                    }
-
-                case XNZ_BT_COMM:
-                    switch (speed)
-                    {
-                        case 2:
-                            if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld)
-                            {
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == NULL)
-                                {
-                                    XPLMCommandBegin((((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld));
-                                    return 0;
-                                }
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld)
-                                {
-                                    return 0;
-                                }
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld)
-                                {
-                                    XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current);
-                                    XPLMCommandBegin((((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld));
-                                    return 0;
-                                }
-                                ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                                return 0;
-                            }
-                            else
-                            {
-                                ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                                return 0;
-                            }
-                        default:
-                            if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld)
-                            {
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == NULL)
-                                {
-                                    XPLMCommandBegin((((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld));
-                                    return 0;
-                                }
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld)
-                                {
-                                    return 0;
-                                }
-                                if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current == ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_mxb_hld)
-                                {
-                                    XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current);
-                                    XPLMCommandBegin((((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_rgb_hld));
-                                    return 0;
-                                }
-                                ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                                return 0;
-                            }
-                            else
-                            {
-                                ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                                return 0;
-                            }
-                    }
-
-                case XNZ_BT_PKBR:
-                    if (((xnz_cmd_context*)inRefcon)->xnz_pb == XNZ_PB_XPLM && parking_brake_get(inRefcon) == 1)
-                    {
-                        return 0;
-                    }
-                    switch (speed)
-                    {
-                        case 2:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 0.9f);
-                            return 0;
-                        case 1:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 0.6f);
-                            return 0;
-                        default:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 0.3f);
-                            return 0;
-                    }
-
-                case XNZ_BT_SIMC:
-                    if (((xnz_cmd_context*)inRefcon)->xnz_pb == XNZ_PB_XPLM && parking_brake_get(inRefcon) == 1)
-                    {
-                        return 0;
-                    }
-                    switch (speed)
-                    {
-                        case 2:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 1.0f);
-                            return 0;
-                        case 1:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, .75f);
-                            return 0;
-                        default:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 0.5f);
-                            return 0;
-                    }
-
-                case XNZ_BT_TO32:
-                    switch (speed)
-                    {
-                        case 2:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.l_rgb_ratio, 0.9f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.r_rgb_ratio, 0.9f);
-                            return 0;
-                        case 1:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.l_rgb_ratio, 0.6f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.r_rgb_ratio, 0.6f);
-                            return 0;
-                        default:
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.l_rgb_ratio, 0.3f);
-                            XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.r_rgb_ratio, 0.3f);
-                            return 0;
-                    }
-
-                /*
-                 * sim/flight_controls/brakes_regular seems to use 1-sim/parckBrake too…
-                 */
-                case XNZ_BT_FF35:
-                    if (0 == parking_brake_get(inRefcon))
-                    {
-                        return parking_brake_set(inRefcon, 1);
-                    }
-                    return 0;
-
-                case XNZ_BT_TBM9:
-                    switch (speed)
-                    {
-                        case 2:
-                            barray[0] = barray[1] = 0.9f;
-                            break;
-                        case 1:
-                            barray[0] = barray[1] = 0.6f;
-                            break;
-                        default:
-                            barray[0] = barray[1] = 0.3f;
-                            break;
-                    }
-                    XPLMSetDatavf(((xnz_cmd_context*)inRefcon)->bt.tbm9.rbrak_array, barray, 0, 2);
-                    return 0;
-
-                case XNZ_BT_ERRR:
-                default:
-                    return 0;
-            }
-            return 0;
+            XPLMCommandOnce(commands->et.evic.cmd_e_2_tog);
         }
+        return 0;
+    }
+    return 0;
+}
 
-        case xplm_CommandEnd:
-        default:
+static int xnz_et_ix73_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (XPLMGetDatai(commands->xp.ongroundany))
         {
-            switch (((xnz_cmd_context*)inRefcon)->xnz_bt)
-            {
-                case XNZ_BT_XPLM:
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.l_rgb_ratio, 0.0f);
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.r_rgb_ratio, 0.0f);
-                    return parking_brake_set(inRefcon, ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff);
-                    return 0;
-
-                case XNZ_BT_COMM:
-                    if (((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current != NULL)
-                    {
-                        XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current);
-                        ((xnz_cmd_context*)inRefcon)->bt.comm.cmd_current = NULL;
-                        return 0;
-                    }
-                    return 0;
-
-                case XNZ_BT_PKBR:
-                case XNZ_BT_SIMC:
-                    if (((xnz_cmd_context*)inRefcon)->xnz_pb == XNZ_PB_XPLM)
-                    {
-                        return parking_brake_set(inRefcon, ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff);
-                    }
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.pbrak_ratio, 0.0f);
-                    return parking_brake_set(inRefcon, ((xnz_cmd_context*)inRefcon)->xp.pbrak_onoff);
-
-                case XNZ_BT_TO32:
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.l_rgb_ratio, 0.0f);
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->bt.to32.r_rgb_ratio, 0.0f);
-                    return 0;
-
-                case XNZ_BT_FF35:
-                    return parking_brake_set(inRefcon, ((xnz_cmd_context*)inRefcon)->bt.ff35.pbrak_onoff);
-
-                case XNZ_BT_TBM9:
-                    barray[0] = barray[1] = 0.0f; XPLMSetDatavf(((xnz_cmd_context*)inRefcon)->bt.tbm9.rbrak_array, barray, 0, 2);
-                    return 0;
-
-                case XNZ_BT_ERRR:
-                default:
-                    return 0;
-            }
+            XPLMSetDataf(commands->et.ix73.drf_e_1_knb, -1.0f);
             return 0;
         }
+        XPLMSetDataf(commands->et.ix73.drf_e_1_knb, 2.0f);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_pkb_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ix73_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        if (parking_brake_get(inRefcon))
+        if (XPLMGetDatai(commands->xp.ongroundany))
         {
-            return chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
+            XPLMSetDataf(commands->et.ix73.drf_e_2_knb, -1.0f);
+            return 0;
         }
-        return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
+        XPLMSetDataf(commands->et.ix73.drf_e_2_knb, 2.0f);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_pkb_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ix73_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-#if 0
     if (inPhase == xplm_CommandEnd)
     {
-        /*
-         * this may not work under X-Plane 11, they didn't
-         * apply the same tweak as for engine run switches
-         */
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
-        {
-            return parking_brake_set(inRefcon, 1);
-        }
+        XPLMSetDataf(commands->et.ix73.drf_e_1_knb, 0.0f);
+        XPLMSetDataf(commands->et.ix73.drf_e_2_knb, 0.0f);
+        return 0;
     }
-#endif
+    return 0;
+}
+
+static int xnz_et_ix73_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        return chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
+        XPLMSetDataf(commands->et.ix73.drf_e_1_knb, 1.0f);
+        XPLMSetDataf(commands->et.ix73.drf_e_2_knb, 1.0f);
+        return 0;
     }
-    if (inPhase == xplm_CommandBegin)
+    return 0;
+}
+
+static int xnz_et_ix73_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
     {
-        return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
+        XPLMSetDataf(commands->et.ix73.drf_e_1_cut, 1.0f);
+        return 0;
     }
-    if (inPhase == xplm_CommandContinue)
-    {
-        if (0 == parking_brake_get(inRefcon))
-        {
-            return parking_brake_set(inRefcon, 1);
-        }
+    return 0;
+}
+
+static int xnz_et_ix73_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMSetDataf(commands->et.ix73.drf_e_1_cut, 0.0f);
         return 0;
     }
     return 0;
 }
 
-static int chandler_pkb_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ix73_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        XPLMSpeakString("park brake set");
-        return parking_brake_set(inRefcon, 1);
+        XPLMSetDataf(commands->et.ix73.drf_e_2_cut, 1.0f);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_pkb_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ix73_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        XPLMSpeakString("park brake released");
-        return parking_brake_set(inRefcon, 0);
+        XPLMSetDataf(commands->et.ix73.drf_e_2_cut, 0.0f);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_a_p_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_ap)
+        if (XPLMGetDatai(commands->xp.ongroundany))
         {
-            case XNZ_AP_XPLM:
-            case XNZ_AP_XGFC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_ap_on);
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_yd_on); // TODO: when do we need this???
-                return 0;
-
-            case XNZ_AP_COMM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->ap.comm.cmd_ap_conn);
-                return 0;
-
-            default:
-                break;
+            XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 0.0f);
+            return 0;
         }
+        XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 4.0f);
         return 0;
     }
     return 0;
 }
 
-static int chandler_a_p_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_ap)
+        if (XPLMGetDatai(commands->xp.ongroundany))
         {
-            case XNZ_AP_XPLM:
-            case XNZ_AP_XGFC:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.auto_pil_on) > 0)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_fd_dn);
-                }
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_yd_no);
-                return 0;
-
-            case XNZ_AP_COMM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->ap.comm.cmd_ap_disc);
-                return 0;
-
-            default:
-                break;
+            XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 0.0f);
+            return 0;
         }
+        XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 4.0f);
         return 0;
     }
     return 0;
 }
 
-static int chandler_at_toga(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inPhase == xplm_CommandBegin)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_APTO:
-            case XNZ_AT_NONE:
-                if (((xnz_cmd_context*)inRefcon)->xnz_ap == XNZ_AP_XGFC)
-                {
-                    XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->xp.ap_cw_st);
-                    return 0;
-                }
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 2.0f);
+        XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 2.0f);
         return 0;
     }
+    return 0;
+}
+
+static int xnz_et_ff75_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
+        int eng_running[2]; XPLMGetDatavi(commands->xp.eng_running, eng_running, 0, 2);
+        if (eng_running[0])
         {
-            case XNZ_AT_XP11:
-                if (((xnz_cmd_context*)inRefcon)->xp.at_at_n1)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga);
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_n1);
-                    return 0;
-                }
-            case XNZ_AT_XPLM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga);
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_on);
-                return 0;
-
-            case XNZ_AT_TOLI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_on);
-                return 0;
-
-            case XNZ_AT_COMM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.comm.cmd_at_toga);
-                return 0;
-
-            case XNZ_AT_APTO:
-            case XNZ_AT_NONE:
-                if (((xnz_cmd_context*)inRefcon)->xnz_ap == XNZ_AP_XGFC)
-                {
-                    XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->xp.ap_cw_st);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_AT_ERRR:
-            case XNZ_AT_TOGG:
-//          case XNZ_AT_DISC:
-            default:
-                return 0;
+            XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 1.0f);
+        }
+        else
+        {
+            XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 2.0f);
+        }
+        if (eng_running[1])
+        {
+            XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 1.0f);
+        }
+        else
+        {
+            XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 2.0f);
         }
         return 0;
     }
     return 0;
 }
 
-static int chandler_at_disc(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_XP11:
-            case XNZ_AT_XPLM:
-            case XNZ_AT_TOLI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_no);
-                return 0;
-
-            case XNZ_AT_COMM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.comm.cmd_at_disc);
-                return 0;
-
-            case XNZ_AT_APTO:
-            case XNZ_AT_ERRR:
-            case XNZ_AT_NONE:
-            case XNZ_AT_TOGG:
-//          case XNZ_AT_DISC:
-            default:
-                return 0;
-        }
+        XPLMSetDataf(commands->et.ff75.drf_e_1_knb, 3.0f);
+        XPLMSetDataf(commands->et.ff75.drf_e_2_knb, 3.0f);
         return 0;
     }
     return 0;
 }
 
-static int chandler_a_12_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_XPLM:
-            case XNZ_AT_TOLI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_no);
-                return 0;
-
-            case XNZ_AT_COMM:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.comm.cmd_at_disc);
-                return 0;
-
-//          case XNZ_AT_DISC:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.at_at_no);
-//              return 0;
-
-            case XNZ_AT_APTO:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.toga.cmd_ap_toga);
-                return 0;
-
-            case XNZ_AT_NONE:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga);
-                return 0;
-
-            case XNZ_AT_ERRR:
-            case XNZ_AT_TOGG:
-            default:
-                return 0;
-        }
+        XPLMSetDatai(commands->et.ix73.drf_e_1_cut, 2);
         return 0;
     }
     return 0;
 }
 
-static int chandler_a_12_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_APTO:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.toga.cmd_ap_toga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            case XNZ_AT_NONE:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            default:
-                break;
-        }
-        return chandler_a_12_lt(((xnz_cmd_context*)inRefcon)->cmd_a_12_lt, xplm_CommandEnd, inRefcon);
+        XPLMSetDatai(commands->et.ix73.drf_e_1_cut, 0);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_a_34_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_APTO:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.toga.cmd_ap_toga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            case XNZ_AT_NONE:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            default:
-                break;
-        }
-        return chandler_a_12_lt(((xnz_cmd_context*)inRefcon)->cmd_a_12_lt, xplm_CommandEnd, inRefcon);
+        XPLMSetDatai(commands->et.ix73.drf_e_2_cut, 2);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_a_34_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_ff75_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_at)
-        {
-            case XNZ_AT_APTO:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->at.toga.cmd_ap_toga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            case XNZ_AT_NONE:
-//              XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ap_to_ga); // only map to the leftmost button (engines 1 & 2)
-                return 0;
-
-            default:
-                break;
-        }
-        return chandler_a_12_lt(((xnz_cmd_context*)inRefcon)->cmd_a_12_lt, xplm_CommandEnd, inRefcon);
+        XPLMSetDatai(commands->et.ix73.drf_e_2_cut, 0);
+        return 0;
     }
     return 0;
 }
 
-static int chandler_x_12_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_tbm9_x_12_lt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandBegin)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_lt);
-                return 0;
-
-            case XNZ_ET_DA62:
-            case XNZ_ET_LEG2:
-            case XNZ_ET_XPPI:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->xp.p_start1);
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_1_knb) > 0)
-                {
-                    XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_1_rgt);
-                    return 0;
-                }
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    if (inPhase == xplm_CommandContinue)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_RPTP:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.rptp.drf_e_1_eng, 1);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandBegin(commands->et.tbm9.cmd_x_12_lt);
         return 0;
     }
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_lt);
-                return 0;
-
-            case XNZ_ET_DA62:
-            case XNZ_ET_LEG2:
-            case XNZ_ET_XPPI:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->xp.p_start1);
-                return 0;
-
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_x_12_lt);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_knb) > 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_1_rgt);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_1_knb) > 0)
-                {
-                    XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_1_rgt);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.ongroundany))
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_knb, -1.0f);
-                    return 0;
-                }
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_knb, 2.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.ongroundany))
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 0.0f);
-                    return 0;
-                }
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 4.0f);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandEnd(commands->et.tbm9.cmd_x_12_lt);
         return 0;
     }
     return 0;
 }
 
-static int chandler_x_12_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_tbm9_x_12_rt(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
     if (inPhase == xplm_CommandBegin)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_rt);
-                return 0;
-
-            case XNZ_ET_DA62:
-            case XNZ_ET_XPPI:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->xp.p_start2);
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_2_knb) > 0)
-                {
-                    XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_2_rgt);
-                    return 0;
-                }
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandBegin(commands->et.tbm9.cmd_x_12_rt);
         return 0;
     }
-    if (inPhase == xplm_CommandContinue)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_RPTP:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.rptp.drf_e_1_eng, 0);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandEnd(commands->et.tbm9.cmd_x_12_rt);
         return 0;
     }
+    return 0;
+}
+
+static int xnz_et_tbm9_m_12_cr(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_rt);
-                return 0;
-
-            case XNZ_ET_DA62:
-            case XNZ_ET_XPPI:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->xp.p_start2);
-                return 0;
-
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_x_12_rt);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_knb) > 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_2_rgt);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_2_knb) > 0)
-                {
-                    XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_2_rgt);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.ongroundany))
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_knb, -1.0f);
-                    return 0;
-                }
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_knb, 2.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.ongroundany))
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 0.0f);
-                    return 0;
-                }
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 4.0f);
-                return 0;
-
-            case XNZ_ET_LEG2:
-            {
-                float fuelsel = XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.leg2.drf_fuelsel);
-                if (0.5f > fuelsel)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_f_sl_lt);
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_f_sl_lt);
-                    return 0; // off -> left
-                }
-                if (1.5f > fuelsel)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_f_sl_lt);
-                    return 0; // right -> left
-                }
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_f_sl_rt);
-                return 0; // left -> right
-            }
-
-            default:
-                break;
-        }
+        XPLMCommandOnce(commands->et.tbm9.cmd_m_12_cr);
         return 0;
     }
     return 0;
 }
 
-static int chandler_x_34_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_tbm9_m_12_no(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inPhase == xplm_CommandBegin)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_lt);
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->xp.p_start3);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandOnce(commands->et.tbm9.cmd_m_12_no);
         return 0;
     }
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_lt);
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->xp.p_start3);
-                return 0;
+    return 0;
+}
 
-            default:
-                break;
-        }
+static int xnz_et_tbm9_m_12_st(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        XPLMCommandOnce(commands->et.tbm9.cmd_m_12_st);
         return 0;
     }
     return 0;
 }
 
-static int chandler_x_34_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_tbm9_e_1_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inPhase == xplm_CommandBegin)
+    if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_rt);
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandBegin(((xnz_cmd_context*)inRefcon)->xp.p_start4);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_onn); // cutoff -> low idle
         return 0;
     }
+    return 0;
+}
+
+static int xnz_et_tbm9_e_1_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TBM9:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_x_12_rt);
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandEnd(((xnz_cmd_context*)inRefcon)->xp.p_start4);
-                return 0;
-
-            default:
-                break;
-        }
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_off); // low idle -> cutoff
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_12_ch(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int xnz_et_tbm9_e_2_onn(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
 {
-    if (inPhase == xplm_CommandBegin)
+    if (inPhase == xplm_CommandEnd)
     {
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
-        {
-            return 0;
-        }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_cr);
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_onn); // low -> high idle
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_onn); // high -> flight idle
+//      XPLMSetDatai(commands->et.tbm9.drf_fuelsel, 0); // FUEL SEL switch position. 0 = AUTO, 1 = MAN.
         return 0;
     }
+    return 0;
+}
+
+static int xnz_et_tbm9_e_2_off(xnz_cmd_context *commands, XPLMCommandPhase inPhase)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
-        {
-            return chandler_m_12_cr(((xnz_cmd_context*)inRefcon)->cmd_m_12_cr, xplm_CommandEnd, inRefcon);
-        }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_no);
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_off); // flight -> high idle
+        XPLMCommandOnce(commands->et.tbm9.cmd_e_1_off); // high -> low idle
+//      XPLMSetDatai(commands->et.tbm9.drf_fuelsel, 1); // FUEL SEL switch position. 0 = AUTO, 1 = MAN.
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_12_cr(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static const xnz_et_ops xnz_et_ops_noop =
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_m_12_cr);
-                return 0;
+    .x_12_lt = xnz_op_noop,
+    .x_12_rt = xnz_op_noop,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_op_noop,
+    .m_12_st = xnz_op_noop,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_op_noop,
+    .e_1_off = xnz_op_noop,
+    .e_2_onn = xnz_op_noop,
+    .e_2_off = xnz_op_noop,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_m_12_cr);
-                return 0;
+static const xnz_et_ops xnz_et_ops_xptp =
+{
+    .x_12_lt = xnz_op_noop,
+    .x_12_rt = xnz_op_noop,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_op_noop,
+    .m_12_st = xnz_op_noop,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_xptp_e_1_onn,
+    .e_1_off = xnz_et_xptp_e_1_off,
+    .e_2_onn = xnz_et_xptp_e_1_onn,
+    .e_2_off = xnz_et_xptp_e_1_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_m_12_cr);
-                return 0;
+static const xnz_et_ops xnz_et_ops_xppi =
+{
+    .x_12_lt = xnz_et_xppi_x_12_lt,
+    .x_12_rt = xnz_et_xppi_x_12_rt,
+    .x_34_lt = xnz_et_xppi_x_34_lt,
+    .x_34_rt = xnz_et_xppi_x_34_rt,
+    .m_12_cr = xnz_et_xppi_m_12_cr,
+    .m_12_no = xnz_et_xppi_m_12_no,
+    .m_12_st = xnz_et_xppi_m_12_st,
+    .m_34_cr = xnz_et_xppi_m_34_cr,
+    .m_34_no = xnz_et_xppi_m_34_no,
+    .m_34_st = xnz_et_xppi_m_34_st,
+    .e_1_onn = xnz_et_xppi_e_1_onn,
+    .e_1_off = xnz_et_xppi_e_1_off,
+    .e_2_onn = xnz_et_xppi_e_2_onn,
+    .e_2_off = xnz_et_xppi_e_2_off,
+    .e_3_onn = xnz_et_xppi_e_3_onn,
+    .e_3_off = xnz_et_xppi_e_3_off,
+    .e_4_onn = xnz_et_xppi_e_4_onn,
+    .e_4_off = xnz_et_xppi_e_4_off,
+};
 
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_lft1);
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_lft2);
-                return 0;
+static const xnz_et_ops xnz_et_ops_rptp =
+{
+    .x_12_lt = xnz_et_rptp_x_12_lt,
+    .x_12_rt = xnz_et_rptp_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_rptp_m_12_cr,
+    .m_12_no = xnz_et_rptp_m_12_cr,
+    .m_12_st = xnz_et_rptp_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_xptp_e_1_onn,
+    .e_1_off = xnz_et_xptp_e_1_off,
+    .e_2_onn = xnz_et_xptp_e_1_onn,
+    .e_2_off = xnz_et_xptp_e_1_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) > 0.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) > 1.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_dn);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_dn);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) > 0.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) > 1.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_dn);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_dn);
-                }
-                return 0;
+static const xnz_et_ops xnz_et_ops_da62 =
+{
+    .x_12_lt = xnz_et_xppi_x_12_lt,
+    .x_12_rt = xnz_et_xppi_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_da62_m_12_cr,
+    .m_12_no = xnz_et_da62_m_12_no,
+    .m_12_st = xnz_et_da62_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_da62_e_1_onn,
+    .e_1_off = xnz_et_da62_e_1_off,
+    .e_2_onn = xnz_et_da62_e_2_onn,
+    .e_2_off = xnz_et_da62_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_DA62:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) > 0.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) > 1.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_dn);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_dn);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) > 0.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) > 1.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_dn);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_dn);
-                }
-                return 0;
+static const xnz_et_ops xnz_et_ops_e35l =
+{
+    .x_12_lt = xnz_et_e35l_x_12_lt,
+    .x_12_rt = xnz_et_e35l_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_e35l_m_12_cr,
+    .m_12_no = xnz_et_e35l_m_12_no,
+    .m_12_st = xnz_op_noop,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_e35l_e_1_onn,
+    .e_1_off = xnz_et_e35l_e_1_off,
+    .e_2_onn = xnz_et_e35l_e_2_onn,
+    .e_2_off = xnz_et_e35l_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_E35L:
-            {
-                int auto_ignite_off[2] = { 0, 0, };
-                XPLMSetDatavi(((xnz_cmd_context*)inRefcon)->xp.auto_ignite, auto_ignite_off, 0, 2);
-                return 0;
-            }
+static const xnz_et_ops xnz_et_ops_to32 =
+{
+    .x_12_lt = xnz_op_noop,
+    .x_12_rt = xnz_op_noop,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_to32_m_12_cr,
+    .m_12_no = xnz_et_to32_m_12_no,
+    .m_12_st = xnz_et_to32_m_12_st,
+    .m_34_cr = xnz_et_to32_m_12_cr,
+    .m_34_no = xnz_et_to32_m_12_no,
+    .m_34_st = xnz_et_to32_m_12_st,
+    .e_1_onn = xnz_et_to32_e_1_onn,
+    .e_1_off = xnz_et_to32_e_1_off,
+    .e_2_onn = xnz_et_to32_e_2_onn,
+    .e_2_off = xnz_et_to32_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_FF75:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 2.0f);
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 2.0f);
-                return 0;
+static const xnz_et_ops xnz_et_ops_ff35 =
+{
+    .x_12_lt = xnz_op_noop,
+    .x_12_rt = xnz_op_noop,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_ff35_m_12_cr,
+    .m_12_no = xnz_et_ff35_m_12_no,
+    .m_12_st = xnz_et_ff35_m_12_st,
+    .m_34_cr = xnz_et_ff35_m_12_cr,
+    .m_34_no = xnz_et_ff35_m_12_no,
+    .m_34_st = xnz_et_ff35_m_12_st,
+    .e_1_onn = xnz_et_ff35_e_1_onn,
+    .e_1_off = xnz_et_ff35_e_1_off,
+    .e_2_onn = xnz_et_ff35_e_2_onn,
+    .e_2_off = xnz_et_ff35_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            case XNZ_ET_RPTP:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.rptp.drf_e_1_ign, 0);
-                return 0;
+static const xnz_et_ops xnz_et_ops_e55p =
+{
+    .x_12_lt = xnz_et_e55p_x_12_lt,
+    .x_12_rt = xnz_et_e55p_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_e55p_m_12_cr,
+    .m_12_no = xnz_et_e55p_m_12_no,
+    .m_12_st = xnz_et_e55p_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_e55p_e_1_onn,
+    .e_1_off = xnz_et_e55p_e_1_off,
+    .e_2_onn = xnz_et_e55p_e_2_onn,
+    .e_2_off = xnz_et_e55p_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
-}
+static const xnz_et_ops xnz_et_ops_leg2 =
+{
+    .x_12_lt = xnz_et_xppi_x_12_lt,
+    .x_12_rt = xnz_et_leg2_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_et_leg2_m_12_no,
+    .m_12_st = xnz_et_leg2_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_leg2_e_1_onn,
+    .e_1_off = xnz_et_leg2_e_1_off,
+    .e_2_onn = xnz_et_leg2_e_2_onn,
+    .e_2_off = xnz_et_leg2_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
 
-static int chandler_m_12_no(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static const xnz_et_ops xnz_et_ops_ea50 =
 {
-    if (inPhase == xplm_CommandEnd)
+    .x_12_lt = xnz_op_noop,
+    .x_12_rt = xnz_op_noop,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_et_ea50_m_12_no,
+    .m_12_st = xnz_et_ea50_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_ea50_e_1_onn,
+    .e_1_off = xnz_et_ea50_e_1_off,
+    .e_2_onn = xnz_et_ea50_e_2_onn,
+    .e_2_off = xnz_et_ea50_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
+
+static const xnz_et_ops xnz_et_ops_evic =
+{
+    .x_12_lt = xnz_et_evic_x_12_lt,
+    .x_12_rt = xnz_et_evic_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_et_evic_m_12_no,
+    .m_12_st = xnz_et_evic_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_evic_e_1_onn,
+    .e_1_off = xnz_et_evic_e_1_off,
+    .e_2_onn = xnz_et_evic_e_2_onn,
+    .e_2_off = xnz_et_evic_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
+
+static const xnz_et_ops xnz_et_ops_ix73 =
+{
+    .x_12_lt = xnz_et_ix73_x_12_lt,
+    .x_12_rt = xnz_et_ix73_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_op_noop,
+    .m_12_no = xnz_et_ix73_m_12_no,
+    .m_12_st = xnz_et_ix73_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_ix73_e_1_onn,
+    .e_1_off = xnz_et_ix73_e_1_off,
+    .e_2_onn = xnz_et_ix73_e_2_onn,
+    .e_2_off = xnz_et_ix73_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
+
+static const xnz_et_ops xnz_et_ops_ff75 =
+{
+    .x_12_lt = xnz_et_ff75_x_12_lt,
+    .x_12_rt = xnz_et_ff75_x_12_rt,
+    .x_34_lt = xnz_op_noop,
+    .x_34_rt = xnz_op_noop,
+    .m_12_cr = xnz_et_ff75_m_12_cr,
+    .m_12_no = xnz_et_ff75_m_12_no,
+    .m_12_st = xnz_et_ff75_m_12_st,
+    .m_34_cr = xnz_op_noop,
+    .m_34_no = xnz_op_noop,
+    .m_34_st = xnz_op_noop,
+    .e_1_onn = xnz_et_ff75_e_1_onn,
+    .e_1_off = xnz_et_ff75_e_1_off,
+    .e_2_onn = xnz_et_ff75_e_2_onn,
+    .e_2_off = xnz_et_ff75_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
+
+static const xnz_et_ops xnz_et_ops_tbm9 =
+{
+    .x_12_lt = xnz_et_tbm9_x_12_lt,
+    .x_12_rt = xnz_et_tbm9_x_12_rt,
+    .x_34_lt = xnz_et_tbm9_x_12_lt,
+    .x_34_rt = xnz_et_tbm9_x_12_rt,
+    .m_12_cr = xnz_et_tbm9_m_12_cr,
+    .m_12_no = xnz_et_tbm9_m_12_no,
+    .m_12_st = xnz_et_tbm9_m_12_st,
+    .m_34_cr = xnz_et_tbm9_m_12_cr,
+    .m_34_no = xnz_et_tbm9_m_12_no,
+    .m_34_st = xnz_et_tbm9_m_12_st,
+    .e_1_onn = xnz_et_tbm9_e_1_onn,
+    .e_1_off = xnz_et_tbm9_e_1_off,
+    .e_2_onn = xnz_et_tbm9_e_2_onn,
+    .e_2_off = xnz_et_tbm9_e_2_off,
+    .e_3_onn = xnz_op_noop,
+    .e_3_off = xnz_op_noop,
+    .e_4_onn = xnz_op_noop,
+    .e_4_off = xnz_op_noop,
+};
+static void xnz_cmd_ops_resolve(xnz_cmd_context *commands)
+{
+    switch (commands->xnz_ap)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_m_12_no);
-                return 0;
+        case XNZ_AP_XPLM:
+        case XNZ_AP_XGFC:
+            commands->ops.ap = &xnz_ap_ops_xplm;
+            break;
 
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_m_12_no);
-                return 0;
+        case XNZ_AP_COMM:
+            commands->ops.ap = &xnz_ap_ops_comm;
+            break;
 
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_m_12_no);
-                return 0;
+        case XNZ_AP_ERRR:
+        case XNZ_AP_NONE:
+        case XNZ_AP_TOGG:
+        case XNZ_AP_FF32:
+        default:
+            commands->ops.ap = &xnz_ap_ops_noop;
+            break;
+    }
+    switch (commands->xnz_at)
+    {
+        case XNZ_AT_NONE:
+            commands->ops.at = &xnz_at_ops_none;
+            break;
 
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_m_12_no);
-                return 0;
+        case XNZ_AT_XPLM:
+            commands->ops.at = &xnz_at_ops_xplm;
+            break;
 
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_up);
-                }
-                else if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) > 1.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_dn);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_up);
-                }
-                else if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) > 1.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_dn);
-                }
-                return 0;
+        case XNZ_AT_COMM:
+            commands->ops.at = &xnz_at_ops_comm;
+            break;
 
-            case XNZ_ET_XPPI:
-            {
-                int eng_running[2]; XPLMGetDatavi(((xnz_cmd_context*)inRefcon)->xp.eng_running, eng_running, 0, 2);
-                if (eng_running[0])
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth1);
-                }
-                else
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop1);
-                }
-                if (eng_running[1])
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth2);
-                }
-                else
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop2);
-                }
-                return 0;
-            }
+        case XNZ_AT_APTO:
+            commands->ops.at = &xnz_at_ops_apto;
+            break;
 
-            case XNZ_ET_EA50:
-            {
-                int eng_running[2]; XPLMGetDatavi(((xnz_cmd_context*)inRefcon)->xp.eng_running, eng_running, 0, 2);
-                if (eng_running[0])
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en1, 1);
-                }
-                else
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en1, 0);
-                }
-                if (eng_running[1])
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en2, 1);
-                }
-                else
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en2, 0);
-                }
-                return 0;
-            }
+        case XNZ_AT_XP11:
+            commands->ops.at = &xnz_at_ops_xp11;
+            break;
 
-            case XNZ_ET_DA62:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_up);
-                }
-                else if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) > 1.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_dn);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_up);
-                }
-                else if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) > 1.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_dn);
-                }
-                return 0;
+        case XNZ_AT_TOLI:
+            commands->ops.at = &xnz_at_ops_toli;
+            break;
 
-            case XNZ_ET_E35L:
-            {
-                int auto_ignite_on[2] = { 1, 1, };
-                XPLMSetDatavi(((xnz_cmd_context*)inRefcon)->xp.auto_ignite, auto_ignite_on, 0, 2);
-                return 0;
-            }
+        case XNZ_AT_ERRR:
+        case XNZ_AT_TOGG:
+        case XNZ_AT_FF32:
+        default:
+            commands->ops.at = &xnz_at_ops_noop;
+            break;
+    }
+    switch (commands->xnz_et)
+    {
+        case XNZ_ET_XPTP:
+            commands->ops.et = &xnz_et_ops_xptp;
+            break;
 
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_knb, 0.0f);
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_knb, 0.0f);
-                return 0;
+        case XNZ_ET_XPPI:
+            commands->ops.et = &xnz_et_ops_xppi;
+            break;
 
-            case XNZ_ET_FF75:
-            {
-                int eng_running[2]; XPLMGetDatavi(((xnz_cmd_context*)inRefcon)->xp.eng_running, eng_running, 0, 2);
-                if (eng_running[0])
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 1.0f);
-                }
-                else
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 2.0f);
-                }
-                if (eng_running[1])
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 1.0f);
-                }
-                else
-                {
-                    XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 2.0f);
-                }
-                return 0;
-            }
+        case XNZ_ET_RPTP:
+            commands->ops.et = &xnz_et_ops_rptp;
+            break;
 
-            case XNZ_ET_RPTP:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.rptp.drf_e_1_ign, 0);
-                return 0;
+        case XNZ_ET_DA62:
+            commands->ops.et = &xnz_et_ops_da62;
+            break;
 
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_m_12_no);
-                return 0;
+        case XNZ_ET_E35L:
+            commands->ops.et = &xnz_et_ops_e35l;
+            break;
+
+        case XNZ_ET_TO32:
+            commands->ops.et = &xnz_et_ops_to32;
+            break;
+
+        case XNZ_ET_FF35:
+            commands->ops.et = &xnz_et_ops_ff35;
+            break;
+
+        case XNZ_ET_E55P:
+            commands->ops.et = &xnz_et_ops_e55p;
+            break;
+
+        case XNZ_ET_LEG2:
+            commands->ops.et = &xnz_et_ops_leg2;
+            break;
+
+        case XNZ_ET_EA50:
+            commands->ops.et = &xnz_et_ops_ea50;
+            break;
+
+        case XNZ_ET_EVIC:
+            commands->ops.et = &xnz_et_ops_evic;
+            break;
+
+        case XNZ_ET_IX73:
+            commands->ops.et = &xnz_et_ops_ix73;
+            break;
+
+        case XNZ_ET_FF75:
+            commands->ops.et = &xnz_et_ops_ff75;
+            break;
+
+        case XNZ_ET_TBM9:
+            commands->ops.et = &xnz_et_ops_tbm9;
+            break;
+
+        case XNZ_ET_ERRR:
+        case XNZ_ET_NONE:
+        case XNZ_ET_XPJT:
+        case XNZ_ET_FF32:
+        case XNZ_ET_PIPA:
+        case XNZ_ET_CL30:
+        default:
+            commands->ops.et = &xnz_et_ops_noop;
+            break;
+    }
+    switch (commands->xnz_bt)
+    {
+        case XNZ_BT_XPLM:
+            commands->ops.bt = &xnz_bt_ops_xplm;
+            break;
+
+        case XNZ_BT_COMM:
+            commands->ops.bt = &xnz_bt_ops_comm;
+            break;
+
+        case XNZ_BT_PKBR:
+            commands->ops.bt = &xnz_bt_ops_pkbr;
+            break;
+
+        case XNZ_BT_SIMC:
+            commands->ops.bt = &xnz_bt_ops_simc;
+            break;
+
+        case XNZ_BT_TO32:
+            commands->ops.bt = &xnz_bt_ops_to32;
+            break;
+
+        case XNZ_BT_FF35:
+            commands->ops.bt = &xnz_bt_ops_ff35;
+            break;
+
+        case XNZ_BT_TBM9:
+            commands->ops.bt = &xnz_bt_ops_tbm9;
+            break;
+
+        case XNZ_BT_ERRR:
+        default:
+            commands->ops.bt = &xnz_bt_ops_noop;
+            break;
+    }
+    switch (commands->xnz_pb)
+    {
+        case XNZ_PB_XPLM:
+            commands->ops.pb = &xnz_pb_ops_xplm;
+            break;
+
+        case XNZ_PB_TO32:
+            commands->ops.pb = &xnz_pb_ops_to32;
+            break;
+
+        case XNZ_PB_FF35:
+            commands->ops.pb = &xnz_pb_ops_ff35;
+            break;
+
+        case XNZ_PB_TBM9:
+            commands->ops.pb = &xnz_pb_ops_tbm9;
+            break;
+
+        case XNZ_PB_ERRR:
+        default:
+            commands->ops.pb = &xnz_pb_ops_errr;
+            break;
+    }
+}
 
-            default:
-                break;
+static int chandler_ldg_upp(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_up);
+            xnz_callout(inRefcon, XNZ_CALLOUT_GEAR_UP);
+            return 0;
         }
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_12_st(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_ldg_dwn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
+        if (inRefcon)
         {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_m_12_st);
-                return 0;
-
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_m_12_st);
-                return 0;
-
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_m_12_st);
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_rgt1);
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_rgt2);
-                return 0;
-
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_m_12_st);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) < 1.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_ign) < 0.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_up);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_1_up);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) < 1.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_ign) < 0.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_up);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_ig_2_up);
-                }
-                return 0;
+            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_dn);
+            xnz_callout(inRefcon, XNZ_CALLOUT_GEAR_DN);
+            return 0;
+        }
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_ET_EA50:
+static int chandler_ldg_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (inRefcon)
+        {
+            if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->xp.gear_handle) == 1)
             {
-                int eng_running[2]; XPLMGetDatavi(((xnz_cmd_context*)inRefcon)->xp.eng_running, eng_running, 0, 2);
-                if (eng_running[0])
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en1, 2);
-                }
-                if (eng_running[1])
-                {
-                    XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en2, 2);
-                }
+                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_up);
+                xnz_callout(inRefcon, XNZ_CALLOUT_GEAR_UP);
                 return 0;
             }
-
-            case XNZ_ET_DA62:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) < 1.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec1) < 0.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_up);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu1_up);
-                }
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) < 1.5f)
-                {
-                    if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.da62.drf_mod_ec2) < 0.5f)
-                    {
-                        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_up);
-                    }
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_ecu2_up);
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_knb, 1.0f);
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_knb, 1.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_1_knb, 3.0f);
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ff75.drf_e_2_knb, 3.0f);
-                return 0;
-
-            case XNZ_ET_RPTP:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.rptp.drf_e_1_ign, 1);
-                return 0;
-
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_m_12_st);
-                return 0;
-
-            default:
-                break;
+            XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.ld_gr_dn);
+            xnz_callout(inRefcon, XNZ_CALLOUT_GEAR_DN);
+            return 0;
         }
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_12_sh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_rgb_pkb(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
     if (inPhase == xplm_CommandBegin)
     {
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        if ((((xnz_cmd_context*)inRefcon)->xp.pbrakonoff2 = parking_brake_get(inRefcon))) // if set, release parking brake
+        {
+            chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
+        }
+        return chandler_rgb_hld(((xnz_cmd_context*)inRefcon)->cmd_rgb_hld, xplm_CommandBegin, inRefcon);
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (0 == chandler_rgb_hld(((xnz_cmd_context*)inRefcon)->cmd_rgb_hld, xplm_CommandEnd, inRefcon))
         {
+            if (((xnz_cmd_context*)inRefcon)->xp.pbrakonoff2 == 0) // if was NOT set on command begin, set parking brake
+            {
+                if (GROUNDSP_KTS_MIN > MPS2KTS(XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.groundspeed))) // only when groundspeed is very low
+                {
+                    return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
+                }
+                return 0;
+            }
             return 0;
         }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_st);
         return 0;
     }
+    return 0;
+}
+static int chandler_rgb_hld(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.bt->rgb_hld((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_pkb_tog(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
     if (inPhase == xplm_CommandEnd)
     {
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        if (parking_brake_get(inRefcon))
         {
-            return chandler_m_12_st(((xnz_cmd_context*)inRefcon)->cmd_m_12_st, xplm_CommandEnd, inRefcon);
+            return chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
         }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_no);
-        return 0;
+        return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
     }
     return 0;
 }
 
-static int chandler_m_34_ch(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_pkb_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandBegin)
+#if 0
+    if (inPhase == xplm_CommandEnd)
     {
+        /*
+         * this may not work under X-Plane 11, they didn't
+         * apply the same tweak as for engine run switches
+         */
         if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
         {
-            return 0;
+            return parking_brake_set(inRefcon, 1);
         }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_34_cr);
-        return 0;
     }
+#endif
     if (inPhase == xplm_CommandEnd)
     {
-        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        return chandler_pkb_off(((xnz_cmd_context*)inRefcon)->cmd_pkb_off, xplm_CommandEnd, inRefcon); // use command handler for callouts
+    }
+    if (inPhase == xplm_CommandBegin)
+    {
+        return chandler_pkb_onn(((xnz_cmd_context*)inRefcon)->cmd_pkb_onn, xplm_CommandEnd, inRefcon); // use command handler for callouts
+    }
+    if (inPhase == xplm_CommandContinue)
+    {
+        if (0 == parking_brake_get(inRefcon))
         {
-            return chandler_m_34_cr(((xnz_cmd_context*)inRefcon)->cmd_m_34_cr, xplm_CommandEnd, inRefcon);
+            return parking_brake_set(inRefcon, 1);
         }
-        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_34_no);
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_34_cr(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_pkb_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-            case XNZ_ET_FF35:
-            case XNZ_ET_TBM9:
-                return chandler_m_12_cr(((xnz_cmd_context*)inRefcon)->cmd_m_12_cr, xplm_CommandEnd, inRefcon);
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_lft3);
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_lft4);
-                return 0;
+        xnz_callout(inRefcon, XNZ_CALLOUT_PKB_SET);
+        return parking_brake_set(inRefcon, 1);
+    }
+    return 0;
+}
 
-            default:
-                break;
-        }
-        return 0;
+static int chandler_pkb_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandEnd)
+    {
+        xnz_callout(inRefcon, XNZ_CALLOUT_PKB_REL);
+        return parking_brake_set(inRefcon, 0);
     }
     return 0;
 }
 
-static int chandler_m_34_no(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_a_p_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.ap->a_p_onn((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_a_p_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.ap->a_p_off((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_at_toga(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->at_toga((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_at_disc(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->at_disc((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_a_12_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->a_12_lt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_a_12_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->a_12_rt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_a_34_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->a_34_lt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_a_34_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.at->a_34_rt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_x_12_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
+    return ((xnz_cmd_context*)inRefcon)->ops.et->x_12_lt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_x_12_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->x_12_rt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_x_34_lt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->x_34_lt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_x_34_rt(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->x_34_rt((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_m_12_ch(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        {
+            return 0;
+        }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_cr);
+        return 0;
+    }
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
         {
-            case XNZ_ET_TO32:
-            case XNZ_ET_FF35:
-            case XNZ_ET_TBM9:
-                return chandler_m_12_no(((xnz_cmd_context*)inRefcon)->cmd_m_12_no, xplm_CommandEnd, inRefcon);
+            return chandler_m_12_cr(((xnz_cmd_context*)inRefcon)->cmd_m_12_cr, xplm_CommandEnd, inRefcon);
+        }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_no);
+        return 0;
+    }
+    return 0;
+}
 
-            case XNZ_ET_XPPI:
-            {
-                int eng_running[2]; XPLMGetDatavi(((xnz_cmd_context*)inRefcon)->xp.eng_running, eng_running, 2, 2);
-                if (eng_running[0])
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth3);
-                }
-                else
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop3);
-                }
-                if (eng_running[1])
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth4);
-                }
-                else
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop4);
-                }
-                return 0;
-            }
+static int chandler_m_12_cr(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_12_cr((xnz_cmd_context*)inRefcon, inPhase);
+}
 
-            default:
-                break;
+static int chandler_m_12_no(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_12_no((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_m_12_st(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_12_st((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_m_12_sh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    if (inPhase == xplm_CommandBegin)
+    {
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        {
+            return 0;
+        }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_st);
+        return 0;
+    }
+    if (inPhase == xplm_CommandEnd)
+    {
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        {
+            return chandler_m_12_st(((xnz_cmd_context*)inRefcon)->cmd_m_12_st, xplm_CommandEnd, inRefcon);
         }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_12_no);
         return 0;
     }
     return 0;
 }
 
-static int chandler_m_34_st(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+static int chandler_m_34_ch(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
+    if (inPhase == xplm_CommandBegin)
+    {
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
+        {
+            return 0;
+        }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_34_cr);
+        return 0;
+    }
     if (inPhase == xplm_CommandEnd)
     {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
+        if (((xnz_cmd_context*)inRefcon)->xp_11_50_or_later)
         {
-            case XNZ_ET_TO32:
-            case XNZ_ET_FF35:
-            case XNZ_ET_TBM9:
-                return chandler_m_12_st(((xnz_cmd_context*)inRefcon)->cmd_m_12_st, xplm_CommandEnd, inRefcon);
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_rgt3);
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_m_rgt4);
-                return 0;
-
-            default:
-                break;
+            return chandler_m_34_cr(((xnz_cmd_context*)inRefcon)->cmd_m_34_cr, xplm_CommandEnd, inRefcon);
         }
+        XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->cmd_m_34_no);
         return 0;
     }
     return 0;
 }
 
+static int chandler_m_34_cr(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_34_cr((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_m_34_no(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_34_no((xnz_cmd_context*)inRefcon, inPhase);
+}
+
+static int chandler_m_34_st(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
+{
+    return ((xnz_cmd_context*)inRefcon)->ops.et->m_34_st((xnz_cmd_context*)inRefcon, inPhase);
+}
+
 static int chandler_m_34_sh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
     if (inPhase == xplm_CommandBegin)
@@ -5178,150 +10104,12 @@ static int chandler_e_1_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 
 static int chandler_e_1_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_e_1_onn);
-                return 0;
-
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_e_1_onn);
-                return 0;
-
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_onn); // cutoff -> low idle
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth1);
-                return 0;
-
-            case XNZ_ET_EA50:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en1, 1);
-                return 0;
-
-            case XNZ_ET_DA62:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_e_1_onn);
-                return 0;
-
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_e_1_onn);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_knb) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_1_rgt);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_1_knb) < 1)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_1_rgt);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_cut, 1.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_cut, 2);
-                return 0;
-
-            case XNZ_ET_XPTP:
-            case XNZ_ET_RPTP:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all, 0.5f + XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all));
-                return 0;
-
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_e_1_onn);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_1_onn((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_1_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_e_1_off);
-                return 0;
-
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_e_1_off);
-                return 0;
-
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_off); // low idle -> cutoff
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop1);
-                return 0;
-
-            case XNZ_ET_EA50:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en1, 0);
-                return 0;
-
-            case XNZ_ET_DA62:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_e_1_off);
-                return 0;
-
-            case XNZ_ET_EVIC:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_e_1_off);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_1_knb) > 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_1_lft);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_1_knb) > 0)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_1_lft);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_cut, 0.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_1_cut, 0);
-                return 0;
-
-            case XNZ_ET_XPTP:
-            case XNZ_ET_RPTP:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all, XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all) - 0.5f);
-                return 0;
-
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_e_1_off);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_1_off((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_2_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
@@ -5349,160 +10137,12 @@ static int chandler_e_2_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 
 static int chandler_e_2_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_e_2_onn);
-                return 0;
-
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_e_2_onn);
-                return 0;
-
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_onn); // low -> high idle
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_onn); // high -> flight idle
-//              XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.tbm9.drf_fuelsel, 0); // FUEL SEL switch position. 0 = AUTO, 1 = MAN.
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth2);
-                return 0;
-
-            case XNZ_ET_EA50:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en2, 1);
-                return 0;
-
-            case XNZ_ET_DA62:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_e_2_onn);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_knb) < 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_2_rgt);
-                }
-                return 0;
-
-            case XNZ_ET_EVIC:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.evic.drf_fuel_at) == 0)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_e_2_tog);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_2_knb) < 1)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_2_rgt);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_cut, 1.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_cut, 2);
-                return 0;
-
-            case XNZ_ET_XPTP:
-            case XNZ_ET_RPTP:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all, 0.5f + XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all));
-                return 0;
-
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_e_2_onn);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_2_onn((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_2_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_TO32:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.to32.cmd_e_2_off);
-                return 0;
-
-            case XNZ_ET_FF35:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.ff35.cmd_e_2_off);
-                return 0;
-
-            case XNZ_ET_TBM9:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_off); // flight -> high idle
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.tbm9.cmd_e_1_off); // high -> low idle
-//              XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.tbm9.drf_fuelsel, 1); // FUEL SEL switch position. 0 = AUTO, 1 = MAN.
-                return 0;
-
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop2);
-                return 0;
-
-            case XNZ_ET_EA50:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ea50.drf_mod_en2, 0);
-                return 0;
-
-            case XNZ_ET_DA62:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.da62.cmd_e_2_off);
-                return 0;
-
-            case XNZ_ET_E55P:
-                if (XPLMGetDataf(((xnz_cmd_context*)inRefcon)->et.e55p.drf_e_2_knb) > 0.5f)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e55p.cmd_e_2_lft);
-                }
-                return 0;
-
-            case XNZ_ET_EVIC:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.evic.drf_fuel_at) != 0)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.evic.cmd_e_2_tog);
-                }
-                return 0;
-
-            case XNZ_ET_E35L:
-                if (XPLMGetDatai(((xnz_cmd_context*)inRefcon)->et.e35l.drf_e_2_knb) > 0)
-                {
-                    XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.e35l.cmd_e_2_lft);
-                    return 0;
-                }
-                return 0;
-
-            case XNZ_ET_IX73:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_cut, 0.0f);
-                return 0;
-
-            case XNZ_ET_FF75:
-                XPLMSetDatai(((xnz_cmd_context*)inRefcon)->et.ix73.drf_e_2_cut, 0);
-                return 0;
-
-            case XNZ_ET_XPTP:
-            case XNZ_ET_RPTP:
-                XPLMSetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all, XPLMGetDataf(((xnz_cmd_context*)inRefcon)->xp.mixture_all) - 0.5f);
-                return 0;
-
-            case XNZ_ET_LEG2:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->et.leg2.cmd_e_2_off);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_2_off((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_3_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
@@ -5530,38 +10170,12 @@ static int chandler_e_3_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 
 static int chandler_e_3_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth3);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_3_onn((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_3_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop3);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_3_off((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_4_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
@@ -5589,38 +10203,12 @@ static int chandler_e_4_onh(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 
 static int chandler_e_4_onn(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mboth4);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_4_onn((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_e_4_off(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
 {
-    if (inPhase == xplm_CommandEnd)
-    {
-        switch (((xnz_cmd_context*)inRefcon)->xnz_et)
-        {
-            case XNZ_ET_XPPI:
-                XPLMCommandOnce(((xnz_cmd_context*)inRefcon)->xp.p_mstop4);
-                return 0;
-
-            default:
-                break;
-        }
-        return 0;
-    }
-    return 0;
+    return ((xnz_cmd_context*)inRefcon)->ops.et->e_4_off((xnz_cmd_context*)inRefcon, inPhase);
 }
 
 static int chandler_printax(XPLMCommandRef inCommand, XPLMCommandPhase inPhase, void *inRefcon)
@@ -5632,7 +10220,7 @@ static int chandler_printax(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
             if (((xnz_context*)inRefcon)->idx_throttle_axis_1 >= 0)
             {
                 float f[2]; XPLMGetDatavf(((xnz_context*)inRefcon)->f_stick_val, f, ((xnz_context*)inRefcon)->idx_throttle_axis_1, 2);
-                xnz_log("[debug]: throttle axes (raw): (%.6f -- %.6f) --> (%.6f)\n", f[0], f[1], ((f[0] + f[1]) / 2.0f));
+                xnz_log(XNZ_LOG_DEBUG, "throttle axes (raw): (%.6f -- %.6f) --> (%.6f)\n", f[0], f[1], ((f[0] + f[1]) / 2.0f));
                 return 0;
             }
             return 0;
@@ -5649,9 +10237,60 @@ static int chandler_printax(XPLMCommandRef inCommand, XPLMCommandPhase inPhase,
 #undef GROUNDSP_KTS_MIN
 #undef GROUNDSP_KTS_MID
 #undef GROUNDSP_KTS_MAX
+#ifndef PUBLIC_RELEASE_BUILD
+#undef XPLMCommandOnce
+#undef XPLMCommandBegin
+#undef XPLMCommandEnd
+#undef XPLMSetDatai
+#undef XPLMSetDataf
+#undef XPLMSetDatavi
+#undef XPLMSetDatavf
+#undef XNZ_JOURNAL_FILE
+#endif
+#ifndef PUBLIC_RELEASE_BUILD
+#undef XNZ_OVERLAY_W
+#undef XNZ_OVERLAY_H
+#endif
 #undef XNZ_LOG_PREFIX
+#undef XNZ_LOG_BUFFER
+#undef XNZ_LOG_RESERVE
+#undef XNZ_LOG_BURST
+#undef XNZ_LOG_WINDOW_NS
 #undef XNZ_XPLM_TITLE
-#undef ACF_ROLL_SET
+#undef XNZ_XPLM_TRACE
+#undef XNZ_XPLM_FFREC
+#undef XNZ_XPLM_TELEM
+#undef XNZ_XPLM_INGRS
+#undef XNZ_INGRESS_BUDGET
+#undef XNZ_TRACE_RING
+#undef XNZ_TRACE_CHUNK
+#undef XNZ_TRACE_SLEEP
+#undef XNZ_FFREC_RING
+#undef XNZ_PERF_DUMP_BUFFER
+#undef XNZ_STUTTER_EVENTS
+#ifdef XNZ_XPLM_CALLSTATS
+#undef XPLMFindDataRef
+#undef XPLMFindCommand
+#undef XPLMGetDatai
+#undef XPLMGetDataf
+#undef XPLMGetDatavi
+#undef XPLMGetDatavf
+#undef XPLMGetDatab
+#undef XPLMSetDatai
+#undef XPLMSetDataf
+#undef XPLMSetDatavi
+#undef XPLMSetDatavf
+#undef XPLMCommandOnce
+#undef XPLMCommandBegin
+#undef XPLMCommandEnd
+#undef XNZ_CALLS_LINES
+#undef XNZ_CALLS_TOP
+#endif
+#undef XNZ_CALLS_SITE
+#undef XNZ_CALLS_SITE_PARAM
+#undef XNZ_CALLS_SITE_ARG
+#undef XNZ_CALLS_XPLM
+#undef NULLZONE_MIN
 #undef HS_TBM9_IDLE
 #undef XNZ_THINN_NO
 #undef XNZ_THOUT_AT
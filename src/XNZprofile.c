@@ -0,0 +1,412 @@
+/*
+ * XNZprofile.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if IBM
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "XNZprofile.h"
+
+#define XNZ_PROFILE_TEXT_MAX (64 * 1024)
+
+static int profile_error(char *err, size_t errlen, const char *path, int line, const char *what)
+{
+    if (err && errlen)
+    {
+        if (line > 0)
+        {
+            snprintf(err, errlen, "%s:%d: %s", path, line, what);
+        }
+        else
+        {
+            snprintf(err, errlen, "%s: %s", path, what);
+        }
+    }
+    return -1;
+}
+
+static int parse_floats(char *s, float *out, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        char *end; out[i] = strtof(s, &end);
+        if (end == s || !isfinite(out[i])) // range checks below don't catch NaN
+        {
+            return -1;
+        }
+        s = end;
+    }
+    while (isspace((unsigned char)*s))
+    {
+        s++;
+    }
+    return *s ? -1 : 0;
+}
+
+static int parse_curve(char *s, xnz_curve *c, float min, float max)
+{
+    memset(c, 0, sizeof(*c));
+    while (1)
+    {
+        while (isspace((unsigned char)*s))
+        {
+            s++;
+        }
+        if (*s == '\0')
+        {
+            break;
+        }
+        if (c->count >= XNZ_CURVE_POINTS)
+        {
+            return -1;
+        }
+        char *end; c->x[c->count] = strtof(s, &end);
+        if (end == s || *end != ':' || !isfinite(c->x[c->count]))
+        {
+            return -1;
+        }
+        s = end + 1; c->y[c->count] = strtof(s, &end);
+        if (end == s || !isfinite(c->y[c->count]))
+        {
+            return -1;
+        }
+        if (c->count && c->x[c->count] <= c->x[c->count - 1])
+        {
+            return -1;
+        }
+        if (c->y[c->count] < min || c->y[c->count] > max)
+        {
+            return -1;
+        }
+        s = end; c->count++;
+    }
+    return c->count ? 0 : -1;
+}
+
+static int parse_line(char *line, xnz_profile *p)
+{
+    char *key = line, *val;
+    if (NULL == (val = strchr(line, '=')))
+    {
+        return -1;
+    }
+    *val++ = '\0';
+    for (size_t len = strlen(key); len && isspace((unsigned char)key[len - 1]); len--)
+    {
+        key[len - 1] = '\0';
+    }
+    if (!strcmp(key, "detents"))
+    {
+        if (parse_floats(val, p->detent, 3))
+        {
+            return -1;
+        }
+        /* every zone between (and outside) the deadbands must be non-empty */
+        if (p->detent[0] < XNZ_DETENT_DEADBAND ||
+            p->detent[1] - p->detent[0] < XNZ_DETENT_DEADBAND * 2.0f ||
+            p->detent[2] - p->detent[1] < XNZ_DETENT_DEADBAND * 2.0f ||
+            1.0f - p->detent[2] < XNZ_DETENT_DEADBAND)
+        {
+            return -2;
+        }
+        p->flags |= XNZ_PROFILE_DETENTS;
+        return 0;
+    }
+    if (!strcmp(key, "shares"))
+    {
+        if (parse_floats(val, p->share, 3) ||
+            p->share[0] <= 0.0f || p->share[0] > p->share[1] ||
+            p->share[1] > p->share[2] || p->share[2] > 1.0f)
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_SHARES;
+        return 0;
+    }
+    if (!strcmp(key, "brakes"))
+    {
+        if (parse_floats(val, p->brake, 3) ||
+            p->brake[0] < 0.0f || p->brake[0] > 1.0f ||
+            p->brake[1] < 0.0f || p->brake[1] > 1.0f ||
+            p->brake[2] < 0.0f || p->brake[2] > 1.0f)
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_BRAKES;
+        return 0;
+    }
+    if (!strcmp(key, "decel"))
+    {
+        if (parse_floats(val, p->decel, 3) ||
+            p->decel[0] <= 0.0f || p->decel[0] > 10.0f ||
+            p->decel[1] <= 0.0f || p->decel[1] > 10.0f ||
+            p->decel[2] <= 0.0f || p->decel[2] > 10.0f)
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_DECEL;
+        return 0;
+    }
+    if (!strcmp(key, "nullzone_pitch_roll"))
+    {
+        if (parse_curve(val, &p->nullzone[0], 0.0f, 1.0f))
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_NZ_PR;
+        return 0;
+    }
+    if (!strcmp(key, "nullzone_yaw_tiller"))
+    {
+        if (parse_curve(val, &p->nullzone[1], 0.0f, 1.0f))
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_NZ_YT;
+        return 0;
+    }
+    if (!strcmp(key, "roll_coef_delta"))
+    {
+        if (parse_curve(val, &p->roll, -1.0f, 1.0f))
+        {
+            return -1;
+        }
+        p->flags |= XNZ_PROFILE_ROLL;
+        return 0;
+    }
+    return -1;
+}
+
+static int profile_compile(const char *path, const struct stat *st, xnz_profile *p, char *err, size_t errlen)
+{
+    FILE *f; char *text; size_t size; int ret;
+    if (st->st_size > XNZ_PROFILE_TEXT_MAX)
+    {
+        return profile_error(err, errlen, path, 0, "file too large");
+    }
+    if (NULL == (f = fopen(path, "rb")))
+    {
+        return profile_error(err, errlen, path, 0, "could not open file");
+    }
+    if (NULL == (text = malloc(st->st_size + 1)))
+    {
+        fclose(f); return profile_error(err, errlen, path, 0, "out of memory");
+    }
+    size = fread(text, 1, st->st_size, f); text[size] = '\0'; fclose(f);
+
+    memset(p, 0, sizeof(*p));
+    p->magic = XNZ_PROFILE_MAGIC;
+    p->version = XNZ_PROFILE_VERSION;
+    p->size = sizeof(xnz_profile);
+    p->src_size = st->st_size;
+    p->src_mtime = st->st_mtime;
+    char *line = text;
+    for (int number = 1; line; number++)
+    {
+        char *next = strchr(line, '\n'), *hash;
+        if (next)
+        {
+            *next++ = '\0';
+        }
+        if ((hash = strchr(line, '#')))
+        {
+            *hash = '\0';
+        }
+        while (isspace((unsigned char)*line))
+        {
+            line++;
+        }
+        if (*line && (ret = parse_line(line, p)))
+        {
+            free(text); return profile_error(err, errlen, path, number, ret == -2 ? "detents too close to each other or to the lever's ends" : "invalid or unknown setting");
+        }
+        line = next;
+    }
+    free(text);
+    return 0;
+}
+
+static int profile_valid(const void *base, size_t size, const struct stat *st)
+{
+    const xnz_profile *p = base;
+    return (size == sizeof(xnz_profile) &&
+            p->magic == XNZ_PROFILE_MAGIC &&
+            p->version == XNZ_PROFILE_VERSION &&
+            p->size == sizeof(xnz_profile) &&
+            p->src_size == (int64_t)st->st_size &&
+            p->src_mtime == (int64_t)st->st_mtime);
+}
+
+static int profile_write(const char *path, const xnz_profile *p)
+{
+    char temp[1024 + 4]; FILE *f;
+    snprintf(temp, sizeof(temp), "%s.tmp", path);
+    if (NULL == (f = fopen(temp, "wb")))
+    {
+        return -1;
+    }
+    if (fwrite(p, sizeof(*p), 1, f) != 1)
+    {
+        fclose(f); remove(temp); return -1;
+    }
+    fclose(f);
+#if IBM
+    remove(path); // rename does not replace existing files on Windows
+#endif
+    if (rename(temp, path))
+    {
+        remove(temp); return -1;
+    }
+    return 0;
+}
+
+static int profile_map(xnz_profile_map *map, const char *path)
+{
+#if IBM
+    HANDLE file, mapping; LARGE_INTEGER size;
+    if (INVALID_HANDLE_VALUE == (file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)))
+    {
+        return -1;
+    }
+    if (!GetFileSizeEx(file, &size) || size.QuadPart != sizeof(xnz_profile))
+    {
+        CloseHandle(file); return -1;
+    }
+    if (NULL == (mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL)))
+    {
+        CloseHandle(file); return -1;
+    }
+    map->base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); CloseHandle(file); // the view keeps the mapping alive
+    if (NULL == map->base)
+    {
+        return -1;
+    }
+#else
+    FILE *f; struct stat st; void *base;
+    if (NULL == (f = fopen(path, "rb")))
+    {
+        return -1;
+    }
+    if (fstat(fileno(f), &st) || st.st_size != sizeof(xnz_profile))
+    {
+        fclose(f); return -1;
+    }
+    base = mmap(NULL, sizeof(xnz_profile), PROT_READ, MAP_PRIVATE, fileno(f), 0);
+    fclose(f); // the mapping outlives the descriptor
+    if (MAP_FAILED == base)
+    {
+        return -1;
+    }
+    map->base = base;
+#endif
+    map->size = sizeof(xnz_profile);
+    map->mapped = 1;
+    return 0;
+}
+
+void xnz_profile_close(xnz_profile_map *map)
+{
+    if (map && map->base)
+    {
+        if (map->mapped)
+        {
+#if IBM
+            UnmapViewOfFile(map->base);
+#else
+            munmap(map->base, map->size);
+#endif
+        }
+        else
+        {
+            free(map->base);
+        }
+    }
+    if (map)
+    {
+        memset(map, 0, sizeof(*map));
+    }
+}
+
+void xnz_lut_bake(xnz_lut *lut, const xnz_curve *c)
+{
+    float span = c->x[c->count - 1] - c->x[0];
+    lut->x0 = c->x[0];
+    lut->scale = span > 0.0f ? (float)(XNZ_LUT_POINTS - 1) / span : 0.0f;
+    for (int i = 0; i < XNZ_LUT_POINTS; i++)
+    {
+        lut->y[i] = xnz_curve_eval(c, c->x[0] + span * ((float)i / (float)(XNZ_LUT_POINTS - 1)));
+    }
+}
+
+int xnz_profile_open(xnz_profile_map *map, const char *dir, const char *name, char *err, size_t errlen)
+{
+    char src[1024], bin[1024]; struct stat st; xnz_profile p;
+    memset(map, 0, sizeof(*map));
+    snprintf(src, sizeof(src), "%s%s.txt", dir, name);
+    snprintf(bin, sizeof(bin), "%s%s.xnzp", dir, name);
+    if (stat(src, &st))
+    {
+        return 1;
+    }
+    if (0 == profile_map(map, bin))
+    {
+        if (profile_valid(map->base, map->size, &st))
+        {
+            map->profile = map->base;
+            return 0;
+        }
+        xnz_profile_close(map); // stale or outdated: recompile
+    }
+    if (profile_compile(src, &st, &p, err, errlen))
+    {
+        return -1;
+    }
+    if (0 == profile_write(bin, &p) && 0 == profile_map(map, bin))
+    {
+        if (profile_valid(map->base, map->size, &st))
+        {
+            map->profile = map->base;
+            return 0;
+        }
+        xnz_profile_close(map);
+    }
+    if (NULL == (map->base = malloc(sizeof(p)))) // can't write or map blob: use it from the heap
+    {
+        return profile_error(err, errlen, src, 0, "out of memory");
+    }
+    memcpy(map->base, &p, sizeof(p));
+    map->size = sizeof(p);
+    map->profile = map->base;
+    return 0;
+}
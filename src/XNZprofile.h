@@ -0,0 +1,153 @@
+/*
+ * XNZprofile.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_PROFILE_H
+#define XNZ_PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Per-aircraft profiles: human-editable text files (<name>.txt), compiled on
+ * first use into a versioned binary blob (<name>.xnzp) next to the source;
+ * later sessions map the blob and use it in place (no parsing, no allocation)
+ * for as long as the source file's size and modification time are unchanged.
+ *
+ * Text format: one "key = values" per line, '#' starts a comment:
+ *
+ *   detents = 0.311589 0.520279 0.706744  # idle, climb, flex (lever position)
+ *   shares  = 0.500 0.875 1.000           # cumulative climb, flex, TOGA thrust
+ *   brakes  = 0.3 0.6 0.9                 # low, medium, high speed brake ratio
+ *   decel   = 1.0 2.0 3.0                 # low, medium, high speed target deceleration (m/s²)
+ *   nullzone_pitch_roll = 50:0.125 62.5:0.04  # indicated airspeed (kts):nullzone
+ *   nullzone_yaw_tiller = 3.125:0.25 31.25:0.04  # groundspeed (kts):nullzone
+ *   roll_coef_delta = 2.5:0 26.25:0.025 50:0  # groundspeed (kts):added ground roll friction (X-Plane 10)
+ *
+ * Only the keys present in the file override the built-in values; values must
+ * be finite. tools/xnz_profile checks a profile without X-Plane.
+ */
+#define XNZ_PROFILE_MAGIC   0x504E5A58u // "XZNP"
+#define XNZ_PROFILE_VERSION 5
+#define XNZ_CURVE_POINTS    8
+#define XNZ_LUT_POINTS      65
+#define XNZ_DETENT_DEADBAND 0.0375f // either side of each detent (TCA_DEADBAND)
+
+enum
+{
+    XNZ_PROFILE_DETENTS = 1 << 0,
+    XNZ_PROFILE_SHARES  = 1 << 1,
+    XNZ_PROFILE_BRAKES  = 1 << 2,
+    XNZ_PROFILE_NZ_PR   = 1 << 3,
+    XNZ_PROFILE_NZ_YT   = 1 << 4,
+    XNZ_PROFILE_DECEL   = 1 << 5,
+    XNZ_PROFILE_ROLL    = 1 << 6,
+};
+
+/*
+ * Piecewise-linear breakpoint curve (x strictly ascending), clamped at both ends.
+ */
+typedef struct
+{
+    uint32_t count;
+    float x[XNZ_CURVE_POINTS];
+    float y[XNZ_CURVE_POINTS];
+}
+xnz_curve;
+
+/*
+ * A curve resampled at XNZ_LUT_POINTS evenly-spaced speeds (first to last
+ * breakpoint), for evaluation in constant time; clamped at both ends.
+ */
+typedef struct
+{
+    float x0; // first breakpoint
+    float scale; // (XNZ_LUT_POINTS - 1) / (last - first breakpoint); zero: constant
+    float y[XNZ_LUT_POINTS];
+}
+xnz_lut;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // sizeof(xnz_profile)
+    uint32_t flags; // XNZ_PROFILE_*: fields set in the source file
+    int64_t src_size;
+    int64_t src_mtime;
+    float detent[3]; // idle, climb, flex detent centers
+    float share[3]; // cumulative climb, flex, TOGA thrust share
+    float brake[3]; // brake ratio by speed range (low, medium, high)
+    float decel[3]; // target deceleration (m/s²) by speed range (low, medium, high)
+    float reserved[2];
+    xnz_curve nullzone[2]; // pitch/roll vs. airspeed, yaw/tiller vs. groundspeed
+    xnz_curve roll; // ground roll friction increment vs. groundspeed
+}
+xnz_profile;
+
+typedef struct
+{
+    const xnz_profile *profile; // NULL: no profile for this aircraft
+    void *base;
+    size_t size;
+    int mapped; // zero: heap copy (blob could not be written or mapped)
+}
+xnz_profile_map;
+
+/*
+ * Open (compiling first, if required) profile <dir><name>.txt; dir must end
+ * with a directory separator. Returns 0 on success, 1 if there is no profile,
+ * -1 on error (with a message in err).
+ */
+int  xnz_profile_open(xnz_profile_map *map, const char *dir, const char *name, char *err, size_t errlen);
+void xnz_profile_close(xnz_profile_map *map);
+void xnz_lut_bake(xnz_lut *lut, const xnz_curve *c);
+
+static inline float xnz_curve_eval(const xnz_curve *c, float x)
+{
+    if (x <= c->x[0])
+    {
+        return c->y[0];
+    }
+    for (uint32_t i = 1; i < c->count; i++)
+    {
+        if (x < c->x[i])
+        {
+            return c->y[i - 1] + (c->y[i] - c->y[i - 1]) * ((x - c->x[i - 1]) / (c->x[i] - c->x[i - 1]));
+        }
+    }
+    return c->y[c->count - 1];
+}
+
+static inline float xnz_lut_eval(const xnz_lut *lut, float x)
+{
+    float f = (x - lut->x0) * lut->scale;
+    if (!(f > 0.0f)) // NaN too
+    {
+        return lut->y[0];
+    }
+    if (f >= (float)(XNZ_LUT_POINTS - 1))
+    {
+        return lut->y[XNZ_LUT_POINTS - 1];
+    }
+    int i = (int)f;
+    return lut->y[i] + (lut->y[i + 1] - lut->y[i]) * (f - (float)i);
+}
+
+#endif /* XNZ_PROFILE_H */
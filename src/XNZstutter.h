@@ -0,0 +1,72 @@
+/*
+ * XNZstutter.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_STUTTER_H
+#define XNZ_STUTTER_H
+
+#include <stdint.h>
+
+/*
+ * Stutter detection: frame periods are compared with a running average of
+ * the normal frames; a frame at least XNZ_STUTTER_FACTOR times the average,
+ * and XNZ_STUTTER_MIN_NS longer, is a stutter. A sustained change of the
+ * frame rate (heavier scenery, weather) is not: after XNZ_STUTTER_REBASE
+ * consecutive long frames, the average restarts from the current period.
+ * tools/xnz_stutter.c runs the same detector over axis traces.
+ */
+#define XNZ_STUTTER_FACTOR  (2.0)
+#define XNZ_STUTTER_MIN_NS  (10000000ull)
+#define XNZ_STUTTER_WARMUP  (64) // frames before the average is trusted
+#define XNZ_STUTTER_REBASE  (8) // consecutive long frames: new frame rate
+
+typedef struct
+{
+    double average; // normal frame period (ns)
+    uint32_t frames; // periods seen
+    uint32_t run; // consecutive long frames
+}
+xnz_stutter_baseline;
+
+/*
+ * Account for one frame period (ns); returns non-zero for a stutter.
+ */
+static inline int xnz_stutter_check(xnz_stutter_baseline *b, double period)
+{
+    double average = b->average;
+    int stutter = (b->frames >= XNZ_STUTTER_WARMUP &&
+                   period >= average * XNZ_STUTTER_FACTOR &&
+                   period >= average + XNZ_STUTTER_MIN_NS);
+    b->frames++;
+    if (stutter == 0)
+    {
+        b->run = 0;
+        b->average += (period - average) / (b->frames < 32 ? b->frames : 32);
+        return 0;
+    }
+    if (++b->run >= XNZ_STUTTER_REBASE)
+    {
+        b->run = 0;
+        b->average = period;
+        return 0;
+    }
+    return 1;
+}
+
+#endif /* XNZ_STUTTER_H */
@@ -0,0 +1,143 @@
+/*
+ * XNZtelemetry.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_TELEMETRY_H
+#define XNZ_TELEMETRY_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "XNZplatform.h"
+
+/*
+ * Telemetry: the axis flight loop publishes one frame per tick into a ring in
+ * named shared memory (see xnz_shm), for home cockpit controllers, dashboards
+ * and other local processes, which map it read-only and read the latest frame
+ * or the history directly (no copies but their own, no system calls).
+ *
+ * Each frame has its own sequence lock: odd while being written. The writer
+ * never waits for readers; a reader copies the frame, then checks that the
+ * sequence is even and unchanged, and that the frame is the one it wanted
+ * (the ring may have wrapped), else tries again or gives up.
+ *
+ * Segment names: x-nullzones.telemetry (Quadrant314.telemetry in public
+ * builds); "/name" for shm_open, "Local\name" on Windows.
+ */
+#define XNZ_TELEMETRY_NAME        "x-nullzones.telemetry"
+#define XNZ_TELEMETRY_NAME_PUBLIC "Quadrant314.telemetry"
+#define XNZ_TELEMETRY_MAGIC   0x535A4E58u // "XNZS"
+#define XNZ_TELEMETRY_VERSION 1
+#define XNZ_TELEMETRY_FRAMES  256 // power of two (~12 seconds at 20 Hz)
+
+enum
+{
+    XNZ_TELEMETRY_BACKEND_TT, // xnz_tt (throttle)
+    XNZ_TELEMETRY_BACKEND_AB, // xnz_ab (autobrake)
+    XNZ_TELEMETRY_BACKEND_AP, // xnz_ap (autopilot)
+    XNZ_TELEMETRY_BACKEND_AT, // xnz_at (autothrottle)
+    XNZ_TELEMETRY_BACKEND_BT, // xnz_bt (regular brakes)
+    XNZ_TELEMETRY_BACKEND_ET, // xnz_et (engines)
+    XNZ_TELEMETRY_BACKEND_PB, // xnz_pb (parking brake)
+    XNZ_TELEMETRY_BACKEND_SB, // xnz_sb (speedbrake)
+    XNZ_TELEMETRY_BACKEND_COUNT,
+};
+
+typedef struct // 128 bytes
+{
+    uint32_t sequence; // sequence lock (odd: being written)
+    uint32_t index; // position in the stream (the header's head when written)
+    uint64_t time; // monotonic clock (ns), same origin as the plugin's traces
+    float lever_inn[2]; // raw levers (0: idle/aft, 1: forward)
+    float engine_out[8]; // throttle ratios written (negative: reverse)
+    int32_t lever_zone[2]; // -1: none
+    int32_t pipeline; // pipeline state (xnz/throttle/pipeline/state)
+    int32_t generation; // xnz/throttle/generation
+    float throttle_inn; // average lever (negative: no input)
+    float throttle_out; // average throttle ratio (negative: autothrottle or skipped)
+    float brake_output; // regular brake hold controller output (ratio)
+    float brake_decel; // measured deceleration (m/s²)
+    float nullzone[2]; // pitch/roll, yaw/tiller (negative: not scheduled)
+    int16_t backend[XNZ_TELEMETRY_BACKEND_COUNT];
+    uint8_t reserved[16];
+}
+xnz_telemetry_frame;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frame_size; // sizeof(xnz_telemetry_frame)
+    uint32_t frame_count; // XNZ_TELEMETRY_FRAMES
+    uint32_t live; // zero once the writer has stopped
+    uint32_t reserved;
+    uint64_t started; // monotonic clock (ns)
+    uint8_t padding[32];
+    uint32_t head; // frames written so far (the latest is head - 1); own cache line
+    uint8_t padding_head[60];
+    xnz_telemetry_frame frame[XNZ_TELEMETRY_FRAMES];
+}
+xnz_telemetry;
+
+/*
+ * Reader side: copy frame number index (not position) to out; returns 0 on
+ * success, -1 if that frame was overwritten, or is not written yet.
+ */
+static inline int xnz_telemetry_read(const xnz_telemetry *t, uint32_t index, xnz_telemetry_frame *out)
+{
+    const xnz_telemetry_frame *f = &t->frame[index & (XNZ_TELEMETRY_FRAMES - 1)];
+    for (int attempt = 0; attempt < 64; attempt++)
+    {
+        uint32_t before = xnz_atomic_load_u32(&f->sequence);
+        if (before & 1)
+        {
+            continue; // being written
+        }
+        memcpy(out, (const void*)f, sizeof(*out));
+        xnz_atomic_fence();
+        if (xnz_atomic_load_u32(&f->sequence) == before)
+        {
+            return out->index == index && before ? 0 : -1;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Reader side: copy the latest frame to out; returns 0 on success, -1 if
+ * nothing was written yet.
+ */
+static inline int xnz_telemetry_latest(const xnz_telemetry *t, xnz_telemetry_frame *out)
+{
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        uint32_t head = xnz_atomic_load_u32(&t->head);
+        if (head == 0)
+        {
+            return -1;
+        }
+        if (xnz_telemetry_read(t, head - 1, out) == 0)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+#endif /* XNZ_TELEMETRY_H */
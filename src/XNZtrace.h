@@ -0,0 +1,125 @@
+/*
+ * XNZtrace.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+#ifndef XNZ_TRACE_H
+#define XNZ_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Axis pipeline trace: one fixed-size record per throttle_axes() tick, pushed
+ * by the flight loop into a single-producer ring and streamed by a writer
+ * thread to <preferences>/x-nullzones.trace (Quadrant314.trace in public
+ * builds) while recording, which the xnz/trace/axes/toggle command starts and
+ * stops. tools/xnz_trace.c decodes a trace.
+ *
+ * File layout (host byte order):
+ *
+ *   xnz_trace_header
+ *   encoded records, oldest first, until end of file
+ *
+ * Each record is XOR'd with the previous one (the first with zeroes), then
+ * stored as a 64-bit mask of its non-zero bytes followed by those bytes, so
+ * that fields unchanged since the previous tick take no space at all.
+ * Records dropped while the ring was full show as gaps in the sequence.
+ */
+#define XNZ_TRACE_MAGIC   0x545A4E58u // "XNZT"
+#define XNZ_TRACE_VERSION 1
+#define XNZ_TRACE_ENCODED_MAX (sizeof(uint64_t) + sizeof(xnz_trace_record))
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size; // sizeof(xnz_trace_record)
+    uint32_t reserved;
+    uint64_t started; // monotonic clock (ns) when recording started, same origin as record.time
+}
+xnz_trace_header;
+
+typedef struct // 64 bytes: one bit per byte in the encoded mask
+{
+    uint64_t time; // monotonic clock (ns)
+    uint32_t sequence; // tick number since recording started
+    float raw[2]; // f_stick_val as read (0: lever forward)
+    float sync[2]; // after lever synchronization (zero: pipeline stopped earlier)
+    float mapped[2]; // after throttle mapping, negative: reverse (zero: pipeline stopped earlier)
+    float written[2]; // engine_out[0..1] (last values written)
+    int16_t tt; // xnz_tt
+    int16_t et; // xnz_et
+    int8_t zone[2]; // lever_zone
+    int8_t propmode[8]; // i_propmode_value
+    uint8_t pipeline; // pipeline_st
+    uint8_t skip; // skip_idle_overwrite counter (saturated)
+    uint8_t commands; // beta/reverse toggle commands fired
+    uint8_t reserved[3];
+}
+xnz_trace_record;
+
+/*
+ * Encode cur relative to prev into out (at most XNZ_TRACE_ENCODED_MAX bytes);
+ * returns the number of bytes written.
+ */
+static inline size_t xnz_trace_encode(const xnz_trace_record *prev, const xnz_trace_record *cur, uint8_t *out)
+{
+    const uint8_t *p = (const uint8_t*)prev, *c = (const uint8_t*)cur;
+    uint8_t *o = out + sizeof(uint64_t); uint64_t mask = 0;
+    for (size_t i = 0; i < sizeof(xnz_trace_record); i++)
+    {
+        uint8_t x = p[i] ^ c[i];
+        if (x)
+        {
+            mask |= (uint64_t)1 << i;
+            *o++ = x;
+        }
+    }
+    memcpy(out, &mask, sizeof(mask));
+    return o - out;
+}
+
+/*
+ * Decode one record from in (avail bytes) into cur, which holds the previous
+ * record on entry; returns the number of bytes consumed, or 0 if truncated.
+ */
+static inline size_t xnz_trace_decode(xnz_trace_record *cur, const uint8_t *in, size_t avail)
+{
+    uint8_t *c = (uint8_t*)cur; const uint8_t *i = in + sizeof(uint64_t); uint64_t mask;
+    if (avail < sizeof(mask))
+    {
+        return 0;
+    }
+    memcpy(&mask, in, sizeof(mask));
+    for (size_t b = 0; b < sizeof(xnz_trace_record); b++)
+    {
+        if (mask & ((uint64_t)1 << b))
+        {
+            if ((size_t)(i - in) >= avail)
+            {
+                return 0;
+            }
+            c[b] ^= *i++;
+        }
+    }
+    return i - in;
+}
+
+#endif /* XNZ_TRACE_H */
@@ -0,0 +1,167 @@
+/*
+ * xnz_bench.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Context layout benchmark: builds the plugin source against stub XPLM
+ * functions (datarefs are plain arrays), sets up a two-engine X-Plane
+ * aircraft and runs the per-frame flight loops with a moving lever:
+ *
+ *   xnz_bench [frames]
+ *
+ * Prints the size of the hot and cold contexts, the cache lines of each
+ * written per frame (a snapshot diff, so lines only read don't show), and
+ * the time per frame with warm caches and after evicting them, the latter
+ * being closer to X-Plane where a frame's worth of other work runs between
+ * two of our callbacks. Timings are medians; compare builds of the same
+ * tree on the same machine only.
+ */
+
+#include "XNZplugin.c"
+#include "xnz_stubs.h"
+
+#define BENCH_EVICT (32 * 1024 * 1024) // larger than the last level cache
+
+static xnz_context* bench_context(void)
+{
+    xnz_context *ctx;
+    if (NULL == (ctx = xnz_aligned_calloc(sizeof(xnz_context))) ||
+        NULL == (ctx->cold = calloc(1, sizeof(xnz_cold_context))))
+    {
+        return NULL;
+    }
+#ifndef PUBLIC_RELEASE_BUILD
+    if (NULL == (ctx->cold->perf.handler = calloc(sizeof(xnz_init_cmds) / sizeof(xnz_init_cmds[0]), sizeof(*ctx->cold->perf.handler))))
+    {
+        return NULL;
+    }
+    ctx->f_air_speed = XPLMFindDataRef("sim/flightmodel/position/indicated_airspeed");
+    ctx->f_grd_speed = XPLMFindDataRef("sim/flightmodel/position/groundspeed");
+    ctx->nullzone[0] = XPLMFindDataRef("sim/joystick/joystick_pitch_nullzone");
+    ctx->nullzone[1] = XPLMFindDataRef("sim/joystick/joystick_roll_nullzone");
+    ctx->nullzone[2] = XPLMFindDataRef("sim/joystick/joystick_heading_nullzone");
+    ctx->acf_roll_co = XPLMFindDataRef("sim/aircraft/overflow/acf_roll_co");
+    ctx->ongroundany = XPLMFindDataRef("sim/flightmodel/failures/onground_any");
+    xnz_sched_invalidate(ctx);
+#endif
+    ctx->f_stick_val = XPLMFindDataRef("sim/joystick/joystick_axis_values");
+    ctx->f_throttall = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio_all");
+    ctx->f_thr_array = XPLMFindDataRef("sim/cockpit2/engine/actuators/throttle_ratio");
+    ctx->i_prop_mode = XPLMFindDataRef("sim/cockpit2/engine/actuators/prop_mode");
+    ctx->auto_thr_on = XPLMFindDataRef("sim/cockpit2/autopilot/autothrottle_on");
+    ctx->auto_pil_on = XPLMFindDataRef("sim/cockpit2/autopilot/servos_on");
+    ctx->tca_support_enabled = 1;
+    ctx->idx_throttle_axis_1 = 0;
+    ctx->arcrft_engine_count = 2;
+    ctx->i_version_simulator = 11550;
+    ctx->xnz_tt = XNZ_TT_XPLM;
+    update_thrust_zones(&ctx->cold->zones_base, TCA_IDLE_CTR, TCA_CLMB_CTR, TCA_FLEX_CTR);
+    default_throt_share(&ctx->cold->zones_base);
+    if (NULL == (ctx->params = xnz_params_create(&ctx->cold->zones_base, 0, NULL)))
+    {
+        return NULL;
+    }
+    return ctx;
+}
+
+static void bench_frame(xnz_context *ctx, int frame)
+{
+    xnz_stub_ref *stick = ctx->f_stick_val;
+    stick->f[0] = stick->f[1] = 0.5f + 0.45f * sinf((float)frame * 0.05f); // lever moving through the detents
+    axes_hdlr_fnc(0.05f, 0.05f, frame, ctx);
+#ifndef PUBLIC_RELEASE_BUILD
+    callback_hdlr(0.05f, 0.05f, frame, ctx);
+#endif
+}
+
+static int bench_lines(const void *a, const void *b, size_t size)
+{
+    int lines = 0;
+    for (size_t offset = 0; offset < size; offset += XNZ_CACHELINE_SIZE)
+    {
+        size_t length = size - offset < XNZ_CACHELINE_SIZE ? size - offset : XNZ_CACHELINE_SIZE;
+        lines += memcmp((const char*)a + offset, (const char*)b + offset, length) != 0;
+    }
+    return lines;
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+    return (*(const uint64_t*)a > *(const uint64_t*)b) - (*(const uint64_t*)a < *(const uint64_t*)b);
+}
+
+static uint64_t bench_median(uint64_t *ns, int count)
+{
+    qsort(ns, count, sizeof(*ns), &bench_compare);
+    return ns[count / 2];
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 500, frame = 0, hot_lines = 0, cold_lines = 0;
+    xnz_context *ctx, *hot; xnz_cold_context *cold; uint64_t *ns; volatile uint8_t *evict;
+    if (frames < 1 ||
+        NULL == (ctx = bench_context()) ||
+        NULL == (hot = malloc(sizeof(xnz_context))) ||
+        NULL == (cold = malloc(sizeof(xnz_cold_context))) ||
+        NULL == (ns = calloc(frames, sizeof(*ns))) ||
+        NULL == (evict = malloc(BENCH_EVICT)))
+    {
+        fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+    for (int i = 0; i < 100; i++) // past the first-frame paths
+    {
+        bench_frame(ctx, frame++);
+    }
+
+    for (int i = 0; i < frames; i++)
+    {
+        memcpy(hot, ctx, sizeof(xnz_context));
+        memcpy(cold, ctx->cold, sizeof(xnz_cold_context));
+        bench_frame(ctx, frame++);
+        hot_lines += bench_lines(hot, ctx, sizeof(xnz_context));
+        cold_lines += bench_lines(cold, ctx->cold, sizeof(xnz_cold_context));
+    }
+    printf("xnz_context:      %5zu bytes, %3zu lines, %5.2f lines written per frame\n",
+           sizeof(xnz_context), (sizeof(xnz_context) + XNZ_CACHELINE_SIZE - 1) / XNZ_CACHELINE_SIZE, (double)hot_lines / frames);
+    printf("xnz_cold_context: %5zu bytes, %3zu lines, %5.2f lines written per frame\n",
+           sizeof(xnz_cold_context), (sizeof(xnz_cold_context) + XNZ_CACHELINE_SIZE - 1) / XNZ_CACHELINE_SIZE, (double)cold_lines / frames);
+
+    for (int i = 0; i < frames; i++)
+    {
+        uint64_t t = xnz_time_ns();
+        bench_frame(ctx, frame++);
+        ns[i] = xnz_time_ns() - t;
+    }
+    printf("frame, warm caches:    %6.3f us (median of %d)\n", (double)bench_median(ns, frames) / 1000.0, frames);
+
+    for (int i = 0; i < frames; i++)
+    {
+        for (size_t offset = 0; offset < BENCH_EVICT; offset += XNZ_CACHELINE_SIZE)
+        {
+            evict[offset]++;
+        }
+        uint64_t t = xnz_time_ns();
+        bench_frame(ctx, frame++);
+        ns[i] = xnz_time_ns() - t;
+    }
+    printf("frame, evicted caches: %6.3f us (median of %d)\n", (double)bench_median(ns, frames) / 1000.0, frames);
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * xnz_command.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Command ingress client (see src/XNZingress.h):
+ *
+ *   xnz_command [-q] -list                    commands the plugin accepts
+ *   xnz_command [-q] <command> [begin|end|once] (default: once)
+ *   xnz_command -selftest                     exercise the ring without X-Plane
+ *
+ * -q: Quadrant314 (public build) segment.
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "XNZingress.h"
+
+#if IBM
+#define client_id() ((uint32_t)GetCurrentProcessId())
+#else
+#define client_id() ((uint32_t)getpid())
+#endif
+
+#define SELFTEST_PRODUCERS 4
+#define SELFTEST_REQUESTS  20000 // per producer
+
+typedef struct
+{
+    xnz_ingress *q;
+    uint32_t producer;
+    uint32_t full; // ring full (retried)
+}
+selftest_producer;
+
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL selftest_produce(void *arg)
+{
+    selftest_producer *p = arg;
+    for (uint32_t i = 0; i < SELFTEST_REQUESTS; i++)
+    {
+        while (xnz_ingress_push(p->q, (uint16_t)p->producer, XNZ_INGRESS_ONCE, (float)i, i))
+        {
+            p->full++;
+            xnz_sleep_ms(1); // let the consumer catch up
+        }
+    }
+    return 0;
+}
+
+/*
+ * Several producer threads against one consumer, in a private segment: every
+ * request must arrive exactly once, in order per producer.
+ */
+static int selftest(void)
+{
+    char name[64]; xnz_shm shm; xnz_ingress_slot r; int ret = 0;
+    selftest_producer p[SELFTEST_PRODUCERS]; xnz_thread t[SELFTEST_PRODUCERS];
+    uint32_t next[SELFTEST_PRODUCERS] = { 0, }, received = 0, full = 0;
+    snprintf(name, sizeof(name), "xnz.selftest.%u", client_id());
+    if (xnz_shm_create(&shm, name, sizeof(xnz_ingress)))
+    {
+        fprintf(stderr, "selftest: could not create shared memory\n");
+        return 1;
+    }
+    xnz_ingress_init(shm.base);
+    uint64_t start = xnz_time_ns();
+    for (uint32_t i = 0; i < SELFTEST_PRODUCERS; i++)
+    {
+        p[i].q = shm.base; p[i].producer = i; p[i].full = 0;
+        if (xnz_thread_create(&t[i], &selftest_produce, &p[i]))
+        {
+            fprintf(stderr, "selftest: could not start thread\n");
+            xnz_shm_destroy(&shm); return 1;
+        }
+    }
+    while (received < SELFTEST_PRODUCERS * SELFTEST_REQUESTS)
+    {
+        if (xnz_ingress_pop(shm.base, &r) == 0)
+        {
+            continue;
+        }
+        if (r.command >= SELFTEST_PRODUCERS || r.client != next[r.command] || r.argument != (float)r.client)
+        {
+            fprintf(stderr, "selftest: unexpected request %u from producer %u (expected %u)\n", r.client, r.command, r.command < SELFTEST_PRODUCERS ? next[r.command] : 0);
+            ret = 1;
+            break;
+        }
+        next[r.command]++;
+        received++;
+    }
+    for (uint32_t i = 0; i < SELFTEST_PRODUCERS; i++)
+    {
+        xnz_thread_join(t[i]); // ret != 0: producers may spin on a full ring
+        full += p[i].full;
+    }
+    printf("selftest: %s, %u requests in %.1f ms (%u times full)\n",
+           ret ? "FAILED" : "ok", received, (double)(xnz_time_ns() - start) / 1e6, full);
+    xnz_shm_destroy(&shm);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = XNZ_INGRESS_NAME; const char *command = NULL, *phase = "once";
+    int list = 0, id; uint8_t p = XNZ_INGRESS_ONCE; xnz_shm shm; xnz_ingress *q;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-selftest"))
+        {
+            return selftest();
+        }
+        if (!strcmp(argv[i], "-q"))
+        {
+            name = XNZ_INGRESS_NAME_PUBLIC;
+            continue;
+        }
+        if (!strcmp(argv[i], "-list"))
+        {
+            list = 1;
+            continue;
+        }
+        if (command == NULL)
+        {
+            command = argv[i];
+            continue;
+        }
+        phase = argv[i];
+    }
+    if (!strcmp(phase, "begin"))
+    {
+        p = XNZ_INGRESS_BEGIN;
+    }
+    else if (!strcmp(phase, "end"))
+    {
+        p = XNZ_INGRESS_END;
+    }
+    else if (!strcmp(phase, "once"))
+    {
+        p = XNZ_INGRESS_ONCE;
+    }
+    else
+    {
+        command = NULL;
+    }
+    if (list == 0 && command == NULL)
+    {
+        fprintf(stderr, "usage: %s [-q] -list | [-q] <command> [begin|end|once] | -selftest\n", argv[0]);
+        return 1;
+    }
+    if (xnz_shm_open(&shm, name, sizeof(xnz_ingress), 1))
+    {
+        fprintf(stderr, "%s: not available (is the plugin running?)\n", name);
+        return 1;
+    }
+    q = shm.base;
+    if (xnz_atomic_load_u32(&q->magic) != XNZ_INGRESS_MAGIC ||
+        q->version != XNZ_INGRESS_VERSION ||
+        q->slot_count != XNZ_INGRESS_SLOTS ||
+        xnz_atomic_load_u32(&q->live) == 0)
+    {
+        fprintf(stderr, "%s: not initialized, stopped, or unsupported version\n", name);
+        xnz_shm_close(&shm); return 1;
+    }
+    if (list)
+    {
+        for (uint32_t i = 0; i < q->command_count; i++)
+        {
+            printf("%3u %.*s\n", i, XNZ_INGRESS_NAME_MAX, q->names[i]);
+        }
+        xnz_shm_close(&shm); return 0;
+    }
+    if ((id = xnz_ingress_find(q, command)) < 0)
+    {
+        fprintf(stderr, "%s: unknown command (see -list)\n", command);
+        xnz_shm_close(&shm); return 1;
+    }
+    if (xnz_ingress_push(q, (uint16_t)id, p, 0.0f, client_id()))
+    {
+        fprintf(stderr, "%s: ring full\n", name);
+        xnz_shm_close(&shm); return 1;
+    }
+    xnz_shm_close(&shm);
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * xnz_evdev.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Direct TCA input test tool (see src/XNZevdev.h), Linux only:
+ *
+ *   xnz_evdev -record <device|auto> <file>  record lever events (until ^C)
+ *   xnz_evdev -read [device|auto|file]       print samples as the plugin gets them
+ *   xnz_evdev -uinput <file>                 replay a recording through a virtual
+ *                                            quadrant (/dev/uinput), which the
+ *                                            plugin finds like the real one
+ *   xnz_evdev -selftest                      exercise the mailbox and replay
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "XNZevdev.h"
+
+#if defined(__linux__)
+#include <linux/uinput.h>
+#include <signal.h>
+
+#define SELFTEST_SAMPLES 2000000
+
+static volatile sig_atomic_t interrupted;
+
+static void on_signal(int signal)
+{
+    (void)signal;
+    interrupted = 1;
+}
+
+static int record(const char *device, const char *path)
+{
+    xnz_evdev e; struct input_event in[64]; struct pollfd p; xnz_evdev_event ev;
+    uint64_t count = 0; ssize_t n; FILE *f;
+    if (xnz_evdev_open(&e, device) || e.replay)
+    {
+        fprintf(stderr, "%s: no TCA quadrant (device node expected)\n", device);
+        return 1;
+    }
+    if (NULL == (f = fopen(path, "wb")) || fwrite(&e.axes, sizeof(e.axes), 1, f) != 1)
+    {
+        fprintf(stderr, "%s: could not write\n", path);
+        close(e.fd);
+        if (f)
+        {
+            fclose(f);
+        }
+        return 1;
+    }
+    printf("recording \"%s\" (%s) to %s, ^C to stop\n", e.axes.name, e.path, path);
+    signal(SIGINT, &on_signal);
+    p.fd = e.fd; p.events = POLLIN;
+    while (interrupted == 0)
+    {
+        if (poll(&p, 1, XNZ_EVDEV_POLL) <= 0 || (p.revents & POLLIN) == 0)
+        {
+            if (p.revents & (POLLERR | POLLHUP))
+            {
+                break;
+            }
+            continue;
+        }
+        if ((n = read(e.fd, in, sizeof(in))) <= 0)
+        {
+            continue;
+        }
+        for (ssize_t i = 0; i < n / (ssize_t)sizeof(in[0]); i++)
+        {
+            ev.time = (uint64_t)in[i].input_event_sec * 1000000000ull + (uint64_t)in[i].input_event_usec * 1000ull;
+            ev.type = in[i].type;
+            ev.code = in[i].code;
+            ev.value = in[i].value;
+            count += fwrite(&ev, sizeof(ev), 1, f);
+        }
+    }
+    printf("%llu events\n", (unsigned long long)count);
+    close(e.fd);
+    return fclose(f) != 0;
+}
+
+static int read_samples(const char *path)
+{
+    xnz_evdev *e; xnz_evdev_sample s; uint32_t last = 0;
+    if (NULL == (e = xnz_aligned_calloc(sizeof(*e))))
+    {
+        return 1;
+    }
+    if (xnz_evdev_open(e, path) || xnz_evdev_start(e))
+    {
+        fprintf(stderr, "%s: no TCA quadrant or recording\n", path ? path : "auto");
+        xnz_aligned_free(e); return 1;
+    }
+    printf("reading \"%s\" (%s)%s, ^C to stop\n", e->axes.name, e->path, e->replay ? ", replay" : "");
+    signal(SIGINT, &on_signal);
+    while (interrupted == 0 && xnz_atomic_load_u32(&e->failed) == 0)
+    {
+        if (xnz_evdev_latest(&e->mailbox, &s) == 0 && s.count != last)
+        {
+            printf("%8u %.6f %.6f  age %.3f ms\n", s.count, s.value[0], s.value[1], (double)(int64_t)(xnz_time_ns() - s.time) / 1e6);
+            last = s.count;
+        }
+        xnz_sleep_ms(5);
+    }
+    xnz_evdev_stop(e);
+    printf("%llu events, %u reports, %llu resyncs\n", (unsigned long long)e->events, e->mailbox.count, (unsigned long long)e->resyncs);
+    xnz_aligned_free(e);
+    return 0;
+}
+
+static int uinput(const char *path)
+{
+    xnz_evdev_header h; xnz_evdev_event ev; struct uinput_setup setup; struct uinput_abs_setup abs;
+    struct input_event out; uint64_t origin = 0, start, count = 0; int fd; FILE *f;
+    if (NULL == (f = fopen(path, "rb")) || fread(&h, sizeof(h), 1, f) != 1 ||
+        h.magic != XNZ_EVDEV_MAGIC || h.version != XNZ_EVDEV_VERSION)
+    {
+        fprintf(stderr, "%s: not a recording\n", path);
+        if (f)
+        {
+            fclose(f);
+        }
+        return 1;
+    }
+    if ((fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0)
+    {
+        fprintf(stderr, "/dev/uinput: %s\n", strerror(errno));
+        fclose(f); return 1;
+    }
+    memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = XNZ_EVDEV_VENDOR;
+    snprintf(setup.name, sizeof(setup.name), "Virtual TCA (%.48s)", h.name);
+    ioctl(fd, UI_SET_EVBIT, EV_SYN);
+    ioctl(fd, UI_SET_EVBIT, EV_ABS);
+    for (int i = 0; i < 2; i++)
+    {
+        memset(&abs, 0, sizeof(abs));
+        abs.code = h.code[i];
+        abs.absinfo.minimum = h.minimum[i];
+        abs.absinfo.maximum = h.maximum[i];
+        ioctl(fd, UI_SET_ABSBIT, h.code[i]);
+        ioctl(fd, UI_ABS_SETUP, &abs);
+    }
+    if (ioctl(fd, UI_DEV_SETUP, &setup) || ioctl(fd, UI_DEV_CREATE))
+    {
+        fprintf(stderr, "/dev/uinput: could not create device: %s\n", strerror(errno));
+        close(fd); fclose(f); return 1;
+    }
+    printf("replaying %s as \"%s\", ^C to stop\n", path, setup.name);
+    signal(SIGINT, &on_signal);
+    start = xnz_time_ns();
+    while (interrupted == 0 && fread(&ev, sizeof(ev), 1, f) == 1)
+    {
+        if (origin == 0)
+        {
+            origin = ev.time;
+        }
+        while (interrupted == 0 && xnz_time_ns() < start + (ev.time - origin))
+        {
+            xnz_sleep_ms(1);
+        }
+        memset(&out, 0, sizeof(out));
+        out.type = ev.type;
+        out.code = ev.code;
+        out.value = ev.value;
+        count += write(fd, &out, sizeof(out)) == (ssize_t)sizeof(out); // the kernel stamps it
+    }
+    printf("%llu events\n", (unsigned long long)count);
+    ioctl(fd, UI_DEV_DESTROY);
+    close(fd); fclose(f);
+    return 0;
+}
+
+/*
+ * Mailbox: one writer publishing as fast as it can, the reader must never see
+ * a torn sample (both values and the time are derived from the count).
+ */
+typedef struct
+{
+    xnz_evdev_mailbox mailbox XNZ_CACHELINE_ALIGNED;
+    uint32_t done;
+}
+selftest_state;
+
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL selftest_publish(void *arg)
+{
+    selftest_state *st = arg;
+    for (uint32_t i = 1; i <= SELFTEST_SAMPLES; i++)
+    {
+        float value[2] = { (float)(i & 0xffff), (float)(i & 0xffff) * 2.0f, };
+        xnz_evdev_publish(&st->mailbox, i, value);
+    }
+    xnz_atomic_store_u32(&st->done, 1);
+    return 0;
+}
+
+static int selftest_replay(void)
+{
+    char path[] = "/tmp/xnz_evdev.selftest.XXXXXX"; xnz_evdev_header h; xnz_evdev_event ev[6];
+    xnz_evdev *e; xnz_evdev_sample s; int fd, ret = 1;
+    if ((fd = mkstemp(path)) < 0)
+    {
+        return 1;
+    }
+    memset(&h, 0, sizeof(h));
+    h.magic = XNZ_EVDEV_MAGIC; h.version = XNZ_EVDEV_VERSION;
+    h.code[0] = ABS_X; h.code[1] = ABS_Y; h.maximum[0] = h.maximum[1] = 1000;
+    ev[0] = (xnz_evdev_event){ 5000000, EV_ABS, ABS_X, 250, };
+    ev[1] = (xnz_evdev_event){ 5000000, EV_ABS, ABS_Y, 500, };
+    ev[2] = (xnz_evdev_event){ 5000000, EV_SYN, SYN_REPORT, 0, };
+    ev[3] = (xnz_evdev_event){ 25000000, EV_ABS, ABS_Y, 1000, };
+    ev[4] = (xnz_evdev_event){ 25000000, EV_ABS, ABS_Z, 7, }; // not a lever
+    ev[5] = (xnz_evdev_event){ 25000000, EV_SYN, SYN_REPORT, 0, };
+    if (write(fd, &h, sizeof(h)) != (ssize_t)sizeof(h) || write(fd, ev, sizeof(ev)) != (ssize_t)sizeof(ev) ||
+        NULL == (e = xnz_aligned_calloc(sizeof(*e))))
+    {
+        close(fd); unlink(path); return 1;
+    }
+    close(fd);
+    uint64_t start = xnz_time_ns();
+    if (xnz_evdev_open(e, path) == 0 && e->replay && xnz_evdev_start(e) == 0)
+    {
+        while (xnz_atomic_load_u32(&e->failed) == 0) // stops by itself at the end
+        {
+            xnz_sleep_ms(1);
+        }
+        xnz_evdev_stop(e);
+        ret = !(xnz_evdev_latest(&e->mailbox, &s) == 0 && s.count == 2 && e->events == 6 &&
+                s.value[0] == 0.25f && s.value[1] == 1.0f && s.time - start >= 20000000);
+    }
+    printf("selftest: replay %s\n", ret ? "FAILED" : "ok");
+    xnz_aligned_free(e);
+    unlink(path);
+    return ret;
+}
+
+static int selftest(void)
+{
+    selftest_state *st; xnz_thread t; xnz_evdev_sample s;
+    uint64_t reads = 0, torn = 0, busy = 0; uint32_t last = 0, backwards = 0;
+    if (NULL == (st = xnz_aligned_calloc(sizeof(*st))) || xnz_thread_create(&t, &selftest_publish, st))
+    {
+        fprintf(stderr, "selftest: could not start thread\n");
+        xnz_aligned_free(st); return 1;
+    }
+    while (xnz_atomic_load_u32(&st->done) == 0)
+    {
+        if (xnz_evdev_latest(&st->mailbox, &s))
+        {
+            busy++;
+            continue;
+        }
+        reads++;
+        torn += s.time != s.count || s.value[0] != (float)(s.count & 0xffff) || s.value[1] != s.value[0] * 2.0f;
+        backwards += s.count < last;
+        last = s.count;
+    }
+    xnz_thread_join(t);
+    printf("selftest: mailbox %s, %llu reads (%llu torn, %u backwards, %llu busy)\n", torn || backwards ? "FAILED" : "ok",
+           (unsigned long long)reads, (unsigned long long)torn, backwards, (unsigned long long)busy);
+    xnz_aligned_free(st);
+    return (torn || backwards) | selftest_replay();
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && !strcmp(argv[1], "-selftest"))
+    {
+        return selftest();
+    }
+    if (argc == 4 && !strcmp(argv[1], "-record"))
+    {
+        return record(argv[2], argv[3]);
+    }
+    if ((argc == 2 || argc == 3) && !strcmp(argv[1], "-read"))
+    {
+        return read_samples(argc == 3 ? argv[2] : NULL);
+    }
+    if (argc == 3 && !strcmp(argv[1], "-uinput"))
+    {
+        return uinput(argv[2]);
+    }
+    fprintf(stderr, "usage: %s -record <device|auto> <file> | -read [device|auto|file] | -uinput <file> | -selftest\n", argv[0]);
+    return 1;
+}
+#else
+int main(int argc, char **argv)
+{
+    (void)argc;
+    fprintf(stderr, "%s: Linux only\n", argv[0]);
+    return 1;
+}
+#endif
@@ -0,0 +1,182 @@
+/*
+ * xnz_ffrec.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Offline decoder for FlightFactor A320 recordings (see src/XNZffrec.h);
+ * lists the recorded values and the number of frames, or prints one CSV row
+ * per frame (oldest first, a comment line for each gap):
+ *
+ *   xnz_ffrec [-csv] <Output/preferences/x-nullzones.ffrec>
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XNZffrec.h"
+
+static const char* type_name(uint32_t type)
+{
+    switch (type)
+    {
+        case XNZ_FFREC_SINT8:   return "int8";
+        case XNZ_FFREC_UINT8:   return "uint8";
+        case XNZ_FFREC_SINT16:  return "int16";
+        case XNZ_FFREC_UINT16:  return "uint16";
+        case XNZ_FFREC_SINT32:  return "int32";
+        case XNZ_FFREC_UINT32:  return "uint32";
+        case XNZ_FFREC_FLOAT32: return "float";
+        case XNZ_FFREC_FLOAT64: return "double";
+        case XNZ_FFREC_TIME:    return "time";
+        default:                return "?";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    xnz_ffrec_header h; xnz_ffrec_block b; xnz_ffrec_column *c = NULL; uint8_t *data = NULL;
+    size_t row = 0, *offset = NULL; uint32_t next = 0, blocks = 0; uint64_t frames = 0, dropped = 0;
+    const char *path = NULL; int csv = 0, ret = 1; FILE *f;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-csv"))
+        {
+            csv = 1;
+            continue;
+        }
+        path = argv[i];
+    }
+    if (path == NULL)
+    {
+        fprintf(stderr, "usage: %s [-csv] <ffrec>\n", argv[0]);
+        return 1;
+    }
+    if (NULL == (f = fopen(path, "rb")))
+    {
+        fprintf(stderr, "%s: could not open file\n", path);
+        return 1;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 ||
+        h.magic != XNZ_FFREC_MAGIC ||
+        h.version != XNZ_FFREC_VERSION ||
+        h.column_count == 0 || h.column_count > XNZ_FFREC_COLUMNS ||
+        h.block_frames == 0 || h.block_frames > XNZ_FFREC_FRAMES)
+    {
+        fprintf(stderr, "%s: not a recording, or unsupported version\n", path);
+        fclose(f); return 1;
+    }
+    if (NULL == (c = calloc(h.column_count, sizeof(*c))) ||
+        NULL == (offset = calloc(h.column_count, sizeof(*offset))))
+    {
+        fprintf(stderr, "out of memory\n");
+        goto end;
+    }
+    if (fread(c, sizeof(*c), h.column_count, f) != h.column_count)
+    {
+        fprintf(stderr, "%s: truncated column list\n", path);
+        goto end;
+    }
+    for (uint32_t i = 0; i < h.column_count; i++)
+    {
+        if (c[i].size != xnz_ffrec_type_size(c[i].type))
+        {
+            fprintf(stderr, "%s: column %u: bad type\n", path, i);
+            goto end;
+        }
+        c[i].name[XNZ_FFREC_NAME_MAX - 1] = '\0';
+        offset[i] = xnz_ffrec_block_size(row, h.block_frames);
+        row += c[i].size;
+    }
+    if (NULL == (data = malloc(xnz_ffrec_block_size(row, h.block_frames))))
+    {
+        fprintf(stderr, "out of memory\n");
+        goto end;
+    }
+
+    if (csv)
+    {
+        printf("frame,time,step");
+        for (uint32_t i = 0; i < h.column_count; i++)
+        {
+            printf(",%s", c[i].name);
+        }
+        printf("\n");
+    }
+    while (fread(&b, sizeof(b), 1, f) == 1)
+    {
+        /* arrays are packed to the block's frame count in the file */
+        size_t size = 0; const uint64_t *time = (const uint64_t*)data;
+        const double *step = (const double*)(data + h.block_frames * sizeof(uint64_t));
+        if (b.frames == 0 || b.frames > h.block_frames ||
+            fread(data, sizeof(uint64_t), b.frames, f) != b.frames ||
+            fread(data + h.block_frames * sizeof(uint64_t), sizeof(double), b.frames, f) != b.frames)
+        {
+            fprintf(stderr, "%s: truncated block after %" PRIu64 " frames\n", path, frames);
+            break;
+        }
+        for (uint32_t i = 0; i < h.column_count; i++)
+        {
+            size += fread(data + offset[i], c[i].size, b.frames, f);
+        }
+        if (size != (size_t)b.frames * h.column_count)
+        {
+            fprintf(stderr, "%s: truncated block after %" PRIu64 " frames\n", path, frames);
+            break;
+        }
+        if (b.first != next)
+        {
+            dropped += b.first - next;
+            if (csv)
+            {
+                printf("# %" PRIu32 " frames dropped\n", b.first - next);
+            }
+        }
+        next = b.first + b.frames;
+        frames += b.frames;
+        blocks++;
+        for (uint32_t j = 0; csv && j < b.frames; j++)
+        {
+            printf("%" PRIu32 ",%.6f,%.6f", b.first + j, (double)(int64_t)(time[j] - h.started) / 1e9, step[j]);
+            for (uint32_t i = 0; i < h.column_count; i++)
+            {
+                printf(",%.9g", xnz_ffrec_value(c[i].type, data + offset[i] + j * c[i].size));
+            }
+            printf("\n");
+        }
+    }
+    if (csv == 0)
+    {
+        printf("%" PRIu32 " values, %" PRIu64 " frames in %" PRIu32 " blocks, %" PRIu64 " dropped\n",
+               h.column_count, frames, blocks, dropped);
+        for (uint32_t i = 0; i < h.column_count; i++)
+        {
+            printf("%5" PRId32 " %-6s 0x%08" PRIx32 " %s\n", c[i].id, type_name(c[i].type), c[i].units, c[i].name);
+        }
+    }
+    ret = 0;
+
+end:
+    free(data);
+    free(offset);
+    free(c);
+    fclose(f);
+    return ret;
+}
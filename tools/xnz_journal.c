@@ -0,0 +1,265 @@
+/*
+ * xnz_journal.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Offline decoder for command journal dumps (see src/XNZjournal.h); prints
+ * one line per handler begin and end phase, oldest first, with the number of
+ * continue phases (frames the command was held) on the end line:
+ *
+ *   xnz_journal <Output/preferences/x-nullzones.journal>
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XNZjournal.h"
+
+typedef struct
+{
+    uint64_t target;
+    char *name;
+}
+symbol;
+
+typedef struct
+{
+    int value;
+    const char *name;
+}
+backend;
+
+/* backend selectors, as in xnz_cmd_context */
+static const backend backends_ap[] =
+{
+    { -1, "ERRR", }, { 0, "NONE", }, { 1, "XPLM", }, { 2, "COMM", }, { 3, "TOGG", },
+    { 320, "FF32", }, { 700, "XGFC", }, { 0, NULL, },
+};
+static const backend backends_at[] =
+{
+    { -1, "ERRR", }, { 0, "NONE", }, { 1, "XPLM", }, { 2, "COMM", }, { 3, "TOGG", },
+    { 4, "APTO", }, { 11, "XP11", }, { 320, "FF32", }, { 321, "TOLI", }, { 0, NULL, },
+};
+static const backend backends_bt[] =
+{
+    { -1, "ERRR", }, { 1, "XPLM", }, { 2, "COMM", }, { 3, "PKBR", }, { 4, "SIMC", },
+    { 320, "FF32", }, { 321, "TO32", }, { 350, "FF35", }, { 900, "TBM9", }, { 0, NULL, },
+};
+static const backend backends_et[] =
+{
+    { -1, "ERRR", }, { 0, "NONE", }, { 1, "XPJT", }, { 2, "XPTP", }, { 3, "XPPI", },
+    { 12, "RPTP", }, { 62, "DA62", }, { 135, "E35L", }, { 320, "FF32", }, { 321, "TO32", },
+    { 350, "FF35", }, { 535, "E55P", }, { 540, "PIPA", }, { 550, "LEG2", }, { 610, "EA50", },
+    { 617, "EVIC", }, { 700, "CL30", }, { 733, "IX73", }, { 757, "FF75", }, { 900, "TBM9", },
+    { 0, NULL, },
+};
+static const backend backends_pb[] =
+{
+    { -1, "ERRR", }, { 1, "XPLM", }, { 2, "COMM", }, { 320, "FF32", }, { 321, "TO32", },
+    { 350, "FF35", }, { 900, "TBM9", }, { 0, NULL, },
+};
+
+static const char* backend_name(int family, int value, char *buf, size_t size)
+{
+    const char *prefix; const backend *b;
+    switch (family)
+    {
+        case XNZ_JOURNAL_FAMILY_AP: prefix = "ap"; b = backends_ap; break;
+        case XNZ_JOURNAL_FAMILY_AT: prefix = "at"; b = backends_at; break;
+        case XNZ_JOURNAL_FAMILY_BT: prefix = "bt"; b = backends_bt; break;
+        case XNZ_JOURNAL_FAMILY_ET: prefix = "et"; b = backends_et; break;
+        case XNZ_JOURNAL_FAMILY_PB: prefix = "pb"; b = backends_pb; break;
+        default:
+            return "-";
+    }
+    for (; b->name; b++)
+    {
+        if (b->value == value)
+        {
+            snprintf(buf, size, "%s:%s", prefix, b->name);
+            return buf;
+        }
+    }
+    snprintf(buf, size, "%s:%d", prefix, value);
+    return buf;
+}
+
+static const char* phase_name(int phase)
+{
+    switch (phase)
+    {
+        case 0: return "begin";
+        case 2: return "end";
+        default: return "?";
+    }
+}
+
+static const char* call_name(int call)
+{
+    switch (call)
+    {
+        case XNZ_JOURNAL_CALL_ONCE:  return "once";
+        case XNZ_JOURNAL_CALL_BEGIN: return "begin";
+        case XNZ_JOURNAL_CALL_END:   return "end";
+        case XNZ_JOURNAL_CALL_SETI:  return "seti";
+        case XNZ_JOURNAL_CALL_SETF:  return "setf";
+        case XNZ_JOURNAL_CALL_SETVI: return "setvi";
+        case XNZ_JOURNAL_CALL_SETVF: return "setvf";
+        default: return "?";
+    }
+}
+
+static char* read_name(FILE *f)
+{
+    uint32_t length; char *name;
+    if (fread(&length, sizeof(length), 1, f) != 1 || length > 4096)
+    {
+        return NULL;
+    }
+    if (NULL == (name = malloc(length + 1)))
+    {
+        return NULL;
+    }
+    if (fread(name, 1, length, f) != length)
+    {
+        free(name); return NULL;
+    }
+    name[length] = '\0';
+    return name;
+}
+
+int main(int argc, char **argv)
+{
+    xnz_journal_header h; xnz_journal_record *records = NULL;
+    char **commands = NULL; symbol *symbols = NULL; FILE *f; int ret = 1;
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <journal>\n", argv[0]);
+        return 1;
+    }
+    if (NULL == (f = fopen(argv[1], "rb")))
+    {
+        fprintf(stderr, "%s: could not open file\n", argv[1]);
+        return 1;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 ||
+        h.magic != XNZ_JOURNAL_MAGIC ||
+        h.version != XNZ_JOURNAL_VERSION ||
+        h.record_size != sizeof(xnz_journal_record) ||
+        h.record_count > XNZ_JOURNAL_RECORDS)
+    {
+        fprintf(stderr, "%s: not a journal, or unsupported version\n", argv[1]);
+        goto fail;
+    }
+    if (NULL == (records = calloc(h.record_count + 1, sizeof(*records))) ||
+        NULL == (commands = calloc(h.command_count + 1, sizeof(*commands))) ||
+        NULL == (symbols = calloc(h.symbol_count + 1, sizeof(*symbols))))
+    {
+        fprintf(stderr, "out of memory\n");
+        goto fail;
+    }
+    if (fread(records, sizeof(*records), h.record_count, f) != h.record_count)
+    {
+        fprintf(stderr, "%s: truncated (records)\n", argv[1]);
+        goto fail;
+    }
+    for (uint32_t i = 0; i < h.command_count; i++)
+    {
+        if (NULL == (commands[i] = read_name(f)))
+        {
+            fprintf(stderr, "%s: truncated (commands)\n", argv[1]);
+            goto fail;
+        }
+    }
+    for (uint32_t i = 0; i < h.symbol_count; i++)
+    {
+        if (fread(&symbols[i].target, sizeof(symbols[i].target), 1, f) != 1 ||
+            NULL == (symbols[i].name = read_name(f)))
+        {
+            fprintf(stderr, "%s: truncated (symbols)\n", argv[1]);
+            goto fail;
+        }
+    }
+
+    printf("%8s %12s %10s %-28s %-5s %6s %-9s %10s  %s\n",
+           "seq", "time (s)", "delta (ms)", "command", "phase", "holds", "backend", "dur (us)", "downstream");
+    for (uint32_t i = 0; i < h.record_count; i++)
+    {
+        const xnz_journal_record *r = &records[i]; char buf[32], target[32], holds[16] = "-";
+        const char *command = r->command < h.command_count ? commands[r->command] : "?";
+        const char *downstream = "-";
+        if (r->calls)
+        {
+            downstream = NULL;
+            for (uint32_t k = 0; k < h.symbol_count; k++)
+            {
+                if (symbols[k].target == r->target)
+                {
+                    downstream = symbols[k].name;
+                    break;
+                }
+            }
+            if (downstream == NULL)
+            {
+                snprintf(target, sizeof(target), "0x%" PRIx64, r->target);
+                downstream = target;
+            }
+        }
+        if (r->phase == 2)
+        {
+            snprintf(holds, sizeof(holds), "%" PRIu32, r->holds);
+        }
+        printf("%8" PRIu32 " %12.6f %10.3f %-28s %-5s %6s %-9s %10.3f  ",
+               r->sequence,
+               (double)(int64_t)(r->time - h.dumped) / 1e9,
+               i ? (double)(r->time - records[i - 1].time) / 1e6 : 0.0,
+               command, phase_name(r->phase), holds,
+               backend_name(r->family, r->backend, buf, sizeof(buf)),
+               (double)r->duration / 1e3);
+        if (r->calls)
+        {
+            printf("%s %s (%u calls)\n", call_name(r->call), downstream, r->calls);
+        }
+        else
+        {
+            printf("-\n");
+        }
+    }
+    ret = 0;
+
+fail:
+    if (commands)
+    {
+        for (uint32_t i = 0; i < h.command_count; i++)
+        {
+            free(commands[i]);
+        }
+    }
+    if (symbols)
+    {
+        for (uint32_t i = 0; i < h.symbol_count; i++)
+        {
+            free(symbols[i].name);
+        }
+    }
+    free(records); free(commands); free(symbols); fclose(f);
+    return ret;
+}
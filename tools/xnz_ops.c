@@ -0,0 +1,477 @@
+/*
+ * xnz_ops.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Backend ops table check: resolves the command handlers (see
+ * xnz_cmd_ops_resolve) for each backend of each family and compares them
+ * with the handlers the per-command switch statements dispatched to before
+ * the tables replaced them; actions missing below must be no-ops:
+ *
+ *   xnz_ops                     print the resolved handlers
+ *   xnz_ops -selftest           check them against the table below
+ */
+
+#include "XNZplugin.c"
+#include "xnz_stubs.h"
+
+typedef void (*xnz_ops_fn)(void);
+
+typedef struct
+{
+    const char *family;
+    int backend;
+    const char *backend_name;
+    size_t offset;
+    const char *op;
+    xnz_ops_fn handler;
+    const char *handler_name;
+}
+xnz_ops_row;
+
+#define OP(fam, be, slot, fn) { #fam, be, #be, offsetof(xnz_##fam##_ops, slot), #slot, (xnz_ops_fn)fn, #fn, }
+
+/*
+ * From the switch statements in the command handlers, case by case (a case
+ * forwarding to another backend's handler lists that handler).
+ */
+static const xnz_ops_row rows[] =
+{
+    OP(ap, XNZ_AP_XPLM, a_p_onn, xnz_ap_xplm_a_p_onn),
+    OP(ap, XNZ_AP_XPLM, a_p_off, xnz_ap_xplm_a_p_off),
+
+    OP(ap, XNZ_AP_COMM, a_p_onn, xnz_ap_comm_a_p_onn),
+    OP(ap, XNZ_AP_COMM, a_p_off, xnz_ap_comm_a_p_off),
+
+    OP(ap, XNZ_AP_XGFC, a_p_onn, xnz_ap_xplm_a_p_onn),
+    OP(ap, XNZ_AP_XGFC, a_p_off, xnz_ap_xplm_a_p_off),
+
+    OP(at, XNZ_AT_NONE, at_toga, xnz_at_none_at_toga),
+    OP(at, XNZ_AT_NONE, a_12_lt, xnz_at_none_a_12_lt),
+
+    OP(at, XNZ_AT_XPLM, at_toga, xnz_at_xplm_at_toga),
+    OP(at, XNZ_AT_XPLM, at_disc, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_XPLM, a_12_lt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_XPLM, a_12_rt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_XPLM, a_34_lt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_XPLM, a_34_rt, xnz_at_xplm_at_disc),
+
+    OP(at, XNZ_AT_COMM, at_toga, xnz_at_comm_at_toga),
+    OP(at, XNZ_AT_COMM, at_disc, xnz_at_comm_at_disc),
+    OP(at, XNZ_AT_COMM, a_12_lt, xnz_at_comm_at_disc),
+    OP(at, XNZ_AT_COMM, a_12_rt, xnz_at_comm_at_disc),
+    OP(at, XNZ_AT_COMM, a_34_lt, xnz_at_comm_at_disc),
+    OP(at, XNZ_AT_COMM, a_34_rt, xnz_at_comm_at_disc),
+
+    OP(at, XNZ_AT_APTO, at_toga, xnz_at_none_at_toga),
+    OP(at, XNZ_AT_APTO, a_12_lt, xnz_at_apto_a_12_lt),
+
+    OP(at, XNZ_AT_XP11, at_toga, xnz_at_xp11_at_toga),
+    OP(at, XNZ_AT_XP11, at_disc, xnz_at_xplm_at_disc),
+
+    OP(at, XNZ_AT_TOLI, at_toga, xnz_at_toli_at_toga),
+    OP(at, XNZ_AT_TOLI, at_disc, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_TOLI, a_12_lt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_TOLI, a_12_rt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_TOLI, a_34_lt, xnz_at_xplm_at_disc),
+    OP(at, XNZ_AT_TOLI, a_34_rt, xnz_at_xplm_at_disc),
+
+    OP(bt, XNZ_BT_XPLM, rgb_hld, xnz_bt_xplm_rgb_hld),
+
+    OP(bt, XNZ_BT_COMM, rgb_hld, xnz_bt_comm_rgb_hld),
+
+    OP(bt, XNZ_BT_PKBR, rgb_hld, xnz_bt_pkbr_rgb_hld),
+
+    OP(bt, XNZ_BT_SIMC, rgb_hld, xnz_bt_simc_rgb_hld),
+
+    OP(bt, XNZ_BT_TO32, rgb_hld, xnz_bt_to32_rgb_hld),
+
+    OP(bt, XNZ_BT_FF35, rgb_hld, xnz_bt_ff35_rgb_hld),
+
+    OP(bt, XNZ_BT_TBM9, rgb_hld, xnz_bt_tbm9_rgb_hld),
+
+    OP(et, XNZ_ET_XPTP, e_1_onn, xnz_et_xptp_e_1_onn),
+    OP(et, XNZ_ET_XPTP, e_1_off, xnz_et_xptp_e_1_off),
+    OP(et, XNZ_ET_XPTP, e_2_onn, xnz_et_xptp_e_1_onn),
+    OP(et, XNZ_ET_XPTP, e_2_off, xnz_et_xptp_e_1_off),
+
+    OP(et, XNZ_ET_XPPI, x_12_lt, xnz_et_xppi_x_12_lt),
+    OP(et, XNZ_ET_XPPI, x_12_rt, xnz_et_xppi_x_12_rt),
+    OP(et, XNZ_ET_XPPI, x_34_lt, xnz_et_xppi_x_34_lt),
+    OP(et, XNZ_ET_XPPI, x_34_rt, xnz_et_xppi_x_34_rt),
+    OP(et, XNZ_ET_XPPI, m_12_cr, xnz_et_xppi_m_12_cr),
+    OP(et, XNZ_ET_XPPI, m_12_no, xnz_et_xppi_m_12_no),
+    OP(et, XNZ_ET_XPPI, m_12_st, xnz_et_xppi_m_12_st),
+    OP(et, XNZ_ET_XPPI, m_34_cr, xnz_et_xppi_m_34_cr),
+    OP(et, XNZ_ET_XPPI, m_34_no, xnz_et_xppi_m_34_no),
+    OP(et, XNZ_ET_XPPI, m_34_st, xnz_et_xppi_m_34_st),
+    OP(et, XNZ_ET_XPPI, e_1_onn, xnz_et_xppi_e_1_onn),
+    OP(et, XNZ_ET_XPPI, e_1_off, xnz_et_xppi_e_1_off),
+    OP(et, XNZ_ET_XPPI, e_2_onn, xnz_et_xppi_e_2_onn),
+    OP(et, XNZ_ET_XPPI, e_2_off, xnz_et_xppi_e_2_off),
+    OP(et, XNZ_ET_XPPI, e_3_onn, xnz_et_xppi_e_3_onn),
+    OP(et, XNZ_ET_XPPI, e_3_off, xnz_et_xppi_e_3_off),
+    OP(et, XNZ_ET_XPPI, e_4_onn, xnz_et_xppi_e_4_onn),
+    OP(et, XNZ_ET_XPPI, e_4_off, xnz_et_xppi_e_4_off),
+
+    OP(et, XNZ_ET_RPTP, x_12_lt, xnz_et_rptp_x_12_lt),
+    OP(et, XNZ_ET_RPTP, x_12_rt, xnz_et_rptp_x_12_rt),
+    OP(et, XNZ_ET_RPTP, m_12_cr, xnz_et_rptp_m_12_cr),
+    OP(et, XNZ_ET_RPTP, m_12_no, xnz_et_rptp_m_12_cr),
+    OP(et, XNZ_ET_RPTP, m_12_st, xnz_et_rptp_m_12_st),
+    OP(et, XNZ_ET_RPTP, e_1_onn, xnz_et_xptp_e_1_onn),
+    OP(et, XNZ_ET_RPTP, e_1_off, xnz_et_xptp_e_1_off),
+    OP(et, XNZ_ET_RPTP, e_2_onn, xnz_et_xptp_e_1_onn),
+    OP(et, XNZ_ET_RPTP, e_2_off, xnz_et_xptp_e_1_off),
+
+    OP(et, XNZ_ET_DA62, x_12_lt, xnz_et_xppi_x_12_lt),
+    OP(et, XNZ_ET_DA62, x_12_rt, xnz_et_xppi_x_12_rt),
+    OP(et, XNZ_ET_DA62, m_12_cr, xnz_et_da62_m_12_cr),
+    OP(et, XNZ_ET_DA62, m_12_no, xnz_et_da62_m_12_no),
+    OP(et, XNZ_ET_DA62, m_12_st, xnz_et_da62_m_12_st),
+    OP(et, XNZ_ET_DA62, e_1_onn, xnz_et_da62_e_1_onn),
+    OP(et, XNZ_ET_DA62, e_1_off, xnz_et_da62_e_1_off),
+    OP(et, XNZ_ET_DA62, e_2_onn, xnz_et_da62_e_2_onn),
+    OP(et, XNZ_ET_DA62, e_2_off, xnz_et_da62_e_2_off),
+
+    OP(et, XNZ_ET_E35L, x_12_lt, xnz_et_e35l_x_12_lt),
+    OP(et, XNZ_ET_E35L, x_12_rt, xnz_et_e35l_x_12_rt),
+    OP(et, XNZ_ET_E35L, m_12_cr, xnz_et_e35l_m_12_cr),
+    OP(et, XNZ_ET_E35L, m_12_no, xnz_et_e35l_m_12_no),
+    OP(et, XNZ_ET_E35L, e_1_onn, xnz_et_e35l_e_1_onn),
+    OP(et, XNZ_ET_E35L, e_1_off, xnz_et_e35l_e_1_off),
+    OP(et, XNZ_ET_E35L, e_2_onn, xnz_et_e35l_e_2_onn),
+    OP(et, XNZ_ET_E35L, e_2_off, xnz_et_e35l_e_2_off),
+
+    OP(et, XNZ_ET_TO32, m_12_cr, xnz_et_to32_m_12_cr),
+    OP(et, XNZ_ET_TO32, m_12_no, xnz_et_to32_m_12_no),
+    OP(et, XNZ_ET_TO32, m_12_st, xnz_et_to32_m_12_st),
+    OP(et, XNZ_ET_TO32, m_34_cr, xnz_et_to32_m_12_cr),
+    OP(et, XNZ_ET_TO32, m_34_no, xnz_et_to32_m_12_no),
+    OP(et, XNZ_ET_TO32, m_34_st, xnz_et_to32_m_12_st),
+    OP(et, XNZ_ET_TO32, e_1_onn, xnz_et_to32_e_1_onn),
+    OP(et, XNZ_ET_TO32, e_1_off, xnz_et_to32_e_1_off),
+    OP(et, XNZ_ET_TO32, e_2_onn, xnz_et_to32_e_2_onn),
+    OP(et, XNZ_ET_TO32, e_2_off, xnz_et_to32_e_2_off),
+
+    OP(et, XNZ_ET_FF35, m_12_cr, xnz_et_ff35_m_12_cr),
+    OP(et, XNZ_ET_FF35, m_12_no, xnz_et_ff35_m_12_no),
+    OP(et, XNZ_ET_FF35, m_12_st, xnz_et_ff35_m_12_st),
+    OP(et, XNZ_ET_FF35, m_34_cr, xnz_et_ff35_m_12_cr),
+    OP(et, XNZ_ET_FF35, m_34_no, xnz_et_ff35_m_12_no),
+    OP(et, XNZ_ET_FF35, m_34_st, xnz_et_ff35_m_12_st),
+    OP(et, XNZ_ET_FF35, e_1_onn, xnz_et_ff35_e_1_onn),
+    OP(et, XNZ_ET_FF35, e_1_off, xnz_et_ff35_e_1_off),
+    OP(et, XNZ_ET_FF35, e_2_onn, xnz_et_ff35_e_2_onn),
+    OP(et, XNZ_ET_FF35, e_2_off, xnz_et_ff35_e_2_off),
+
+    OP(et, XNZ_ET_E55P, x_12_lt, xnz_et_e55p_x_12_lt),
+    OP(et, XNZ_ET_E55P, x_12_rt, xnz_et_e55p_x_12_rt),
+    OP(et, XNZ_ET_E55P, m_12_cr, xnz_et_e55p_m_12_cr),
+    OP(et, XNZ_ET_E55P, m_12_no, xnz_et_e55p_m_12_no),
+    OP(et, XNZ_ET_E55P, m_12_st, xnz_et_e55p_m_12_st),
+    OP(et, XNZ_ET_E55P, e_1_onn, xnz_et_e55p_e_1_onn),
+    OP(et, XNZ_ET_E55P, e_1_off, xnz_et_e55p_e_1_off),
+    OP(et, XNZ_ET_E55P, e_2_onn, xnz_et_e55p_e_2_onn),
+    OP(et, XNZ_ET_E55P, e_2_off, xnz_et_e55p_e_2_off),
+
+    OP(et, XNZ_ET_LEG2, x_12_lt, xnz_et_xppi_x_12_lt),
+    OP(et, XNZ_ET_LEG2, x_12_rt, xnz_et_leg2_x_12_rt),
+    OP(et, XNZ_ET_LEG2, m_12_no, xnz_et_leg2_m_12_no),
+    OP(et, XNZ_ET_LEG2, m_12_st, xnz_et_leg2_m_12_st),
+    OP(et, XNZ_ET_LEG2, e_1_onn, xnz_et_leg2_e_1_onn),
+    OP(et, XNZ_ET_LEG2, e_1_off, xnz_et_leg2_e_1_off),
+    OP(et, XNZ_ET_LEG2, e_2_onn, xnz_et_leg2_e_2_onn),
+    OP(et, XNZ_ET_LEG2, e_2_off, xnz_et_leg2_e_2_off),
+
+    OP(et, XNZ_ET_EA50, m_12_no, xnz_et_ea50_m_12_no),
+    OP(et, XNZ_ET_EA50, m_12_st, xnz_et_ea50_m_12_st),
+    OP(et, XNZ_ET_EA50, e_1_onn, xnz_et_ea50_e_1_onn),
+    OP(et, XNZ_ET_EA50, e_1_off, xnz_et_ea50_e_1_off),
+    OP(et, XNZ_ET_EA50, e_2_onn, xnz_et_ea50_e_2_onn),
+    OP(et, XNZ_ET_EA50, e_2_off, xnz_et_ea50_e_2_off),
+
+    OP(et, XNZ_ET_EVIC, x_12_lt, xnz_et_evic_x_12_lt),
+    OP(et, XNZ_ET_EVIC, x_12_rt, xnz_et_evic_x_12_rt),
+    OP(et, XNZ_ET_EVIC, m_12_no, xnz_et_evic_m_12_no),
+    OP(et, XNZ_ET_EVIC, m_12_st, xnz_et_evic_m_12_st),
+    OP(et, XNZ_ET_EVIC, e_1_onn, xnz_et_evic_e_1_onn),
+    OP(et, XNZ_ET_EVIC, e_1_off, xnz_et_evic_e_1_off),
+    OP(et, XNZ_ET_EVIC, e_2_onn, xnz_et_evic_e_2_onn),
+    OP(et, XNZ_ET_EVIC, e_2_off, xnz_et_evic_e_2_off),
+
+    OP(et, XNZ_ET_IX73, x_12_lt, xnz_et_ix73_x_12_lt),
+    OP(et, XNZ_ET_IX73, x_12_rt, xnz_et_ix73_x_12_rt),
+    OP(et, XNZ_ET_IX73, m_12_no, xnz_et_ix73_m_12_no),
+    OP(et, XNZ_ET_IX73, m_12_st, xnz_et_ix73_m_12_st),
+    OP(et, XNZ_ET_IX73, e_1_onn, xnz_et_ix73_e_1_onn),
+    OP(et, XNZ_ET_IX73, e_1_off, xnz_et_ix73_e_1_off),
+    OP(et, XNZ_ET_IX73, e_2_onn, xnz_et_ix73_e_2_onn),
+    OP(et, XNZ_ET_IX73, e_2_off, xnz_et_ix73_e_2_off),
+
+    OP(et, XNZ_ET_FF75, x_12_lt, xnz_et_ff75_x_12_lt),
+    OP(et, XNZ_ET_FF75, x_12_rt, xnz_et_ff75_x_12_rt),
+    OP(et, XNZ_ET_FF75, m_12_cr, xnz_et_ff75_m_12_cr),
+    OP(et, XNZ_ET_FF75, m_12_no, xnz_et_ff75_m_12_no),
+    OP(et, XNZ_ET_FF75, m_12_st, xnz_et_ff75_m_12_st),
+    OP(et, XNZ_ET_FF75, e_1_onn, xnz_et_ff75_e_1_onn),
+    OP(et, XNZ_ET_FF75, e_1_off, xnz_et_ff75_e_1_off),
+    OP(et, XNZ_ET_FF75, e_2_onn, xnz_et_ff75_e_2_onn),
+    OP(et, XNZ_ET_FF75, e_2_off, xnz_et_ff75_e_2_off),
+
+    OP(et, XNZ_ET_TBM9, x_12_lt, xnz_et_tbm9_x_12_lt),
+    OP(et, XNZ_ET_TBM9, x_12_rt, xnz_et_tbm9_x_12_rt),
+    OP(et, XNZ_ET_TBM9, x_34_lt, xnz_et_tbm9_x_12_lt),
+    OP(et, XNZ_ET_TBM9, x_34_rt, xnz_et_tbm9_x_12_rt),
+    OP(et, XNZ_ET_TBM9, m_12_cr, xnz_et_tbm9_m_12_cr),
+    OP(et, XNZ_ET_TBM9, m_12_no, xnz_et_tbm9_m_12_no),
+    OP(et, XNZ_ET_TBM9, m_12_st, xnz_et_tbm9_m_12_st),
+    OP(et, XNZ_ET_TBM9, m_34_cr, xnz_et_tbm9_m_12_cr),
+    OP(et, XNZ_ET_TBM9, m_34_no, xnz_et_tbm9_m_12_no),
+    OP(et, XNZ_ET_TBM9, m_34_st, xnz_et_tbm9_m_12_st),
+    OP(et, XNZ_ET_TBM9, e_1_onn, xnz_et_tbm9_e_1_onn),
+    OP(et, XNZ_ET_TBM9, e_1_off, xnz_et_tbm9_e_1_off),
+    OP(et, XNZ_ET_TBM9, e_2_onn, xnz_et_tbm9_e_2_onn),
+    OP(et, XNZ_ET_TBM9, e_2_off, xnz_et_tbm9_e_2_off),
+
+    OP(pb, XNZ_PB_XPLM, get, xnz_pb_xplm_get),
+    OP(pb, XNZ_PB_XPLM, set, xnz_pb_xplm_set),
+
+    OP(pb, XNZ_PB_TO32, get, xnz_pb_to32_get),
+    OP(pb, XNZ_PB_TO32, set, xnz_pb_to32_set),
+
+    OP(pb, XNZ_PB_FF35, get, xnz_pb_ff35_get),
+    OP(pb, XNZ_PB_FF35, set, xnz_pb_ff35_set),
+
+    OP(pb, XNZ_PB_TBM9, get, xnz_pb_tbm9_get),
+    OP(pb, XNZ_PB_TBM9, set, xnz_pb_tbm9_set),
+};
+
+#undef OP
+
+typedef struct
+{
+    size_t offset;
+    const char *name;
+}
+xnz_ops_slot;
+
+typedef struct
+{
+    int value;
+    const char *name;
+}
+xnz_ops_backend;
+
+#define SLOT(fam, slot) { offsetof(xnz_##fam##_ops, slot), #slot, }
+#define BACKEND(be) { be, #be, }
+#define UNKNOWN { 12345, "(unknown)", } // the default case
+
+static const xnz_ops_slot ap_slots[] =
+{
+    SLOT(ap, a_p_onn), SLOT(ap, a_p_off),
+};
+
+static const xnz_ops_slot at_slots[] =
+{
+    SLOT(at, at_toga), SLOT(at, at_disc), SLOT(at, a_12_lt),
+    SLOT(at, a_12_rt), SLOT(at, a_34_lt), SLOT(at, a_34_rt),
+};
+
+static const xnz_ops_slot et_slots[] =
+{
+    SLOT(et, x_12_lt), SLOT(et, x_12_rt), SLOT(et, x_34_lt), SLOT(et, x_34_rt),
+    SLOT(et, m_12_cr), SLOT(et, m_12_no), SLOT(et, m_12_st),
+    SLOT(et, m_34_cr), SLOT(et, m_34_no), SLOT(et, m_34_st),
+    SLOT(et, e_1_onn), SLOT(et, e_1_off), SLOT(et, e_2_onn), SLOT(et, e_2_off),
+    SLOT(et, e_3_onn), SLOT(et, e_3_off), SLOT(et, e_4_onn), SLOT(et, e_4_off),
+};
+
+static const xnz_ops_slot bt_slots[] =
+{
+    SLOT(bt, rgb_hld),
+};
+
+static const xnz_ops_slot pb_slots[] =
+{
+    SLOT(pb, get), SLOT(pb, set),
+};
+
+static const xnz_ops_backend ap_backends[] =
+{
+    BACKEND(XNZ_AP_ERRR), BACKEND(XNZ_AP_NONE), BACKEND(XNZ_AP_XPLM), BACKEND(XNZ_AP_COMM),
+    BACKEND(XNZ_AP_TOGG), BACKEND(XNZ_AP_FF32), BACKEND(XNZ_AP_XGFC), UNKNOWN,
+};
+
+static const xnz_ops_backend at_backends[] =
+{
+    BACKEND(XNZ_AT_ERRR), BACKEND(XNZ_AT_NONE), BACKEND(XNZ_AT_XPLM), BACKEND(XNZ_AT_COMM),
+    BACKEND(XNZ_AT_TOGG), BACKEND(XNZ_AT_APTO), BACKEND(XNZ_AT_XP11), BACKEND(XNZ_AT_FF32),
+    BACKEND(XNZ_AT_TOLI), UNKNOWN,
+};
+
+static const xnz_ops_backend et_backends[] =
+{
+    BACKEND(XNZ_ET_ERRR), BACKEND(XNZ_ET_NONE), BACKEND(XNZ_ET_XPJT), BACKEND(XNZ_ET_XPTP),
+    BACKEND(XNZ_ET_XPPI), BACKEND(XNZ_ET_RPTP), BACKEND(XNZ_ET_DA62), BACKEND(XNZ_ET_E35L),
+    BACKEND(XNZ_ET_FF32), BACKEND(XNZ_ET_TO32), BACKEND(XNZ_ET_FF35), BACKEND(XNZ_ET_E55P),
+    BACKEND(XNZ_ET_PIPA), BACKEND(XNZ_ET_LEG2), BACKEND(XNZ_ET_EA50), BACKEND(XNZ_ET_EVIC),
+    BACKEND(XNZ_ET_CL30), BACKEND(XNZ_ET_IX73), BACKEND(XNZ_ET_FF75), BACKEND(XNZ_ET_TBM9), UNKNOWN,
+};
+
+static const xnz_ops_backend bt_backends[] =
+{
+    BACKEND(XNZ_BT_ERRR), BACKEND(XNZ_BT_XPLM), BACKEND(XNZ_BT_COMM), BACKEND(XNZ_BT_PKBR),
+    BACKEND(XNZ_BT_SIMC), BACKEND(XNZ_BT_FF32), BACKEND(XNZ_BT_TO32), BACKEND(XNZ_BT_FF35),
+    BACKEND(XNZ_BT_TBM9), UNKNOWN,
+};
+
+static const xnz_ops_backend pb_backends[] =
+{
+    BACKEND(XNZ_PB_ERRR), BACKEND(XNZ_PB_XPLM), BACKEND(XNZ_PB_COMM), BACKEND(XNZ_PB_FF32),
+    BACKEND(XNZ_PB_TO32), BACKEND(XNZ_PB_FF35), BACKEND(XNZ_PB_TBM9), UNKNOWN,
+};
+
+#undef SLOT
+#undef BACKEND
+#undef UNKNOWN
+
+#define FAMILY(fam) { #fam, offsetof(xnz_cmd_context, ops.fam), \
+                      fam##_slots, sizeof(fam##_slots) / sizeof(fam##_slots[0]), \
+                      fam##_backends, sizeof(fam##_backends) / sizeof(fam##_backends[0]), }
+
+static const struct
+{
+    const char *name;
+    size_t ops; // offset of the resolved table in xnz_cmd_context
+    const xnz_ops_slot *slots;
+    size_t nslots;
+    const xnz_ops_backend *backends;
+    size_t nbackends;
+}
+families[] =
+{
+    FAMILY(ap), FAMILY(at), FAMILY(et), FAMILY(bt), FAMILY(pb),
+};
+
+#undef FAMILY
+
+static const xnz_ops_row* find(const char *family, int backend, size_t offset)
+{
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+    {
+        if (rows[i].backend == backend && rows[i].offset == offset && !strcmp(rows[i].family, family))
+        {
+            return &rows[i];
+        }
+    }
+    return NULL;
+}
+
+static const char* name(xnz_ops_fn fn)
+{
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+    {
+        if (rows[i].handler == fn)
+        {
+            return rows[i].handler_name;
+        }
+    }
+    if (fn == (xnz_ops_fn)xnz_op_noop)
+    {
+        return "xnz_op_noop";
+    }
+    if (fn == (xnz_ops_fn)xnz_pb_errr_get)
+    {
+        return "xnz_pb_errr_get";
+    }
+    if (fn == (xnz_ops_fn)xnz_pb_errr_set)
+    {
+        return "xnz_pb_errr_set";
+    }
+    return "(unknown)";
+}
+
+/*
+ * Resolves every backend of every family, printing the handlers that aren't
+ * no-ops (verbose) and those not matching the table; returns the latter's
+ * count.
+ */
+static int check(int verbose)
+{
+    xnz_cmd_context *commands; int failed = 0;
+    if (NULL == (commands = calloc(1, sizeof(xnz_cmd_context))))
+    {
+        fprintf(stderr, "could not allocate memory\n");
+        return 1;
+    }
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++)
+    {
+        for (size_t b = 0; b < families[f].nbackends; b++)
+        {
+            const xnz_ops_backend *be = &families[f].backends[b]; const void *ops;
+            commands->xnz_ap = commands->xnz_at = commands->xnz_bt = commands->xnz_et = commands->xnz_pb = be->value;
+            xnz_cmd_ops_resolve(commands);
+            memcpy(&ops, (const char*)commands + families[f].ops, sizeof(ops));
+
+            for (size_t s = 0; s < families[f].nslots; s++)
+            {
+                const xnz_ops_slot *slot = &families[f].slots[s]; const xnz_ops_row *row;
+                xnz_ops_fn fn, expected = (xnz_ops_fn)xnz_op_noop;
+                memcpy(&fn, (const char*)ops + slot->offset, sizeof(fn));
+                if ((row = find(families[f].name, be->value, slot->offset)))
+                {
+                    expected = row->handler;
+                }
+                else if (!strcmp(families[f].name, "pb"))
+                {
+                    expected = slot->offset == offsetof(xnz_pb_ops, get) ? (xnz_ops_fn)xnz_pb_errr_get : (xnz_ops_fn)xnz_pb_errr_set;
+                }
+                if (fn != expected)
+                {
+                    fprintf(stderr, "%s %s %s: %s (expected %s)\n", families[f].name, be->name, slot->name, name(fn), name(expected));
+                    failed++;
+                }
+                else if (verbose && row)
+                {
+                    printf("%s %s %s: %s\n", families[f].name, be->name, slot->name, name(fn));
+                }
+            }
+        }
+    }
+    free(commands);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int failed;
+    if (argc == 2 && !strcmp(argv[1], "-selftest"))
+    {
+        failed = check(0);
+        printf("selftest: backend ops %s, %zu handlers (%d failed)\n", failed ? "FAILED" : "ok", sizeof(rows) / sizeof(rows[0]), failed);
+        return failed != 0;
+    }
+    if (argc == 1)
+    {
+        return check(1) != 0;
+    }
+    fprintf(stderr, "usage: %s [-selftest]\n", argv[0]);
+    return 1;
+}
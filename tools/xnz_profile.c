@@ -0,0 +1,153 @@
+/*
+ * xnz_profile.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Per-aircraft profile checker (see src/XNZprofile.h): compiles a profile the
+ * way the plugin does (writing the .xnzp blob next to it) and prints the
+ * values it overrides, or reports the first invalid line:
+ *
+ *   xnz_profile <dir/name.txt>
+ *   xnz_profile -selftest       accept/reject a set of sample profiles
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XNZprofile.h"
+
+static void print_curve(const char *key, const xnz_curve *c)
+{
+    printf("%s =", key);
+    for (uint32_t i = 0; i < c->count; i++)
+    {
+        printf(" %g:%g", c->x[i], c->y[i]);
+    }
+    printf("\n");
+}
+
+static int check(const char *path)
+{
+    char dir[1024], name[1024], err[1024] = ""; const char *base = strrchr(path, '/'); size_t len;
+    xnz_profile_map map; const xnz_profile *p; int ret;
+    base = base ? base + 1 : path;
+    len = strlen(base);
+    if (len < 5 || strcmp(base + len - 4, ".txt") || (size_t)(base - path) >= sizeof(dir) || len >= sizeof(name))
+    {
+        fprintf(stderr, "%s: not a profile (<name>.txt)\n", path);
+        return 1;
+    }
+    snprintf(dir, sizeof(dir), "%.*s", (int)(base - path), path);
+    snprintf(name, sizeof(name), "%.*s", (int)(len - 4), base);
+    if ((ret = xnz_profile_open(&map, dir[0] ? dir : "./", name, err, sizeof(err))))
+    {
+        fprintf(stderr, "%s\n", ret > 0 ? "no such profile" : err);
+        return 1;
+    }
+    p = map.profile;
+    printf("%s (%s)\n", path, map.mapped ? "mapped" : "heap copy");
+    if (p->flags & XNZ_PROFILE_DETENTS) printf("detents = %g %g %g\n", p->detent[0], p->detent[1], p->detent[2]);
+    if (p->flags & XNZ_PROFILE_SHARES)  printf("shares = %g %g %g\n",  p->share[0],  p->share[1],  p->share[2]);
+    if (p->flags & XNZ_PROFILE_BRAKES)  printf("brakes = %g %g %g\n",  p->brake[0],  p->brake[1],  p->brake[2]);
+    if (p->flags & XNZ_PROFILE_DECEL)   printf("decel = %g %g %g\n",   p->decel[0],  p->decel[1],  p->decel[2]);
+    if (p->flags & XNZ_PROFILE_NZ_PR)   print_curve("nullzone_pitch_roll", &p->nullzone[0]);
+    if (p->flags & XNZ_PROFILE_NZ_YT)   print_curve("nullzone_yaw_tiller", &p->nullzone[1]);
+    if (p->flags & XNZ_PROFILE_ROLL)    print_curve("roll_coef_delta", &p->roll);
+    xnz_profile_close(&map);
+    return 0;
+}
+
+static int selftest(void)
+{
+    static const struct
+    {
+        const char *text;
+        int valid;
+    }
+    cases[] =
+    {
+        { "detents = 0.311589 0.520279 0.706744\n", 1, },
+        { "shares = 0.5 0.875 1.0\nbrakes = 0.3 0.6 0.9\ndecel = 1 2 3\n", 1, },
+        { "nullzone_pitch_roll = 50:0.125 62.5:0.04\nroll_coef_delta = 2.5:0 26.25:0.025 50:0\n", 1, },
+        { "detents = 0.30 0.35 0.70\n", 0, }, // too close together
+        { "detents = nan 0.5 0.7\n", 0, },
+        { "detents = 0.3 0.5 inf\n", 0, },
+        { "shares = 0.5 nan 1.0\n", 0, },
+        { "brakes = 0.3 0.6 NAN\n", 0, },
+        { "decel = 1 nan 3\n", 0, },
+        { "nullzone_pitch_roll = 50:0.125 nan:0.04\n", 0, },
+        { "nullzone_yaw_tiller = 3.125:nan 31.25:0.04\n", 0, },
+        { "roll_coef_delta = 2.5:0 -inf:0.025\n", 0, },
+        { "unknown = 1\n", 0, },
+    };
+    char dir[] = "/tmp/xnz_profile.selftest.XXXXXX", src[64], bin[64]; int failed = 0;
+    if (NULL == mkdtemp(dir))
+    {
+        fprintf(stderr, "selftest: could not create directory\n");
+        return 1;
+    }
+    snprintf(src, sizeof(src), "%s/t.txt", dir);
+    snprintf(bin, sizeof(bin), "%s/t.xnzp", dir);
+    strcat(dir, "/");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        xnz_profile_map map; char err[1024] = ""; int ret; FILE *f;
+        if (NULL == (f = fopen(src, "w")) || fputs(cases[i].text, f) < 0 || fclose(f))
+        {
+            fprintf(stderr, "selftest: could not write %s\n", src);
+            failed++; break;
+        }
+        ret = xnz_profile_open(&map, dir, "t", err, sizeof(err));
+        if ((ret == 0) != cases[i].valid)
+        {
+            fprintf(stderr, "selftest: case %zu %s: %s", i, ret ? "rejected" : "accepted", cases[i].text);
+            failed++;
+        }
+        if (ret == 0)
+        {
+            xnz_profile_close(&map);
+        }
+        remove(bin); // same size, same second: don't reuse the previous blob
+        remove(src);
+    }
+    dir[strlen(dir) - 1] = '\0';
+    rmdir(dir);
+    printf("selftest: profiles %s, %zu cases (%d failed)\n", failed ? "FAILED" : "ok", sizeof(cases) / sizeof(cases[0]), failed);
+    return failed != 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && !strcmp(argv[1], "-selftest"))
+    {
+        return selftest();
+    }
+    if (argc == 2 && argv[1][0] != '-')
+    {
+        return check(argv[1]);
+    }
+    fprintf(stderr, "usage: %s <profile.txt> | -selftest\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,145 @@
+/*
+ * xnz_stubs.h
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Stub XPLM functions for the tools that build the plugin source itself
+ * (#include "XNZplugin.c" first): datarefs and commands resolve to plain
+ * arrays (xnz_stub_refs) by name, everything else does nothing.
+ */
+
+#ifndef XNZ_STUBS_H
+#define XNZ_STUBS_H
+
+typedef struct
+{
+    const char *name;
+    float f[16];
+    int i[16];
+}
+xnz_stub_ref;
+
+static xnz_stub_ref xnz_stub_refs[256];
+
+static xnz_stub_ref* xnz_stub_find(const char *name)
+{
+    for (size_t i = 0; i < sizeof(xnz_stub_refs) / sizeof(xnz_stub_refs[0]); i++)
+    {
+        if (xnz_stub_refs[i].name == NULL)
+        {
+            xnz_stub_refs[i].name = name;
+            return &xnz_stub_refs[i];
+        }
+        if (!strcmp(xnz_stub_refs[i].name, name))
+        {
+            return &xnz_stub_refs[i];
+        }
+    }
+    return &xnz_stub_refs[0]; // full: share the first one
+}
+
+XPLMDataRef XPLMFindDataRef(const char *inDataRefName) { return xnz_stub_find(inDataRefName); }
+XPLMCommandRef XPLMFindCommand(const char *inName) { return xnz_stub_find(inName); }
+XPLMCommandRef XPLMCreateCommand(const char *inName, const char *inDescription) { return xnz_stub_find(inName); }
+float XPLMGetDataf(XPLMDataRef inDataRef) { return inDataRef ? ((xnz_stub_ref*)inDataRef)->f[0] : 0.0f; }
+int XPLMGetDatai(XPLMDataRef inDataRef) { return inDataRef ? ((xnz_stub_ref*)inDataRef)->i[0] : 0; }
+void XPLMSetDataf(XPLMDataRef inDataRef, float inValue) { if (inDataRef) ((xnz_stub_ref*)inDataRef)->f[0] = inValue; }
+void XPLMSetDatai(XPLMDataRef inDataRef, int inValue) { if (inDataRef) ((xnz_stub_ref*)inDataRef)->i[0] = inValue; }
+int XPLMGetDatab(XPLMDataRef inDataRef, void *outValue, int inOffset, int inMaxBytes) { return 0; }
+
+int XPLMGetDatavf(XPLMDataRef inDataRef, float *outValues, int inOffset, int inMax)
+{
+    for (int n = 0; outValues && n < inMax; n++)
+    {
+        outValues[n] = inDataRef && inOffset + n < 16 ? ((xnz_stub_ref*)inDataRef)->f[inOffset + n] : 0.0f;
+    }
+    return inMax;
+}
+
+int XPLMGetDatavi(XPLMDataRef inDataRef, int *outValues, int inOffset, int inMax)
+{
+    for (int n = 0; outValues && n < inMax; n++)
+    {
+        outValues[n] = inDataRef && inOffset + n < 16 ? ((xnz_stub_ref*)inDataRef)->i[inOffset + n] : 0;
+    }
+    return inMax;
+}
+
+void XPLMSetDatavf(XPLMDataRef inDataRef, float *inValues, int inoffset, int inCount)
+{
+    for (int n = 0; inDataRef && n < inCount && inoffset + n < 16; n++)
+    {
+        ((xnz_stub_ref*)inDataRef)->f[inoffset + n] = inValues[n];
+    }
+}
+
+void XPLMSetDatavi(XPLMDataRef inDataRef, int *inValues, int inoffset, int inCount)
+{
+    for (int n = 0; inDataRef && n < inCount && inoffset + n < 16; n++)
+    {
+        ((xnz_stub_ref*)inDataRef)->i[inoffset + n] = inValues[n];
+    }
+}
+
+XPLMDataRef XPLMRegisterDataAccessor(const char *inDataName, XPLMDataTypeID inDataType, int inIsWritable,
+                                     XPLMGetDatai_f inReadInt, XPLMSetDatai_f inWriteInt,
+                                     XPLMGetDataf_f inReadFloat, XPLMSetDataf_f inWriteFloat,
+                                     XPLMGetDatad_f inReadDouble, XPLMSetDatad_f inWriteDouble,
+                                     XPLMGetDatavi_f inReadIntArray, XPLMSetDatavi_f inWriteIntArray,
+                                     XPLMGetDatavf_f inReadFloatArray, XPLMSetDatavf_f inWriteFloatArray,
+                                     XPLMGetDatab_f inReadData, XPLMSetDatab_f inWriteData,
+                                     void *inReadRefcon, void *inWriteRefcon) { return xnz_stub_find(inDataName); }
+void XPLMUnregisterDataAccessor(XPLMDataRef inDataRef) {}
+void XPLMCommandBegin(XPLMCommandRef inCommand) {}
+void XPLMCommandEnd(XPLMCommandRef inCommand) {}
+void XPLMCommandOnce(XPLMCommandRef inCommand) {}
+void XPLMRegisterCommandHandler(XPLMCommandRef inComand, XPLMCommandCallback_f inHandler, int inBefore, void *inRefcon) {}
+void XPLMUnregisterCommandHandler(XPLMCommandRef inComand, XPLMCommandCallback_f inHandler, int inBefore, void *inRefcon) {}
+void XPLMRegisterFlightLoopCallback(XPLMFlightLoop_f inFlightLoop, float inInterval, void *inRefcon) {}
+void XPLMUnregisterFlightLoopCallback(XPLMFlightLoop_f inFlightLoop, void *inRefcon) {}
+void XPLMSetFlightLoopCallbackInterval(XPLMFlightLoop_f inFlightLoop, float inInterval, int inRelativeToNow, void *inRefcon) {}
+void XPLMDebugString(const char *inString) {}
+void XPLMSpeakString(const char *inString) {}
+void XPLMEnableFeature(const char *inFeature, int inEnable) {}
+void XPLMGetVersions(int *outXPlaneVersion, int *outXPLMVersion, XPLMHostApplicationID *outHostID) { *outXPlaneVersion = 11550; *outXPLMVersion = 303; *outHostID = xplm_Host_XPlane; }
+void XPLMGetPrefsPath(char *outPrefsPath) { strcpy(outPrefsPath, "/tmp/xnz_stubs.prf"); }
+const char* XPLMGetDirectorySeparator(void) { return "/"; }
+char* XPLMExtractFileAndPath(char *inFullPath) { return inFullPath; }
+void XPLMGetNthAircraftModel(int inIndex, char *outFileName, char *outPath) { outFileName[0] = outPath[0] = '\0'; }
+int XPLMCountPlugins(void) { return 0; }
+XPLMPluginID XPLMGetNthPlugin(int inIndex) { return XPLM_NO_PLUGIN_ID; }
+XPLMPluginID XPLMFindPluginBySignature(const char *inSignature) { return XPLM_NO_PLUGIN_ID; }
+int XPLMIsPluginEnabled(XPLMPluginID inPluginID) { return 0; }
+void XPLMSendMessageToPlugin(XPLMPluginID inPlugin, int inMessage, void *inParam) {}
+void XPLMGetPluginInfo(XPLMPluginID inPlugin, char *outName, char *outFilePath, char *outSignature, char *outDescription) {}
+XPLMMenuID XPLMCreateMenu(const char *inName, XPLMMenuID inParentMenu, int inParentItem, XPLMMenuHandler_f inHandler, void *inMenuRef) { return NULL; }
+int XPLMAppendMenuItem(XPLMMenuID inMenu, const char *inItemName, void *inItemRef, int inDeprecatedAndIgnored) { return 0; }
+void XPLMCheckMenuItem(XPLMMenuID inMenu, int index, XPLMMenuCheck inCheck) {}
+void XPLMCheckMenuItemState(XPLMMenuID inMenu, int index, XPLMMenuCheck *outCheck) { *outCheck = xplm_Menu_NoCheck; }
+XPLMWindowID XPLMCreateWindowEx(XPLMCreateWindow_t *inParams) { return NULL; }
+void XPLMDestroyWindow(XPLMWindowID inWindowID) {}
+void XPLMSetWindowIsVisible(XPLMWindowID inWindowID, int inIsVisible) {}
+void XPLMSetWindowGeometry(XPLMWindowID inWindowID, int inLeft, int inTop, int inRight, int inBottom) {}
+void XPLMGetScreenSize(int *outWidth, int *outHeight) { if (outWidth) *outWidth = 1920; if (outHeight) *outHeight = 1080; }
+void XPLMGetFontDimensions(XPLMFontID inFontID, int *outCharWidth, int *outCharHeight, int *outDigitsOnly) {}
+float XPLMMeasureString(XPLMFontID inFontID, const char *inChar, int inNumChars) { return 0.0f; }
+void XPLMDrawString(float *inColorRGB, int inXOffset, int inYOffset, char *inChar, int *inWordWrapWidth, XPLMFontID inFontID) {}
+void XPLMDrawTranslucentDarkBox(int inLeft, int inTop, int inRight, int inBottom) {}
+
+#endif /* XNZ_STUBS_H */
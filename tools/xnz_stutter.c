@@ -0,0 +1,164 @@
+/*
+ * xnz_stutter.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Runs the plugin's stutter detector (see src/XNZstutter.h) offline, over the
+ * tick times of an axis trace (see src/XNZtrace.h); the baseline restarts
+ * after each gap (dropped records):
+ *
+ *   xnz_stutter <Output/preferences/x-nullzones.trace>
+ *   xnz_stutter -selftest       step changes and spikes in frame time
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XNZstutter.h"
+#include "XNZtrace.h"
+
+static int scan(const char *path)
+{
+    xnz_trace_header h; xnz_trace_record r; uint8_t buf[64 * 1024]; xnz_stutter_baseline b;
+    size_t avail = 0, offset = 0, n; uint32_t next = 0; uint64_t count = 0, stutters = 0, last = 0; FILE *f;
+    if (NULL == (f = fopen(path, "rb")))
+    {
+        fprintf(stderr, "%s: could not open file\n", path);
+        return 1;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 ||
+        h.magic != XNZ_TRACE_MAGIC ||
+        h.version != XNZ_TRACE_VERSION ||
+        h.record_size != sizeof(xnz_trace_record))
+    {
+        fprintf(stderr, "%s: not a trace, or unsupported version\n", path);
+        fclose(f); return 1;
+    }
+    memset(&r, 0, sizeof(r));
+    memset(&b, 0, sizeof(b));
+
+    while (1)
+    {
+        if (avail - offset < XNZ_TRACE_ENCODED_MAX)
+        {
+            memmove(buf, buf + offset, avail - offset);
+            avail -= offset; offset = 0;
+            avail += fread(buf + avail, 1, sizeof(buf) - avail, f);
+            if (avail == 0)
+            {
+                break;
+            }
+        }
+        if (0 == (n = xnz_trace_decode(&r, buf + offset, avail - offset)))
+        {
+            fprintf(stderr, "%s: truncated record after %" PRIu64 " records\n", path, count);
+            break;
+        }
+        offset += n;
+        if (count++ == 0 || r.sequence != next)
+        {
+            memset(&b, 0, sizeof(b));
+        }
+        else
+        {
+            double average = b.average, period = (double)(int64_t)(r.time - last);
+            if (xnz_stutter_check(&b, period))
+            {
+                printf("%8" PRIu32 " %10.3f stutter: %.3f ms (average %.3f ms)\n",
+                       r.sequence, (double)(int64_t)(r.time - h.started) / 1e9, period / 1e6, average / 1e6);
+                stutters++;
+            }
+        }
+        next = r.sequence + 1;
+        last = r.time;
+    }
+    fclose(f);
+    printf("%" PRIu64 " ticks, %" PRIu64 " stutters\n", count, stutters);
+    return 0;
+}
+
+/*
+ * Feeds n periods of ns nanoseconds; returns the number of stutters.
+ */
+static int feed(xnz_stutter_baseline *b, double ns, int n)
+{
+    int stutters = 0;
+    for (int i = 0; i < n; i++)
+    {
+        stutters += xnz_stutter_check(b, ns) != 0;
+    }
+    return stutters;
+}
+
+static int selftest(void)
+{
+    xnz_stutter_baseline b; int failed = 0, n;
+    memset(&b, 0, sizeof(b));
+
+    if ((n = feed(&b, 16.7e6, 500))) // 60 fps
+    {
+        fprintf(stderr, "selftest: steady 60 fps: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 100e6, 1)) != 1) // one spike
+    {
+        fprintf(stderr, "selftest: spike at 60 fps: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 16.7e6, 100)))
+    {
+        fprintf(stderr, "selftest: 60 fps after a spike: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 40e6, 500)) > XNZ_STUTTER_REBASE - 1) // step down to 25 fps
+    {
+        fprintf(stderr, "selftest: step to 25 fps: %d stutters (max. %d)\n", n, XNZ_STUTTER_REBASE - 1); failed++;
+    }
+    if ((n = feed(&b, 100e6, 1)) != 1) // spikes must still show at the new rate
+    {
+        fprintf(stderr, "selftest: spike at 25 fps: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 40e6, 100)))
+    {
+        fprintf(stderr, "selftest: 25 fps after a spike: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 16.7e6, 500))) // back up to 60 fps
+    {
+        fprintf(stderr, "selftest: step to 60 fps: %d stutters\n", n); failed++;
+    }
+    if ((n = feed(&b, 100e6, 1)) != 1)
+    {
+        fprintf(stderr, "selftest: spike after the steps: %d stutters\n", n); failed++;
+    }
+    printf("selftest: stutter detector %s (%d failed)\n", failed ? "FAILED" : "ok", failed);
+    return failed != 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && !strcmp(argv[1], "-selftest"))
+    {
+        return selftest();
+    }
+    if (argc == 2 && argv[1][0] != '-')
+    {
+        return scan(argv[1]);
+    }
+    fprintf(stderr, "usage: %s <trace> | -selftest\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * xnz_telemetry.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Example telemetry reader (see src/XNZtelemetry.h): follows the latest frame
+ * while the plugin runs, or prints the history currently in the ring:
+ *
+ *   xnz_telemetry [-q] [-history]
+ *
+ * -q: Quadrant314 (public build) segment.
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "XNZtelemetry.h"
+
+static void print_frame(const xnz_telemetry *t, const xnz_telemetry_frame *f)
+{
+    printf("%8" PRIu32 " %10.3f  lever %.4f %.4f  zone %2d %2d  out %8.5f %8.5f  pipe %" PRId32 "  brake %.3f (%5.2f m/s²)  nz %.4f %.4f  be",
+           f->index, (double)(int64_t)(f->time - t->started) / 1e9,
+           f->lever_inn[0], f->lever_inn[1], f->lever_zone[0], f->lever_zone[1],
+           f->engine_out[0], f->engine_out[1], f->pipeline,
+           f->brake_output, f->brake_decel, f->nullzone[0], f->nullzone[1]);
+    for (int i = 0; i < XNZ_TELEMETRY_BACKEND_COUNT; i++)
+    {
+        printf(" %d", f->backend[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = XNZ_TELEMETRY_NAME; int history = 0; xnz_shm shm;
+    const xnz_telemetry *t; xnz_telemetry_frame f;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-q"))
+        {
+            name = XNZ_TELEMETRY_NAME_PUBLIC;
+            continue;
+        }
+        if (!strcmp(argv[i], "-history"))
+        {
+            history = 1;
+            continue;
+        }
+        fprintf(stderr, "usage: %s [-q] [-history]\n", argv[0]);
+        return 1;
+    }
+    if (xnz_shm_open(&shm, name, sizeof(xnz_telemetry), 0))
+    {
+        fprintf(stderr, "%s: not available (is the plugin running?)\n", name);
+        return 1;
+    }
+    t = shm.base;
+    if (xnz_atomic_load_u32(&t->magic) != XNZ_TELEMETRY_MAGIC ||
+        t->version != XNZ_TELEMETRY_VERSION ||
+        t->frame_size != sizeof(xnz_telemetry_frame) ||
+        t->frame_count != XNZ_TELEMETRY_FRAMES)
+    {
+        fprintf(stderr, "%s: not initialized, or unsupported version\n", name);
+        xnz_shm_close(&shm); return 1;
+    }
+    if (history)
+    {
+        uint32_t head = xnz_atomic_load_u32(&t->head);
+        uint32_t first = head > XNZ_TELEMETRY_FRAMES ? head - XNZ_TELEMETRY_FRAMES : 0;
+        for (uint32_t index = first; index != head; index++)
+        {
+            if (xnz_telemetry_read(t, index, &f) == 0) // else overwritten meanwhile
+            {
+                print_frame(t, &f);
+            }
+        }
+        xnz_shm_close(&shm); return 0;
+    }
+    for (uint32_t last = UINT32_MAX; xnz_atomic_load_u32(&t->live); xnz_sleep_ms(50))
+    {
+        if (xnz_telemetry_latest(t, &f) == 0 && f.index != last)
+        {
+            print_frame(t, &f);
+            last = f.index;
+        }
+    }
+    printf("writer stopped\n");
+    xnz_shm_close(&shm); return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * xnz_trace.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Offline decoder for axis pipeline traces (see src/XNZtrace.h); prints one
+ * line per tick, oldest first, and a note for each gap (dropped records):
+ *
+ *   xnz_trace <Output/preferences/x-nullzones.trace>
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XNZtrace.h"
+
+static const char* pipeline_name(int pipeline)
+{
+    switch (pipeline)
+    {
+        case 0: return "OFF";
+        case 1: return "NOIN";
+        case 2: return "AUTO";
+        case 3: return "SKIP";
+        case 4: return "TOGG";
+        case 5: return "WRIT";
+        case 6: return "NSUP";
+        default: return "?";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    xnz_trace_header h; xnz_trace_record r; uint8_t buf[64 * 1024];
+    size_t avail = 0, offset = 0, n; uint32_t next = 0; uint64_t count = 0; FILE *f;
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <trace>\n", argv[0]);
+        return 1;
+    }
+    if (NULL == (f = fopen(argv[1], "rb")))
+    {
+        fprintf(stderr, "%s: could not open file\n", argv[1]);
+        return 1;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 ||
+        h.magic != XNZ_TRACE_MAGIC ||
+        h.version != XNZ_TRACE_VERSION ||
+        h.record_size != sizeof(xnz_trace_record))
+    {
+        fprintf(stderr, "%s: not a trace, or unsupported version\n", argv[1]);
+        fclose(f); return 1;
+    }
+    memset(&r, 0, sizeof(r));
+
+    printf("%8s %10s %-17s %-17s %-17s %-17s %5s %4s %-4s %4s %3s %-8s\n",
+           "seq", "time (s)", "raw", "sync", "mapped", "written", "zones", "skip", "pipe", "cmds", "tt", "propmode");
+    while (1)
+    {
+        if (avail - offset < XNZ_TRACE_ENCODED_MAX)
+        {
+            memmove(buf, buf + offset, avail - offset);
+            avail -= offset; offset = 0;
+            avail += fread(buf + avail, 1, sizeof(buf) - avail, f);
+            if (avail == 0)
+            {
+                break;
+            }
+        }
+        if (0 == (n = xnz_trace_decode(&r, buf + offset, avail - offset)))
+        {
+            fprintf(stderr, "%s: truncated record after %" PRIu64 " records\n", argv[1], count);
+            break;
+        }
+        offset += n; count++;
+        if (r.sequence != next)
+        {
+            printf("%8s (%" PRIu32 " records dropped)\n", "-", r.sequence - next);
+        }
+        next = r.sequence + 1;
+        printf("%8" PRIu32 " %10.3f %8.5f %8.5f %8.5f %8.5f %8.5f %8.5f %8.5f %8.5f %2d %2d %4u %-4s %4u %3d ",
+               r.sequence, (double)(int64_t)(r.time - h.started) / 1e9,
+               r.raw[0], r.raw[1], r.sync[0], r.sync[1],
+               r.mapped[0], r.mapped[1], r.written[0], r.written[1],
+               r.zone[0], r.zone[1], r.skip, pipeline_name(r.pipeline), r.commands, r.tt);
+        for (int i = 0; i < 8; i++)
+        {
+            printf("%d", r.propmode[i]);
+        }
+        printf("\n");
+    }
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,676 @@
+/*
+ * xnz_trace_stats.c
+ *
+ * This file is part of the x-nullzones source code.
+ *
+ * (C) Copyright 2020 Timothy D. Walker and others.
+ *
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of the GNU General Public License (GPL) version 2
+ * which accompanies this distribution (LICENSE file), and is also available at
+ * http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * Contributors:
+ *     Timothy D. Walker
+ */
+
+/*
+ * Aggregate statistics over any number of axis pipeline traces (see
+ * src/XNZtrace.h), e.g. a whole fleet's worth of flights:
+ *
+ *   xnz_trace_stats [-j threads] [-v] <trace>...
+ *
+ * Per lever: time spent in each zone, zone (detent) dwell times, output steps
+ * (ticks where the written value changed, and by how much), transitions into
+ * reverse and input-to-output lag (from a change of the raw lever value to
+ * the next change of the written value); overall: beta/reverse toggle
+ * commands fired and records dropped while recording. -v adds one line per
+ * trace.
+ *
+ * Traces are memory-mapped and analyzed in parallel, one trace per task: each
+ * worker owns a deque of tasks, largest traces first, and steals from the
+ * others when its own is empty. A trace is decoded in chunks into one array
+ * per field; the arithmetic runs over those arrays in XNZ_STATS_LANES
+ * independent lanes (no intrinsics: the compiler vectorizes the loops). Each
+ * worker accumulates into its own statistics, merged once all are done.
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, O_CLOEXEC etc. with -std=c99
+#endif
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XNZhist.h"
+#include "XNZplatform.h"
+#include "XNZtrace.h"
+
+#define XNZ_STATS_CHUNK   4096 // records decoded per pass
+#define XNZ_STATS_LANES   8
+#define XNZ_STATS_WORKERS 64
+#define XNZ_STATS_ZONES   5 // no zone (-1), then ZONE_REV..ZONE_TGA
+#define XNZ_STATS_LAG_MAX 1000000000ull // raw changes not followed by an output change within 1 s are not lag
+
+static const char *zone_names[XNZ_STATS_ZONES] = { "none", "REV", "CLB", "FLX", "TGA", };
+
+typedef struct
+{
+    uint64_t files;
+    uint64_t bad; // not a trace, unsupported version or truncated
+    uint64_t records;
+    uint64_t dropped;
+    uint64_t duration; // ns, first to last record
+    uint64_t commands;
+    uint64_t zone_ns[2][XNZ_STATS_ZONES];
+    uint64_t steps[2];
+    uint64_t reversals[2];
+    uint64_t unanswered[2]; // raw changes without an output change (see XNZ_STATS_LAG_MAX)
+    double step_sum[2];
+    float step_max[2];
+    xnz_hist dwell[2][XNZ_STATS_ZONES]; // milliseconds (nanoseconds would saturate at ~4.3 s)
+    xnz_hist lag[2]; // nanoseconds
+}
+trace_stats;
+
+/*
+ * One chunk of decoded records, one array per field; index 0 holds the last
+ * record of the previous chunk (unless this is the first one).
+ */
+typedef struct
+{
+    uint64_t time[XNZ_STATS_CHUNK + 1];
+    uint64_t dt[XNZ_STATS_CHUNK + 1];
+    uint32_t sequence[XNZ_STATS_CHUNK + 1];
+    float raw[2][XNZ_STATS_CHUNK + 1];
+    float mapped[2][XNZ_STATS_CHUNK + 1];
+    float written[2][XNZ_STATS_CHUNK + 1];
+    int8_t zone[2][XNZ_STATS_CHUNK + 1];
+    uint8_t commands[XNZ_STATS_CHUNK + 1];
+}
+trace_chunk;
+
+/*
+ * Sequential state carried from one chunk to the next.
+ */
+typedef struct
+{
+    uint64_t run_start[2]; // current zone's first record
+    uint64_t pending[2]; // time of a raw change not yet followed by an output change
+    int has_pending[2];
+}
+trace_state;
+
+typedef struct
+{
+    uint32_t top XNZ_CACHELINE_ALIGNED; // thieves
+    uint32_t bottom XNZ_CACHELINE_ALIGNED; // owner
+    uint32_t *task; // indices in trace_job.path
+}
+task_deque;
+
+typedef struct
+{
+    uint64_t records;
+    uint64_t duration;
+    uint64_t dropped;
+    int status; // 0: ok, 1: bad, 2: truncated
+}
+trace_summary;
+
+typedef struct trace_job trace_job;
+
+typedef struct
+{
+    trace_job *job;
+    uint32_t index;
+    xnz_thread thread;
+    task_deque deque;
+    trace_chunk *chunk;
+    trace_stats *stats;
+}
+trace_worker;
+
+struct trace_job
+{
+    char **path;
+    uint64_t *size;
+    trace_summary *summary;
+    uint32_t count;
+    uint32_t workers;
+    trace_worker worker[XNZ_STATS_WORKERS];
+};
+
+static int zone_slot(int zone)
+{
+    return zone < -1 || zone >= XNZ_STATS_ZONES - 1 ? 0 : zone + 1;
+}
+
+/*
+ * Kernels: n records from index 1 (index 0: the previous record).
+ */
+static void kernel_steps(const float *restrict w, size_t n, uint64_t *count, double *sum, float *max)
+{
+    uint32_t c[XNZ_STATS_LANES] = { 0, }; float s[XNZ_STATS_LANES] = { 0, }, m[XNZ_STATS_LANES] = { 0, };
+    size_t i = 1;
+    for (; i + XNZ_STATS_LANES <= n + 1; i += XNZ_STATS_LANES)
+    {
+        for (int l = 0; l < XNZ_STATS_LANES; l++)
+        {
+            float d = fabsf(w[i + l] - w[i + l - 1]);
+            c[l] += d != 0.0f;
+            s[l] += d;
+            m[l] = m[l] > d ? m[l] : d;
+        }
+    }
+    for (; i < n + 1; i++)
+    {
+        float d = fabsf(w[i] - w[i - 1]);
+        c[0] += d != 0.0f;
+        s[0] += d;
+        m[0] = m[0] > d ? m[0] : d;
+    }
+    for (int l = 0; l < XNZ_STATS_LANES; l++)
+    {
+        *count += c[l];
+        *sum += s[l];
+        *max = *max > m[l] ? *max : m[l];
+    }
+}
+
+static uint64_t kernel_reversals(const float *restrict m, size_t n)
+{
+    uint32_t c[XNZ_STATS_LANES] = { 0, }; uint64_t count = 0; size_t i = 1;
+    for (; i + XNZ_STATS_LANES <= n + 1; i += XNZ_STATS_LANES)
+    {
+        for (int l = 0; l < XNZ_STATS_LANES; l++)
+        {
+            c[l] += (m[i + l - 1] >= 0.0f) & (m[i + l] < 0.0f);
+        }
+    }
+    for (; i < n + 1; i++)
+    {
+        c[0] += (m[i - 1] >= 0.0f) & (m[i] < 0.0f);
+    }
+    for (int l = 0; l < XNZ_STATS_LANES; l++)
+    {
+        count += c[l];
+    }
+    return count;
+}
+
+/*
+ * dt[i]: time from record i - 1 to record i, i.e. spent in record i - 1's zone.
+ */
+static void kernel_dt(const uint64_t *restrict t, uint64_t *restrict dt, size_t n)
+{
+    for (size_t i = 1; i < n + 1; i++)
+    {
+        dt[i] = t[i] - t[i - 1];
+    }
+}
+
+static uint64_t kernel_zone_ns(const int8_t *restrict zone, const uint64_t *restrict dt, size_t n, int8_t z)
+{
+    uint64_t s[XNZ_STATS_LANES] = { 0, }, sum = 0; size_t i = 1;
+    for (; i + XNZ_STATS_LANES <= n + 1; i += XNZ_STATS_LANES)
+    {
+        for (int l = 0; l < XNZ_STATS_LANES; l++)
+        {
+            s[l] += zone[i + l - 1] == z ? dt[i + l] : 0;
+        }
+    }
+    for (; i < n + 1; i++)
+    {
+        s[0] += zone[i - 1] == z ? dt[i] : 0;
+    }
+    for (int l = 0; l < XNZ_STATS_LANES; l++)
+    {
+        sum += s[l];
+    }
+    return sum;
+}
+
+static uint64_t kernel_dropped(const uint32_t *restrict seq, size_t n)
+{
+    uint64_t s[XNZ_STATS_LANES] = { 0, }, sum = 0; size_t i = 1;
+    for (; i + XNZ_STATS_LANES <= n + 1; i += XNZ_STATS_LANES)
+    {
+        for (int l = 0; l < XNZ_STATS_LANES; l++)
+        {
+            s[l] += seq[i + l] - seq[i + l - 1] - 1;
+        }
+    }
+    for (; i < n + 1; i++)
+    {
+        s[0] += seq[i] - seq[i - 1] - 1;
+    }
+    for (int l = 0; l < XNZ_STATS_LANES; l++)
+    {
+        sum += s[l];
+    }
+    return sum;
+}
+
+static uint64_t kernel_commands(const uint8_t *restrict c, size_t n)
+{
+    uint32_t s[XNZ_STATS_LANES] = { 0, }; uint64_t sum = 0; size_t i = 1;
+    for (; i + XNZ_STATS_LANES <= n + 1; i += XNZ_STATS_LANES)
+    {
+        for (int l = 0; l < XNZ_STATS_LANES; l++)
+        {
+            s[l] += c[i + l];
+        }
+    }
+    for (; i < n + 1; i++)
+    {
+        s[0] += c[i];
+    }
+    for (int l = 0; l < XNZ_STATS_LANES; l++)
+    {
+        sum += s[l];
+    }
+    return sum;
+}
+
+/*
+ * Dwell times and lag depend on what came before: one sequential pass.
+ */
+static void scan_runs(const trace_chunk *c, size_t n, int lever, trace_state *st, trace_stats *s)
+{
+    const int8_t *zone = c->zone[lever]; const float *raw = c->raw[lever], *w = c->written[lever];
+    for (size_t i = 1; i < n + 1; i++)
+    {
+        if (zone[i] != zone[i - 1])
+        {
+            xnz_hist_record(&s->dwell[lever][zone_slot(zone[i - 1])], (c->time[i] - st->run_start[lever]) / 1000000);
+            st->run_start[lever] = c->time[i];
+        }
+        if (st->has_pending[lever] && c->time[i] - st->pending[lever] > XNZ_STATS_LAG_MAX)
+        {
+            st->has_pending[lever] = 0;
+            s->unanswered[lever]++;
+        }
+        if (raw[i] != raw[i - 1] && st->has_pending[lever] == 0)
+        {
+            st->pending[lever] = c->time[i];
+            st->has_pending[lever] = 1;
+        }
+        if (w[i] != w[i - 1] && st->has_pending[lever])
+        {
+            xnz_hist_record(&s->lag[lever], c->time[i] - st->pending[lever]);
+            st->has_pending[lever] = 0;
+        }
+    }
+}
+
+static void analyze_chunk(trace_chunk *c, size_t n, trace_state *st, trace_stats *s)
+{
+    kernel_dt(c->time, c->dt, n);
+    s->dropped += kernel_dropped(c->sequence, n);
+    s->commands += kernel_commands(c->commands, n);
+    for (int lever = 0; lever < 2; lever++)
+    {
+        for (int z = 0; z < XNZ_STATS_ZONES; z++)
+        {
+            s->zone_ns[lever][z] += kernel_zone_ns(c->zone[lever], c->dt, n, (int8_t)(z - 1));
+        }
+        kernel_steps(c->written[lever], n, &s->steps[lever], &s->step_sum[lever], &s->step_max[lever]);
+        s->reversals[lever] += kernel_reversals(c->mapped[lever], n);
+        scan_runs(c, n, lever, st, s);
+    }
+}
+
+static void chunk_store(trace_chunk *c, size_t i, const xnz_trace_record *r)
+{
+    c->time[i] = r->time;
+    c->sequence[i] = r->sequence;
+    c->commands[i] = r->commands;
+    for (int lever = 0; lever < 2; lever++)
+    {
+        c->raw[lever][i] = r->raw[lever];
+        c->mapped[lever][i] = r->mapped[lever];
+        c->written[lever][i] = r->written[lever];
+        c->zone[lever][i] = r->zone[lever];
+    }
+}
+
+static void analyze_trace(trace_worker *w, uint32_t task)
+{
+    trace_summary *sum = &w->job->summary[task]; trace_chunk *c = w->chunk; trace_stats *s = w->stats;
+    xnz_file_map m; xnz_trace_header h; xnz_trace_record r; trace_state st;
+    size_t offset = sizeof(h), n = 0, used; uint64_t first = 0, last = 0, dropped = s->dropped;
+    if (xnz_file_map_open(&m, w->job->path[task]))
+    {
+        sum->status = 1; s->bad++; s->files++;
+        return;
+    }
+    memcpy(&h, m.base, m.size < sizeof(h) ? m.size : sizeof(h));
+    if (m.size < sizeof(h) || h.magic != XNZ_TRACE_MAGIC || h.version != XNZ_TRACE_VERSION || h.record_size != sizeof(r))
+    {
+        xnz_file_map_close(&m);
+        sum->status = 1; s->bad++; s->files++;
+        return;
+    }
+    memset(&r, 0, sizeof(r));
+    memset(&st, 0, sizeof(st));
+    while (offset < m.size)
+    {
+        if (0 == (used = xnz_trace_decode(&r, (const uint8_t*)m.base + offset, m.size - offset)))
+        {
+            sum->status = 2;
+            break;
+        }
+        offset += used;
+        if (sum->records++ == 0)
+        {
+            chunk_store(c, 0, &r); // compares with itself: no step, no change
+            first = st.run_start[0] = st.run_start[1] = r.time;
+            continue;
+        }
+        chunk_store(c, ++n, &r);
+        if (n == XNZ_STATS_CHUNK)
+        {
+            analyze_chunk(c, n, &st, s);
+            chunk_store(c, 0, &r);
+            n = 0;
+        }
+    }
+    if (n)
+    {
+        analyze_chunk(c, n, &st, s);
+    }
+    if (sum->records)
+    {
+        last = r.time;
+        for (int lever = 0; lever < 2; lever++)
+        {
+            xnz_hist_record(&s->dwell[lever][zone_slot(r.zone[lever])], (last - st.run_start[lever]) / 1000000); // cut short by the end of the trace
+        }
+    }
+    xnz_file_map_close(&m);
+    sum->duration = last - first;
+    sum->dropped = s->dropped - dropped;
+    s->duration += sum->duration;
+    s->records += sum->records;
+    s->bad += sum->status != 0;
+    s->files++;
+}
+
+/*
+ * Work-stealing deques (after Chase and Lev, without push: every task is
+ * dealt before the workers start). The owner takes from the bottom, thieves
+ * from the top; a compare-and-swap on top settles the race for the last task.
+ */
+static int deque_pop(task_deque *d, uint32_t *task)
+{
+    uint32_t b = xnz_atomic_load_u32(&d->bottom) - 1, t;
+    xnz_atomic_store_u32(&d->bottom, b);
+    xnz_atomic_fence();
+    t = xnz_atomic_load_u32(&d->top);
+    if ((int32_t)(b - t) < 0)
+    {
+        xnz_atomic_store_u32(&d->bottom, b + 1); // empty
+        return 0;
+    }
+    *task = d->task[b];
+    if (b != t)
+    {
+        return 1;
+    }
+    int won = xnz_atomic_cas_u32(&d->top, &t, t + 1); // last task: race the thieves
+    xnz_atomic_store_u32(&d->bottom, b + 1);
+    return won;
+}
+
+static int deque_steal(task_deque *d, uint32_t *task)
+{
+    uint32_t t = xnz_atomic_load_u32(&d->top), b;
+    xnz_atomic_fence();
+    b = xnz_atomic_load_u32(&d->bottom);
+    if ((int32_t)(b - t) <= 0)
+    {
+        return 0;
+    }
+    *task = d->task[t];
+    return xnz_atomic_cas_u32(&d->top, &t, t + 1);
+}
+
+static XNZ_THREAD_RETURN XNZ_THREAD_CALL worker_run(void *arg)
+{
+    trace_worker *w = arg; trace_job *job = w->job; uint32_t task;
+    while (1)
+    {
+        if (deque_pop(&w->deque, &task))
+        {
+            analyze_trace(w, task);
+            continue;
+        }
+        int found = 0;
+        for (uint32_t i = 1; i < job->workers && found == 0; i++) // nothing left of our own: steal
+        {
+            trace_worker *victim = &job->worker[(w->index + i) % job->workers];
+            while (found == 0 && (int32_t)(xnz_atomic_load_u32(&victim->deque.bottom) - xnz_atomic_load_u32(&victim->deque.top)) > 0)
+            {
+                found = deque_steal(&victim->deque, &task); // lost a race: retry while it isn't empty
+            }
+        }
+        if (found == 0)
+        {
+            return 0; // no task is ever added: every deque is empty for good
+        }
+        analyze_trace(w, task);
+    }
+}
+
+static uint32_t cpu_count(void)
+{
+#if IBM
+    SYSTEM_INFO si; GetSystemInfo(&si); long n = (long)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return n < 1 ? 1 : n > XNZ_STATS_WORKERS ? XNZ_STATS_WORKERS : (uint32_t)n;
+}
+
+static trace_job *sort_job; // qsort has no context argument
+
+static int by_size_ascending(const void *a, const void *b)
+{
+    uint64_t sa = sort_job->size[*(const uint32_t*)a], sb = sort_job->size[*(const uint32_t*)b];
+    return sa < sb ? -1 : sa > sb;
+}
+
+static void stats_merge(trace_stats *dst, const trace_stats *src)
+{
+    dst->files += src->files;
+    dst->bad += src->bad;
+    dst->records += src->records;
+    dst->dropped += src->dropped;
+    dst->duration += src->duration;
+    dst->commands += src->commands;
+    for (int lever = 0; lever < 2; lever++)
+    {
+        for (int z = 0; z < XNZ_STATS_ZONES; z++)
+        {
+            dst->zone_ns[lever][z] += src->zone_ns[lever][z];
+            xnz_hist_merge(&dst->dwell[lever][z], &src->dwell[lever][z]);
+        }
+        dst->steps[lever] += src->steps[lever];
+        dst->reversals[lever] += src->reversals[lever];
+        dst->unanswered[lever] += src->unanswered[lever];
+        dst->step_sum[lever] += src->step_sum[lever];
+        dst->step_max[lever] = dst->step_max[lever] > src->step_max[lever] ? dst->step_max[lever] : src->step_max[lever];
+        xnz_hist_merge(&dst->lag[lever], &src->lag[lever]);
+    }
+}
+
+static void print_hist(const char *name, const xnz_hist *h, double scale, const char *unit)
+{
+    printf("  %-12s %10" PRIu64 "  p50 %10.3f  p90 %10.3f  p99 %10.3f  max %10.3f  mean %10.3f (%s)\n", name, h->count,
+           xnz_hist_quantile(h, 0.50) / scale, xnz_hist_quantile(h, 0.90) / scale, xnz_hist_quantile(h, 0.99) / scale,
+           h->max / scale, h->count ? (double)h->sum / (double)h->count / scale : 0.0, unit);
+}
+
+static void print_report(const trace_stats *s, double elapsed)
+{
+    printf("%" PRIu64 " traces (%" PRIu64 " unreadable or truncated), %" PRIu64 " records (%" PRIu64 " dropped), %.1f h recorded, analyzed in %.3f s\n",
+           s->files, s->bad, s->records, s->dropped, (double)s->duration / 3.6e12, elapsed);
+    printf("beta/reverse toggle commands: %" PRIu64 "\n", s->commands);
+    for (int lever = 0; lever < 2; lever++)
+    {
+        uint64_t total = 0;
+        for (int z = 0; z < XNZ_STATS_ZONES; z++)
+        {
+            total += s->zone_ns[lever][z];
+        }
+        printf("\nlever %d\n", lever + 1);
+        for (int z = 0; z < XNZ_STATS_ZONES; z++)
+        {
+            printf("  zone %-4s %10.1f s (%5.1f%%)\n", zone_names[z], (double)s->zone_ns[lever][z] / 1e9,
+                   total ? 100.0 * (double)s->zone_ns[lever][z] / (double)total : 0.0);
+        }
+        printf("  output steps %" PRIu64 " (mean %.5f, max %.5f), into reverse %" PRIu64 "\n", s->steps[lever],
+               s->steps[lever] ? s->step_sum[lever] / (double)s->steps[lever] : 0.0, s->step_max[lever], s->reversals[lever]);
+        printf("  dwell\n");
+        for (int z = 0; z < XNZ_STATS_ZONES; z++)
+        {
+            print_hist(zone_names[z], &s->dwell[lever][z], 1e3, "s");
+        }
+        print_hist("lag", &s->lag[lever], 1e6, "ms");
+        printf("  raw changes without output change within %.0f ms: %" PRIu64 "\n", XNZ_STATS_LAG_MAX / 1e6, s->unanswered[lever]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    trace_job job; trace_stats *total = NULL; uint32_t *order = NULL, workers = cpu_count(), started = 0;
+    int verbose = 0, ret = 1; xnz_file_map m;
+    memset(&job, 0, sizeof(job));
+    if (NULL == (job.path = calloc(argc, sizeof(*job.path))))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        {
+            long j = strtol(argv[++i], NULL, 10);
+            workers = j < 1 ? 1 : j > XNZ_STATS_WORKERS ? XNZ_STATS_WORKERS : (uint32_t)j;
+            continue;
+        }
+        if (!strcmp(argv[i], "-v"))
+        {
+            verbose = 1;
+            continue;
+        }
+        job.path[job.count++] = argv[i];
+    }
+    if (job.count == 0)
+    {
+        fprintf(stderr, "usage: %s [-j threads] [-v] <trace>...\n", argv[0]);
+        free(job.path); return 1;
+    }
+    if (workers > job.count)
+    {
+        workers = job.count;
+    }
+    if (NULL == (job.size = calloc(job.count, sizeof(*job.size))) ||
+        NULL == (job.summary = calloc(job.count, sizeof(*job.summary))) ||
+        NULL == (order = calloc(job.count, sizeof(*order))) ||
+        NULL == (total = xnz_aligned_calloc(sizeof(*total))))
+    {
+        fprintf(stderr, "out of memory\n");
+        goto end;
+    }
+    for (uint32_t i = 0; i < job.count; i++)
+    {
+        if (xnz_file_map_open(&m, job.path[i]) == 0)
+        {
+            job.size[i] = m.size;
+            xnz_file_map_close(&m);
+        }
+        order[i] = i;
+    }
+
+    /* deal largest last, i.e. at the bottom of each deque: owners start with their largest traces */
+    sort_job = &job;
+    qsort(order, job.count, sizeof(*order), &by_size_ascending);
+    job.workers = workers;
+    for (uint32_t w = 0; w < workers; w++)
+    {
+        trace_worker *tw = &job.worker[w];
+        tw->job = &job;
+        tw->index = w;
+        if (NULL == (tw->deque.task = calloc(job.count / workers + 1, sizeof(uint32_t))) ||
+            NULL == (tw->chunk = xnz_aligned_calloc(sizeof(trace_chunk))) ||
+            NULL == (tw->stats = xnz_aligned_calloc(sizeof(trace_stats))))
+        {
+            fprintf(stderr, "out of memory\n");
+            goto end;
+        }
+    }
+    for (uint32_t i = 0; i < job.count; i++)
+    {
+        task_deque *d = &job.worker[i % workers].deque;
+        d->task[d->bottom++] = order[i];
+    }
+    uint64_t start = xnz_time_ns();
+    for (; started < workers; started++)
+    {
+        if (xnz_thread_create(&job.worker[started].thread, &worker_run, &job.worker[started]))
+        {
+            fprintf(stderr, "could not start thread\n");
+            break; // the others steal its tasks
+        }
+    }
+    if (started == 0)
+    {
+        goto end;
+    }
+    for (uint32_t w = 0; w < started; w++)
+    {
+        xnz_thread_join(job.worker[w].thread);
+    }
+    for (uint32_t w = 0; w < workers; w++)
+    {
+        stats_merge(total, job.worker[w].stats);
+    }
+    double elapsed = (double)(xnz_time_ns() - start) / 1e9;
+
+    if (verbose)
+    {
+        for (uint32_t i = 0; i < job.count; i++)
+        {
+            trace_summary *s = &job.summary[i];
+            printf("%-9s %10" PRIu64 " records %10.1f s %8" PRIu64 " dropped  %s\n",
+                   s->status == 1 ? "bad" : s->status == 2 ? "truncated" : "ok",
+                   s->records, (double)s->duration / 1e9, s->dropped, job.path[i]);
+        }
+        printf("\n");
+    }
+    print_report(total, elapsed);
+    ret = total->bad != 0;
+
+end:
+    for (uint32_t w = 0; w < XNZ_STATS_WORKERS; w++)
+    {
+        free(job.worker[w].deque.task);
+        xnz_aligned_free(job.worker[w].chunk);
+        xnz_aligned_free(job.worker[w].stats);
+    }
+    xnz_aligned_free(total);
+    free(order);
+    free(job.summary);
+    free(job.size);
+    free(job.path);
+    return ret;
+}